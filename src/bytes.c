@@ -32,15 +32,39 @@
 #include "bytes.h"
 #include "blammo.h"
 #include "utils.h"              // memzero(), function signatures
+#include "hash.h"
+#include "checksum.h"
+#include "search.h"
+#include "number.h"
+
+//------------------------------------------------------------------------|
+// Size of the inline buffer, including the terminator.  Contents up to
+// one less than this are stored within the private struct itself,
+// sparing a separate heap allocation for short keys, tokens, etc.
+#define BYTES_LOCAL_SIZE            24
+
+// Bytes of a run that the tokenizer checks one at a time before handing
+// over to the vector scans in search.h
+#define BYTES_TOKEN_HEAD            16
+
+// Encapsulation pairs the tokenizer handles without allocating
+#define BYTES_LOCAL_PAIRS           4
 
 //------------------------------------------------------------------------|
 // bytes private implementation data
 typedef struct
 {
-    // The total number of bytes allocated
+    // The number of bytes in use, not counting the hidden terminator
     size_t size;
 
-    // The raw data array
+    // The number of bytes that fit before the data array must be
+    // reallocated, again not counting the terminator.  Grows
+    // geometrically so that a series of appends costs amortized Order-1
+    // per byte, rather than a realloc() each.
+    size_t capacity;
+
+    // The raw data array, capacity + 1 bytes when allocated.  Points
+    // either to 'local' or to the heap, or is NULL if never allocated.
     uint8_t * data;
 
     // Dynamically sized token pointer array. Used with tokenize/mark
@@ -48,11 +72,22 @@ typedef struct
     char ** tokens;
     size_t maxtokens;
 
+    // Dynamically sized array of match offsets, used with find_all
+    size_t * offsets;
+    size_t maxoffsets;
+
+    // Dynamically sized array of token spans, used with spans
+    bytes_span_t * spans;
+    size_t maxspans;
+
     // A report buffer used for hexdump, debugging, tokens? etc...
     // This is only used for certain calls, but otherwise left NULL.
     // it will be re-purposed as necessary and destroyed when the main
     // object is destroyed.
     bytes_t * buffer;
+
+    // Inline storage used until the contents outgrow it
+    uint8_t local[BYTES_LOCAL_SIZE];
 }
 bytes_priv_t;
 
@@ -147,6 +182,19 @@ static int bytes_compare(const void * bytes, const void * other)
     return memcmp(a->data(a), b->data(b), a->size(a));
 }
 
+//------------------------------------------------------------------------|
+static uint64_t bytes_hash(const void * bytes)
+{
+    bytes_t * b = (bytes_t *) bytes;
+    return hash_bytes(b->data(b), b->size(b), 0);
+}
+
+//------------------------------------------------------------------------|
+static uint32_t bytes_checksum(const bytes_t * bytes, checksum_t type)
+{
+    return checksum_of(type, bytes->data(bytes), bytes->size(bytes));
+}
+
 //------------------------------------------------------------------------|
 ssize_t bytes_diff_byte(const bytes_t * bytes, const bytes_t * other)
 {
@@ -221,16 +269,141 @@ static void bytes_clear(bytes_t * bytes)
         free(priv->tokens);
     }
 
-    // Destroy the actual byte array
+    // And the match offsets, and token spans
+    if (priv->offsets)
+    {
+        memzero(priv->offsets, sizeof(size_t) * priv->maxoffsets);
+        free(priv->offsets);
+    }
+
+    if (priv->spans)
+    {
+        memzero(priv->spans, sizeof(bytes_span_t) * priv->maxspans);
+        free(priv->spans);
+    }
+
+    // Destroy the actual byte array, including any spare capacity that
+    // may still hold old contents
     if (priv->data)
     {
-        memzero(priv->data, priv->size);
-        free(priv->data);
+        memzero(priv->data, priv->capacity + 1);
+        if (priv->data != priv->local)
+        {
+            free(priv->data);
+        }
     }
 
     memzero(bytes->priv, sizeof(bytes_priv_t));
 }
 
+//------------------------------------------------------------------------|
+// Private helper that reallocates the data array to hold exactly
+// 'capacity' bytes plus the terminator, or moves it in or out of the
+// inline buffer as needed.  Keeps the current contents and terminator,
+// which must fit.  Leaves everything intact and returns false on failure.
+static bool bytes_realloc(bytes_priv_t * priv, size_t capacity)
+{
+    uint8_t * data = NULL;
+
+    // Small enough for the inline buffer, which always has full capacity
+    if (capacity < BYTES_LOCAL_SIZE)
+    {
+        if (priv->data && priv->data != priv->local)
+        {
+            memcpy(priv->local, priv->data, priv->size + 1);
+            memzero(priv->data, priv->capacity + 1);
+            free(priv->data);
+        }
+
+        priv->data = priv->local;
+        priv->capacity = BYTES_LOCAL_SIZE - 1;
+        return true;
+    }
+
+    // Moving out of the inline buffer
+    if (priv->data == priv->local)
+    {
+        data = (uint8_t *) malloc(capacity + 1);
+        if (!data)
+        {
+            BLAMMO(FATAL, "malloc(%zu) failed\n", capacity + 1);
+            return false;
+        }
+
+        memcpy(data, priv->local, priv->size + 1);
+        memzero(priv->local, BYTES_LOCAL_SIZE);
+        priv->data = data;
+        priv->capacity = capacity;
+        return true;
+    }
+
+    data = (uint8_t *) realloc(priv->data, capacity + 1);
+    if (!data)
+    {
+        BLAMMO(FATAL, "realloc(%zu) failed\n", capacity + 1);
+        return false;
+    }
+
+    priv->data = data;
+    priv->capacity = capacity;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static size_t bytes_capacity(const bytes_t * bytes)
+{
+    return ((bytes_priv_t *) bytes->priv)->capacity;
+}
+
+//------------------------------------------------------------------------|
+static bool bytes_reserve(bytes_t * bytes, size_t capacity)
+{
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+
+    if (priv->data && capacity <= priv->capacity)
+    {
+        return true;
+    }
+
+    if (!bytes_realloc(priv, capacity))
+    {
+        return false;
+    }
+
+    priv->data[priv->size] = 0;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static bool bytes_shrink_to_fit(bytes_t * bytes)
+{
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+
+    if (!priv->data || priv->data == priv->local ||
+        priv->capacity == priv->size)
+    {
+        return true;
+    }
+
+    // Wipe the spare capacity before handing it back
+    memzero(priv->data + priv->size, priv->capacity - priv->size);
+    return bytes_realloc(priv, priv->size);
+}
+
+//------------------------------------------------------------------------|
+// Private helper that makes sure 'size' bytes fit, reallocating only when
+// out of room, and then to at least double the capacity.  The first
+// allocation lands in the inline buffer if small enough.
+static bool bytes_grow(bytes_priv_t * priv, size_t size)
+{
+    if (priv->data && size <= priv->capacity)
+    {
+        return true;
+    }
+
+    return bytes_realloc(priv, MAX(size, priv->capacity * 2));
+}
+
 //------------------------------------------------------------------------|
 static void bytes_resize(bytes_t * bytes, size_t size)
 {
@@ -242,18 +415,16 @@ static void bytes_resize(bytes_t * bytes, size_t size)
         return;
     }
 
-    // Use realloc to resize byte array
-    priv->data = (uint8_t *) realloc(priv->data, size + 1);
-    if (!priv->data)
+    if (!bytes_grow(priv, size))
     {
-        BLAMMO(FATAL, "realloc(%zu) failed\n", size + 1);
         return;
     }
 
-    // Zero out the new memory
+    // Zero out the new memory.  This is not erasing anything sensitive,
+    // so plain memset() is fine and much faster than memzero().
     if (size > priv->size)
     {
-        memzero(priv->data + priv->size, size - priv->size);
+        memset(priv->data + priv->size, 0, size - priv->size);
     }
 
     // Update size and explicitly terminate buffer
@@ -263,7 +434,15 @@ static void bytes_resize(bytes_t * bytes, size_t size)
 }
 
 //------------------------------------------------------------------------|
-ssize_t bytes_vprint(bytes_t * bytes, const char * format, va_list args)
+// Private helper that formats into the buffer from 'offset' on, which
+// becomes the new size.  Writes straight into the capacity left after the
+// offset, and only formats a second time if that turns out too small.
+// The buffer then grows geometrically, so a series of appends rarely
+// needs the second pass.
+static ssize_t bytes_format(bytes_t * bytes,
+                            size_t offset,
+                            const char * format,
+                            va_list args)
 {
     bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
     ssize_t nchars = 0;
@@ -284,37 +463,64 @@ ssize_t bytes_vprint(bytes_t * bytes, const char * format, va_list args)
     // if a second pass is necessary: use the original
     va_copy(args_copy, args);
 
-    // First pass will be successful if the current size is large enough.
-    // It is OK (and should be done) to call va_end() on the copy.
-    nchars = vsnprintf((char *) priv->data, priv->size, format, args_copy);
+    // First pass will be successful if the current capacity is large
+    // enough.  It is OK (and should be done) to call va_end() on the copy.
+    char * out = priv->data ? (char *) priv->data + offset : NULL;
+    size_t room = priv->data ? priv->capacity - offset + 1 : 0;
+    nchars = vsnprintf(out, room, format, args_copy);
     va_end (args_copy);
 
-    // Return early if error occurred
+    // Return early if error occurred.  The first pass may have written
+    // over the terminator, so put it back at the offset.
     if (nchars < 0)
     {
         BLAMMO(ERROR, "vsnprintf(%p, %zu, %s, va_list) returned %d",
-            priv->data, priv->size, format, nchars);
+            out, room, format, nchars);
+        if (priv->data)
+        {
+            priv->size = offset;
+            priv->data[offset] = 0;
+        }
         return nchars;
     }
 
-    // If vsnprintf returns larger than (OR EQUAL TO) existing size, then another
-    // pass is necessary.  Either way, we'll resize to either shrink down or
-    // grow to fit.  If the two are the same then resize checks for that.
-    // FIX: vsnprintf() apparently returns length including null terminator.
-    // This leads to all sorts of weird behavior when appending and trimming.
-    // This is why a redo is necessary when nchars == size.
-    redo = (nchars >= priv->size);
-    bytes->resize(bytes, (size_t) nchars);
+    // vsnprintf() returns the length without the null terminator, so a
+    // second pass is necessary if that does not fit in the capacity.
+    // Otherwise the formatted text and its terminator are already in
+    // place, and only the size needs to catch up.
+    redo = ((size_t) nchars >= room);
+    if (!redo)
+    {
+        priv->size = offset + (size_t) nchars;
+        return nchars;
+    }
 
-    if (redo)
+    // The new bytes are about to be written, so skip resize() zeroing
+    // them.  On failure the first pass may have left the terminator
+    // overwritten, as above.
+    if (!bytes_grow(priv, offset + (size_t) nchars))
     {
-        // Second pass will pick up the full formatted buffer
-        nchars = vsnprintf((char *) priv->data, priv->size + 1, format, args);
+        if (priv->data)
+        {
+            priv->size = offset;
+            priv->data[offset] = 0;
+        }
+        return -1;
     }
 
+    // Second pass will pick up the full formatted buffer
+    priv->size = offset + (size_t) nchars;
+    nchars = vsnprintf((char *) priv->data + offset, (size_t) nchars + 1,
+                       format, args);
     return nchars;
 }
 
+//------------------------------------------------------------------------|
+ssize_t bytes_vprint(bytes_t * bytes, const char * format, va_list args)
+{
+    return bytes_format(bytes, 0, format, args);
+}
+
 //------------------------------------------------------------------------|
 static ssize_t bytes_print(bytes_t * bytes, const char * format, ...)
 {
@@ -328,6 +534,161 @@ static ssize_t bytes_print(bytes_t * bytes, const char * format, ...)
     return nchars;
 }
 
+//------------------------------------------------------------------------|
+static ssize_t bytes_append_vprint(bytes_t * bytes,
+                                   const char * format,
+                                   va_list args)
+{
+    return bytes_format(bytes, ((bytes_priv_t *) bytes->priv)->size,
+                        format, args);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t bytes_append_print(bytes_t * bytes, const char * format, ...)
+{
+    va_list args;
+    ssize_t nchars = 0;
+
+    va_start (args, format);
+    nchars = bytes->append_vprint(bytes, format, args);
+    va_end (args);
+
+    return nchars;
+}
+
+//------------------------------------------------------------------------|
+// Private helper that makes room at the end for any formatted number, so
+// that the number_format_*() functions can write straight into the data
+static inline char * bytes_number_room(bytes_priv_t * priv)
+{
+    if (!bytes_grow(priv, priv->size + NUMBER_MAX_CHARS))
+    {
+        return NULL;
+    }
+
+    return (char *) priv->data + priv->size;
+}
+
+// Private helper that takes in a number just written at the end
+static inline void bytes_number_done(bytes_priv_t * priv, size_t length)
+{
+    priv->size += length;
+    priv->data[priv->size] = 0;
+}
+
+//------------------------------------------------------------------------|
+static void bytes_append_u64(bytes_t * bytes, uint64_t value)
+{
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+    char * out = bytes_number_room(priv);
+
+    if (out)
+    {
+        bytes_number_done(priv, number_format_u64(out, value));
+    }
+}
+
+//------------------------------------------------------------------------|
+static void bytes_append_i64(bytes_t * bytes, int64_t value)
+{
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+    char * out = bytes_number_room(priv);
+
+    if (out)
+    {
+        bytes_number_done(priv, number_format_i64(out, value));
+    }
+}
+
+//------------------------------------------------------------------------|
+static void bytes_append_hex(bytes_t * bytes, uint64_t value, size_t width)
+{
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+    char * out = bytes_number_room(priv);
+
+    if (out)
+    {
+        bytes_number_done(priv, number_format_hex(out, value, width));
+    }
+}
+
+//------------------------------------------------------------------------|
+static void bytes_append_double(bytes_t * bytes, double value)
+{
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+    char * out = bytes_number_room(priv);
+
+    if (out)
+    {
+        bytes_number_done(priv, number_format_double(out, value));
+    }
+}
+
+//------------------------------------------------------------------------|
+static ssize_t bytes_parse_u64(const bytes_t * bytes,
+                               size_t offset,
+                               uint64_t * value)
+{
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+
+    if (offset > priv->size)
+    {
+        BLAMMO(ERROR, "offset %zu is after data size %zu", offset, priv->size);
+        return -1;
+    }
+
+    return number_parse_u64(priv->data + offset, priv->size - offset, value);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t bytes_parse_i64(const bytes_t * bytes,
+                               size_t offset,
+                               int64_t * value)
+{
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+
+    if (offset > priv->size)
+    {
+        BLAMMO(ERROR, "offset %zu is after data size %zu", offset, priv->size);
+        return -1;
+    }
+
+    return number_parse_i64(priv->data + offset, priv->size - offset, value);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t bytes_parse_hex(const bytes_t * bytes,
+                               size_t offset,
+                               uint64_t * value)
+{
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+
+    if (offset > priv->size)
+    {
+        BLAMMO(ERROR, "offset %zu is after data size %zu", offset, priv->size);
+        return -1;
+    }
+
+    return number_parse_hex(priv->data + offset, priv->size - offset, value);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t bytes_parse_double(const bytes_t * bytes,
+                                  size_t offset,
+                                  double * value)
+{
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+
+    if (offset > priv->size)
+    {
+        BLAMMO(ERROR, "offset %zu is after data size %zu", offset, priv->size);
+        return -1;
+    }
+
+    return number_parse_double(priv->data + offset, priv->size - offset,
+                               value);
+}
+
 //------------------------------------------------------------------------|
 static void bytes_assign(bytes_t * bytes, const void * data, size_t size)
 {
@@ -349,14 +710,23 @@ static void bytes_assign(bytes_t * bytes, const void * data, size_t size)
 static void bytes_append(bytes_t * bytes, const void * data, size_t size)
 {
     bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
-    size_t prev_size = priv->size;
 
-    // Simply add data to end, resizing up.  Note this is functionally
-    // the same as insert() at the end.
-    bytes->resize(bytes, priv->size + size);
+    if (size == 0)
+    {
+        return;
+    }
+
+    // Simply add data to end, growing as needed.  Note this is
+    // functionally the same as insert() at the end, but the new bytes
+    // are about to be overwritten, so skip resize() zeroing them.
+    if (!bytes_grow(priv, priv->size + size))
+    {
+        return;
+    }
 
-    // buffer was already terminated in resize
-    memcpy(priv->data + prev_size, data, size);
+    memcpy(priv->data + priv->size, data, size);
+    priv->size += size;
+    priv->data[priv->size] = 0;
 }
 
 //------------------------------------------------------------------------|
@@ -455,21 +825,19 @@ static ssize_t bytes_find_forward(struct bytes_t * bytes,
                                   size_t size)
 {
     bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
-    ssize_t offset = (ssize_t) start_offset;
+    ssize_t found;
 
-    // Return on first match
-    while(offset + size <= priv->size)
+    if (start_offset > priv->size)
     {
-        if (!memcmp(priv->data + offset, data, size))
-        {
-            return offset;
-        }
-
-        offset++;
+        return -1;
     }
 
-    // No match found
-    return -1;
+    // See search.h for how the search is done
+    found = search_forward(priv->data + start_offset,
+                           priv->size - start_offset,
+                           data, size);
+
+    return found < 0 ? found : found + (ssize_t) start_offset;
 }
 
 //------------------------------------------------------------------------|
@@ -487,21 +855,68 @@ static ssize_t bytes_find_reverse(struct bytes_t * bytes,
         start_offset = priv->size;
     }
 
-    ssize_t offset = start_offset - size;
+    // Matches must end at or before start_offset
+    return search_reverse(priv->data, start_offset, data, size);
+}
+
+//------------------------------------------------------------------------|
+static const size_t * bytes_find_all(bytes_t * bytes,
+                                     size_t start_offset,
+                                     const void * data,
+                                     size_t size,
+                                     bool overlapping,
+                                     size_t * count)
+{
+    // Returned when nothing is found, so that NULL only means failure
+    static const size_t none[1] = { 0 };
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+    ssize_t found;
+    size_t i;
 
-    // Return on first match
-    while(offset >= 0)
+    *count = 0;
+    if (start_offset > priv->size)
     {
-        if (!memcmp(priv->data + offset, data, size))
-        {
-            return offset;
-        }
+        return none;
+    }
+
+    // Offsets come back relative to start_offset
+    found = search_all(priv->data + start_offset, priv->size - start_offset,
+                       data, size, overlapping,
+                       &priv->offsets, &priv->maxoffsets);
+    if (found < 0)
+    {
+        return NULL;
+    }
+    else if (found == 0)
+    {
+        return none;
+    }
+
+    for (i = 0; start_offset && i < (size_t) found; i++)
+    {
+        priv->offsets[i] += start_offset;
+    }
+
+    *count = (size_t) found;
+    return priv->offsets;
+}
+
+//------------------------------------------------------------------------|
+static size_t bytes_count(const bytes_t * bytes,
+                          size_t start_offset,
+                          const void * data,
+                          size_t size,
+                          bool overlapping)
+{
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
 
-        offset--;
+    if (start_offset > priv->size)
+    {
+        return 0;
     }
 
-    // No match found
-    return -1;
+    return search_count(priv->data + start_offset, priv->size - start_offset,
+                        data, size, overlapping);
 }
 
 //------------------------------------------------------------------------|
@@ -531,173 +946,279 @@ static void * bytes_copy(const void * bytes_ptr)
 }
 
 //------------------------------------------------------------------------|
-// Private helper function for dynamically sizing token array
-static void bytes_resize_tokens(bytes_t * bytes,
-                                size_t numtokens,
-                                size_t maxtokens)
+// Private helper function for dynamically sizing token array.  Only ever
+// grows, so that the array is reused from one call to the next, and
+// entries past those in use are left as they are, the tokenizer
+// terminating the list itself.  Returns false if memory could not be
+// allocated, leaving the array as it was.
+static bool bytes_reserve_tokens(bytes_priv_t * priv, size_t maxtokens)
 {
-    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+    char ** tokens;
+
+    if (maxtokens <= priv->maxtokens)
+    {
+        return true;
+    }
 
-    priv->tokens = (char **) realloc(priv->tokens,
-                                     sizeof(char *) * maxtokens);
-    if (!priv->tokens)
+    tokens = (char **) realloc(priv->tokens, sizeof(char *) * maxtokens);
+    if (!tokens)
     {
         BLAMMO(FATAL, "realloc(%zu) failed", sizeof(char *) * maxtokens);
-        return;
+        return false;
     }
 
+    priv->tokens = tokens;
     priv->maxtokens = maxtokens;
-    memzero(&priv->tokens[numtokens],
-            sizeof(char *) * (maxtokens - numtokens));
-
     BLAMMO(DEBUG, "resized maxtokens: %zu", priv->maxtokens);
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// The tokenizer's arguments, compiled once per call into byte sets and a
+// table of which encapsulation pair each byte begins, so that finding a
+// token takes no strspn(), strlen() or trial of every pair, and the long
+// runs within and between tokens are scanned 16 or 32 bytes at a time.
+typedef struct
+{
+    // Delimiters, skipped ahead of each token, and delimiters plus NUL,
+    // which end plain tokens
+    search_set_t delims;
+    search_set_t stops;
+
+    // One plus the index of the first encapsulation pair that begins with
+    // each byte, or zero.  For each pair in use, its begin and end bytes
+    // plus NUL, which are what matter within encapsulated tokens.
+    // These are kept within the rules for the first few pairs.
+    const char ** encaps;
+    uint16_t pairs[256];
+    search_set_t * nests;
+    search_set_t local[BYTES_LOCAL_PAIRS];
+
+    // Tokens may not begin with this, if not NULL
+    const char * ignore;
+    size_t ignore_size;
+}
+bytes_rules_t;
+
+// A token found by bytes_scan_token(), as offsets into the data
+typedef struct
+{
+    size_t begin;       // first byte of the token
+    size_t end;         // one past its last byte
+    size_t next;        // where to look for the next token
+    size_t pair;        // one plus the index of its encapsulation pair, or 0
 }
+bytes_token_t;
 
 //------------------------------------------------------------------------|
-// Private helper function for bytes_next_token().  This is essentially
-// a super-strcspn() that accounts for encapsulated tokens such as quoted
-// strings and parenthetical expressions.  The encapsulation charaters are
-// included in the spanned token.
-static size_t bytes_encaps_span(const char * str, const char * encaps)
+// Private helper function for bytes_scan_token().  Length of the run at
+// 'data' of bytes in the set, or of bytes not in it.  Most runs, such as
+// tokens and the gaps between them, end before a vector scan would pay
+// for setting itself up, so the first few bytes are looked up in the
+// set's table right here, and only longer runs go to search_span() and
+// search_cspan().
+static inline size_t bytes_token_run(const uint8_t * data,
+                                     size_t size,
+                                     const search_set_t * set,
+                                     bool in)
 {
-    // Nothing to check here if end of string or if not encapsulated.
-    if (!*str || (*str != encaps[0]))
+    size_t head = MIN(size, (size_t) BYTES_TOKEN_HEAD);
+    size_t i = 0;
+
+    while (i < head && (set->member[data[i]] != 0) == in)
     {
-        return 0;
+        i++;
     }
 
-    // The *str must necessarily be encaps[0] to get to this point,
-    // so advance past it and start at nest level 1.
-    char * ptr = (char *) str + 1;
-    int nest = 1;
-
-    // Done either at end-of-string or nest level gets back to zero
-    while (*ptr && nest)
+    if (i < head || i == size)
     {
-        // Have to check for end-encaps (encaps[1]) first to cover
-        // special case of quotes, where end char == begin char.
-        if (*ptr == encaps[1])
-        {
-            nest--;
-        }
-        else if (*ptr == encaps[0])
-        {
-            nest++;
-        }
+        return i;
+    }
 
-        ptr++;
+    return i + (in ? search_span(data + i, size - i, set)
+                   : search_cspan(data + i, size - i, set));
+}
+
+//------------------------------------------------------------------------|
+// Private helper function for tokenizer().  Returns false if memory could
+// not be allocated.
+static bool bytes_compile_rules(bytes_rules_t * rules,
+                                const char ** encaps,
+                                const char * delim,
+                                const char * ignore)
+{
+    size_t delim_size = delim ? strlen(delim) : 0;
+    size_t npairs = 0;
+    size_t i;
+
+    // The terminator of 'delim' puts NUL among the stops
+    search_set_init(&rules->delims, delim, delim_size);
+    search_set_init(&rules->stops, delim ? delim : "", delim_size + 1);
+
+    rules->ignore = ignore;
+    rules->ignore_size = ignore ? strlen(ignore) : 0;
+    rules->encaps = encaps;
+    rules->nests = NULL;
+    memset(rules->pairs, 0, sizeof(rules->pairs));
+
+    while (encaps && encaps[npairs])
+    {
+        npairs++;
+    }
+
+    if (npairs == 0)
+    {
+        return true;
+    }
+
+    rules->nests = rules->local;
+    if (npairs > BYTES_LOCAL_PAIRS)
+    {
+        rules->nests = (search_set_t *) malloc(sizeof(search_set_t) * npairs);
     }
 
-    // Check for unterminated token.  I.E. missing parenthesis, or
-    // no end-quote, for example.
-    if (nest)
+    if (!rules->nests)
     {
-        BLAMMO(WARNING, "Expected \'%c\' at nest level %d offset %zu",
-                encaps[1], nest, ptr - str);
+        BLAMMO(FATAL, "malloc(%zu) failed", sizeof(search_set_t) * npairs);
+        return false;
     }
 
-    return (size_t) (ptr - str);
+    // First pair wins: I.E. consider "(parens-inside)" versus
+    // ("quotes-inside").  A pair given as a single character has NUL for
+    // an end, and so runs to the end of the data.
+    for (i = 0; i < npairs && i < UINT16_MAX; i++)
+    {
+        const uint8_t begin = (uint8_t) encaps[i][0];
+        const uint8_t nest[3] = { begin, begin ? encaps[i][1] : 0, 0 };
+
+        if (begin && !rules->pairs[begin])
+        {
+            rules->pairs[begin] = i + 1;
+            search_set_init(&rules->nests[i], nest, sizeof(nest));
+        }
+    }
+
+    return true;
 }
 
 //------------------------------------------------------------------------|
-// Private helper function for tokenizer().  This is essentially a super-
-// glorified strtok_r() except that it handles encapsulated tokens
-// and optionally does or does not insert null terminators, as requested.
-static char * bytes_next_token(bytes_t * bytes,
-                               bool split,
-                               const char ** encaps,
-                               const char * delim,
-                               const char * ignore,
-                               char ** saveptr)
+// Private helper function for tokenizer().  Frees what compiling the
+// rules may have allocated.
+static void bytes_release_rules(bytes_rules_t * rules)
 {
-    char * end;
-    char * str = NULL;
-    size_t span = 0;
-    int i = 0;
+    if (rules->nests != rules->local)
+    {
+        free(rules->nests);
+    }
+}
 
-    // Set the current pointer within the buffer
-    if (bytes)
+//------------------------------------------------------------------------|
+// Private helper function for bytes_scan_token().  Whether there can be
+// no token at an offset: at the end of the data, a NUL, or the beginning
+// of the 'ignore' string (an inline comment, for example)
+static inline bool bytes_token_done(const uint8_t * data,
+                                    size_t size,
+                                    size_t offset,
+                                    const bytes_rules_t * rules)
+{
+    if (offset >= size || !data[offset])
     {
-        str = (char *) bytes->cstr(bytes);
+        return true;
     }
-    else
+
+    if (!rules->ignore)
     {
-        str = *saveptr;
+        return false;
     }
 
-    // Can't track str pointer inside bytes size here
-    // because intentionally NULL bytes on Nth call.
+    return rules->ignore_size == 0 ||
+           (data[offset] == (uint8_t) rules->ignore[0] &&
+            size - offset >= rules->ignore_size &&
+            !memcmp(data + offset, rules->ignore, rules->ignore_size));
+}
 
-    // Check if we're done early, ignore inline comments
-    if ((*str == '\0') ||
-       (ignore && !strncmp(str, ignore, strlen(ignore))))
+//------------------------------------------------------------------------|
+// Private helper function for tokenizer().  This is essentially a super-
+// glorified strtok_r() except that it handles encapsulated tokens, and
+// works on offsets without altering the data.  Finds the next token at or
+// after 'offset', returning false if there are no more.  Encapsulation
+// characters are included in the token, unless 'strip' is set and the
+// pair is identical (quotes), in which case they are left out.
+static bool bytes_scan_token(const uint8_t * data,
+                             size_t size,
+                             size_t offset,
+                             const bytes_rules_t * rules,
+                             bool strip,
+                             bytes_token_t * token)
+{
+    // Check if we're done early, then skip leading delimiters, and check
+    // again at the token beginning
+    if (bytes_token_done(data, size, offset, rules))
     {
-        *saveptr = str;
-        return NULL;
+        return false;
     }
 
-    // Scan for leading delimiters, move up to token beginning
-    str += strspn(str, delim);
-    if ((*str == '\0') ||
-       (ignore && !strncmp(str, ignore, strlen(ignore))))
+    offset += bytes_token_run(data + offset, size - offset,
+                              &rules->delims, true);
+    if (bytes_token_done(data, size, offset, rules))
     {
-        *saveptr = str;
-        return NULL;
+        return false;
     }
 
-    // Check for encapsulated tokens.  Regular delimiters are
-    // allowed to occur within these, such as quoted strings
-    // or parenthetical expressions.  First match wins: I.E.
-    // consider "(parens-inside)" versus ("quotes-inside")
-    while (encaps && encaps[i])
+    token->begin = offset;
+    token->pair = rules->pairs[data[offset]];
+
+    // If not encapsulated, do things as regular-ol' strtok_r() would.
+    // The next token starts after the delimiter, if there is one.
+    if (!token->pair)
     {
-        span = bytes_encaps_span(str, encaps[i]);
-        if (span > 0)
-        {
-            end = str + span;
-
-            // Special case!  Assume that if encapsulation pair is identical,
-            // then it represents quoted strings, and also that we would want
-            // the quotes STRIPPED from the token IF and ONLY IF a split is
-            // requested.  This function works OK without this block of code
-            // but would otherwise leave all quoted tokens with quotes in place.
-            if (split && encaps[i][0] == encaps[i][1])
-            {
-                str++;
-                end--;
+        token->end = offset + bytes_token_run(data + offset, size - offset,
+                                              &rules->stops, false);
+        token->next = token->end + (token->end < size && data[token->end]);
+        return true;
+    }
 
-                // If end <= str then the token is empty / invalid!!
-                if (end <= str)
-                {
-                    //return bytes_next_token(bytes, split, encaps, delim, ignore, &end);
-                    //goto some lable just before "str += strspn(str, delim);" above
-                    return NULL;
-                }
-            }
+    // Encapsulated tokens, such as quoted strings or parenthetical
+    // expressions, may contain regular delimiters, and run to where the
+    // nest level gets back to zero.  End-encaps must be checked first to
+    // cover the special case of quotes, where end char == begin char.
+    const char * encaps = rules->encaps[token->pair - 1];
+    const search_set_t * nest_set = &rules->nests[token->pair - 1];
+    size_t ptr = offset + 1;
+    int nest = 1;
 
+    while (nest)
+    {
+        ptr += bytes_token_run(data + ptr, size - ptr, nest_set, false);
+        if (ptr >= size || !data[ptr])
+        {
+            // Unterminated token.  I.E. missing parenthesis, or no
+            // end-quote, for example.
+            BLAMMO(WARNING, "Expected \'%c\' at nest level %d offset %zu",
+                   encaps[1], nest, ptr - offset);
             break;
         }
 
-        i++;
+        nest += data[ptr] == (uint8_t) encaps[1] ? -1 : 1;
+        ptr++;
     }
 
-    // If span is zero at this point then no encapsulated token,
-    // so do things as regular-ol' strtok_r() would in that case.
-    if (span == 0)
+    token->end = ptr;
+    if (strip && encaps[0] == encaps[1])
     {
-        // Find where the token ends
-        end = str + strcspn(str, delim);
-        if (*end == '\0')
+        token->begin++;
+        token->end--;
+
+        // If end <= begin then the token is empty / invalid!!
+        if (token->end <= token->begin)
         {
-            *saveptr = end;
-            return str;
+            return false;
         }
     }
 
-    // Terminate the token (if requested) and make *saveptr point past it.
-    if (split) { *end = '\0'; }
-    *saveptr = end + 1;
-    return str;
+    // The byte just past the token is taken to be its delimiter
+    token->next = token->end + 1;
+    return true;
 }
 
 //------------------------------------------------------------------------|
@@ -716,6 +1237,14 @@ static char ** bytes_tokenizer(bytes_t * bytes,
     }
 
     bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+    bytes_rules_t rules;
+    bytes_token_t token;
+    size_t offset = 0;
+
+    if (!bytes_compile_rules(&rules, encaps, delim, ignore))
+    {
+        return NULL;
+    }
 
     // The theoretical maximum number of tokens in a string is
     // probably something like 1/2 strlen: if every single token was 1
@@ -724,50 +1253,105 @@ static char ** bytes_tokenizer(bytes_t * bytes,
     // chars long, a reasonable guess is 1/4 strlen.  Add some extra
     // extra padding onto that, say 2 elements.  Then the plan is to
     // double this size whenever we run out of room.
-    size_t maxtokens = 2 + (priv->size >> 2);
-    bytes_resize_tokens(bytes, 0, maxtokens);
-
-    // Proceed with tokenization
-    char * saveptr = NULL;
-    char * ptr = bytes_next_token(bytes, split, encaps, delim, ignore, &saveptr);
+    if (!bytes_reserve_tokens(priv, 2 + (priv->size >> 2)))
+    {
+        bytes_release_rules(&rules);
+        return NULL;
+    }
 
+    // Proceed with tokenization, quotes being stripped only if splitting
     *numtokens = 0;
-    while (ptr != NULL)
+    while (bytes_scan_token(priv->data, priv->size, offset,
+                            &rules, split, &token))
     {
-        BLAMMO(DEBUG, "ptr: %s", ptr);
-        priv->tokens[(*numtokens)++] = ptr;
-
-        // HACK
-        // Must also check when/if saveptr goes out of range.
-        // This is the source of the intermittent print bug
-        // FIXME: Find a better way to fix this.
-        if (bytes->offset(bytes, saveptr) > bytes->size(bytes))
+        // Terminate the token if requested
+        if (split && token.end < priv->size)
         {
-            BLAMMO(ERROR, "saveptr went out of range");
-            //hexdump(bytes->data(bytes), bytes->size(bytes) + 3, 0);
-            break;
+            priv->data[token.end] = '\0';
         }
-        // END HACK
 
-        ptr = bytes_next_token(NULL, split, encaps, delim, ignore, &saveptr);
+        priv->tokens[(*numtokens)++] = (char *) priv->data + token.begin;
+        offset = token.next;
 
-        // Resize up if necessary, zeroing new memory
-        if (*numtokens >= priv->maxtokens)
+        // Resize up if necessary, leaving room for the terminator
+        if (*numtokens >= priv->maxtokens &&
+            !bytes_reserve_tokens(priv, priv->maxtokens << 1))
         {
-            maxtokens <<= 1;
-            bytes_resize_tokens(bytes, *numtokens, maxtokens);
+            (*numtokens)--;
+            break;
         }
     }
 
-    // DEBUG ONLY:
+    priv->tokens[*numtokens] = NULL;
+    bytes_release_rules(&rules);
     BLAMMO(DEBUG, "numtokens: %zu", *numtokens);
-    size_t tnum = 0;
-    for (tnum = 0; tnum < *numtokens; tnum++)
+    return priv->tokens;
+}
+
+//------------------------------------------------------------------------|
+ssize_t bytes_tokenize(const void * data,
+                       size_t size,
+                       const char ** encaps,
+                       const char * delim,
+                       const char * ignore,
+                       bytes_span_t ** spans,
+                       size_t * capacity)
+{
+    bytes_rules_t rules;
+    bytes_token_t token;
+    size_t offset = 0;
+    size_t count = 0;
+
+    if (!bytes_compile_rules(&rules, encaps, delim, ignore))
     {
-        BLAMMO(DEBUG, "token[%zu]: %s", tnum, priv->tokens[tnum]);
+        return -1;
     }
 
-    return priv->tokens;
+    while (bytes_scan_token((const uint8_t *) data, size, offset,
+                            &rules, false, &token))
+    {
+        if (count >= *capacity)
+        {
+            size_t grown = MAX((size_t) 16, *capacity * 2);
+            bytes_span_t * array = (bytes_span_t *)
+                                   realloc(*spans,
+                                           sizeof(bytes_span_t) * grown);
+            if (!array)
+            {
+                BLAMMO(FATAL, "realloc(%zu) failed",
+                       sizeof(bytes_span_t) * grown);
+                bytes_release_rules(&rules);
+                return -1;
+            }
+
+            *spans = array;
+            *capacity = grown;
+        }
+
+        (*spans)[count].offset = token.begin;
+        (*spans)[count].length = token.end - token.begin;
+        (*spans)[count].encaps = (ssize_t) token.pair - 1;
+        count++;
+        offset = token.next;
+    }
+
+    bytes_release_rules(&rules);
+    return (ssize_t) count;
+}
+
+//------------------------------------------------------------------------|
+static const bytes_span_t * bytes_spans(bytes_t * bytes,
+                                        const char ** encaps,
+                                        const char * delim,
+                                        const char * ignore,
+                                        size_t * numtokens)
+{
+    bytes_priv_t * priv = (bytes_priv_t *) bytes->priv;
+    ssize_t found = bytes_tokenize(priv->data, priv->size, encaps, delim,
+                                   ignore, &priv->spans, &priv->maxspans);
+
+    *numtokens = found > 0 ? (size_t) found : 0;
+    return found > 0 ? priv->spans : NULL;
 }
 
 //------------------------------------------------------------------------|
@@ -838,6 +1422,10 @@ static ssize_t bytes_insert(bytes_t * bytes,
     // Size up to hold new data
     size_t oldsize = priv->size;
     bytes->resize(bytes, priv->size + size);
+    if (priv->size != oldsize + size)
+    {
+        return -2;
+    }
 
     // Move higher data up
     memmove(priv->data + offset + size,
@@ -976,6 +1564,8 @@ const bytes_t bytes_pub = {
     &bytes_print_create,
     &bytes_destroy,
     &bytes_compare,
+    &bytes_hash,
+    &bytes_checksum,
     &bytes_diff_byte,
     &bytes_data,
     &bytes_cstr,
@@ -983,8 +1573,21 @@ const bytes_t bytes_pub = {
     &bytes_empty,
     &bytes_clear,
     &bytes_resize,
+    &bytes_capacity,
+    &bytes_reserve,
+    &bytes_shrink_to_fit,
     &bytes_vprint,
     &bytes_print,
+    &bytes_append_vprint,
+    &bytes_append_print,
+    &bytes_append_u64,
+    &bytes_append_i64,
+    &bytes_append_hex,
+    &bytes_append_double,
+    &bytes_parse_u64,
+    &bytes_parse_i64,
+    &bytes_parse_hex,
+    &bytes_parse_double,
     &bytes_assign,
     &bytes_append,
     &bytes_read_at,
@@ -994,12 +1597,495 @@ const bytes_t bytes_pub = {
     &bytes_trim,
     &bytes_find_forward,
     &bytes_find_reverse,
+    &bytes_find_all,
+    &bytes_count,
     &bytes_fill,
     &bytes_copy,
     &bytes_tokenizer,
+    &bytes_spans,
     &bytes_offset,
     &bytes_remove,
     &bytes_insert,
     &bytes_hexdump,
     NULL
 };
+
+//------------------------------------------------------------------------|
+// Where a bytes_tokenizer_t is in the input, in the terms of
+// bytes_scan_token(): about to check for the end of the tokens, skipping
+// delimiters, checking again at the token beginning, within a plain or an
+// encapsulated token, about to skip the byte after a token, or done.
+typedef enum
+{
+    BYTES_STREAM_CHECK = 0,
+    BYTES_STREAM_DELIMS,
+    BYTES_STREAM_BEGIN,
+    BYTES_STREAM_PLAIN,
+    BYTES_STREAM_NEST,
+    BYTES_STREAM_SKIP,
+    BYTES_STREAM_DONE,
+}
+bytes_stream_t;
+
+// bytes_tokenizer private implementation data
+typedef struct
+{
+    // Compiled arguments, and the copies of them that the rules use
+    bytes_rules_t rules;
+    char ** encaps;
+    char * ignore;
+
+    // Where the tokenizer is, and within an encapsulated token, which
+    // pair (plus one) and how deeply nested
+    bytes_stream_t state;
+    size_t pair;
+    int nest;
+
+    // The unfinished end of the input so far: the current token, or
+    // a possible 'ignore' string, from its beginning on.  The first
+    // 'scanned' bytes have been looked at already, and the first one is
+    // at 'offset' in the input.
+    uint8_t * pending;
+    size_t size;
+    size_t capacity;
+    size_t scanned;
+    size_t offset;
+}
+bytes_tokenizer_priv_t;
+
+//------------------------------------------------------------------------|
+// Private helper function for bytes_tokenizer_t.  bytes_token_done() for
+// data that may go on past 'size', if 'more' is set.  Returns 1 if there
+// are no more tokens, 0 if there may be one here, or negative if that
+// depends on data yet to come.
+static int bytes_stream_done(const uint8_t * data,
+                             size_t size,
+                             size_t offset,
+                             const bytes_rules_t * rules,
+                             bool more)
+{
+    size_t avail = size - offset;
+
+    if (offset >= size)
+    {
+        return more ? -1 : 1;
+    }
+
+    if (!rules->ignore || avail >= rules->ignore_size ||
+        data[offset] != (uint8_t) rules->ignore[0])
+    {
+        return bytes_token_done(data, size, offset, rules);
+    }
+
+    // What is here so far starts like the 'ignore' string
+    if (!data[offset] || memcmp(data + offset, rules->ignore, avail))
+    {
+        return !data[offset];
+    }
+
+    return more ? -1 : 0;
+}
+
+//------------------------------------------------------------------------|
+// Private helper function for bytes_tokenizer_t.  Passes a token to the
+// caller, returning false to stop.
+static inline bool bytes_stream_found(const bytes_tokenizer_priv_t * priv,
+                                      const uint8_t * data,
+                                      size_t begin,
+                                      size_t end,
+                                      bytes_token_f found,
+                                      void * object)
+{
+    bytes_span_t span = {
+        priv->offset + begin,
+        end - begin,
+        (ssize_t) priv->pair - 1
+    };
+
+    return found(object, data + begin, &span);
+}
+
+//------------------------------------------------------------------------|
+// Private helper function for bytes_tokenizer_t.  Runs the tokenizer over
+// 'size' bytes of data, the first of which is at priv->offset in the
+// input, from priv->scanned on.  'more' tells whether the input goes on
+// after this.  Sets 'keep' to where the unfinished end of the data
+// begins, and returns the number of tokens found.
+static size_t bytes_stream_run(bytes_tokenizer_priv_t * priv,
+                               const uint8_t * data,
+                               size_t size,
+                               bool more,
+                               bytes_token_f found,
+                               void * object,
+                               size_t * keep)
+{
+    const bytes_rules_t * rules = &priv->rules;
+    const char * encaps;
+    size_t count = 0;
+    size_t begin = 0;
+    size_t i = priv->scanned;
+    bool waiting = false;
+    int done;
+
+    // Data kept over from before always starts where the state did, and
+    // whatever is unfinished when the data runs out is kept from where
+    // its state began
+    *keep = size;
+    while (priv->state != BYTES_STREAM_DONE && !waiting)
+    {
+        switch (priv->state)
+        {
+        case BYTES_STREAM_CHECK:
+        case BYTES_STREAM_BEGIN:
+            done = bytes_stream_done(data, size, i, rules, more);
+            if (done < 0)
+            {
+                *keep = i;
+                waiting = true;
+            }
+            else if (done)
+            {
+                priv->state = BYTES_STREAM_DONE;
+            }
+            else if (priv->state == BYTES_STREAM_CHECK)
+            {
+                priv->state = BYTES_STREAM_DELIMS;
+            }
+            else
+            {
+                begin = i;
+                priv->pair = rules->pairs[data[i]];
+                priv->nest = 1;
+                priv->state = priv->pair ? BYTES_STREAM_NEST
+                                         : BYTES_STREAM_PLAIN;
+                i += priv->pair != 0;
+            }
+            break;
+
+        case BYTES_STREAM_DELIMS:
+            i += bytes_token_run(data + i, size - i, &rules->delims, true);
+            if (i < size || !more)
+            {
+                priv->state = BYTES_STREAM_BEGIN;
+            }
+            else
+            {
+                *keep = i;
+                waiting = true;
+            }
+            break;
+
+        case BYTES_STREAM_PLAIN:
+            i += bytes_token_run(data + i, size - i, &rules->stops, false);
+            if (i == size && more)
+            {
+                *keep = begin;
+                waiting = true;
+                break;
+            }
+
+            count++;
+            if (!bytes_stream_found(priv, data, begin, i, found, object) ||
+                i == size || !data[i])
+            {
+                priv->state = BYTES_STREAM_DONE;
+                break;
+            }
+
+            // Past the delimiter
+            i++;
+            priv->state = BYTES_STREAM_CHECK;
+            break;
+
+        case BYTES_STREAM_NEST:
+            encaps = rules->encaps[priv->pair - 1];
+            i += bytes_token_run(data + i, size - i,
+                                 &rules->nests[priv->pair - 1], false);
+            if (i == size && more)
+            {
+                *keep = begin;
+                waiting = true;
+                break;
+            }
+
+            if (i == size || !data[i])
+            {
+                BLAMMO(WARNING, "Expected \'%c\' at nest level %d offset %zu",
+                       encaps[1], priv->nest, i - begin);
+                priv->nest = 0;
+            }
+            else
+            {
+                priv->nest += data[i] == (uint8_t) encaps[1] ? -1 : 1;
+                i++;
+            }
+
+            if (!priv->nest)
+            {
+                count++;
+                priv->state = bytes_stream_found(priv, data, begin, i,
+                                                 found, object) ?
+                              BYTES_STREAM_SKIP : BYTES_STREAM_DONE;
+            }
+            break;
+
+        case BYTES_STREAM_SKIP:
+            // The byte just past an encapsulated token is taken to be
+            // its delimiter
+            if (i < size)
+            {
+                i++;
+                priv->state = BYTES_STREAM_CHECK;
+            }
+            else if (more)
+            {
+                *keep = i;
+                waiting = true;
+            }
+            else
+            {
+                priv->state = BYTES_STREAM_DONE;
+            }
+            break;
+
+        default:
+            priv->state = BYTES_STREAM_DONE;
+            break;
+        }
+    }
+
+    priv->scanned = i - *keep;
+    return count;
+}
+
+//------------------------------------------------------------------------|
+// Private helper function for bytes_tokenizer_t.  Makes room for 'size'
+// bytes of pending data.
+static bool bytes_stream_reserve(bytes_tokenizer_priv_t * priv, size_t size)
+{
+    size_t grown = MAX(size, priv->capacity * 2);
+    uint8_t * pending;
+
+    if (size <= priv->capacity)
+    {
+        return true;
+    }
+
+    pending = (uint8_t *) realloc(priv->pending, grown);
+    if (!pending)
+    {
+        BLAMMO(FATAL, "realloc(%zu) failed", grown);
+        return false;
+    }
+
+    priv->pending = pending;
+    priv->capacity = grown;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static void bytes_tokenizer_reset(bytes_tokenizer_t * tokenizer)
+{
+    bytes_tokenizer_priv_t * priv = (bytes_tokenizer_priv_t *)
+                                    tokenizer->priv;
+
+    priv->state = BYTES_STREAM_CHECK;
+    priv->pair = 0;
+    priv->nest = 0;
+    priv->size = 0;
+    priv->scanned = 0;
+    priv->offset = 0;
+}
+
+//------------------------------------------------------------------------|
+static bytes_tokenizer_t * bytes_tokenizer_create(const char ** encaps,
+                                                  const char * delim,
+                                                  const char * ignore)
+{
+    bytes_tokenizer_t * tokenizer = (bytes_tokenizer_t *)
+                                    malloc(sizeof(bytes_tokenizer_t));
+    size_t npairs = 0;
+    size_t i;
+
+    if (!tokenizer)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(bytes_tokenizer_t)) failed");
+        return NULL;
+    }
+
+    memcpy(tokenizer, &bytes_tokenizer_pub, sizeof(bytes_tokenizer_t));
+
+    bytes_tokenizer_priv_t * priv = (bytes_tokenizer_priv_t *)
+                                    malloc(sizeof(bytes_tokenizer_priv_t));
+    if (!priv)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(bytes_tokenizer_priv_t)) failed");
+        free(tokenizer);
+        return NULL;
+    }
+
+    memzero(priv, sizeof(bytes_tokenizer_priv_t));
+    tokenizer->priv = priv;
+
+    // Copy the arguments, a NULL encaps list becoming an empty one
+    while (encaps && encaps[npairs])
+    {
+        npairs++;
+    }
+
+    priv->encaps = (char **) calloc(npairs + 1, sizeof(char *));
+    priv->ignore = ignore ? strdup(ignore) : NULL;
+    if (!priv->encaps || (ignore && !priv->ignore))
+    {
+        BLAMMO(FATAL, "failed to copy tokenizer arguments");
+        tokenizer->destroy(tokenizer);
+        return NULL;
+    }
+
+    for (i = 0; i < npairs; i++)
+    {
+        priv->encaps[i] = strdup(encaps[i]);
+        if (!priv->encaps[i])
+        {
+            BLAMMO(FATAL, "strdup() failed");
+            tokenizer->destroy(tokenizer);
+            return NULL;
+        }
+    }
+
+    if (!bytes_compile_rules(&priv->rules, (const char **) priv->encaps,
+                             delim, priv->ignore))
+    {
+        tokenizer->destroy(tokenizer);
+        return NULL;
+    }
+
+    bytes_tokenizer_reset(tokenizer);
+    return tokenizer;
+}
+
+//------------------------------------------------------------------------|
+static void bytes_tokenizer_destroy(void * tokenizer_ptr)
+{
+    bytes_tokenizer_t * tokenizer = (bytes_tokenizer_t *) tokenizer_ptr;
+    size_t i;
+
+    // guard against accidental double-destroy or early-destroy
+    if (!tokenizer || !tokenizer->priv)
+    {
+        BLAMMO(WARNING, "attempt to early or double-destroy");
+        return;
+    }
+
+    bytes_tokenizer_priv_t * priv = (bytes_tokenizer_priv_t *)
+                                    tokenizer->priv;
+
+    bytes_release_rules(&priv->rules);
+
+    for (i = 0; priv->encaps && priv->encaps[i]; i++)
+    {
+        free(priv->encaps[i]);
+    }
+
+    free(priv->encaps);
+    free(priv->ignore);
+
+    if (priv->pending)
+    {
+        memzero(priv->pending, priv->capacity);
+        free(priv->pending);
+    }
+
+    // zero out and destroy the private data
+    memzero(tokenizer->priv, sizeof(bytes_tokenizer_priv_t));
+    free(tokenizer->priv);
+
+    // zero out and destroy the public interface
+    memzero(tokenizer, sizeof(bytes_tokenizer_t));
+    free(tokenizer);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t bytes_tokenizer_feed(bytes_tokenizer_t * tokenizer,
+                                    const void * data,
+                                    size_t size,
+                                    bytes_token_f found,
+                                    void * object)
+{
+    bytes_tokenizer_priv_t * priv = (bytes_tokenizer_priv_t *)
+                                    tokenizer->priv;
+    size_t count;
+    size_t keep;
+
+    if (priv->state == BYTES_STREAM_DONE)
+    {
+        return 0;
+    }
+
+    // Room for the whole chunk is made up front, so that keeping the end
+    // of it cannot fail once its tokens have been passed on
+    if (!bytes_stream_reserve(priv, priv->size + size))
+    {
+        return -1;
+    }
+
+    // With nothing pending, the chunk is tokenized where it is, and only
+    // its unfinished end copied.  Otherwise it goes after what is pending.
+    if (priv->size == 0)
+    {
+        count = bytes_stream_run(priv, (const uint8_t *) data, size, true,
+                                 found, object, &keep);
+        if (keep < size)
+        {
+            memcpy(priv->pending, (const uint8_t *) data + keep, size - keep);
+        }
+
+        priv->size = size - keep;
+    }
+    else
+    {
+        if (size > 0)
+        {
+            memcpy(priv->pending + priv->size, data, size);
+        }
+
+        priv->size += size;
+        count = bytes_stream_run(priv, priv->pending, priv->size, true,
+                                 found, object, &keep);
+        memmove(priv->pending, priv->pending + keep, priv->size - keep);
+        priv->size -= keep;
+    }
+
+    priv->offset += keep;
+    return (ssize_t) count;
+}
+
+//------------------------------------------------------------------------|
+static ssize_t bytes_tokenizer_finish(bytes_tokenizer_t * tokenizer,
+                                      bytes_token_f found,
+                                      void * object)
+{
+    bytes_tokenizer_priv_t * priv = (bytes_tokenizer_priv_t *)
+                                    tokenizer->priv;
+    size_t count = 0;
+    size_t keep;
+
+    if (priv->state != BYTES_STREAM_DONE)
+    {
+        count = bytes_stream_run(priv, priv->pending, priv->size, false,
+                                 found, object, &keep);
+    }
+
+    bytes_tokenizer_reset(tokenizer);
+    return (ssize_t) count;
+}
+
+//------------------------------------------------------------------------|
+const bytes_tokenizer_t bytes_tokenizer_pub = {
+    &bytes_tokenizer_create,
+    &bytes_tokenizer_destroy,
+    &bytes_tokenizer_feed,
+    &bytes_tokenizer_finish,
+    &bytes_tokenizer_reset,
+    NULL
+};
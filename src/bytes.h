@@ -30,6 +30,18 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
+#include "checksum.h"       // checksum_t
+
+//------------------------------------------------------------------------|
+// A token as a span of the data, from spans() and bytes_tokenize()
+typedef struct
+{
+    size_t offset;      // where the token begins
+    size_t length;      // its length, including any encapsulation
+    ssize_t encaps;     // index of its encapsulation pair, or negative
+}
+bytes_span_t;
+
 //------------------------------------------------------------------------|
 typedef struct bytes_t
 {
@@ -46,6 +58,16 @@ typedef struct bytes_t
     // as qsort()'s 'compar' argument, for that purpose.
     int (*compare)(const void * bytes, const void * other);
 
+    // 64-bit hash of the contents (see hash.h), consistent with compare()
+    // in that equal byte buffers hash equally.  Intentionally has the
+    // generic_hash_f signature.
+    uint64_t (*hash)(const void * bytes);
+
+    // Checksum of the contents with the given algorithm (see checksum.h).
+    // For a checksum running over several buffers, use the checksum_*()
+    // functions on data() and size() directly.
+    uint32_t (*checksum)(const struct bytes_t * bytes, checksum_t type);
+
     // Comparator that finds the index of the first byte that is
     // different between the two buffers, searching from the beginning
     // (offset 0) up to the end of the shortest byte buffer.
@@ -54,7 +76,9 @@ typedef struct bytes_t
     ssize_t (*diff_byte)(const struct bytes_t * bytes,
                          const struct bytes_t * other);
 
-    // Get the data as a byte array pointer
+    // Get the data as a byte array pointer.  Short contents are stored
+    // inline within the object, so like any other pointer into the data
+    // this is only valid until the next call that changes the size.
     const uint8_t * (*data)(const struct bytes_t * bytes);
 
     // Get the data as a C string
@@ -69,9 +93,24 @@ typedef struct bytes_t
     // Effectively brings the bytes back to factory condition.
     void (*clear)(struct bytes_t * bytes);
 
-    // Resize the buffer, keeping existing data intact
+    // Resize the buffer, keeping existing data intact.  Growing zeroes
+    // the new bytes.  The underlying allocation grows geometrically and
+    // is kept when shrinking, so repeated resizes and appends are cheap.
     void (*resize)(struct bytes_t * bytes, size_t size);
 
+    // Number of bytes the buffer can hold before it must be reallocated,
+    // not counting the hidden null terminator
+    size_t (*capacity)(const struct bytes_t * bytes);
+
+    // Make room for at least 'capacity' bytes in total without changing
+    // the size, so that growing up to that needs no reallocation.
+    // Returns false if memory could not be allocated.
+    bool (*reserve)(struct bytes_t * bytes, size_t capacity);
+
+    // Give any spare capacity back to the heap.  Returns false if memory
+    // could not be reallocated, in which case nothing changes.
+    bool (*shrink_to_fit)(struct bytes_t * bytes);
+
     // vprintf()-style string formatter.  resizes as necessary.
     // Does not call va_start or va_end!!!
     ssize_t (*vprint)(struct bytes_t * bytes, const char * format, va_list args);
@@ -79,6 +118,42 @@ typedef struct bytes_t
     // printf-style string formatter.  resizes as necessary
     ssize_t (*print)(struct bytes_t * bytes, const char * format, ...);
 
+    // vprintf()-style formatter that appends to the existing data rather
+    // than replacing it, formatting straight into the spare capacity.
+    // Returns the number of bytes appended or negative if an error
+    // occurred.  Does not call va_start or va_end!!!
+    ssize_t (*append_vprint)(struct bytes_t * bytes,
+                             const char * format,
+                             va_list args);
+
+    // printf-style formatter that appends, as append_vprint()
+    ssize_t (*append_print)(struct bytes_t * bytes, const char * format, ...);
+
+    // Append a number formatted as by the number_format_*() functions
+    // (see number.h), writing straight into the buffer without printf().
+    // Doubles get the shortest digits that read back exactly.
+    void (*append_u64)(struct bytes_t * bytes, uint64_t value);
+    void (*append_i64)(struct bytes_t * bytes, int64_t value);
+    void (*append_hex)(struct bytes_t * bytes, uint64_t value, size_t width);
+    void (*append_double)(struct bytes_t * bytes, double value);
+
+    // Parse a number starting at an offset into the data, as by the
+    // number_parse_*() functions.  Returns the number of bytes it took
+    // up, or negative if there is no number there, it is out of range,
+    // or the offset is out of bounds.
+    ssize_t (*parse_u64)(const struct bytes_t * bytes,
+                         size_t offset,
+                         uint64_t * value);
+    ssize_t (*parse_i64)(const struct bytes_t * bytes,
+                         size_t offset,
+                         int64_t * value);
+    ssize_t (*parse_hex)(const struct bytes_t * bytes,
+                         size_t offset,
+                         uint64_t * value);
+    ssize_t (*parse_double)(const struct bytes_t * bytes,
+                            size_t offset,
+                            double * value);
+
     // Assign data directly to buffer, replacing any existing data,
     // and sizing the buffer as necessary.  strncpy/memcpy analog.
     void (*assign)(struct bytes_t * bytes,
@@ -114,7 +189,9 @@ typedef struct bytes_t
 
     // Find instance(s) of subsequence, searching from left or right,
     // negative return indicates not found.  length of match is same as substring
-    // TODO: consider find_all by re-using token array
+    // Forward finds the first match starting at or after start_offset,
+    // reverse the last match ending at or before it.  See search.h, and
+    // bytes_searcher_t there for searching repeatedly for one needle.
     ssize_t (*find_forward)(struct bytes_t * bytes,
                             size_t start_offset,
                             const void * data,
@@ -125,6 +202,28 @@ typedef struct bytes_t
                             const void * data,
                             size_t size);
 
+    // Find every instance of subsequence from start_offset on, in a
+    // single pass.  If 'overlapping' is false, each match starts after
+    // the end of the previous one.  Returns the match offsets in order,
+    // in an array kept by the bytes object and reused by the next call,
+    // and sets 'count'.  If none were found, returns an empty array and
+    // sets 'count' to zero.  Returns NULL only if the array could not be
+    // grown.
+    const size_t * (*find_all)(struct bytes_t * bytes,
+                               size_t start_offset,
+                               const void * data,
+                               size_t size,
+                               bool overlapping,
+                               size_t * count);
+
+    // Count instances of subsequence from start_offset on, as find_all()
+    // would find them, without recording where they are
+    size_t (*count)(const struct bytes_t * bytes,
+                    size_t start_offset,
+                    const void * data,
+                    size_t size,
+                    bool overlapping);
+
     // Fill the buffer completely with a given character
     void (*fill)(struct bytes_t * bytes, const char c);
 
@@ -158,6 +257,19 @@ typedef struct bytes_t
                          const char * ignore,
                          size_t * numtokens);
 
+    // Same tokens as tokenizer() without 'split', as spans of the data
+    // rather than pointers into it, so that nothing is altered and no
+    // token needs re-scanning to find its end.  Encapsulated tokens keep
+    // their encapsulation characters, and 'encaps' in the span tells
+    // which pair.  Returns the spans in an array kept by the bytes
+    // object and reused by the next call, and sets 'numtokens'.  Returns
+    // NULL if there are no tokens.
+    const bytes_span_t * (*spans)(struct bytes_t * bytes,
+                                  const char ** encaps,
+                                  const char * delim,
+                                  const char * ignore,
+                                  size_t * numtokens);
+
     // Given an absolute pointer into the data, get the relative offset
     // Returns negative value if there is an error
     ssize_t (*offset)(struct bytes_t * bytes, void * ptr);
@@ -188,16 +300,81 @@ bytes_t;
 extern const bytes_t bytes_pub;
 
 //------------------------------------------------------------------------|
-//    ssize_t (*find_all)(struct bytes_t * bytes,
-//                        const void * data,
-//                        size_t size,
-//                        size_t * offsets,
-//                        size_t * max_offsets);
-// Else consider returning a list.
+// spans() on data held anywhere, such as read-only or memory-mapped
+// buffers, which are never written to.  As with tokenizer(), a NUL byte
+// ends the data.  The spans are written in order to the array at
+// '*spans', which holds '*capacity' of them and is grown with realloc()
+// as needed, so that an array passed back in is reused.  Both may start
+// out NULL and zero.  The caller owns the array, and frees it with
+// free().  Returns the number of tokens, or negative if memory could not
+// be allocated.
+ssize_t bytes_tokenize(const void * data,
+                       size_t size,
+                       const char ** encaps,
+                       const char * delim,
+                       const char * ignore,
+                       bytes_span_t ** spans,
+                       size_t * capacity);
+
+//------------------------------------------------------------------------|
+// Callback for each token from a bytes_tokenizer_t.  'object' is the
+// caller's context, 'token' points to the token's bytes, which are only
+// valid during the call, and 'span' gives its length, its offset from the
+// start of the input, and its encapsulation pair.  Return false to stop.
+typedef bool (*bytes_token_f)(void * object,
+                              const uint8_t * token,
+                              const bytes_span_t * span);
+
+// Incremental tokenizer for input that arrives in chunks, such as from a
+// pipe.  Finds the same tokens as spans() would on all of the input
+// joined together, including tokens and nesting that straddle chunks.
+// Only the unfinished token at the end of a chunk is kept until the next
+// one, so memory stays within the longest token plus the largest chunk,
+// however long the input.
+typedef struct bytes_tokenizer_t
+{
+    // Factory function.  Arguments are as for tokenizer(), and are copied,
+    // so they need not outlive the tokenizer.
+    struct bytes_tokenizer_t * (*create)(const char ** encaps,
+                                         const char * delim,
+                                         const char * ignore);
+
+    // Tokenizer destructor function
+    void (*destroy)(void * tokenizer);
+
+    // Tokenize the next chunk, passing each token finished within it to
+    // 'found'.  Returns the number of tokens, or negative if memory could
+    // not be allocated.  Once the input is over, as by an 'ignore' string
+    // or a NUL byte, or by 'found' returning false, further chunks are
+    // skipped until reset().
+    ssize_t (*feed)(struct bytes_tokenizer_t * tokenizer,
+                    const void * data,
+                    size_t size,
+                    bytes_token_f found,
+                    void * object);
+
+    // End of input: passes any token still unfinished to 'found', as when
+    // the last quote is missing, and resets for new input.  Returns the
+    // number of tokens.
+    ssize_t (*finish)(struct bytes_tokenizer_t * tokenizer,
+                      bytes_token_f found,
+                      void * object);
+
+    // Drop any unfinished token and start over on new input
+    void (*reset)(struct bytes_tokenizer_t * tokenizer);
+
+    // Private data
+    void * priv;
+}
+bytes_tokenizer_t;
+
+//------------------------------------------------------------------------|
+extern const bytes_tokenizer_t bytes_tokenizer_pub;
+
+//------------------------------------------------------------------------|
 // TODO: Notional Functions
 // (*fill_cyclic) // for VR purposes
 // TODO: how to handle whether the string needs to be un-escaped or not?
 // TODO: manual escape/un-escape calls for this
 //(*escape/encode) (*unescape/decode)
 //find/insert/replace/remove
-//void (*shrink)(struct bytes_t * bytes); ???
@@ -0,0 +1,503 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "cache.h"
+#include "utils.h"              // memzero()
+#include "hash.h"
+#include "blammo.h"
+
+//------------------------------------------------------------------------|
+// A cached object.  Each entry sits on two intrusive lists at once: its
+// hash bucket chain and the recency list, so that neither a lookup nor a
+// promotion or eviction ever needs a search.
+typedef struct cache_entry_t
+{
+    // Next entry in the same hash bucket
+    struct cache_entry_t * chain;
+
+    // Neighbours in the recency list: toward most and least recent
+    struct cache_entry_t * newer;
+    struct cache_entry_t * older;
+
+    // Pointer to the object managed by this cache, and its cost
+    void * object;
+    size_t cost;
+
+    // Object destructor function
+    generic_destroy_f object_destroy;
+
+    // Hash and dictionary-style keyword associated with this object
+    uint64_t hash;
+    char key[];
+}
+cache_entry_t;
+
+// Cache private implementation data
+typedef struct
+{
+    // Hash index.  Sized once for the capacity and never rehashed.
+    cache_entry_t ** buckets;
+    size_t mask;
+
+    // Recency list ends
+    cache_entry_t * newest;
+    cache_entry_t * oldest;
+
+    // Limits and current usage
+    size_t capacity;
+    size_t max_cost;
+    size_t length;
+    size_t cost;
+
+    // Statistics
+    bool timing;
+    size_t hits;
+    size_t misses;
+    size_t inserts;
+    size_t evictions;
+    size_t timed;
+    uint64_t nsec;
+}
+cache_priv_t;
+
+//------------------------------------------------------------------------|
+static inline uint64_t cache_clock_nsec()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+//------------------------------------------------------------------------|
+// Find an entry along with the link that points to it in its bucket
+static cache_entry_t * cache_entry_find(cache_priv_t * priv,
+                                        const char * key,
+                                        uint64_t hash,
+                                        cache_entry_t *** link)
+{
+    cache_entry_t ** at = &priv->buckets[hash & priv->mask];
+
+    while (*at)
+    {
+        if ((*at)->hash == hash && strcmp((*at)->key, key) == 0)
+        {
+            break;
+        }
+
+        at = &(*at)->chain;
+    }
+
+    if (link)
+    {
+        *link = at;
+    }
+
+    return *at;
+}
+
+//------------------------------------------------------------------------|
+static inline void cache_entry_unlink(cache_priv_t * priv,
+                                      cache_entry_t * entry)
+{
+    if (entry->newer)
+    {
+        entry->newer->older = entry->older;
+    }
+    else
+    {
+        priv->newest = entry->older;
+    }
+
+    if (entry->older)
+    {
+        entry->older->newer = entry->newer;
+    }
+    else
+    {
+        priv->oldest = entry->newer;
+    }
+
+    entry->newer = NULL;
+    entry->older = NULL;
+}
+
+//------------------------------------------------------------------------|
+static inline void cache_entry_push(cache_priv_t * priv,
+                                    cache_entry_t * entry)
+{
+    entry->older = priv->newest;
+    entry->newer = NULL;
+
+    if (priv->newest)
+    {
+        priv->newest->newer = entry;
+    }
+    else
+    {
+        priv->oldest = entry;
+    }
+
+    priv->newest = entry;
+}
+
+//------------------------------------------------------------------------|
+// Remove an entry from both lists and destroy it along with its object
+static void cache_entry_remove(cache_priv_t * priv,
+                               cache_entry_t * entry,
+                               cache_entry_t ** link)
+{
+    if (!link)
+    {
+        cache_entry_find(priv, entry->key, entry->hash, &link);
+    }
+
+    *link = entry->chain;
+    cache_entry_unlink(priv, entry);
+
+    priv->length--;
+    priv->cost -= entry->cost;
+
+    if (entry->object && entry->object_destroy)
+    {
+        entry->object_destroy(entry->object);
+    }
+
+    free(entry);
+}
+
+//------------------------------------------------------------------------|
+// Evict least recently used entries until both limits are respected
+static void cache_evict(cache_priv_t * priv)
+{
+    while (priv->oldest &&
+           (priv->length > priv->capacity ||
+            (priv->max_cost && priv->cost > priv->max_cost)))
+    {
+        cache_entry_remove(priv, priv->oldest, NULL);
+        priv->evictions++;
+    }
+}
+
+//------------------------------------------------------------------------|
+static cache_t * cache_create(size_t capacity, size_t max_cost)
+{
+    if (capacity == 0)
+    {
+        BLAMMO(ERROR, "cache capacity must be non-zero");
+        return NULL;
+    }
+
+    // Allocate and initialize public interface
+    cache_t * cache = (cache_t *) malloc(sizeof(cache_t));
+    if (!cache)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(cache_t)) failed");
+        return NULL;
+    }
+
+    // bulk copy all function pointers and init opaque ptr
+    memcpy(cache, &cache_pub, sizeof(cache_t));
+
+    // Allocate and initialize private implementation
+    cache->priv = malloc(sizeof(cache_priv_t));
+    if (!cache->priv)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(cache_priv_t)) failed");
+        free(cache);
+        return NULL;
+    }
+
+    memzero(cache->priv, sizeof(cache_priv_t));
+    cache_priv_t * priv = (cache_priv_t *) cache->priv;
+
+    size_t count = 1;
+    while (count < capacity)
+    {
+        count <<= 1;
+    }
+
+    priv->buckets = (cache_entry_t **) calloc(count, sizeof(cache_entry_t *));
+    if (!priv->buckets)
+    {
+        BLAMMO(FATAL, "calloc(%zu, sizeof(cache_entry_t *)) failed", count);
+        free(cache->priv);
+        free(cache);
+        return NULL;
+    }
+
+    priv->mask = count - 1;
+    priv->capacity = capacity;
+    priv->max_cost = max_cost;
+    return cache;
+}
+
+//------------------------------------------------------------------------|
+static void cache_destroy(void * cache_ptr)
+{
+    cache_t * cache = (cache_t *) cache_ptr;
+
+    // guard against accidental double-destroy or early-destroy
+    if (!cache || !cache->priv)
+    {
+        BLAMMO(WARNING, "attempt to early or double-destroy");
+        return;
+    }
+
+    // remove all objects and destroy their data
+    cache->clear(cache);
+
+    cache_priv_t * priv = (cache_priv_t *) cache->priv;
+    free(priv->buckets);
+
+    // zero out and destroy the private data
+    memzero(cache->priv, sizeof(cache_priv_t));
+    free(cache->priv);
+
+    // zero out and destroy the public interface
+    memzero(cache, sizeof(cache_t));
+    free(cache);
+}
+
+//------------------------------------------------------------------------|
+static void cache_clear(cache_t * cache)
+{
+    cache_priv_t * priv = (cache_priv_t *) cache->priv;
+    cache_entry_t * entry = priv->newest;
+
+    while (entry)
+    {
+        cache_entry_t * older = entry->older;
+        if (entry->object && entry->object_destroy)
+        {
+            entry->object_destroy(entry->object);
+        }
+
+        free(entry);
+        entry = older;
+    }
+
+    memzero(priv->buckets, sizeof(cache_entry_t *) * (priv->mask + 1));
+    priv->newest = NULL;
+    priv->oldest = NULL;
+    priv->length = 0;
+    priv->cost = 0;
+}
+
+//------------------------------------------------------------------------|
+static bool cache_empty(cache_t * cache)
+{
+    return ((cache_priv_t *) cache->priv)->length == 0;
+}
+
+//------------------------------------------------------------------------|
+static size_t cache_length(cache_t * cache)
+{
+    return ((cache_priv_t *) cache->priv)->length;
+}
+
+//------------------------------------------------------------------------|
+static size_t cache_cost(cache_t * cache)
+{
+    return ((cache_priv_t *) cache->priv)->cost;
+}
+
+//------------------------------------------------------------------------|
+static void * cache_get(cache_t * cache, const char * key)
+{
+    cache_priv_t * priv = (cache_priv_t *) cache->priv;
+    uint64_t start = priv->timing ? cache_clock_nsec() : 0;
+    void * object = NULL;
+
+    cache_entry_t * entry = cache_entry_find(priv, key,
+                                             hash_bytes(key, strlen(key), 0),
+                                             NULL);
+    if (entry)
+    {
+        // promote to most recently used
+        if (entry != priv->newest)
+        {
+            cache_entry_unlink(priv, entry);
+            cache_entry_push(priv, entry);
+        }
+
+        object = entry->object;
+        priv->hits++;
+    }
+    else
+    {
+        priv->misses++;
+    }
+
+    if (priv->timing)
+    {
+        priv->nsec += cache_clock_nsec() - start;
+        priv->timed++;
+    }
+
+    return object;
+}
+
+//------------------------------------------------------------------------|
+static bool cache_contains(cache_t * cache, const char * key)
+{
+    cache_priv_t * priv = (cache_priv_t *) cache->priv;
+    return cache_entry_find(priv, key, hash_bytes(key, strlen(key), 0),
+                            NULL) != NULL;
+}
+
+//------------------------------------------------------------------------|
+static bool cache_put(cache_t * cache,
+                      const char * key,
+                      void * object,
+                      size_t cost,
+                      generic_destroy_f object_destroy)
+{
+    cache_priv_t * priv = (cache_priv_t *) cache->priv;
+    uint64_t hash = hash_bytes(key, strlen(key), 0);
+    cache_entry_t ** link = NULL;
+
+    if (priv->max_cost && cost > priv->max_cost)
+    {
+        BLAMMO(WARNING, "cost %zu of '%s' exceeds cache limit %zu",
+               cost, key, priv->max_cost);
+        return false;
+    }
+
+    cache_entry_t * entry = cache_entry_find(priv, key, hash, &link);
+    if (entry)
+    {
+        // Destroy the previous object to make way for the replacement
+        if (entry->object && entry->object_destroy &&
+            entry->object != object)
+        {
+            entry->object_destroy(entry->object);
+        }
+
+        priv->cost -= entry->cost;
+        cache_entry_unlink(priv, entry);
+    }
+    else
+    {
+        size_t size = strlen(key) + 1;
+        entry = (cache_entry_t *) malloc(sizeof(cache_entry_t) + size);
+        if (!entry)
+        {
+            BLAMMO(FATAL, "malloc(sizeof(cache_entry_t)) failed");
+            return false;
+        }
+
+        memzero(entry, sizeof(cache_entry_t));
+        memcpy(entry->key, key, size);
+        entry->hash = hash;
+
+        *link = entry;
+        priv->length++;
+        priv->inserts++;
+    }
+
+    entry->object = object;
+    entry->cost = cost;
+    entry->object_destroy = object_destroy;
+    priv->cost += cost;
+    cache_entry_push(priv, entry);
+
+    // The new entry is the most recent, so it is evicted last, and
+    // its cost alone is known to fit.
+    cache_evict(priv);
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static bool cache_remove(cache_t * cache, const char * key)
+{
+    cache_priv_t * priv = (cache_priv_t *) cache->priv;
+    cache_entry_t ** link = NULL;
+    cache_entry_t * entry = cache_entry_find(priv, key,
+                                             hash_bytes(key, strlen(key), 0),
+                                             &link);
+    if (!entry)
+    {
+        return false;
+    }
+
+    cache_entry_remove(priv, entry, link);
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static void cache_timing(cache_t * cache, bool enable)
+{
+    ((cache_priv_t *) cache->priv)->timing = enable;
+}
+
+//------------------------------------------------------------------------|
+static void cache_stats(cache_t * cache, cache_stats_t * stats)
+{
+    cache_priv_t * priv = (cache_priv_t *) cache->priv;
+    size_t lookups = priv->hits + priv->misses;
+
+    stats->hits = priv->hits;
+    stats->misses = priv->misses;
+    stats->inserts = priv->inserts;
+    stats->evictions = priv->evictions;
+    stats->hit_rate = lookups ? (double) priv->hits / lookups : 0.0;
+    stats->get_nsec = priv->timed ? (double) priv->nsec / priv->timed : 0.0;
+}
+
+//------------------------------------------------------------------------|
+static void cache_reset_stats(cache_t * cache)
+{
+    cache_priv_t * priv = (cache_priv_t *) cache->priv;
+
+    priv->hits = 0;
+    priv->misses = 0;
+    priv->inserts = 0;
+    priv->evictions = 0;
+    priv->timed = 0;
+    priv->nsec = 0;
+}
+
+//------------------------------------------------------------------------|
+const cache_t cache_pub = {
+    &cache_create,
+    &cache_destroy,
+    &cache_clear,
+    &cache_empty,
+    &cache_length,
+    &cache_cost,
+    &cache_get,
+    &cache_contains,
+    &cache_put,
+    &cache_remove,
+    &cache_timing,
+    &cache_stats,
+    &cache_reset_stats,
+    NULL
+};
@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------|
+// A bounded key/object cache with least-recently-used eviction.  Objects
+// are keyed by string as in collect_t, and each carries a caller-defined
+// cost (such as its size in bytes).  The cache holds at most a fixed
+// number of objects, and optionally at most a fixed total cost, evicting
+// the least recently used objects through their destructors to stay
+// within both limits.  get(), put() and eviction are all Order-1.
+#include "utils.h"          // generic function signatures
+
+//------------------------------------------------------------------------|
+// Counters kept by the cache.  Latency is only accumulated while timing
+// is enabled, since reading the clock costs about as much as a hit.
+typedef struct
+{
+    size_t hits;
+    size_t misses;
+    size_t inserts;
+    size_t evictions;
+
+    // Hits as a fraction of all lookups, 0.0 if there were none
+    double hit_rate;
+
+    // Average get() latency in nanoseconds over the timed lookups
+    double get_nsec;
+}
+cache_stats_t;
+
+//------------------------------------------------------------------------|
+typedef struct cache_t
+{
+    // Cache factory function.  'capacity' is the maximum number of
+    // objects and must be non-zero.  'max_cost' is the maximum total
+    // cost of all objects, or zero for no cost limit.
+    struct cache_t * (*create)(size_t capacity, size_t max_cost);
+
+    // Cache destructor function
+    void (*destroy)(void * cache);
+
+    // Empty the cache: Removes all items and destroys their data.
+    // Statistics are left untouched.
+    void (*clear)(struct cache_t * cache);
+
+    // Whether the cache is empty or not
+    bool (*empty)(struct cache_t * cache);
+
+    // Number of objects currently cached
+    size_t (*length)(struct cache_t * cache);
+
+    // Total cost of all objects currently cached
+    size_t (*cost)(struct cache_t * cache);
+
+    // Get an object by keyword and mark it as most recently used.
+    // Returns NULL on a miss.
+    void * (*get)(struct cache_t * cache, const char * key);
+
+    // Whether an object is cached, without affecting recency or stats
+    bool (*contains)(struct cache_t * cache, const char * key);
+
+    // Put an object in the cache as the most recently used, replacing
+    // and destroying any previous object under the same key, then evict
+    // as needed to respect the limits.  Returns false, leaving the
+    // object with the caller, if its cost alone exceeds the cost limit
+    // or memory could not be allocated.
+    bool (*put)(struct cache_t * cache,
+                const char * key,
+                void * object,
+                size_t cost,
+                generic_destroy_f object_destroy);
+
+    // Remove and destroy a specific object by key.
+    // returns true if the object was found and removed,
+    // or false if the object was not found
+    bool (*remove)(struct cache_t * cache, const char * key);
+
+    // Enable or disable get() latency measurement
+    void (*timing)(struct cache_t * cache, bool enable);
+
+    // Get a snapshot of the cache statistics
+    void (*stats)(struct cache_t * cache, cache_stats_t * stats);
+
+    // Reset the cache statistics to zero
+    void (*reset_stats)(struct cache_t * cache);
+
+    // Private data
+    void * priv;
+}
+cache_t;
+
+//------------------------------------------------------------------------|
+extern const cache_t cache_pub;
@@ -0,0 +1,708 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "ccollect.h"
+#include "utils.h"              // memzero()
+#include "hash.h"
+#include "blammo.h"
+
+//------------------------------------------------------------------------|
+// Number of writer locks.  Bucket 'n' is guarded by stripe n % STRIPES,
+// so writers to unrelated keys rarely contend.
+#define CCOLLECT_STRIPES            64
+
+// Bucket count used when the caller does not specify one
+#define CCOLLECT_DEFAULT_BUCKETS    256
+
+// Reader records are padded out to a cache line so that threads
+// announcing their epochs do not invalidate each other's lines.
+#define CCOLLECT_CACHE_LINE         64
+
+//------------------------------------------------------------------------|
+// Item container for heterogeneous key/object pair payload.  Once an
+// item is published its key and object never change: set() swaps in a
+// whole new item instead, so a reader always sees a consistent pair.
+typedef struct ccollect_item_t
+{
+    // Next item in the same bucket.  Accessed atomically.
+    struct ccollect_item_t * next;
+
+    // Link and global epoch at the time this item was retired
+    struct ccollect_item_t * retired;
+    uint64_t epoch;
+
+    // Pointer to the object managed by this collection
+    void * object;
+
+    // Object deep-copy function
+    generic_copy_f object_copy;
+
+    // Object destructor function
+    generic_destroy_f object_destroy;
+
+    // Hash and dictionary-style keyword associated with this object
+    uint64_t hash;
+    char key[];
+}
+ccollect_item_t;
+
+// Per-thread reader record.  Records are shared by every ccollect_t in
+// the process, are never freed, and are recycled when threads exit.
+typedef struct ccollect_reader_t
+{
+    // Next record in the registry.  Written once before publication.
+    struct ccollect_reader_t * next;
+
+    // Global epoch announced upon entering a critical section, or zero
+    // while the thread is quiescent.  Accessed atomically.
+    uint64_t epoch;
+
+    // Whether a live thread owns this record.  Accessed atomically.
+    bool in_use;
+
+    // Critical section nesting depth, only touched by the owner
+    unsigned int depth;
+}
+ccollect_reader_t;
+
+typedef union
+{
+    ccollect_reader_t reader;
+    uint8_t pad[CCOLLECT_CACHE_LINE];
+}
+ccollect_reader_slot_t;
+
+// Concurrent collection private implementation data
+typedef struct
+{
+    // Bucket chain heads.  Accessed atomically.
+    ccollect_item_t ** buckets;
+    size_t mask;
+
+    // Writer locks
+    pthread_mutex_t stripes[CCOLLECT_STRIPES];
+
+    // Number of objects stored.  Accessed atomically.
+    size_t length;
+
+    // Items unlinked by writers but possibly still visible to readers
+    pthread_mutex_t retire_lock;
+    ccollect_item_t * retired;
+    size_t pending;
+}
+ccollect_priv_t;
+
+//------------------------------------------------------------------------|
+// Process-wide reclamation state.  The global epoch starts at one so
+// that a zero epoch can mark a quiescent reader.
+static uint64_t ccollect_epoch = 1;
+static ccollect_reader_t * ccollect_readers = NULL;
+
+static pthread_once_t ccollect_once = PTHREAD_ONCE_INIT;
+static pthread_key_t ccollect_key;
+static __thread ccollect_reader_t * ccollect_self = NULL;
+
+//------------------------------------------------------------------------|
+// Thread exit hook: hand the thread's reader record back for re-use.
+static void ccollect_reader_release(void * ptr)
+{
+    ccollect_reader_t * reader = (ccollect_reader_t *) ptr;
+
+    reader->depth = 0;
+    __atomic_store_n(&reader->epoch, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&reader->in_use, false, __ATOMIC_RELEASE);
+}
+
+//------------------------------------------------------------------------|
+static void ccollect_key_create(void)
+{
+    if (pthread_key_create(&ccollect_key, ccollect_reader_release) != 0)
+    {
+        BLAMMO(FATAL, "pthread_key_create() failed");
+    }
+}
+
+//------------------------------------------------------------------------|
+// Get the calling thread's reader record, claiming a free one or
+// registering a new one the first time a thread reads.
+static ccollect_reader_t * ccollect_reader()
+{
+    if (ccollect_self)
+    {
+        return ccollect_self;
+    }
+
+    pthread_once(&ccollect_once, ccollect_key_create);
+
+    ccollect_reader_t * reader =
+            __atomic_load_n(&ccollect_readers, __ATOMIC_ACQUIRE);
+
+    while (reader)
+    {
+        bool unused = false;
+        if (__atomic_compare_exchange_n(&reader->in_use, &unused, true,
+                                        false, __ATOMIC_ACQUIRE,
+                                        __ATOMIC_RELAXED))
+        {
+            break;
+        }
+
+        reader = reader->next;
+    }
+
+    if (!reader)
+    {
+        ccollect_reader_slot_t * slot = NULL;
+        if (posix_memalign((void **) &slot, CCOLLECT_CACHE_LINE,
+                           sizeof(ccollect_reader_slot_t)) != 0)
+        {
+            BLAMMO(FATAL, "posix_memalign(ccollect_reader_slot_t) failed");
+            return NULL;
+        }
+
+        memzero(slot, sizeof(ccollect_reader_slot_t));
+        reader = &slot->reader;
+        reader->in_use = true;
+
+        // lock-free push onto the registry, which only ever grows
+        reader->next = __atomic_load_n(&ccollect_readers, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&ccollect_readers,
+                                            &reader->next, reader,
+                                            true, __ATOMIC_RELEASE,
+                                            __ATOMIC_RELAXED));
+    }
+
+    pthread_setspecific(ccollect_key, reader);
+    ccollect_self = reader;
+    return reader;
+}
+
+//------------------------------------------------------------------------|
+// Oldest epoch that any reader may still be observing.  Items retired
+// in an earlier epoch are unreachable and may be destroyed.
+static uint64_t ccollect_oldest_epoch()
+{
+    uint64_t oldest = __atomic_load_n(&ccollect_epoch, __ATOMIC_SEQ_CST);
+    ccollect_reader_t * reader =
+            __atomic_load_n(&ccollect_readers, __ATOMIC_ACQUIRE);
+
+    while (reader)
+    {
+        uint64_t epoch = __atomic_load_n(&reader->epoch, __ATOMIC_SEQ_CST);
+        if (epoch && epoch < oldest)
+        {
+            oldest = epoch;
+        }
+
+        reader = reader->next;
+    }
+
+    return oldest;
+}
+
+//------------------------------------------------------------------------|
+static ccollect_item_t * ccollect_item_create(const char * key,
+                                              uint64_t hash,
+                                              void * object,
+                                              generic_copy_f object_copy,
+                                              generic_destroy_f object_destroy)
+{
+    size_t size = strlen(key) + 1;
+    ccollect_item_t * item =
+            (ccollect_item_t *) malloc(sizeof(ccollect_item_t) + size);
+    if (!item)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(ccollect_item_t)) failed");
+        return NULL;
+    }
+
+    memzero(item, sizeof(ccollect_item_t));
+    memcpy(item->key, key, size);
+    item->hash = hash;
+    item->object = object;
+    item->object_copy = object_copy;
+    item->object_destroy = object_destroy;
+    return item;
+}
+
+//------------------------------------------------------------------------|
+static void ccollect_item_destroy(ccollect_item_t * item)
+{
+    if (item->object_destroy && item->object)
+    {
+        item->object_destroy(item->object);
+    }
+
+    free(item);
+}
+
+//------------------------------------------------------------------------|
+// Hand an item that has just been unlinked over for deferred
+// destruction.  Advancing the global epoch here is what separates
+// readers that might have seen the item from those that cannot have.
+static void ccollect_item_retire(ccollect_priv_t * priv,
+                                 ccollect_item_t * item)
+{
+    item->epoch = __atomic_fetch_add(&ccollect_epoch, 1, __ATOMIC_SEQ_CST);
+
+    pthread_mutex_lock(&priv->retire_lock);
+    item->retired = priv->retired;
+    priv->retired = item;
+    priv->pending++;
+    pthread_mutex_unlock(&priv->retire_lock);
+}
+
+//------------------------------------------------------------------------|
+static ccollect_t * ccollect_create(size_t buckets)
+{
+    // Allocate and initialize public interface
+    ccollect_t * ccollect = (ccollect_t *) malloc(sizeof(ccollect_t));
+    if (!ccollect)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(ccollect_t)) failed");
+        return NULL;
+    }
+
+    // bulk copy all function pointers and init opaque ptr
+    memcpy(ccollect, &ccollect_pub, sizeof(ccollect_t));
+
+    // Allocate and initialize private implementation
+    ccollect->priv = malloc(sizeof(ccollect_priv_t));
+    if (!ccollect->priv)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(ccollect_priv_t)) failed");
+        free(ccollect);
+        return NULL;
+    }
+
+    memzero(ccollect->priv, sizeof(ccollect_priv_t));
+    ccollect_priv_t * priv = (ccollect_priv_t *) ccollect->priv;
+
+    size_t count = 1;
+    buckets = buckets ? buckets : CCOLLECT_DEFAULT_BUCKETS;
+    while (count < buckets)
+    {
+        count <<= 1;
+    }
+
+    priv->buckets = (ccollect_item_t **) calloc(count,
+                                                sizeof(ccollect_item_t *));
+    if (!priv->buckets)
+    {
+        BLAMMO(FATAL, "calloc(%zu, sizeof(ccollect_item_t *)) failed",
+               count);
+        free(ccollect->priv);
+        free(ccollect);
+        return NULL;
+    }
+
+    priv->mask = count - 1;
+
+    size_t i;
+    for (i = 0; i < CCOLLECT_STRIPES; i++)
+    {
+        pthread_mutex_init(&priv->stripes[i], NULL);
+    }
+
+    pthread_mutex_init(&priv->retire_lock, NULL);
+    return ccollect;
+}
+
+//------------------------------------------------------------------------|
+static void ccollect_destroy(void * ccollect_ptr)
+{
+    ccollect_t * ccollect = (ccollect_t *) ccollect_ptr;
+
+    // guard against accidental double-destroy or early-destroy
+    if (!ccollect || !ccollect->priv)
+    {
+        BLAMMO(WARNING, "attempt to early or double-destroy");
+        return;
+    }
+
+    ccollect_priv_t * priv = (ccollect_priv_t *) ccollect->priv;
+    ccollect_item_t * item = NULL;
+    size_t i;
+
+    // Nobody else may be using the collection any more, so there is no
+    // need to wait on readers before destroying everything outright.
+    for (i = 0; i <= priv->mask; i++)
+    {
+        while ((item = priv->buckets[i]))
+        {
+            priv->buckets[i] = item->next;
+            ccollect_item_destroy(item);
+        }
+    }
+
+    while ((item = priv->retired))
+    {
+        priv->retired = item->retired;
+        ccollect_item_destroy(item);
+    }
+
+    for (i = 0; i < CCOLLECT_STRIPES; i++)
+    {
+        pthread_mutex_destroy(&priv->stripes[i]);
+    }
+
+    pthread_mutex_destroy(&priv->retire_lock);
+    free(priv->buckets);
+
+    // zero out and destroy the private data
+    memzero(ccollect->priv, sizeof(ccollect_priv_t));
+    free(ccollect->priv);
+
+    // zero out and destroy the public interface
+    memzero(ccollect, sizeof(ccollect_t));
+    free(ccollect);
+}
+
+//------------------------------------------------------------------------|
+static size_t ccollect_reclaim(ccollect_t * ccollect)
+{
+    ccollect_priv_t * priv = (ccollect_priv_t *) ccollect->priv;
+    ccollect_item_t * doomed = NULL;
+    size_t pending;
+
+    pthread_mutex_lock(&priv->retire_lock);
+
+    // Anything retired from here on is tagged with at least the epoch
+    // sampled here, so it can never be mistaken for reclaimable.
+    uint64_t oldest = ccollect_oldest_epoch();
+    ccollect_item_t ** link = &priv->retired;
+
+    while (*link)
+    {
+        ccollect_item_t * item = *link;
+        if (item->epoch < oldest)
+        {
+            *link = item->retired;
+            item->retired = doomed;
+            doomed = item;
+            priv->pending--;
+        }
+        else
+        {
+            link = &item->retired;
+        }
+    }
+
+    pending = priv->pending;
+    pthread_mutex_unlock(&priv->retire_lock);
+
+    // run destructors outside the lock, they may be arbitrarily slow
+    while (doomed)
+    {
+        ccollect_item_t * item = doomed;
+        doomed = item->retired;
+        ccollect_item_destroy(item);
+    }
+
+    return pending;
+}
+
+//------------------------------------------------------------------------|
+static void ccollect_clear(ccollect_t * ccollect)
+{
+    ccollect_priv_t * priv = (ccollect_priv_t *) ccollect->priv;
+    size_t stripe;
+    size_t i;
+
+    // Clear one stripe at a time rather than stopping every writer at
+    // once.  Items set concurrently into an already-cleared stripe stay.
+    for (stripe = 0; stripe < CCOLLECT_STRIPES; stripe++)
+    {
+        pthread_mutex_lock(&priv->stripes[stripe]);
+
+        for (i = stripe; i <= priv->mask; i += CCOLLECT_STRIPES)
+        {
+            ccollect_item_t * item = priv->buckets[i];
+            __atomic_store_n(&priv->buckets[i], NULL, __ATOMIC_SEQ_CST);
+
+            while (item)
+            {
+                ccollect_item_t * next = item->next;
+                __atomic_sub_fetch(&priv->length, 1, __ATOMIC_RELAXED);
+                ccollect_item_retire(priv, item);
+                item = next;
+            }
+        }
+
+        pthread_mutex_unlock(&priv->stripes[stripe]);
+    }
+
+    ccollect_reclaim(ccollect);
+}
+
+//------------------------------------------------------------------------|
+static bool ccollect_empty(ccollect_t * ccollect)
+{
+    ccollect_priv_t * priv = (ccollect_priv_t *) ccollect->priv;
+    return __atomic_load_n(&priv->length, __ATOMIC_RELAXED) == 0;
+}
+
+//------------------------------------------------------------------------|
+static size_t ccollect_length(ccollect_t * ccollect)
+{
+    ccollect_priv_t * priv = (ccollect_priv_t *) ccollect->priv;
+    return __atomic_load_n(&priv->length, __ATOMIC_RELAXED);
+}
+
+//------------------------------------------------------------------------|
+static bool ccollect_read_lock(ccollect_t * ccollect)
+{
+    (void) ccollect;
+
+    ccollect_reader_t * reader = ccollect_reader();
+    if (!reader)
+    {
+        return false;
+    }
+
+    if (reader->depth++ == 0)
+    {
+        // Announce the current epoch, and make sure the announcement is
+        // visible before anything in the collection is loaded.
+        uint64_t epoch = __atomic_load_n(&ccollect_epoch, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&reader->epoch, epoch, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static void ccollect_read_unlock(ccollect_t * ccollect)
+{
+    (void) ccollect;
+
+    ccollect_reader_t * reader = ccollect_self;
+    if (!reader || reader->depth == 0)
+    {
+        BLAMMO(WARNING, "read_unlock() without read_lock()");
+        return;
+    }
+
+    if (--reader->depth == 0)
+    {
+        __atomic_store_n(&reader->epoch, 0, __ATOMIC_RELEASE);
+    }
+}
+
+//------------------------------------------------------------------------|
+static void * ccollect_get(ccollect_t * ccollect, const char * key)
+{
+    ccollect_priv_t * priv = (ccollect_priv_t *) ccollect->priv;
+    uint64_t hash = hash_bytes(key, strlen(key), 0);
+    void * object = NULL;
+
+    if (!ccollect_read_lock(ccollect))
+    {
+        return NULL;
+    }
+
+    ccollect_item_t * item = __atomic_load_n(&priv->buckets[hash & priv->mask],
+                                             __ATOMIC_ACQUIRE);
+    while (item)
+    {
+        if (item->hash == hash && strcmp(item->key, key) == 0)
+        {
+            object = item->object;
+            break;
+        }
+
+        item = __atomic_load_n(&item->next, __ATOMIC_ACQUIRE);
+    }
+
+    ccollect_read_unlock(ccollect);
+    return object;
+}
+
+//------------------------------------------------------------------------|
+static bool ccollect_set(ccollect_t * ccollect,
+                         const char * key,
+                         void * object,
+                         generic_copy_f object_copy,
+                         generic_destroy_f object_destroy)
+{
+    ccollect_priv_t * priv = (ccollect_priv_t *) ccollect->priv;
+    uint64_t hash = hash_bytes(key, strlen(key), 0);
+    size_t bucket = hash & priv->mask;
+
+    ccollect_item_t * fresh = ccollect_item_create(key, hash, object,
+                                                   object_copy,
+                                                   object_destroy);
+    if (!fresh)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&priv->stripes[bucket % CCOLLECT_STRIPES]);
+
+    ccollect_item_t ** link = &priv->buckets[bucket];
+    ccollect_item_t * item = *link;
+
+    while (item && !(item->hash == hash && strcmp(item->key, key) == 0))
+    {
+        link = &item->next;
+        item = *link;
+    }
+
+    // The new item is fully formed before it is published, and the item
+    // it replaces is left intact for readers that are still on it.
+    if (item)
+    {
+        fresh->next = item->next;
+        __atomic_store_n(link, fresh, __ATOMIC_SEQ_CST);
+        ccollect_item_retire(priv, item);
+    }
+    else
+    {
+        fresh->next = priv->buckets[bucket];
+        __atomic_store_n(&priv->buckets[bucket], fresh, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&priv->length, 1, __ATOMIC_RELAXED);
+    }
+
+    pthread_mutex_unlock(&priv->stripes[bucket % CCOLLECT_STRIPES]);
+
+    if (item)
+    {
+        ccollect_reclaim(ccollect);
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static bool ccollect_remove(ccollect_t * ccollect, const char * key)
+{
+    ccollect_priv_t * priv = (ccollect_priv_t *) ccollect->priv;
+    uint64_t hash = hash_bytes(key, strlen(key), 0);
+    size_t bucket = hash & priv->mask;
+
+    pthread_mutex_lock(&priv->stripes[bucket % CCOLLECT_STRIPES]);
+
+    ccollect_item_t ** link = &priv->buckets[bucket];
+    ccollect_item_t * item = *link;
+
+    while (item && !(item->hash == hash && strcmp(item->key, key) == 0))
+    {
+        link = &item->next;
+        item = *link;
+    }
+
+    if (item)
+    {
+        __atomic_store_n(link, item->next, __ATOMIC_SEQ_CST);
+        __atomic_sub_fetch(&priv->length, 1, __ATOMIC_RELAXED);
+        ccollect_item_retire(priv, item);
+    }
+
+    pthread_mutex_unlock(&priv->stripes[bucket % CCOLLECT_STRIPES]);
+
+    if (!item)
+    {
+        return false;
+    }
+
+    ccollect_reclaim(ccollect);
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static ccollect_t * ccollect_copy(ccollect_t * ccollect)
+{
+    ccollect_priv_t * priv = (ccollect_priv_t *) ccollect->priv;
+    ccollect_t * copy = ccollect_create(priv->mask + 1);
+    bool success = true;
+    size_t i;
+
+    if (!copy)
+    {
+        return NULL;
+    }
+
+    if (!ccollect_read_lock(ccollect))
+    {
+        ccollect_destroy(copy);
+        return NULL;
+    }
+
+    for (i = 0; success && i <= priv->mask; i++)
+    {
+        ccollect_item_t * item = __atomic_load_n(&priv->buckets[i],
+                                                 __ATOMIC_ACQUIRE);
+        while (success && item)
+        {
+            void * object = item->object_copy ?
+                            item->object_copy(item->object) :
+                            item->object;
+
+            success = ccollect_set(copy, item->key, object,
+                                   item->object_copy,
+                                   item->object_destroy);
+
+            if (!success && item->object_copy && item->object_destroy)
+            {
+                item->object_destroy(object);
+            }
+
+            item = __atomic_load_n(&item->next, __ATOMIC_ACQUIRE);
+        }
+    }
+
+    ccollect_read_unlock(ccollect);
+
+    if (!success)
+    {
+        ccollect_destroy(copy);
+        return NULL;
+    }
+
+    return copy;
+}
+
+//------------------------------------------------------------------------|
+const ccollect_t ccollect_pub = {
+    &ccollect_create,
+    &ccollect_destroy,
+    &ccollect_clear,
+    &ccollect_empty,
+    &ccollect_length,
+    &ccollect_copy,
+    &ccollect_read_lock,
+    &ccollect_read_unlock,
+    &ccollect_get,
+    &ccollect_set,
+    &ccollect_remove,
+    &ccollect_reclaim,
+    NULL
+};
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------|
+// A concurrent variant of collect_t for data that is read from many
+// threads and updated rarely, such as shared configuration.  Lookups
+// never take a lock: keys are hashed into a fixed array of buckets whose
+// chains are only ever swapped atomically by writers, and writers
+// serialize against each other with a small set of striped locks.
+//
+// Replaced and removed objects are not destroyed immediately.  They are
+// retired, and their destructor runs only once every thread that could
+// still be looking at them has left its read-side critical section
+// (epoch-based reclamation).  A thread that needs an object returned by
+// get() to stay valid must hold read_lock() for as long as it uses it.
+#include "utils.h"          // generic function signatures
+
+//------------------------------------------------------------------------|
+typedef struct ccollect_t
+{
+    // Concurrent collection factory function.  The bucket array is sized
+    // once, to the next power of two of 'buckets', and never rehashed
+    // since that is what keeps lookups free of locks.  Pass zero for a
+    // reasonable default.
+    struct ccollect_t * (*create)(size_t buckets);
+
+    // Concurrent collection destructor function.  No other thread may be
+    // using the collection when it is destroyed.
+    void (*destroy)(void * ccollect);
+
+    // Empty the collection: Removes all items and retires their data.
+    void (*clear)(struct ccollect_t * ccollect);
+
+    // Whether the collection is empty or not
+    bool (*empty)(struct ccollect_t * ccollect);
+
+    // Gets the length of the collection: the number of objects stored.
+    size_t (*length)(struct ccollect_t * ccollect);
+
+    // Produce a deep copy of the collection.  Items set or removed by
+    // other threads while the copy is made may or may not be included.
+    struct ccollect_t * (*copy)(struct ccollect_t * ccollect);
+
+    // Enter and leave a read-side critical section for the calling
+    // thread.  Objects obtained from get() remain valid until the
+    // matching read_unlock(), even if another thread replaces or removes
+    // them meanwhile.  Calls may be nested.  read_lock() returns false
+    // only if the thread could not be registered as a reader.
+    bool (*read_lock)(struct ccollect_t * ccollect);
+    void (*read_unlock)(struct ccollect_t * ccollect);
+
+    // Get an object by keyword without taking any lock.  Returns NULL if
+    // it doesn't exist.  See read_lock() regarding object lifetime.
+    void * (*get)(struct ccollect_t * ccollect, const char * key);
+
+    // Set an object.  Adds it to the collection if it does not exist,
+    // or else replaces the previous object instance, which is retired
+    // and destroyed once no reader can still see it.  Returns false if
+    // memory could not be allocated.
+    bool (*set)(struct ccollect_t * ccollect,
+                const char * key,
+                void * object,
+                generic_copy_f object_copy,
+                generic_destroy_f object_destroy);
+
+    // Remove a specific object entry by key.
+    // returns true if the object was found and removed,
+    // or false if the object was not found
+    bool (*remove)(struct ccollect_t * ccollect, const char * key);
+
+    // Destroy any retired objects that no reader can still see.  This
+    // happens automatically after every set(), remove() and clear(), but
+    // may be called to flush objects retired while readers were active.
+    // Returns the number of retired objects still awaiting destruction.
+    size_t (*reclaim)(struct ccollect_t * ccollect);
+
+    // Private data
+    void * priv;
+}
+ccollect_t;
+
+//------------------------------------------------------------------------|
+extern const ccollect_t ccollect_pub;
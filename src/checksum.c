@@ -0,0 +1,306 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CHECKSUM_X86
+#endif
+
+#include "checksum.h"
+
+//------------------------------------------------------------------------|
+// Reflected CRC polynomials
+#define CHECKSUM_CRC32C_POLY        0x82f63b78UL
+#define CHECKSUM_CRC32_POLY         0xedb88320UL
+
+// Normal (MSB-first) CRC16-CCITT polynomial
+#define CHECKSUM_CRC16_POLY         0x1021U
+
+// Adler32 modulus, and the most bytes that can be summed before the
+// 32-bit sums must be reduced
+#define CHECKSUM_ADLER_MOD          65521UL
+#define CHECKSUM_ADLER_NMAX         5552
+
+//------------------------------------------------------------------------|
+// Slicing-by-8 tables: [0] is the classic byte-at-a-time table, and [k]
+// advances a byte followed by k zero bytes.  Built once on first use.
+static uint32_t checksum_crc32c_table[8][256];
+static uint32_t checksum_crc32_table[8][256];
+static uint16_t checksum_crc16_table[256];
+static pthread_once_t checksum_once = PTHREAD_ONCE_INIT;
+
+//------------------------------------------------------------------------|
+static void checksum_slice_tables(uint32_t table[8][256], uint32_t poly)
+{
+    uint32_t n;
+    int k;
+
+    for (n = 0; n < 256; n++)
+    {
+        uint32_t crc = n;
+        for (k = 0; k < 8; k++)
+        {
+            crc = (crc >> 1) ^ (poly & (0 - (crc & 1)));
+        }
+
+        table[0][n] = crc;
+    }
+
+    for (n = 0; n < 256; n++)
+    {
+        for (k = 1; k < 8; k++)
+        {
+            table[k][n] = (table[k - 1][n] >> 8) ^
+                          table[0][table[k - 1][n] & 0xff];
+        }
+    }
+}
+
+static void checksum_init(void)
+{
+    uint32_t n;
+    int k;
+
+    checksum_slice_tables(checksum_crc32c_table, CHECKSUM_CRC32C_POLY);
+    checksum_slice_tables(checksum_crc32_table, CHECKSUM_CRC32_POLY);
+
+    for (n = 0; n < 256; n++)
+    {
+        uint16_t crc = (uint16_t) (n << 8);
+        for (k = 0; k < 8; k++)
+        {
+            crc = (uint16_t) ((crc << 1) ^
+                              ((crc & 0x8000) ? CHECKSUM_CRC16_POLY : 0));
+        }
+
+        checksum_crc16_table[n] = crc;
+    }
+}
+
+//------------------------------------------------------------------------|
+// Reflected table-driven CRC over the raw (uninverted) register
+static uint32_t checksum_slice8(uint32_t table[8][256],
+                                uint32_t crc,
+                                const uint8_t * p,
+                                size_t size)
+{
+    // Bytes up to an 8-byte boundary, then eight at a time
+    while (size && ((uintptr_t) p & 7))
+    {
+        crc = (crc >> 8) ^ table[0][(crc ^ *p++) & 0xff];
+        size--;
+    }
+
+    while (size >= 8)
+    {
+        uint32_t lo;
+        uint32_t hi;
+        memcpy(&lo, p, 4);
+        memcpy(&hi, p + 4, 4);
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        lo = __builtin_bswap32(lo);
+        hi = __builtin_bswap32(hi);
+#endif
+
+        lo ^= crc;
+        crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+              table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+              table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^
+              table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+        p += 8;
+        size -= 8;
+    }
+
+    while (size--)
+    {
+        crc = (crc >> 8) ^ table[0][(crc ^ *p++) & 0xff];
+    }
+
+    return crc;
+}
+
+//------------------------------------------------------------------------|
+#if defined(CHECKSUM_X86)
+__attribute__((target("sse4.2")))
+static uint32_t checksum_crc32c_sse42(uint32_t crc,
+                                      const uint8_t * p,
+                                      size_t size)
+{
+    while (size && ((uintptr_t) p & 7))
+    {
+        crc = _mm_crc32_u8(crc, *p++);
+        size--;
+    }
+
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    while (size >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        crc64 = _mm_crc32_u64(crc64, word);
+        p += 8;
+        size -= 8;
+    }
+
+    crc = (uint32_t) crc64;
+#endif
+
+    while (size >= 4)
+    {
+        uint32_t word;
+        memcpy(&word, p, 4);
+        crc = _mm_crc32_u32(crc, word);
+        p += 4;
+        size -= 4;
+    }
+
+    while (size--)
+    {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+
+    return crc;
+}
+#endif
+
+//------------------------------------------------------------------------|
+bool checksum_crc32c_accelerated(void)
+{
+#if defined(CHECKSUM_X86)
+    return __builtin_cpu_supports("sse4.2");
+#else
+    return false;
+#endif
+}
+
+//------------------------------------------------------------------------|
+uint32_t checksum_crc32c_portable(uint32_t crc,
+                                  const void * data,
+                                  size_t size)
+{
+    pthread_once(&checksum_once, checksum_init);
+    return ~checksum_slice8(checksum_crc32c_table, ~crc,
+                            (const uint8_t *) data, size);
+}
+
+//------------------------------------------------------------------------|
+uint32_t checksum_crc32c(uint32_t crc, const void * data, size_t size)
+{
+#if defined(CHECKSUM_X86)
+    if (checksum_crc32c_accelerated())
+    {
+        return ~checksum_crc32c_sse42(~crc, (const uint8_t *) data, size);
+    }
+#endif
+
+    return checksum_crc32c_portable(crc, data, size);
+}
+
+//------------------------------------------------------------------------|
+uint32_t checksum_crc32(uint32_t crc, const void * data, size_t size)
+{
+    pthread_once(&checksum_once, checksum_init);
+    return ~checksum_slice8(checksum_crc32_table, ~crc,
+                            (const uint8_t *) data, size);
+}
+
+//------------------------------------------------------------------------|
+uint16_t checksum_crc16(uint16_t crc, const void * data, size_t size)
+{
+    const uint8_t * p = (const uint8_t *) data;
+
+    pthread_once(&checksum_once, checksum_init);
+    while (size--)
+    {
+        crc = (uint16_t) ((crc << 8) ^
+                          checksum_crc16_table[(crc >> 8) ^ *p++]);
+    }
+
+    return crc;
+}
+
+//------------------------------------------------------------------------|
+uint32_t checksum_adler32(uint32_t adler, const void * data, size_t size)
+{
+    const uint8_t * p = (const uint8_t *) data;
+    uint32_t a = adler & 0xffff;
+    uint32_t b = adler >> 16;
+
+    // Reduce modulo 65521 only as often as the sums could overflow
+    while (size > 0)
+    {
+        size_t n = size < CHECKSUM_ADLER_NMAX ? size : CHECKSUM_ADLER_NMAX;
+        size -= n;
+
+        while (n >= 8)
+        {
+            a += p[0]; b += a;
+            a += p[1]; b += a;
+            a += p[2]; b += a;
+            a += p[3]; b += a;
+            a += p[4]; b += a;
+            a += p[5]; b += a;
+            a += p[6]; b += a;
+            a += p[7]; b += a;
+            p += 8;
+            n -= 8;
+        }
+
+        while (n--)
+        {
+            a += *p++;
+            b += a;
+        }
+
+        a %= CHECKSUM_ADLER_MOD;
+        b %= CHECKSUM_ADLER_MOD;
+    }
+
+    return (b << 16) | a;
+}
+
+//------------------------------------------------------------------------|
+uint32_t checksum_of(checksum_t type, const void * data, size_t size)
+{
+    switch (type)
+    {
+    case CHECKSUM_CRC32C:
+        return checksum_crc32c(CHECKSUM_CRC32C_INIT, data, size);
+    case CHECKSUM_CRC32:
+        return checksum_crc32(CHECKSUM_CRC32_INIT, data, size);
+    case CHECKSUM_CRC16:
+        return checksum_crc16(CHECKSUM_CRC16_INIT, data, size);
+    case CHECKSUM_ADLER32:
+        return checksum_adler32(CHECKSUM_ADLER32_INIT, data, size);
+    default:
+        return 0;
+    }
+}
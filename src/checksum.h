@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------|
+// Checksums for framing and integrity checks.  Each function continues a
+// running checksum over more data, so a stream can be checked piece by
+// piece: start from the algorithm's _INIT value, and pass each result
+// back in along with the next piece.  Checking a whole buffer at once is
+// the same as checking it in any number of pieces.
+//
+// CRC32C uses the SSE4.2 crc32 instruction when the CPU has it, and
+// slicing-by-8 tables otherwise.  CRC32 uses slicing-by-8 as well, and
+// CRC16 a byte-wise table.
+
+// Supported algorithms, for use with bytes->checksum()
+typedef enum
+{
+    CHECKSUM_CRC32C = 0,    // Castagnoli, as in iSCSI, ext4, SCTP
+    CHECKSUM_CRC32,         // IEEE 802.3, as in zlib, PNG, Ethernet
+    CHECKSUM_CRC16,         // CRC-16/CCITT-FALSE, or IBM-3740 (0x1021,
+                            // initial 0xffff, no reflection or final XOR)
+    CHECKSUM_ADLER32,       // as in zlib streams
+}
+checksum_t;
+
+// Starting values of the running checksums
+#define CHECKSUM_CRC32C_INIT        0x00000000UL
+#define CHECKSUM_CRC32_INIT         0x00000000UL
+#define CHECKSUM_CRC16_INIT         0xffffU
+#define CHECKSUM_ADLER32_INIT       0x00000001UL
+
+//------------------------------------------------------------------------|
+uint32_t checksum_crc32c(uint32_t crc, const void * data, size_t size);
+uint32_t checksum_crc32(uint32_t crc, const void * data, size_t size);
+uint16_t checksum_crc16(uint16_t crc, const void * data, size_t size);
+uint32_t checksum_adler32(uint32_t adler, const void * data, size_t size);
+
+// The running checksum of the given algorithm over one buffer, from its
+// starting value.  CRC16 results are zero-extended.
+uint32_t checksum_of(checksum_t type, const void * data, size_t size);
+
+// Whether checksum_crc32c() runs on the CPU's crc32 instruction
+bool checksum_crc32c_accelerated(void);
+
+// checksum_crc32c() without hardware help, for testing and benchmarking
+uint32_t checksum_crc32c_portable(uint32_t crc,
+                                  const void * data,
+                                  size_t size);
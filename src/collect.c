@@ -27,21 +27,47 @@
 #include <stdbool.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "collect.h"
 #include "utils.h"              // memzero(), function signatures
-#include "bytes.h"
+#include "trie.h"
+#include "phash.h"
+#include "hash.h"
 #include "blammo.h"
 
+//------------------------------------------------------------------------|
+// Keys shorter than this are stored inside their container rather than
+// in a separate allocation.
+#define COLLECT_KEY_LOCAL           24
+
+// Number of containers kept inline in the collection itself.  Small
+// collections never touch the heap for their items, and are searched by
+// key tag rather than by walking the list.  At most 16, so that all tags
+// fit in one SSE2 register.
+#define COLLECT_SMALL_ITEMS         16
+
+// Counting Bloom filter geometry: counters per key of capacity, and
+// counters touched per key.  Around a 2.5% false positive rate when full.
+#define COLLECT_FILTER_RATIO        8
+#define COLLECT_FILTER_PROBES       4
+#define COLLECT_FILTER_MIN_KEYS     64
+
 //------------------------------------------------------------------------|
 // Item container for heterogeneous key/object pair payload
 typedef struct collect_object_t
 {
-    // Pointer to the next container in the collection
-    // NULL indicates the end of the collection
+    // Pointers to the next and previous containers in the collection
+    // NULL indicates the end (or beginning) of the collection
     struct collect_object_t * next;
+    struct collect_object_t * prev;
 
-    // Dictionary-style keyword associated with this object
-    bytes_t * key;
+    // Dictionary-style keyword associated with this object, and its
+    // length.  Points at 'local' when the key is short enough.
+    char * key;
+    size_t size;
 
     // Pointer to the object managed by this collection
     void * object;
@@ -51,9 +77,74 @@ typedef struct collect_object_t
 
     // Object destructor function
     generic_destroy_f object_destroy;
+
+    // Inline storage for short keys
+    char local[COLLECT_KEY_LOCAL];
 }
 collect_item_t;
 
+// One slot of a frozen collection's perfect hash table.  The key and its
+// full hash are kept alongside the item so that a miss is almost always
+// rejected without touching the item at all.
+typedef struct
+{
+    uint64_t hash;
+    const char * key;
+    collect_item_t * item;
+}
+collect_slot_t;
+
+// Minimal perfect hash table over the keys of a frozen collection (see
+// phash.h).  Header, slots and displacements share one allocation.
+typedef struct
+{
+    size_t size;
+    size_t buckets;
+    collect_slot_t * slots;
+    uint32_t * disp;
+}
+collect_frozen_t;
+
+// Counting Bloom filter over the keys of a collection.  A key is only
+// possibly present if all of its counters are non-zero, so most misses
+// are answered without looking at any container.  Counters, rather than
+// bits, let remove() take a key back out.  A counter that saturates is
+// never decremented again, which can only cost false positives.
+typedef struct
+{
+    uint8_t * counters;
+    size_t mask;
+
+    // Number of keys the filter is sized for before it is rebuilt larger
+    size_t capacity;
+}
+collect_filter_t;
+
+// Cached pointer array for keys() or objects().  Entries are packed at
+// the back of the buffer, so that the item newly placed on top of the
+// collection costs one store in front of the current contents.  The
+// slot after the last entry always holds the NULL terminator.
+typedef struct
+{
+    void ** base;
+    size_t capacity;
+    size_t length;
+
+    // Collection version that the contents reflect
+    size_t version;
+}
+collect_span_t;
+
+// A block of containers set aside by reserve().  Containers from these
+// blocks are recycled through a free list rather than freed one by one.
+typedef struct collect_chunk_t
+{
+    struct collect_chunk_t * next;
+    size_t count;
+    collect_item_t items[];
+}
+collect_chunk_t;
+
 // Collection private implementation data
 typedef struct
 {
@@ -68,49 +159,415 @@ typedef struct
     // or removal of an object to have it on-hand when asked is Order-1.
     size_t length;
 
-    // Some dynamically-sized pointer arrays for array-style iteration.
-    char ** keys;
-    void ** objects;
+    // Modification counter.  Bumped whenever keys or objects change, so
+    // that cached arrays can tell whether they are still current.
+    size_t version;
+
+    // Cached pointer arrays for array-style iteration.
+    collect_span_t keys;
+    collect_span_t objects;
+
+    // Optional key index mapping keys to their containers.  When present
+    // lookups cost Order-key-length rather than a scan of the whole list.
+    trie_t * index;
+
+    // Optional perfect hash table, present while the collection is frozen
+    collect_frozen_t * frozen;
+
+    // Optional filter that rejects most missing keys up front
+    collect_filter_t * filter;
+
+    // Inline containers, which of them are in use, and a one-byte hash
+    // tag of each one's key.  While no container lives on the heap
+    // ('spilled' is zero) a lookup only compares keys whose tags match.
+    collect_item_t small[COLLECT_SMALL_ITEMS];
+    uint8_t tags[COLLECT_SMALL_ITEMS];
+    uint32_t used;
+    size_t spilled;
+
+    // Reserved blocks of containers, and those of their containers that
+    // are currently unused
+    collect_chunk_t * chunks;
+    collect_item_t * pool;
+    size_t pooled;
 }
 collect_priv_t;
 
+//------------------------------------------------------------------------|
+static inline size_t collect_frozen_bucket(collect_frozen_t * frozen,
+                                           uint64_t hash)
+{
+    return phash_bucket(hash, frozen->buckets);
+}
+
+static inline size_t collect_frozen_slot(collect_frozen_t * frozen,
+                                         uint64_t hash,
+                                         uint32_t disp)
+{
+    return phash_slot(hash, disp, frozen->size);
+}
+
+//------------------------------------------------------------------------|
+static inline uint8_t collect_tag(const char * key, size_t size)
+{
+    return (uint8_t) hash_bytes(key, size, 0);
+}
+
+//------------------------------------------------------------------------|
+// Bit mask of the inline containers whose tag matches.  Only a handful
+// of full key comparisons remain after this.
+static inline uint32_t collect_tag_match(const uint8_t * tags, uint8_t tag)
+{
+#if defined(__SSE2__)
+    __m128i all = _mm_loadu_si128((const __m128i *) tags);
+    __m128i cmp = _mm_cmpeq_epi8(all, _mm_set1_epi8((char) tag));
+    return (uint32_t) _mm_movemask_epi8(cmp);
+#else
+    // SWAR fallback: flag zero bytes of (tags ^ tag) eight at a time.
+    // Borrows may also flag a byte above a true match, which is fine
+    // since every candidate is verified anyway.
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
+    uint32_t mask = 0;
+    size_t half;
+
+    for (half = 0; half < COLLECT_SMALL_ITEMS / 8; half++)
+    {
+        uint64_t word;
+        memcpy(&word, tags + half * 8, sizeof(word));
+        word ^= ones * tag;
+
+        uint64_t zeros = (word - ones) & ~word & highs;
+        while (zeros)
+        {
+            mask |= 1U << (half * 8 + __builtin_ctzll(zeros) / 8);
+            zeros &= zeros - 1;
+        }
+    }
+
+    return mask;
+#endif
+}
+
+//------------------------------------------------------------------------|
+// Discard the perfect hash table, returning to the live structure
+static void collect_thaw(collect_priv_t * priv)
+{
+    if (priv->frozen)
+    {
+        free(priv->frozen);
+        priv->frozen = NULL;
+    }
+}
+
+//------------------------------------------------------------------------|
+static void collect_filter_release(collect_priv_t * priv)
+{
+    if (priv->filter)
+    {
+        free(priv->filter->counters);
+        free(priv->filter);
+        priv->filter = NULL;
+    }
+}
+
+//------------------------------------------------------------------------|
+// Add (step 1) or take away (step -1) one key's share of the counters
+static void collect_filter_update(collect_filter_t * filter,
+                                  const char * key,
+                                  size_t size,
+                                  int step)
+{
+    uint64_t hash = hash_bytes(key, size, 0);
+    uint64_t stride = phash_mix(hash) | 1;
+    int k;
+
+    for (k = 0; k < COLLECT_FILTER_PROBES; k++, hash += stride)
+    {
+        uint8_t * counter = &filter->counters[hash & filter->mask];
+        if (*counter != UINT8_MAX)
+        {
+            *counter += step;
+        }
+    }
+}
+
+//------------------------------------------------------------------------|
+// Whether a key might be in the collection.  False means it certainly
+// is not.
+static bool collect_filter_test(collect_filter_t * filter,
+                                const char * key,
+                                size_t size)
+{
+    uint64_t hash = hash_bytes(key, size, 0);
+    uint64_t stride = phash_mix(hash) | 1;
+    int k;
+
+    for (k = 0; k < COLLECT_FILTER_PROBES; k++, hash += stride)
+    {
+        if (filter->counters[hash & filter->mask] == 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// (Re)build the filter from scratch, sized for at least 'capacity' keys,
+// and add every key in the collection to it
+static bool collect_filter_build(collect_priv_t * priv, size_t capacity)
+{
+    collect_item_t * item = priv->first;
+    size_t count = COLLECT_FILTER_MIN_KEYS * COLLECT_FILTER_RATIO;
+
+    while (count < capacity * COLLECT_FILTER_RATIO)
+    {
+        count <<= 1;
+    }
+
+    collect_filter_release(priv);
+
+    collect_filter_t * filter = (collect_filter_t *)
+            malloc(sizeof(collect_filter_t));
+    uint8_t * counters = (uint8_t *) calloc(count, sizeof(uint8_t));
+
+    if (!filter || !counters)
+    {
+        BLAMMO(FATAL, "filter allocation of %zu counters failed", count);
+        free(filter);
+        free(counters);
+        return false;
+    }
+
+    filter->counters = counters;
+    filter->mask = count - 1;
+    filter->capacity = count / COLLECT_FILTER_RATIO;
+
+    while (item)
+    {
+        collect_filter_update(filter, item->key, item->size, 1);
+        item = item->next;
+    }
+
+    priv->filter = filter;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Account for a key newly linked into the collection
+static void collect_filter_add(collect_priv_t * priv, collect_item_t * item)
+{
+    if (priv->length > priv->filter->capacity)
+    {
+        // Past capacity the false positive rate climbs quickly, so start
+        // over at twice the size.  If that fails the filter is dropped,
+        // which costs speed but never correctness.
+        collect_filter_build(priv, priv->length * 2);
+        return;
+    }
+
+    collect_filter_update(priv->filter, item->key, item->size, 1);
+}
+
+//------------------------------------------------------------------------|
+// Current contents of a cached span, top-first and NULL terminated
+static inline void ** collect_span_view(collect_span_t * span)
+{
+    return span->base + span->capacity - span->length;
+}
+
+//------------------------------------------------------------------------|
+// Make room for at least 'length' entries, keeping existing entries
+// packed against the back of the larger buffer.
+static bool collect_span_reserve(collect_span_t * span, size_t length)
+{
+    if (span->base && span->capacity >= length)
+    {
+        return true;
+    }
+
+    size_t capacity = span->capacity ? span->capacity * 2 : 8;
+    capacity = capacity < length ? length : capacity;
+
+    size_t size = sizeof(void *) * (capacity + 1);
+    void ** base = (void **) realloc(span->base, size);
+    if (!base)
+    {
+        BLAMMO(FATAL, "realloc(%zu) failed", size);
+        return false;
+    }
+
+    memmove(base + capacity - span->length,
+            base + span->capacity - span->length,
+            sizeof(void *) * span->length);
+
+    base[capacity] = NULL;
+    span->base = base;
+    span->capacity = capacity;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Bring a span fully up to date with the collection's contents.  The
+// 'objects' flag selects between caching object or key pointers.
+static bool collect_span_build(collect_priv_t * priv,
+                               collect_span_t * span,
+                               bool objects)
+{
+    collect_item_t * item = priv->first;
+
+    if (!collect_span_reserve(span, priv->length))
+    {
+        return false;
+    }
+
+    void ** entry = span->base + span->capacity - priv->length;
+    while (item)
+    {
+        *entry++ = objects ? item->object : (void *) item->key;
+        item = item->next;
+    }
+
+    span->length = priv->length;
+    span->version = priv->version;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Put an entry in front of a span that was current as of 'version', the
+// collection version just before the new item was inserted.  Stale
+// spans are left alone: they will be rebuilt when next requested.
+static void collect_span_prepend(collect_priv_t * priv,
+                                 collect_span_t * span,
+                                 size_t version,
+                                 void * entry)
+{
+    if (span->version != version ||
+        !collect_span_reserve(span, span->length + 1))
+    {
+        return;
+    }
+
+    span->length++;
+    span->base[span->capacity - span->length] = entry;
+    span->version = priv->version;
+}
+
+//------------------------------------------------------------------------|
+static void collect_span_release(collect_span_t * span)
+{
+    free(span->base);
+    memzero(span, sizeof(collect_span_t));
+}
+
 //------------------------------------------------------------------------|
 // Private helper function for get(), set(), and remove()
 static collect_item_t * collect_item_find(collect_t * collect,
-                                          const char * key,
-                                          collect_item_t ** prev)
+                                          const char * key)
 {
     collect_priv_t * priv = (collect_priv_t *) collect->priv;
     collect_item_t * item = priv->first;
-    bytes_t * keybytes = bytes_pub.create(key, strlen(key));
 
-    // Caller may of may not care about previous node
-    // Initialize the return pointer if prev is requested
-    if (prev) { *prev = NULL; }
+    if (priv->frozen)
+    {
+        collect_frozen_t * frozen = priv->frozen;
+        if (frozen->size == 0)
+        {
+            return NULL;
+        }
+
+        // A single probe: keys that are not in the table still land on
+        // some slot, so the full hash and key must match as well.
+        uint64_t hash = hash_bytes(key, strlen(key), 0);
+        uint32_t disp = frozen->disp[collect_frozen_bucket(frozen, hash)];
+        collect_slot_t * slot =
+                &frozen->slots[collect_frozen_slot(frozen, hash, disp)];
+
+        if (slot->hash == hash && strcmp(slot->key, key) == 0)
+        {
+            return slot->item;
+        }
+
+        return NULL;
+    }
+
+    size_t size = strlen(key);
+
+    // Small collections are already searched by tag, faster than the
+    // filter could reject a key
+    if (priv->filter && priv->spilled > 0 &&
+        !collect_filter_test(priv->filter, key, size))
+    {
+        return NULL;
+    }
+
+    if (priv->index)
+    {
+        return (collect_item_t *) priv->index->get(priv->index, key, size);
+    }
+
+    if (priv->spilled == 0)
+    {
+        uint32_t match = collect_tag_match(priv->tags, collect_tag(key, size));
+        match &= priv->used;
+
+        while (match)
+        {
+            item = &priv->small[__builtin_ctz(match)];
+            if (item->size == size && memcmp(item->key, key, size) == 0)
+            {
+                return item;
+            }
+
+            match &= match - 1;
+        }
+
+        return NULL;
+    }
 
     while (item)
     {
-        if (item->key->compare(item->key, keybytes) == 0)
+        if (item->size == size && memcmp(item->key, key, size) == 0)
         {
-            keybytes->destroy(keybytes);
             return item;
         }
 
-        if (prev) { *prev = item; }
         item = item->next;
     }
 
-    keybytes->destroy(keybytes);
     return NULL;
 }
 
+//------------------------------------------------------------------------|
+// Release a heap container: back to the free list if it came from a
+// reserved block, otherwise back to the heap.
+static void collect_item_free(collect_priv_t * priv, collect_item_t * item)
+{
+    collect_chunk_t * chunk = priv->chunks;
+
+    while (chunk)
+    {
+        if (item >= chunk->items && item < chunk->items + chunk->count)
+        {
+            item->next = priv->pool;
+            priv->pool = item;
+            priv->pooled++;
+            return;
+        }
+
+        chunk = chunk->next;
+    }
+
+    free(item);
+}
+
 //------------------------------------------------------------------------|
 // Private helper function for clear(), remove().  Removes an arbitrary
-// item from the stack.  MUST be given then previous item in the list if
-// it exists (which is not the case for the first item).
+// item from the stack.
 static void collect_item_remove(collect_t * collect,
-                                collect_item_t * item,
-                                collect_item_t * prev)
+                                collect_item_t * item)
 {
     collect_priv_t * priv = (collect_priv_t *) collect->priv;
 
@@ -120,13 +577,30 @@ static void collect_item_remove(collect_t * collect,
         return;
     }
 
+    // The set of keys is changing
+    collect_thaw(priv);
+    priv->version++;
+
     // Destroy heap objects in container
     if (item->object && item->object_destroy)
     {
         item->object_destroy(item->object);
     }
 
-    item->key->destroy(item->key);
+    if (priv->index)
+    {
+        priv->index->remove(priv->index, item->key, item->size);
+    }
+
+    if (priv->filter)
+    {
+        collect_filter_update(priv->filter, item->key, item->size, -1);
+    }
+
+    if (item->key != item->local)
+    {
+        free(item->key);
+    }
 
     // Unlink the item from the collection
     if (item == priv->first)
@@ -134,14 +608,27 @@ static void collect_item_remove(collect_t * collect,
         priv->first = item->next;
     }
 
-    if (prev)
+    if (item->prev)
+    {
+        item->prev->next = item->next;
+    }
+
+    if (item->next)
     {
-        prev->next = item->next;
+        item->next->prev = item->prev;
     }
 
-    // Wipe memory and delete the container
+    // Wipe memory and delete the container, or hand the inline slot back
     memzero(item, sizeof(collect_item_t));
-    free(item);
+    if (item >= priv->small && item < priv->small + COLLECT_SMALL_ITEMS)
+    {
+        priv->used &= ~(1U << (item - priv->small));
+    }
+    else
+    {
+        collect_item_free(priv, item);
+        priv->spilled--;
+    }
 
     // Size is now one fewer
     priv->length--;
@@ -156,24 +643,100 @@ static collect_item_t * collect_item_insert(collect_t * collect,
                                             const char * key)
 {
     collect_priv_t * priv = (collect_priv_t *) collect->priv;
+    collect_item_t * item = NULL;
+    size_t size = strlen(key);
+    uint32_t slot = 0;
+    bool local = (priv->used != (1U << COLLECT_SMALL_ITEMS) - 1);
 
-    collect_item_t * item = (collect_item_t *) malloc(sizeof(collect_item_t));
-    if (!item)
+    // Prefer a free inline container over the heap
+    if (local)
     {
-        BLAMMO(FATAL, "malloc(sizeof(collect_item_t)) failed!");
-        return NULL;
+        slot = (uint32_t) __builtin_ctz(~priv->used);
+        item = &priv->small[slot];
+    }
+    else if (priv->pool)
+    {
+        item = priv->pool;
+        priv->pool = item->next;
+        priv->pooled--;
+    }
+    else
+    {
+        item = (collect_item_t *) malloc(sizeof(collect_item_t));
+        if (!item)
+        {
+            BLAMMO(FATAL, "malloc(sizeof(collect_item_t)) failed!");
+            return NULL;
+        }
     }
 
-    // Wipe all memory, link in the new container
+    // New key is the one provided
     memzero(item, sizeof(collect_item_t));
-    item->next = priv->first;
-    priv->first = item;
+    item->size = size;
+    item->key = item->local;
+
+    if (size >= COLLECT_KEY_LOCAL)
+    {
+        item->key = (char *) malloc(size + 1);
+        if (!item->key)
+        {
+            BLAMMO(FATAL, "malloc(%zu) failed!", size + 1);
+            if (!local)
+            {
+                collect_item_free(priv, item);
+            }
+
+            return NULL;
+        }
+    }
+
+    memcpy(item->key, key, size + 1);
+
+    if (priv->index && !priv->index->set(priv->index, item->key, size, item))
+    {
+        BLAMMO(FATAL, "index->set(%s) failed!", key);
+        if (item->key != item->local)
+        {
+            free(item->key);
+        }
 
-    // New key is the one provided, and length is incremented
+        if (!local)
+        {
+            collect_item_free(priv, item);
+        }
+
+        return NULL;
+    }
+
+    // The set of keys is changing
+    collect_thaw(priv);
+
+    if (local)
+    {
+        priv->used |= 1U << slot;
+        priv->tags[slot] = collect_tag(key, size);
+    }
+    else
+    {
+        priv->spilled++;
+    }
+
+    // Link in the new container, and length is incremented
     // to reflect the new item.
-    item->key = bytes_pub.create(key, strlen(key));
+    item->next = priv->first;
+    if (priv->first)
+    {
+        priv->first->prev = item;
+    }
+
+    priv->first = item;
     priv->length++;
 
+    if (priv->filter)
+    {
+        collect_filter_add(priv, item);
+    }
+
     return item;
 }
 
@@ -220,6 +783,14 @@ static void collect_destroy(void * collect_ptr)
     // remove all objects and destroy their data
     collect->clear(collect);
 
+    collect_priv_t * priv = (collect_priv_t *) collect->priv;
+    if (priv->index)
+    {
+        priv->index->destroy(priv->index);
+    }
+
+    collect_filter_release(priv);
+
     // zero out and destroy the private data
     memzero(collect->priv, sizeof(collect_priv_t));
     free(collect->priv);
@@ -234,23 +805,48 @@ static void collect_clear(collect_t * collect)
 {
     collect_priv_t * priv = (collect_priv_t *) collect->priv;
 
-    if (priv->objects)
-    {
-        free(priv->objects);
-        priv->objects = NULL;
-    }
+    collect_span_release(&priv->objects);
+    collect_span_release(&priv->keys);
 
-    if (priv->keys)
+    // The index is about to be emptied anyway, so skip removing
+    // each item from it one at a time.
+    if (priv->index)
     {
-        free(priv->keys);
-        priv->keys = NULL;
+        priv->index->clear(priv->index);
     }
 
+    collect_thaw(priv);
+
+    // Likewise the filter is rebuilt empty afterwards
+    bool filter = priv->filter != NULL;
+    collect_filter_release(priv);
+
+    trie_t * index = priv->index;
+    priv->index = NULL;
+
     // Just keep popping off the top until the stack is empty
     while(priv->first)
     {
-        collect_item_remove(collect, priv->first, NULL);
+        collect_item_remove(collect, priv->first);
+    }
+
+    priv->index = index;
+
+    if (filter)
+    {
+        collect_filter_build(priv, 0);
     }
+
+    // Reserved containers are all back on the free list by now
+    while (priv->chunks)
+    {
+        collect_chunk_t * chunk = priv->chunks;
+        priv->chunks = chunk->next;
+        free(chunk);
+    }
+
+    priv->pool = NULL;
+    priv->pooled = 0;
 }
 
 //------------------------------------------------------------------------|
@@ -273,6 +869,17 @@ static collect_t * collect_copy(collect_t * collect)
     collect_item_t * item = NULL;
     collect_t * copy = collect_pub.create();
 
+    // Carry the indexing and filtering modes over to the copy
+    if (priv->index)
+    {
+        copy->index(copy, true);
+    }
+
+    if (priv->filter)
+    {
+        copy->filter(copy, true);
+    }
+
     // the copy's contents should end up in the same order,  but the
     // natural tendency when transferring between two stacks would be to
     // end up in reverse order, so that's why this seems a little odd.
@@ -283,7 +890,7 @@ static collect_t * collect_copy(collect_t * collect)
 
     while(i >= 0)
     {
-        item = collect_item_find(collect, keys[i], NULL);
+        item = collect_item_find(collect, keys[i]);
         if (!item)
         {
             BLAMMO(ERROR, "NULL item in collection!");
@@ -302,13 +909,19 @@ static collect_t * collect_copy(collect_t * collect)
                   item->object_destroy);
     }
 
+    // Likewise for the frozen state, once all keys are in place
+    if (priv->frozen)
+    {
+        copy->freeze(copy, true);
+    }
+
     return copy;
 }
 
 //------------------------------------------------------------------------|
 static inline void * collect_get(collect_t * collect, const char * key)
 {
-    collect_item_t * item = collect_item_find(collect, key, NULL);
+    collect_item_t * item = collect_item_find(collect, key);
     return item ? item->object : NULL;
 }
 
@@ -319,11 +932,22 @@ static void collect_set(collect_t * collect,
                         generic_copy_f object_copy,
                         generic_destroy_f object_destroy)
 {
+    collect_priv_t * priv = (collect_priv_t *) collect->priv;
+    size_t version = priv->version++;
+
     // Search through collection and try to find object with the given key.
     // The whole container is needed, not just the object.
-    collect_item_t * item = collect_item_find(collect, key, NULL);
+    collect_item_t * item = collect_item_find(collect, key);
     if (item)
     {
+        // The keys have not changed, so neither has their array.
+        // The replaced object's position is unknown, so the object
+        // array is left stale.
+        if (priv->keys.version == version)
+        {
+            priv->keys.version = priv->version;
+        }
+
         // If found, destroy the object (if allocated/valid).
         // To make way for the replacement object.
         if (item->object && item->object_destroy)
@@ -343,6 +967,10 @@ static void collect_set(collect_t * collect,
             BLAMMO(FATAL, "collect_item_insert(%s) failed!", key);
             return;
         }
+
+        // New items go on top, so current arrays just grow at the front
+        collect_span_prepend(priv, &priv->keys, version, item->key);
+        collect_span_prepend(priv, &priv->objects, version, object);
     }
 
     // Put the provided object in the container,
@@ -355,9 +983,7 @@ static void collect_set(collect_t * collect,
 //------------------------------------------------------------------------|
 static bool collect_remove(collect_t * collect, const char * key)
 {
-    //collect_priv_t * priv = (collect_priv_t *) collect->priv;
-    collect_item_t * prev = NULL;
-    collect_item_t * item = collect_item_find(collect, key, &prev);
+    collect_item_t * item = collect_item_find(collect, key);
 
     // If item was not found, we're done
     if (!item)
@@ -365,7 +991,7 @@ static bool collect_remove(collect_t * collect, const char * key)
         return false;
     }
 
-    collect_item_remove(collect, item, prev);
+    collect_item_remove(collect, item);
 
     return true;
 }
@@ -383,7 +1009,7 @@ static void * collect_first(collect_t * collect,
         return NULL;
     }
 
-    *key = (char *) priv->first->key->cstr(priv->first->key);
+    *key = priv->first->key;
     *object = priv->first->object;
     return (void *) priv->first;
 }
@@ -402,65 +1028,365 @@ static void * collect_next(void * iterator,
     }
 
     item = item->next;
-    *key = (char *) item->key->cstr(item->key);
+    *key = item->key;
     *object = item->object;
     return (void *) item;
 }
 
 //------------------------------------------------------------------------|
 static const char ** collect_keys(collect_t * collect)
+{
+    collect_priv_t * priv = (collect_priv_t *) collect->priv;
+
+    // Only walk the collection if it changed since the last call
+    if (!priv->keys.base || priv->keys.version != priv->version)
+    {
+        if (!collect_span_build(priv, &priv->keys, false))
+        {
+            return NULL;
+        }
+    }
+
+    return (const char **) collect_span_view(&priv->keys);
+}
+
+//------------------------------------------------------------------------|
+static void ** collect_objects(collect_t * collect)
+{
+    collect_priv_t * priv = (collect_priv_t *) collect->priv;
+
+    if (!priv->objects.base || priv->objects.version != priv->version)
+    {
+        if (!collect_span_build(priv, &priv->objects, true))
+        {
+            return NULL;
+        }
+    }
+
+    return collect_span_view(&priv->objects);
+}
+
+//------------------------------------------------------------------------|
+static size_t collect_span(collect_t * collect,
+                           const char *** keys,
+                           void *** objects)
+{
+    collect_priv_t * priv = (collect_priv_t *) collect->priv;
+
+    if (keys)
+    {
+        *keys = collect_keys(collect);
+    }
+
+    if (objects)
+    {
+        *objects = collect_objects(collect);
+    }
+
+    return priv->length;
+}
+
+//------------------------------------------------------------------------|
+static bool collect_reserve(collect_t * collect, size_t length)
+{
+    collect_priv_t * priv = (collect_priv_t *) collect->priv;
+    size_t available = priv->length + priv->pooled +
+                       COLLECT_SMALL_ITEMS -
+                       (size_t) __builtin_popcount(priv->used);
+    size_t i;
+
+    if (!collect_span_reserve(&priv->keys, length) ||
+        !collect_span_reserve(&priv->objects, length))
+    {
+        return false;
+    }
+
+    if (length <= available)
+    {
+        return true;
+    }
+
+    // One block for all the missing containers, threaded onto the free
+    // list in address order
+    size_t count = length - available;
+    size_t size = sizeof(collect_chunk_t) + sizeof(collect_item_t) * count;
+    collect_chunk_t * chunk = (collect_chunk_t *) malloc(size);
+    if (!chunk)
+    {
+        BLAMMO(FATAL, "malloc(%zu) failed", size);
+        return false;
+    }
+
+    chunk->count = count;
+    chunk->next = priv->chunks;
+    priv->chunks = chunk;
+
+    for (i = count; i-- > 0; )
+    {
+        chunk->items[i].next = priv->pool;
+        priv->pool = &chunk->items[i];
+    }
+
+    priv->pooled += count;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Temporary open-addressed hash set of containers used by set_many() to
+// find existing and duplicate keys without a search per key.
+typedef struct
+{
+    uint64_t hash;
+    collect_item_t * item;
+}
+collect_probe_t;
+
+static collect_probe_t * collect_probe_find(collect_probe_t * table,
+                                            size_t mask,
+                                            const char * key,
+                                            size_t size,
+                                            uint64_t hash)
+{
+    collect_probe_t * probe = &table[hash & mask];
+
+    while (probe->item && !(probe->hash == hash &&
+                            probe->item->size == size &&
+                            memcmp(probe->item->key, key, size) == 0))
+    {
+        probe = &table[(probe - table + 1) & mask];
+    }
+
+    return probe;
+}
+
+//------------------------------------------------------------------------|
+static bool collect_set_many(collect_t * collect,
+                             const char ** keys,
+                             void ** objects,
+                             generic_copy_f * copy_fns,
+                             generic_destroy_f * destroy_fns,
+                             size_t count)
 {
     collect_priv_t * priv = (collect_priv_t *) collect->priv;
     collect_item_t * item = priv->first;
+    size_t capacity = 16;
+    size_t i;
 
-    // size the string pointer array appropriately
-    // allow 1 extra to NULL terminate the array.
-    size_t size = sizeof(char *) * (priv->length + 1);
-    priv->keys = (char **) realloc(priv->keys, size);
-    if (!priv->keys)
+    // Arrays are brought up to date on their next use
+    priv->version++;
+
+    if (!collect_reserve(collect, priv->length + count))
     {
-        BLAMMO(FATAL, "realloc(%zu) failed", size);
-        return NULL;
+        return false;
+    }
+
+    while (capacity < 2 * (priv->length + count))
+    {
+        capacity <<= 1;
     }
 
-    memzero(priv->keys, size);
+    collect_probe_t * table = (collect_probe_t *)
+            calloc(capacity, sizeof(collect_probe_t));
+    if (!table)
+    {
+        BLAMMO(FATAL, "calloc(%zu, sizeof(collect_probe_t)) failed",
+               capacity);
+        return false;
+    }
 
-    size_t i = 0;
     while (item)
     {
-        priv->keys[i++] = (char *) item->key->cstr(item->key);
+        uint64_t hash = hash_bytes(item->key, item->size, 0);
+        collect_probe_t * probe = collect_probe_find(table, capacity - 1,
+                                                     item->key, item->size,
+                                                     hash);
+        probe->hash = hash;
+        probe->item = item;
         item = item->next;
     }
 
-    return (const char **) priv->keys;
+    for (i = 0; i < count; i++)
+    {
+        size_t size = strlen(keys[i]);
+        uint64_t hash = hash_bytes(keys[i], size, 0);
+        collect_probe_t * probe = collect_probe_find(table, capacity - 1,
+                                                     keys[i], size, hash);
+        item = probe->item;
+
+        if (item)
+        {
+            // Existing key, or a duplicate within the batch: the last
+            // one wins, exactly as with successive calls to set().
+            if (item->object && item->object_destroy)
+            {
+                item->object_destroy(item->object);
+            }
+        }
+        else
+        {
+            item = collect_item_insert(collect, keys[i]);
+            if (!item)
+            {
+                BLAMMO(FATAL, "collect_item_insert(%s) failed!", keys[i]);
+                free(table);
+                return false;
+            }
+
+            probe->hash = hash;
+            probe->item = item;
+        }
+
+        item->object = objects ? objects[i] : NULL;
+        item->object_copy = copy_fns ? copy_fns[i] : NULL;
+        item->object_destroy = destroy_fns ? destroy_fns[i] : NULL;
+    }
+
+    free(table);
+    return true;
 }
 
 //------------------------------------------------------------------------|
-static void ** collect_objects(collect_t * collect)
+static bool collect_index(collect_t * collect, bool enable)
 {
     collect_priv_t * priv = (collect_priv_t *) collect->priv;
     collect_item_t * item = priv->first;
 
-    // size the object pointer array appropriately
-    // allow 1 extra to NULL terminate the array.
-    size_t size = sizeof(void *) * (priv->length + 1);
-    priv->objects = (void **) realloc(priv->objects, size);
-    if (!priv->objects)
+    if (!enable)
     {
-        BLAMMO(FATAL, "realloc(%zu) failed", size);
-        return NULL;
+        if (priv->index)
+        {
+            priv->index->destroy(priv->index);
+            priv->index = NULL;
+        }
+
+        return true;
+    }
+
+    if (priv->index)
+    {
+        return true;
     }
 
-    memzero(priv->objects, size);
+    // The index holds unmanaged pointers to the containers themselves
+    priv->index = trie_pub.create(NULL, NULL);
+    if (!priv->index)
+    {
+        BLAMMO(ERROR, "trie_pub.create() failed");
+        return false;
+    }
 
-    size_t i = 0;
     while (item)
     {
-        priv->objects[i++] = item->object;
+        if (!priv->index->set(priv->index, item->key, item->size, item))
+        {
+            BLAMMO(ERROR, "index->set(%s) failed", item->key);
+            priv->index->destroy(priv->index);
+            priv->index = NULL;
+            return false;
+        }
+
         item = item->next;
     }
 
-    return priv->objects;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static bool collect_freeze(collect_t * collect, bool enable)
+{
+    collect_priv_t * priv = (collect_priv_t *) collect->priv;
+    collect_item_t * item = priv->first;
+    size_t n = priv->length;
+    size_t i;
+
+    collect_thaw(priv);
+    if (!enable)
+    {
+        return true;
+    }
+
+    size_t buckets = phash_buckets(n);
+    size_t size = sizeof(collect_frozen_t) +
+                  sizeof(collect_slot_t) * n +
+                  sizeof(uint32_t) * buckets;
+
+    collect_frozen_t * frozen = (collect_frozen_t *) malloc(size);
+    uint64_t * hashes = (uint64_t *) malloc(sizeof(uint64_t) * (n + 1));
+    collect_item_t ** items = (collect_item_t **)
+            malloc(sizeof(collect_item_t *) * (n + 1));
+    size_t * placed = (size_t *) malloc(sizeof(size_t) * (n + 1));
+
+    if (!frozen || !hashes || !items || !placed)
+    {
+        BLAMMO(FATAL, "freeze() allocation failed");
+        free(frozen);
+        free(hashes);
+        free(items);
+        free(placed);
+        return false;
+    }
+
+    memzero(frozen, size);
+    frozen->size = n;
+    frozen->buckets = buckets;
+    frozen->slots = (collect_slot_t *) (frozen + 1);
+    frozen->disp = (uint32_t *) (frozen->slots + n);
+
+    for (i = 0; item; item = item->next, i++)
+    {
+        items[i] = item;
+        hashes[i] = hash_bytes(item->key, item->size, 0);
+    }
+
+    bool success = phash_build(hashes, n, frozen->disp, placed);
+    if (success)
+    {
+        for (i = 0; i < n; i++)
+        {
+            frozen->slots[i].hash = hashes[placed[i]];
+            frozen->slots[i].key = items[placed[i]]->key;
+            frozen->slots[i].item = items[placed[i]];
+        }
+    }
+
+    free(hashes);
+    free(items);
+    free(placed);
+
+    if (!success)
+    {
+        free(frozen);
+        return false;
+    }
+
+    priv->frozen = frozen;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static bool collect_frozen(collect_t * collect)
+{
+    collect_priv_t * priv = (collect_priv_t *) collect->priv;
+    return priv->frozen != NULL;
+}
+
+//------------------------------------------------------------------------|
+static bool collect_filter(collect_t * collect, bool enable)
+{
+    collect_priv_t * priv = (collect_priv_t *) collect->priv;
+
+    if (!enable)
+    {
+        collect_filter_release(priv);
+        return true;
+    }
+
+    if (priv->filter)
+    {
+        return true;
+    }
+
+    return collect_filter_build(priv, priv->length);
 }
 
 //------------------------------------------------------------------------|
@@ -478,6 +1404,13 @@ const collect_t collect_pub = {
     &collect_next,
     &collect_keys,
     &collect_objects,
+    &collect_span,
+    &collect_reserve,
+    &collect_set_many,
+    &collect_index,
+    &collect_freeze,
+    &collect_frozen,
+    &collect_filter,
     NULL
 };
 
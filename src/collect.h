@@ -106,13 +106,68 @@ typedef struct collect_t
                    char ** key, void ** object);
 
     // Returns a linear array of all keys associated with objects, NULL
-    // terminated.  Order is top-first, bottom-last.
+    // terminated.  Order is top-first, bottom-last.  The array is cached
+    // and only rebuilt after the collection changes, so repeated calls
+    // are cheap.  It remains valid until the collection is next altered.
     const char ** (*keys)(struct collect_t * collect);
 
     // Returns a linear array of all object pointers, NULL terminated.
-    // Order is top-first, bottom-last.
+    // Order is top-first, bottom-last.  Cached the same way as keys().
     void ** (*objects)(struct collect_t * collect);
 
+    // Get the keys and/or objects arrays together with their length, for
+    // callers that would rather not scan for the NULL terminator (which
+    // is also ambiguous for NULL objects).  Either pointer may be NULL.
+    // Returns the number of entries in each array.
+    size_t (*span)(struct collect_t * collect,
+                   const char *** keys,
+                   void *** objects);
+
+    // Set aside room for at least 'length' objects in total, so that
+    // growing the collection up to that size needs no further container
+    // allocations (keys too long to be stored inline still need one).
+    // Returns false if memory could not be allocated.
+    bool (*reserve)(struct collect_t * collect, size_t length);
+
+    // Set 'count' objects in one pass.  Equivalent to calling set() for
+    // each key in turn, including for keys repeated within the batch,
+    // where the last one wins.  Any of the objects, copy_fns and
+    // destroy_fns arrays may be NULL to mean all NULL.  Returns false if
+    // memory could not be allocated, in which case only some of the
+    // objects may have been set.
+    bool (*set_many)(struct collect_t * collect,
+                     const char ** keys,
+                     void ** objects,
+                     generic_copy_f * copy_fns,
+                     generic_destroy_f * destroy_fns,
+                     size_t count);
+
+    // Enable or disable a trie_t key index for the collection.  When
+    // enabled, get(), set() and remove() cost Order-key-length instead of
+    // scanning every item, at the expense of some memory per key.  All
+    // existing keys are indexed upon enabling.  Returns false if the
+    // index could not be built.
+    bool (*index)(struct collect_t * collect, bool enable);
+
+    // Freeze or thaw the collection.  Freezing builds a minimal perfect
+    // hash table over the current keys, after which get() is a single
+    // probe into one compact array.  Replacing the object of an existing
+    // key keeps the collection frozen, but adding or removing keys thaws
+    // it again.  Returns false if the table could not be built, in which
+    // case the collection is left thawed.
+    bool (*freeze)(struct collect_t * collect, bool enable);
+
+    // Whether the collection is currently frozen
+    bool (*frozen)(struct collect_t * collect);
+
+    // Enable or disable a counting Bloom filter over the keys.  While
+    // enabled, get(), set() and remove() of a missing key usually return
+    // without scanning the collection, at the cost of a few bytes per
+    // key.  The filter follows every change to the keys, growing as
+    // needed, and starts over empty on clear().  Returns false if the
+    // filter could not be built.
+    bool (*filter)(struct collect_t * collect, bool enable);
+
     // Private data
     void * priv;
 }
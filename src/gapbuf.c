@@ -0,0 +1,320 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gapbuf.h"
+#include "utils.h"
+#include "blammo.h"
+
+//------------------------------------------------------------------------|
+// Smallest allocation, so that a new buffer has room to type into
+#define GAPBUF_MIN_CAPACITY         64
+
+//------------------------------------------------------------------------|
+// gapbuf private implementation data.  The contents are data[0, start)
+// followed by data[end, capacity), and the cursor is at 'start'.
+typedef struct
+{
+    uint8_t * data;
+    size_t capacity;
+    size_t start;
+    size_t end;
+}
+gapbuf_priv_t;
+
+//------------------------------------------------------------------------|
+static inline size_t gapbuf_total(const gapbuf_priv_t * priv)
+{
+    return priv->capacity - (priv->end - priv->start);
+}
+
+//------------------------------------------------------------------------|
+// Private helper that widens the gap to at least 'size' bytes, growing
+// the allocation geometrically.  Returns false if memory could not be
+// allocated, in which case nothing changes.
+static bool gapbuf_widen(gapbuf_priv_t * priv, size_t size)
+{
+    size_t total = gapbuf_total(priv);
+    size_t back = priv->capacity - priv->end;
+    size_t capacity = priv->capacity * 2;
+
+    if (priv->end - priv->start >= size)
+    {
+        return true;
+    }
+
+    capacity = MAX(capacity, total + size);
+    capacity = MAX(capacity, (size_t) GAPBUF_MIN_CAPACITY);
+
+    uint8_t * data = (uint8_t *) realloc(priv->data, capacity);
+    if (!data)
+    {
+        BLAMMO(FATAL, "realloc(%zu) failed", capacity);
+        return false;
+    }
+
+    // The back run moves up to the new end
+    memmove(data + capacity - back, data + priv->end, back);
+    priv->data = data;
+    priv->end = capacity - back;
+    priv->capacity = capacity;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static gapbuf_t * gapbuf_create(const void * data, size_t size)
+{
+    gapbuf_t * gapbuf = (gapbuf_t *) malloc(sizeof(gapbuf_t));
+    if (!gapbuf)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(gapbuf_t)) failed");
+        return NULL;
+    }
+
+    memcpy(gapbuf, &gapbuf_pub, sizeof(gapbuf_t));
+
+    gapbuf_priv_t * priv = (gapbuf_priv_t *) malloc(sizeof(gapbuf_priv_t));
+    if (!priv)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(gapbuf_priv_t)) failed");
+        free(gapbuf);
+        return NULL;
+    }
+
+    memzero(priv, sizeof(gapbuf_priv_t));
+    gapbuf->priv = priv;
+
+    // Widening an empty gap by nothing would leave the buffer unallocated
+    if (!gapbuf_widen(priv, MAX(data ? size : 0,
+                                (size_t) GAPBUF_MIN_CAPACITY)))
+    {
+        gapbuf->destroy(gapbuf);
+        return NULL;
+    }
+
+    if (data && size > 0)
+    {
+        memcpy(priv->data, data, size);
+        priv->start = size;
+    }
+
+    return gapbuf;
+}
+
+//------------------------------------------------------------------------|
+static void gapbuf_destroy(void * gapbuf_ptr)
+{
+    gapbuf_t * gapbuf = (gapbuf_t *) gapbuf_ptr;
+
+    // guard against accidental double-destroy or early-destroy
+    if (!gapbuf || !gapbuf->priv)
+    {
+        BLAMMO(WARNING, "attempt to early or double-destroy");
+        return;
+    }
+
+    gapbuf_priv_t * priv = (gapbuf_priv_t *) gapbuf->priv;
+
+    free(priv->data);
+
+    // zero out and destroy the private data
+    memzero(gapbuf->priv, sizeof(gapbuf_priv_t));
+    free(gapbuf->priv);
+
+    // zero out and destroy the public interface
+    memzero(gapbuf, sizeof(gapbuf_t));
+    free(gapbuf);
+}
+
+//------------------------------------------------------------------------|
+static size_t gapbuf_size(const gapbuf_t * gapbuf)
+{
+    return gapbuf_total((gapbuf_priv_t *) gapbuf->priv);
+}
+
+//------------------------------------------------------------------------|
+static size_t gapbuf_cursor(const gapbuf_t * gapbuf)
+{
+    return ((gapbuf_priv_t *) gapbuf->priv)->start;
+}
+
+//------------------------------------------------------------------------|
+static ssize_t gapbuf_seek(gapbuf_t * gapbuf, size_t offset)
+{
+    gapbuf_priv_t * priv = (gapbuf_priv_t *) gapbuf->priv;
+    size_t total = gapbuf_total(priv);
+
+    if (offset > total)
+    {
+        BLAMMO(ERROR, "offset %zu is after data size %zu", offset, total);
+        return -1;
+    }
+    else if (offset < priv->start)
+    {
+        // Bytes between move from before the gap to after it
+        size_t count = priv->start - offset;
+
+        memmove(priv->data + priv->end - count, priv->data + offset, count);
+        priv->start -= count;
+        priv->end -= count;
+    }
+    else if (offset > priv->start)
+    {
+        size_t count = offset - priv->start;
+
+        memmove(priv->data + priv->start, priv->data + priv->end, count);
+        priv->start += count;
+        priv->end += count;
+    }
+
+    return (ssize_t) offset;
+}
+
+//------------------------------------------------------------------------|
+static ssize_t gapbuf_insert(gapbuf_t * gapbuf, const void * data, size_t size)
+{
+    gapbuf_priv_t * priv = (gapbuf_priv_t *) gapbuf->priv;
+
+    if (!gapbuf_widen(priv, size))
+    {
+        return -1;
+    }
+
+    memcpy(priv->data + priv->start, data, size);
+    priv->start += size;
+    return (ssize_t) gapbuf_total(priv);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t gapbuf_backspace(gapbuf_t * gapbuf, size_t count)
+{
+    gapbuf_priv_t * priv = (gapbuf_priv_t *) gapbuf->priv;
+
+    priv->start -= MIN(count, priv->start);
+    return (ssize_t) gapbuf_total(priv);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t gapbuf_erase(gapbuf_t * gapbuf, size_t count)
+{
+    gapbuf_priv_t * priv = (gapbuf_priv_t *) gapbuf->priv;
+
+    priv->end += MIN(count, priv->capacity - priv->end);
+    return (ssize_t) gapbuf_total(priv);
+}
+
+//------------------------------------------------------------------------|
+static void gapbuf_clear(gapbuf_t * gapbuf)
+{
+    gapbuf_priv_t * priv = (gapbuf_priv_t *) gapbuf->priv;
+
+    priv->start = 0;
+    priv->end = priv->capacity;
+}
+
+//------------------------------------------------------------------------|
+static ssize_t gapbuf_read_at(const gapbuf_t * gapbuf,
+                              void * data,
+                              size_t count,
+                              size_t offset)
+{
+    gapbuf_priv_t * priv = (gapbuf_priv_t *) gapbuf->priv;
+    size_t total = gapbuf_total(priv);
+    uint8_t * out = (uint8_t *) data;
+
+    if (offset > total || count > total - offset)
+    {
+        BLAMMO(ERROR, "offset %zu + count %zu is out of bounds for size %zu",
+                      offset, count, total);
+        return -1;
+    }
+
+    // Whatever falls before the gap, then whatever falls after it
+    size_t left = count;
+
+    if (offset < priv->start)
+    {
+        size_t some = MIN(left, priv->start - offset);
+
+        memcpy(out, priv->data + offset, some);
+        out += some;
+        offset += some;
+        left -= some;
+    }
+
+    if (left > 0)
+    {
+        memcpy(out, priv->data + priv->end + (offset - priv->start), left);
+    }
+
+    return (ssize_t) count;
+}
+
+//------------------------------------------------------------------------|
+static void gapbuf_segments(const gapbuf_t * gapbuf,
+                            gapbuf_segments_t * segments)
+{
+    gapbuf_priv_t * priv = (gapbuf_priv_t *) gapbuf->priv;
+
+    segments->front = priv->data;
+    segments->front_size = priv->start;
+    segments->back = priv->data + priv->end;
+    segments->back_size = priv->capacity - priv->end;
+}
+
+//------------------------------------------------------------------------|
+static bytes_t * gapbuf_flatten(const gapbuf_t * gapbuf)
+{
+    gapbuf_priv_t * priv = (gapbuf_priv_t *) gapbuf->priv;
+    bytes_t * bytes = bytes_pub.create(priv->data, priv->start);
+
+    if (!bytes)
+    {
+        return NULL;
+    }
+
+    bytes->append(bytes, priv->data + priv->end, priv->capacity - priv->end);
+    return bytes;
+}
+
+//------------------------------------------------------------------------|
+const gapbuf_t gapbuf_pub = {
+    &gapbuf_create,
+    &gapbuf_destroy,
+    &gapbuf_size,
+    &gapbuf_cursor,
+    &gapbuf_seek,
+    &gapbuf_insert,
+    &gapbuf_backspace,
+    &gapbuf_erase,
+    &gapbuf_clear,
+    &gapbuf_read_at,
+    &gapbuf_segments,
+    &gapbuf_flatten,
+    NULL
+};
@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <sys/types.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "bytes.h"
+
+//------------------------------------------------------------------------|
+// Editable text for many small edits near a cursor, as in a line editor.
+// The contents are kept in one allocation with a gap at the cursor, so
+// that inserting or removing there only moves the gap's edges.  Moving
+// the cursor moves just the bytes between the old and new positions.
+// The gap grows geometrically when it fills, so typing is O(1) amortized.
+
+//------------------------------------------------------------------------|
+// The contents as the two runs either side of the gap, from segments().
+// Either may be empty.  Only valid until the next edit or cursor move.
+typedef struct
+{
+    const uint8_t * front;      // bytes before the cursor
+    size_t front_size;
+    const uint8_t * back;       // bytes from the cursor on
+    size_t back_size;
+}
+gapbuf_segments_t;
+
+//------------------------------------------------------------------------|
+typedef struct gapbuf_t
+{
+    // Gap buffer factory function.  The initial contents are copied and
+    // the cursor is placed at their end.  'data' may be NULL for an empty
+    // buffer.
+    struct gapbuf_t * (*create)(const void * data, size_t size);
+
+    // Gap buffer destructor function
+    void (*destroy)(void * gapbuf);
+
+    // Get the buffer's current length, not counting the gap
+    size_t (*size)(const struct gapbuf_t * gapbuf);
+
+    // Get the cursor's offset, between 0 and size() inclusive
+    size_t (*cursor)(const struct gapbuf_t * gapbuf);
+
+    // Move the cursor to an offset, no further than the end.  Costs the
+    // distance moved.  Returns the new cursor or negative if out of bounds.
+    ssize_t (*seek)(struct gapbuf_t * gapbuf, size_t offset);
+
+    // Insert data at the cursor, leaving the cursor after it as when
+    // typing.  Returns new size or else negative if error occurs.
+    ssize_t (*insert)(struct gapbuf_t * gapbuf, const void * data, size_t size);
+
+    // Remove up to 'count' bytes before the cursor, as backspace does.
+    // Returns new size.
+    ssize_t (*backspace)(struct gapbuf_t * gapbuf, size_t count);
+
+    // Remove up to 'count' bytes from the cursor on, as delete does.
+    // Returns new size.
+    ssize_t (*erase)(struct gapbuf_t * gapbuf, size_t count);
+
+    // Remove everything, keeping the allocation for reuse
+    void (*clear)(struct gapbuf_t * gapbuf);
+
+    // Analogous to pread(), this will read 'count' bytes from an offset,
+    // all of which must be in bounds.  Return value is number of bytes
+    // read or negative if an error occurred.
+    ssize_t (*read_at)(const struct gapbuf_t * gapbuf,
+                       void * data,
+                       size_t count,
+                       size_t offset);
+
+    // Get the contents in place as the runs before and after the gap,
+    // for rendering without copying
+    void (*segments)(const struct gapbuf_t * gapbuf,
+                     gapbuf_segments_t * segments);
+
+    // Copy the contents into a new contiguous bytes_t.  Caller is
+    // responsible for destroying it.
+    bytes_t * (*flatten)(const struct gapbuf_t * gapbuf);
+
+    // Private data
+    void * priv;
+}
+gapbuf_t;
+
+//------------------------------------------------------------------------|
+extern const gapbuf_t gapbuf_pub;
@@ -0,0 +1,861 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "hamt.h"
+#include "utils.h"              // memzero()
+#include "hash.h"
+#include "blammo.h"
+
+//------------------------------------------------------------------------|
+// Each trie level consumes this many bits of the 64-bit key hash.  Keys
+// whose hashes are identical in every bit end up in a collision node.
+#define HAMT_BITS           5
+#define HAMT_MASK           ((1U << HAMT_BITS) - 1)
+#define HAMT_HASH_BITS      64
+
+//------------------------------------------------------------------------|
+// A key/object pair.  Items are immutable and shared between versions.
+typedef struct
+{
+    uint32_t refcount;
+
+    // Pointer to the object managed by this collection
+    void * object;
+
+    // Object destructor function
+    generic_destroy_f object_destroy;
+
+    // Hash and dictionary-style keyword associated with this object
+    uint64_t hash;
+    char key[];
+}
+hamt_item_t;
+
+// A trie node in the compressed (CHAMP) layout: one bitmap says which of
+// the 32 branches hold an item directly and another which hold a child
+// node.  Only occupied branches take up a slot: items first, then child
+// nodes, each in branch order.  Below the last hash bit, a node instead
+// holds a plain list of items whose hashes fully collide.
+typedef struct hamt_node_t
+{
+    uint32_t refcount;
+    uint32_t datamap;
+    uint32_t nodemap;
+    uint32_t size;
+    void * slots[];
+}
+hamt_node_t;
+
+// Private data for one version of the collection
+typedef struct
+{
+    hamt_node_t * root;
+    size_t length;
+}
+hamt_priv_t;
+
+//------------------------------------------------------------------------|
+static inline uint32_t hamt_popcount(uint32_t bits)
+{
+    return (uint32_t) __builtin_popcount(bits);
+}
+
+static inline uint32_t hamt_branch(uint64_t hash, unsigned int shift)
+{
+    return 1U << ((hash >> shift) & HAMT_MASK);
+}
+
+static inline hamt_item_t ** hamt_items(hamt_node_t * node)
+{
+    return (hamt_item_t **) node->slots;
+}
+
+static inline hamt_node_t ** hamt_children(hamt_node_t * node)
+{
+    return (hamt_node_t **) (node->slots + hamt_popcount(node->datamap));
+}
+
+static inline uint32_t hamt_item_count(hamt_node_t * node, unsigned int shift)
+{
+    return shift >= HAMT_HASH_BITS ? node->size : hamt_popcount(node->datamap);
+}
+
+//------------------------------------------------------------------------|
+static inline void hamt_retain(uint32_t * refcount)
+{
+    __atomic_add_fetch(refcount, 1, __ATOMIC_RELAXED);
+}
+
+// Returns true when the caller dropped the last reference
+static inline bool hamt_release(uint32_t * refcount)
+{
+    return __atomic_sub_fetch(refcount, 1, __ATOMIC_ACQ_REL) == 0;
+}
+
+//------------------------------------------------------------------------|
+static hamt_item_t * hamt_item_create(const char * key,
+                                      uint64_t hash,
+                                      void * object,
+                                      generic_destroy_f object_destroy)
+{
+    size_t size = strlen(key) + 1;
+    hamt_item_t * item = (hamt_item_t *) malloc(sizeof(hamt_item_t) + size);
+    if (!item)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(hamt_item_t)) failed");
+        return NULL;
+    }
+
+    memcpy(item->key, key, size);
+    item->refcount = 1;
+    item->object = object;
+    item->object_destroy = object_destroy;
+    item->hash = hash;
+    return item;
+}
+
+//------------------------------------------------------------------------|
+static void hamt_item_release(hamt_item_t * item)
+{
+    if (!hamt_release(&item->refcount))
+    {
+        return;
+    }
+
+    if (item->object && item->object_destroy)
+    {
+        item->object_destroy(item->object);
+    }
+
+    free(item);
+}
+
+//------------------------------------------------------------------------|
+static hamt_node_t * hamt_node_alloc(uint32_t size)
+{
+    hamt_node_t * node = (hamt_node_t *)
+            malloc(sizeof(hamt_node_t) + sizeof(void *) * size);
+    if (!node)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(hamt_node_t)) failed");
+        return NULL;
+    }
+
+    node->refcount = 1;
+    node->datamap = 0;
+    node->nodemap = 0;
+    node->size = size;
+    return node;
+}
+
+//------------------------------------------------------------------------|
+// Drop a reference to a node, and everything beneath it that is no
+// longer shared.  The shift tells collision nodes apart.
+static void hamt_node_release(hamt_node_t * node, unsigned int shift)
+{
+    if (!node || !hamt_release(&node->refcount))
+    {
+        return;
+    }
+
+    uint32_t items = hamt_item_count(node, shift);
+    uint32_t i;
+
+    for (i = 0; i < items; i++)
+    {
+        hamt_item_release(hamt_items(node)[i]);
+    }
+
+    for (i = items; i < node->size; i++)
+    {
+        hamt_node_release((hamt_node_t *) node->slots[i],
+                          shift + HAMT_BITS);
+    }
+
+    free(node);
+}
+
+//------------------------------------------------------------------------|
+// Free a freshly built subtree that was never published, without
+// touching the items in it.  Used to back out of a failed insert.
+static void hamt_node_discard(hamt_node_t * node, unsigned int shift)
+{
+    uint32_t i;
+
+    for (i = hamt_item_count(node, shift); i < node->size; i++)
+    {
+        hamt_node_discard((hamt_node_t *) node->slots[i], shift + HAMT_BITS);
+    }
+
+    free(node);
+}
+
+//------------------------------------------------------------------------|
+// Allocate a node with the given layout, copying the slots of an
+// existing node with one slot dropped (at 'drop') and/or one new slot
+// inserted (at 'add', which indexes the new layout).  Pass HAMT_NONE to
+// skip either.  All copied slots gain a reference.
+#define HAMT_NONE ((uint32_t) -1)
+
+static hamt_node_t * hamt_node_edit(hamt_node_t * node,
+                                    unsigned int shift,
+                                    uint32_t datamap,
+                                    uint32_t nodemap,
+                                    uint32_t size,
+                                    uint32_t drop,
+                                    uint32_t add,
+                                    void * slot)
+{
+    hamt_node_t * copy = hamt_node_alloc(size);
+    if (!copy)
+    {
+        return NULL;
+    }
+
+    copy->datamap = datamap;
+    copy->nodemap = nodemap;
+
+    uint32_t items = hamt_item_count(node, shift);
+    uint32_t from = 0;
+    uint32_t to = 0;
+
+    while (to < size)
+    {
+        if (to == add)
+        {
+            copy->slots[to++] = slot;
+            continue;
+        }
+
+        if (from == drop)
+        {
+            from++;
+            continue;
+        }
+
+        if (from < items)
+        {
+            hamt_retain(&((hamt_item_t *) node->slots[from])->refcount);
+        }
+        else
+        {
+            hamt_retain(&((hamt_node_t *) node->slots[from])->refcount);
+        }
+
+        copy->slots[to++] = node->slots[from++];
+    }
+
+    return copy;
+}
+
+//------------------------------------------------------------------------|
+// Build the smallest subtree holding two items whose hashes agree on all
+// bits below 'shift'.  Takes over the callers' references to both.
+static hamt_node_t * hamt_node_pair(hamt_item_t * a,
+                                    hamt_item_t * b,
+                                    unsigned int shift)
+{
+    hamt_node_t * node = NULL;
+
+    if (shift >= HAMT_HASH_BITS)
+    {
+        node = hamt_node_alloc(2);
+        if (node)
+        {
+            node->slots[0] = a;
+            node->slots[1] = b;
+        }
+
+        return node;
+    }
+
+    uint32_t abit = hamt_branch(a->hash, shift);
+    uint32_t bbit = hamt_branch(b->hash, shift);
+
+    if (abit != bbit)
+    {
+        node = hamt_node_alloc(2);
+        if (node)
+        {
+            node->datamap = abit | bbit;
+            node->slots[abit < bbit ? 0 : 1] = a;
+            node->slots[abit < bbit ? 1 : 0] = b;
+        }
+
+        return node;
+    }
+
+    hamt_node_t * child = hamt_node_pair(a, b, shift + HAMT_BITS);
+    if (!child)
+    {
+        return NULL;
+    }
+
+    node = hamt_node_alloc(1);
+    if (!node)
+    {
+        hamt_node_discard(child, shift + HAMT_BITS);
+        return NULL;
+    }
+
+    node->nodemap = abit;
+    node->slots[0] = child;
+    return node;
+}
+
+//------------------------------------------------------------------------|
+// Path-copying insert.  Returns a new node that owns one reference to
+// 'item', or NULL upon allocation failure (leaving 'item' untouched).
+// Sets 'added' if the key was not already present.
+static hamt_node_t * hamt_node_set(hamt_node_t * node,
+                                   unsigned int shift,
+                                   hamt_item_t * item,
+                                   bool * added)
+{
+    uint32_t i;
+
+    if (shift >= HAMT_HASH_BITS)
+    {
+        for (i = 0; i < node->size; i++)
+        {
+            if (strcmp(hamt_items(node)[i]->key, item->key) == 0)
+            {
+                return hamt_node_edit(node, shift, 0, 0, node->size,
+                                      i, i, item);
+            }
+        }
+
+        *added = true;
+        return hamt_node_edit(node, shift, 0, 0, node->size + 1,
+                              HAMT_NONE, node->size, item);
+    }
+
+    uint32_t bit = hamt_branch(item->hash, shift);
+    uint32_t index = hamt_popcount(node->datamap & (bit - 1));
+
+    if (node->datamap & bit)
+    {
+        hamt_item_t * other = hamt_items(node)[index];
+
+        if (other->hash == item->hash && strcmp(other->key, item->key) == 0)
+        {
+            return hamt_node_edit(node, shift, node->datamap, node->nodemap,
+                                  node->size, index, index, item);
+        }
+
+        // Push both items one level down into a new child node
+        hamt_retain(&other->refcount);
+        hamt_node_t * child = hamt_node_pair(other, item, shift + HAMT_BITS);
+        if (!child)
+        {
+            hamt_release(&other->refcount);
+            return NULL;
+        }
+
+        uint32_t datamap = node->datamap & ~bit;
+        uint32_t nodemap = node->nodemap | bit;
+        uint32_t at = hamt_popcount(datamap) +
+                      hamt_popcount(node->nodemap & (bit - 1));
+
+        // Dropping an item shifts later slots down by one, which is
+        // exactly where the new child belongs in the new layout.
+        hamt_node_t * copy = hamt_node_edit(node, shift, datamap, nodemap,
+                                            node->size, index, at, child);
+        if (!copy)
+        {
+            hamt_node_discard(child, shift + HAMT_BITS);
+            hamt_release(&other->refcount);
+            return NULL;
+        }
+
+        *added = true;
+        return copy;
+    }
+
+    if (node->nodemap & bit)
+    {
+        uint32_t at = hamt_popcount(node->datamap) +
+                      hamt_popcount(node->nodemap & (bit - 1));
+        hamt_node_t * child = hamt_node_set((hamt_node_t *) node->slots[at],
+                                            shift + HAMT_BITS, item, added);
+        if (!child)
+        {
+            return NULL;
+        }
+
+        hamt_node_t * copy = hamt_node_edit(node, shift, node->datamap,
+                                            node->nodemap, node->size,
+                                            at, at, child);
+        if (!copy)
+        {
+            hamt_retain(&item->refcount);
+            hamt_node_release(child, shift + HAMT_BITS);
+        }
+
+        return copy;
+    }
+
+    *added = true;
+    return hamt_node_edit(node, shift, node->datamap | bit, node->nodemap,
+                          node->size + 1, HAMT_NONE, index, item);
+}
+
+//------------------------------------------------------------------------|
+// Path-copying delete.  Returns the new node, which is NULL if the
+// subtree became empty.  Leaves 'found' clear if the key was not found
+// (the return value is then meaningless) and sets 'failed' upon
+// allocation failure.
+static hamt_node_t * hamt_node_remove(hamt_node_t * node,
+                                      unsigned int shift,
+                                      const char * key,
+                                      uint64_t hash,
+                                      bool * found,
+                                      bool * failed)
+{
+    uint32_t i;
+
+    if (shift >= HAMT_HASH_BITS)
+    {
+        for (i = 0; i < node->size; i++)
+        {
+            if (strcmp(hamt_items(node)[i]->key, key) == 0)
+            {
+                *found = true;
+                hamt_node_t * copy = hamt_node_edit(node, shift, 0, 0,
+                                                    node->size - 1,
+                                                    i, HAMT_NONE, NULL);
+                *failed = (copy == NULL);
+                return copy;
+            }
+        }
+
+        return NULL;
+    }
+
+    uint32_t bit = hamt_branch(hash, shift);
+    uint32_t index = hamt_popcount(node->datamap & (bit - 1));
+
+    if (node->datamap & bit)
+    {
+        hamt_item_t * item = hamt_items(node)[index];
+        if (item->hash != hash || strcmp(item->key, key) != 0)
+        {
+            return NULL;
+        }
+
+        *found = true;
+        if (node->size == 1)
+        {
+            return NULL;
+        }
+
+        hamt_node_t * copy = hamt_node_edit(node, shift,
+                                            node->datamap & ~bit,
+                                            node->nodemap,
+                                            node->size - 1,
+                                            index, HAMT_NONE, NULL);
+        *failed = (copy == NULL);
+        return copy;
+    }
+
+    if (!(node->nodemap & bit))
+    {
+        return NULL;
+    }
+
+    uint32_t at = hamt_popcount(node->datamap) +
+                  hamt_popcount(node->nodemap & (bit - 1));
+    hamt_node_t * child = hamt_node_remove((hamt_node_t *) node->slots[at],
+                                           shift + HAMT_BITS, key, hash,
+                                           found, failed);
+    if (!*found || *failed)
+    {
+        return NULL;
+    }
+
+    hamt_node_t * copy = NULL;
+    unsigned int below = shift + HAMT_BITS;
+
+    if (!child)
+    {
+        // subtree vanished entirely
+        if (node->size == 1)
+        {
+            return NULL;
+        }
+
+        copy = hamt_node_edit(node, shift, node->datamap,
+                              node->nodemap & ~bit, node->size - 1,
+                              at, HAMT_NONE, NULL);
+    }
+    else if (child->size == 1 && hamt_item_count(child, below) == 1)
+    {
+        // A lone item below is pulled up in place of its node, keeping
+        // the trie in canonical (minimal) form.
+        hamt_item_t * item = hamt_items(child)[0];
+        hamt_retain(&item->refcount);
+        hamt_node_release(child, below);
+
+        uint32_t datamap = node->datamap | bit;
+        uint32_t to = hamt_popcount(node->datamap & (bit - 1));
+
+        // Copy by hand: the item moves from the nodes to the items
+        copy = hamt_node_alloc(node->size);
+        if (copy)
+        {
+            uint32_t items = hamt_popcount(node->datamap);
+            uint32_t from = 0;
+
+            copy->datamap = datamap;
+            copy->nodemap = node->nodemap & ~bit;
+
+            for (i = 0; i < node->size; i++)
+            {
+                if (i == to)
+                {
+                    copy->slots[i] = item;
+                    continue;
+                }
+
+                if (from == at)
+                {
+                    from++;
+                }
+
+                if (from < items)
+                {
+                    hamt_retain(&hamt_items(node)[from]->refcount);
+                }
+                else
+                {
+                    hamt_retain(&((hamt_node_t *)
+                                  node->slots[from])->refcount);
+                }
+
+                copy->slots[i] = node->slots[from++];
+            }
+        }
+        else
+        {
+            hamt_item_release(item);
+        }
+    }
+    else
+    {
+        copy = hamt_node_edit(node, shift, node->datamap, node->nodemap,
+                              node->size, at, at, child);
+        if (!copy)
+        {
+            hamt_node_release(child, below);
+        }
+    }
+
+    *failed = (copy == NULL);
+    return copy;
+}
+
+//------------------------------------------------------------------------|
+static size_t hamt_node_visit(hamt_node_t * node,
+                              unsigned int shift,
+                              hamt_visit_f visit,
+                              void * object,
+                              bool * stop)
+{
+    uint32_t items = hamt_item_count(node, shift);
+    size_t count = 0;
+    uint32_t i;
+
+    for (i = 0; i < items && !*stop; i++)
+    {
+        hamt_item_t * item = hamt_items(node)[i];
+        count++;
+
+        if (visit && !visit(object, item->key, item->object))
+        {
+            *stop = true;
+        }
+    }
+
+    for (i = items; i < node->size && !*stop; i++)
+    {
+        count += hamt_node_visit((hamt_node_t *) node->slots[i],
+                                 shift + HAMT_BITS, visit, object, stop);
+    }
+
+    return count;
+}
+
+//------------------------------------------------------------------------|
+// Wrap a root node (whose reference is taken over) as a new version
+static hamt_t * hamt_version(hamt_node_t * root, size_t length)
+{
+    // Allocate and initialize public interface
+    hamt_t * hamt = (hamt_t *) malloc(sizeof(hamt_t));
+    if (!hamt)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(hamt_t)) failed");
+        return NULL;
+    }
+
+    // bulk copy all function pointers and init opaque ptr
+    memcpy(hamt, &hamt_pub, sizeof(hamt_t));
+
+    // Allocate and initialize private implementation
+    hamt->priv = malloc(sizeof(hamt_priv_t));
+    if (!hamt->priv)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(hamt_priv_t)) failed");
+        free(hamt);
+        return NULL;
+    }
+
+    memzero(hamt->priv, sizeof(hamt_priv_t));
+
+    hamt_priv_t * priv = (hamt_priv_t *) hamt->priv;
+    priv->root = root;
+    priv->length = length;
+    return hamt;
+}
+
+//------------------------------------------------------------------------|
+static hamt_t * hamt_create()
+{
+    return hamt_version(NULL, 0);
+}
+
+//------------------------------------------------------------------------|
+static void hamt_destroy(void * hamt_ptr)
+{
+    hamt_t * hamt = (hamt_t *) hamt_ptr;
+
+    // guard against accidental double-destroy or early-destroy
+    if (!hamt || !hamt->priv)
+    {
+        BLAMMO(WARNING, "attempt to early or double-destroy");
+        return;
+    }
+
+    hamt_priv_t * priv = (hamt_priv_t *) hamt->priv;
+    hamt_node_release(priv->root, 0);
+
+    // zero out and destroy the private data
+    memzero(hamt->priv, sizeof(hamt_priv_t));
+    free(hamt->priv);
+
+    // zero out and destroy the public interface
+    memzero(hamt, sizeof(hamt_t));
+    free(hamt);
+}
+
+//------------------------------------------------------------------------|
+static bool hamt_empty(hamt_t * hamt)
+{
+    return ((hamt_priv_t *) hamt->priv)->length == 0;
+}
+
+//------------------------------------------------------------------------|
+static size_t hamt_length(hamt_t * hamt)
+{
+    return ((hamt_priv_t *) hamt->priv)->length;
+}
+
+//------------------------------------------------------------------------|
+static hamt_t * hamt_copy(hamt_t * hamt)
+{
+    hamt_priv_t * priv = (hamt_priv_t *) hamt->priv;
+    hamt_t * copy = hamt_version(priv->root, priv->length);
+
+    if (copy && priv->root)
+    {
+        hamt_retain(&priv->root->refcount);
+    }
+
+    return copy;
+}
+
+//------------------------------------------------------------------------|
+static void * hamt_get(hamt_t * hamt, const char * key)
+{
+    hamt_priv_t * priv = (hamt_priv_t *) hamt->priv;
+    hamt_node_t * node = priv->root;
+    uint64_t hash = hash_bytes(key, strlen(key), 0);
+    unsigned int shift = 0;
+    uint32_t i;
+
+    while (node)
+    {
+        if (shift >= HAMT_HASH_BITS)
+        {
+            for (i = 0; i < node->size; i++)
+            {
+                if (strcmp(hamt_items(node)[i]->key, key) == 0)
+                {
+                    return hamt_items(node)[i]->object;
+                }
+            }
+
+            return NULL;
+        }
+
+        uint32_t bit = hamt_branch(hash, shift);
+
+        if (node->datamap & bit)
+        {
+            hamt_item_t * item =
+                    hamt_items(node)[hamt_popcount(node->datamap & (bit - 1))];
+
+            if (item->hash == hash && strcmp(item->key, key) == 0)
+            {
+                return item->object;
+            }
+
+            return NULL;
+        }
+
+        if (!(node->nodemap & bit))
+        {
+            return NULL;
+        }
+
+        node = hamt_children(node)[hamt_popcount(node->nodemap & (bit - 1))];
+        shift += HAMT_BITS;
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------|
+static hamt_t * hamt_set(hamt_t * hamt,
+                         const char * key,
+                         void * object,
+                         generic_destroy_f object_destroy)
+{
+    hamt_priv_t * priv = (hamt_priv_t *) hamt->priv;
+    uint64_t hash = hash_bytes(key, strlen(key), 0);
+    hamt_node_t * root = NULL;
+    bool added = false;
+
+    hamt_item_t * item = hamt_item_create(key, hash, object, object_destroy);
+    if (!item)
+    {
+        return NULL;
+    }
+
+    if (priv->root)
+    {
+        root = hamt_node_set(priv->root, 0, item, &added);
+    }
+    else
+    {
+        root = hamt_node_alloc(1);
+        if (root)
+        {
+            root->datamap = hamt_branch(hash, 0);
+            root->slots[0] = item;
+            added = true;
+        }
+    }
+
+    if (!root)
+    {
+        free(item);
+        return NULL;
+    }
+
+    hamt_t * version = hamt_version(root, priv->length + (added ? 1 : 0));
+    if (!version)
+    {
+        // the object goes back to the caller, so must not be destroyed
+        item->object_destroy = NULL;
+        hamt_node_release(root, 0);
+    }
+
+    return version;
+}
+
+//------------------------------------------------------------------------|
+static hamt_t * hamt_remove(hamt_t * hamt, const char * key)
+{
+    hamt_priv_t * priv = (hamt_priv_t *) hamt->priv;
+    uint64_t hash = hash_bytes(key, strlen(key), 0);
+    hamt_node_t * root = NULL;
+    bool found = false;
+    bool failed = false;
+
+    if (priv->root)
+    {
+        root = hamt_node_remove(priv->root, 0, key, hash, &found, &failed);
+    }
+
+    if (failed)
+    {
+        return NULL;
+    }
+
+    if (!found)
+    {
+        return hamt_copy(hamt);
+    }
+
+    hamt_t * version = hamt_version(root, priv->length - 1);
+    if (!version)
+    {
+        hamt_node_release(root, 0);
+    }
+
+    return version;
+}
+
+//------------------------------------------------------------------------|
+static size_t hamt_foreach(hamt_t * hamt, hamt_visit_f visit, void * object)
+{
+    hamt_priv_t * priv = (hamt_priv_t *) hamt->priv;
+    bool stop = false;
+
+    if (!priv->root)
+    {
+        return 0;
+    }
+
+    return hamt_node_visit(priv->root, 0, visit, object, &stop);
+}
+
+//------------------------------------------------------------------------|
+const hamt_t hamt_pub = {
+    &hamt_create,
+    &hamt_destroy,
+    &hamt_empty,
+    &hamt_length,
+    &hamt_copy,
+    &hamt_get,
+    &hamt_set,
+    &hamt_remove,
+    &hamt_foreach,
+    NULL
+};
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------|
+// A persistent (immutable) collection implemented as a hash array mapped
+// trie.  Each hamt_t is one version of the collection and never changes
+// once created: set() and remove() return a new version that shares all
+// untouched structure with the one it was derived from.  That makes a
+// snapshot an Order-1 copy() and an update Order-log32-N, regardless of
+// how large the objects are.
+//
+// Nodes and items are reference counted, atomically, so versions may be
+// handed to and destroyed by other threads.  An object's destructor runs
+// when the last version that contains it is destroyed.
+#include "utils.h"          // generic function signatures
+
+//------------------------------------------------------------------------|
+// Visitor callback for foreach().  'object' is the caller's context,
+// 'data' is the stored object.  Return false to stop visiting.
+typedef bool (*hamt_visit_f)(void * object, const char * key, void * data);
+
+//------------------------------------------------------------------------|
+typedef struct hamt_t
+{
+    // Factory function that creates an empty collection
+    struct hamt_t * (*create)();
+
+    // Destroy this version of the collection.  Objects that no other
+    // version still refers to are destroyed along with it.
+    void (*destroy)(void * hamt);
+
+    // Whether this version is empty or not
+    bool (*empty)(struct hamt_t * hamt);
+
+    // Gets the number of objects in this version
+    size_t (*length)(struct hamt_t * hamt);
+
+    // Snapshot this version.  Costs Order-1: nothing is copied, and the
+    // snapshot must be destroyed independently of the original.
+    struct hamt_t * (*copy)(struct hamt_t * hamt);
+
+    // Get an object by keyword.  Returns NULL if it doesn't exist.
+    void * (*get)(struct hamt_t * hamt, const char * key);
+
+    // Returns a new version with the object set under the given key,
+    // replacing any previous object in the new version only.  Returns
+    // NULL, leaving the object with the caller, if memory could not be
+    // allocated.
+    struct hamt_t * (*set)(struct hamt_t * hamt,
+                           const char * key,
+                           void * object,
+                           generic_destroy_f object_destroy);
+
+    // Returns a new version without the given key.  If the key was not
+    // present the new version is simply a snapshot.  NULL is returned
+    // if memory could not be allocated.
+    struct hamt_t * (*remove)(struct hamt_t * hamt, const char * key);
+
+    // Visit every key and object in this version, in no particular
+    // order.  Returns the number of items visited.
+    size_t (*foreach)(struct hamt_t * hamt,
+                      hamt_visit_f visit,
+                      void * object);
+
+    // Private data
+    void * priv;
+}
+hamt_t;
+
+//------------------------------------------------------------------------|
+extern const hamt_t hamt_pub;
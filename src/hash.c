@@ -0,0 +1,459 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HASH_X86
+#endif
+
+#include "hash.h"
+#include "utils.h"
+
+//------------------------------------------------------------------------|
+// Inputs longer than this take the striped path
+#define HASH_LONG                   256
+
+// Bytes consumed per accumulation round, one 64-bit word per accumulator
+#define HASH_STRIPE                 64
+#define HASH_LANES                  8
+
+// Stripes per block.  The accumulators are scrambled after each block.
+#define HASH_BLOCK                  16
+
+// Each stripe within a block uses the key words from its own index on,
+// and the scramble and final stripe use words further along
+#define HASH_KEYS                   (HASH_LANES + HASH_BLOCK)
+
+// wyhash primes
+#define HASH_P0                     0xa0761d6478bd642fULL
+#define HASH_P1                     0xe7037ed1a0b428dbULL
+#define HASH_P2                     0x8ebc6af09c88c6e3ULL
+#define HASH_P3                     0x589965cc75374cc3ULL
+
+// 32-bit prime for scrambling, which keeps the multiply vectorizable
+#define HASH_P32                    0x9e3779b1U
+
+//------------------------------------------------------------------------|
+// Arbitrary odd constants (digits of pi) from which the per-seed key for
+// the striped path is derived
+static const uint64_t hash_secret[HASH_KEYS] = {
+    0x243f6a8885a308d3ULL, 0x13198a2e03707345ULL, 0xa4093822299f31d1ULL,
+    0x082efa98ec4e6c89ULL, 0x452821e638d01377ULL, 0xbe5466cf34e90c6dULL,
+    0xc0ac29b7c97c50ddULL, 0x3f84d5b5b5470917ULL, 0x9216d5d98979fb1bULL,
+    0xd1310ba698dfb5adULL, 0x2ffd72dbd01adfb7ULL, 0xb8e1afed6a267e97ULL,
+    0x24a19947b3916cf7ULL, 0x0801f2e2858efc17ULL, 0x636920d871574e69ULL,
+    0xa458fea3f4933d7fULL, 0x0d95748f728eb659ULL, 0x718bcd5882154aefULL,
+    0x7b54a41dc25a59b5ULL, 0x9c30d5392af26013ULL, 0xc5d1b023286085f1ULL,
+    0xca417918b8db38efULL, 0x8e79dcb0603a180fULL, 0x6c9e0e8bb01e8a3fULL,
+};
+
+// Accumulation and scrambling kernels for the striped path.  Each
+// version must compute exactly what the scalar one does.
+typedef struct
+{
+    cpu_kernel_t base;
+
+    // Fold 'stripes' stripes into the accumulators, stripe j using the
+    // key words from key[j]
+    void (*accumulate)(uint64_t * acc,
+                       const uint8_t * data,
+                       size_t stripes,
+                       const uint64_t * key);
+
+    // Mix the accumulators with key[0..7]
+    void (*scramble)(uint64_t * acc, const uint64_t * key);
+}
+hash_kernel_t;
+
+//------------------------------------------------------------------------|
+static inline uint64_t hash_read64(const uint8_t * p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t hash_read32(const uint8_t * p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// 1 to 3 bytes, spread over a word
+static inline uint64_t hash_read_small(const uint8_t * p, size_t size)
+{
+    return ((uint64_t) p[0] << 16) | ((uint64_t) p[size >> 1] << 8) |
+           p[size - 1];
+}
+
+//------------------------------------------------------------------------|
+// Full 64x64->128 bit multiply, returned as its two halves
+static inline void hash_mum(uint64_t * a, uint64_t * b)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t) *a * *b;
+    *a = (uint64_t) r;
+    *b = (uint64_t) (r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32;
+    uint64_t la = (uint32_t) *a, lb = (uint32_t) *b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t lo = t + (rm1 << 32);
+    uint64_t c = (t < rl) + (lo < t);
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+// Multiply and fold the product's halves together
+static inline uint64_t hash_mix(uint64_t a, uint64_t b)
+{
+    hash_mum(&a, &b);
+    return a ^ b;
+}
+
+//------------------------------------------------------------------------|
+static void hash_accumulate_scalar(uint64_t * acc,
+                                   const uint8_t * data,
+                                   size_t stripes,
+                                   const uint64_t * key)
+{
+    size_t j;
+    int i;
+
+    for (j = 0; j < stripes; j++, data += HASH_STRIPE)
+    {
+        for (i = 0; i < HASH_LANES; i++)
+        {
+            uint64_t d = hash_read64(data + 8 * i);
+            uint64_t k = d ^ key[j + i];
+
+            // Keep the raw input too, in the neighbouring lane, so that
+            // a zero product cannot erase it
+            acc[i ^ 1] += d;
+            acc[i] += (k & 0xffffffffULL) * (k >> 32);
+        }
+    }
+}
+
+static void hash_scramble_scalar(uint64_t * acc, const uint64_t * key)
+{
+    int i;
+
+    for (i = 0; i < HASH_LANES; i++)
+    {
+        uint64_t a = acc[i] ^ (acc[i] >> 47) ^ key[i];
+        acc[i] = a * HASH_P32;
+    }
+}
+
+//------------------------------------------------------------------------|
+#if defined(HASH_X86)
+__attribute__((target("sse2")))
+static void hash_accumulate_sse2(uint64_t * acc,
+                                 const uint8_t * data,
+                                 size_t stripes,
+                                 const uint64_t * key)
+{
+    __m128i a[HASH_LANES / 2];
+    size_t j;
+    int i;
+
+    for (i = 0; i < HASH_LANES / 2; i++)
+    {
+        a[i] = _mm_loadu_si128((const __m128i *) (acc + 2 * i));
+    }
+
+    for (j = 0; j < stripes; j++, data += HASH_STRIPE)
+    {
+        for (i = 0; i < HASH_LANES / 2; i++)
+        {
+            __m128i d = _mm_loadu_si128((const __m128i *) (data + 16 * i));
+            __m128i k = _mm_xor_si128(d, _mm_loadu_si128(
+                    (const __m128i *) (key + j + 2 * i)));
+            __m128i product = _mm_mul_epu32(k, _mm_srli_epi64(k, 32));
+            __m128i swapped = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+            a[i] = _mm_add_epi64(a[i], _mm_add_epi64(product, swapped));
+        }
+    }
+
+    for (i = 0; i < HASH_LANES / 2; i++)
+    {
+        _mm_storeu_si128((__m128i *) (acc + 2 * i), a[i]);
+    }
+}
+
+__attribute__((target("sse2")))
+static void hash_scramble_sse2(uint64_t * acc, const uint64_t * key)
+{
+    const __m128i prime = _mm_set1_epi32((int) HASH_P32);
+    int i;
+
+    for (i = 0; i < HASH_LANES / 2; i++)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *) (acc + 2 * i));
+        __m128i k = _mm_loadu_si128((const __m128i *) (key + 2 * i));
+        a = _mm_xor_si128(_mm_xor_si128(a, _mm_srli_epi64(a, 47)), k);
+
+        // 64x32 bit multiply from two 32x32 bit ones
+        __m128i lo = _mm_mul_epu32(a, prime);
+        __m128i hi = _mm_mul_epu32(_mm_srli_epi64(a, 32), prime);
+        a = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+        _mm_storeu_si128((__m128i *) (acc + 2 * i), a);
+    }
+}
+
+//------------------------------------------------------------------------|
+__attribute__((target("avx2")))
+static void hash_accumulate_avx2(uint64_t * acc,
+                                 const uint8_t * data,
+                                 size_t stripes,
+                                 const uint64_t * key)
+{
+    __m256i a0 = _mm256_loadu_si256((const __m256i *) acc);
+    __m256i a1 = _mm256_loadu_si256((const __m256i *) (acc + 4));
+    size_t j;
+
+    for (j = 0; j < stripes; j++, data += HASH_STRIPE)
+    {
+        __m256i d0 = _mm256_loadu_si256((const __m256i *) data);
+        __m256i d1 = _mm256_loadu_si256((const __m256i *) (data + 32));
+        __m256i k0 = _mm256_xor_si256(d0, _mm256_loadu_si256(
+                (const __m256i *) (key + j)));
+        __m256i k1 = _mm256_xor_si256(d1, _mm256_loadu_si256(
+                (const __m256i *) (key + j + 4)));
+
+        // Lane pairs never straddle a 128-bit half, so the in-lane
+        // shuffle is enough to swap neighbours
+        a0 = _mm256_add_epi64(a0, _mm256_add_epi64(
+                _mm256_mul_epu32(k0, _mm256_srli_epi64(k0, 32)),
+                _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2))));
+        a1 = _mm256_add_epi64(a1, _mm256_add_epi64(
+                _mm256_mul_epu32(k1, _mm256_srli_epi64(k1, 32)),
+                _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+
+    _mm256_storeu_si256((__m256i *) acc, a0);
+    _mm256_storeu_si256((__m256i *) (acc + 4), a1);
+}
+
+__attribute__((target("avx2")))
+static void hash_scramble_avx2(uint64_t * acc, const uint64_t * key)
+{
+    const __m256i prime = _mm256_set1_epi32((int) HASH_P32);
+    int i;
+
+    for (i = 0; i < HASH_LANES / 4; i++)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (acc + 4 * i));
+        __m256i k = _mm256_loadu_si256((const __m256i *) (key + 4 * i));
+        a = _mm256_xor_si256(_mm256_xor_si256(a, _mm256_srli_epi64(a, 47)),
+                             k);
+
+        __m256i lo = _mm256_mul_epu32(a, prime);
+        __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+        a = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+        _mm256_storeu_si256((__m256i *) (acc + 4 * i), a);
+    }
+}
+#endif
+
+//------------------------------------------------------------------------|
+static const hash_kernel_t hash_kernels[] = {
+    { { CPU_PATH_SCALAR, "scalar" },
+      &hash_accumulate_scalar, &hash_scramble_scalar },
+#if defined(HASH_X86)
+    { { CPU_PATH_SSE2, "sse2" },
+      &hash_accumulate_sse2, &hash_scramble_sse2 },
+    { { CPU_PATH_AVX2, "avx2" },
+      &hash_accumulate_avx2, &hash_scramble_avx2 },
+#endif
+};
+
+#define HASH_KERNELS (sizeof(hash_kernels) / sizeof(hash_kernels[0]))
+
+//------------------------------------------------------------------------|
+static const hash_kernel_t * hash_kernel(cpu_path_t path)
+{
+    static const void * best = NULL;
+
+    return cpu_kernel_select(hash_kernels, HASH_KERNELS,
+                             sizeof(hash_kernel_t), path, &best);
+}
+
+//------------------------------------------------------------------------|
+const char * hash_path_name(cpu_path_t path)
+{
+    if (!cpu_path_supported(path))
+    {
+        return "unsupported";
+    }
+
+    return hash_kernel(path)->base.name;
+}
+
+//------------------------------------------------------------------------|
+// Striped path for inputs longer than HASH_LONG
+static uint64_t hash_long(const uint8_t * data,
+                          size_t size,
+                          uint64_t seed,
+                          const hash_kernel_t * kernel)
+{
+    uint64_t key[HASH_KEYS];
+    uint64_t acc[HASH_LANES] = {
+        HASH_P0, HASH_P1, HASH_P2, HASH_P3,
+        ~HASH_P0, ~HASH_P1, ~HASH_P2, ~HASH_P3,
+    };
+    size_t i;
+
+    for (i = 0; i < HASH_KEYS; i++)
+    {
+        key[i] = hash_secret[i] + ((i & 1) ? seed : ~seed);
+    }
+
+    // Whole blocks, then the remaining whole stripes, always leaving at
+    // least one byte for the final stripe, which ends flush with the
+    // input and so may overlap the one before it
+    size_t stripes = (size - 1) / HASH_STRIPE;
+    size_t blocks = stripes / HASH_BLOCK;
+
+    for (i = 0; i < blocks; i++)
+    {
+        kernel->accumulate(acc, data, HASH_BLOCK, key);
+        kernel->scramble(acc, key + HASH_BLOCK);
+        data += HASH_BLOCK * HASH_STRIPE;
+    }
+
+    kernel->accumulate(acc, data, stripes % HASH_BLOCK, key);
+    data += (stripes % HASH_BLOCK) * HASH_STRIPE;
+    kernel->accumulate(acc, data + (size - stripes * HASH_STRIPE) -
+                            HASH_STRIPE, 1, key + HASH_BLOCK - 5);
+
+    // Merge the accumulators pairwise, then avalanche
+    uint64_t hash = size * HASH_P0 ^ seed;
+    for (i = 0; i < HASH_LANES; i += 2)
+    {
+        hash += hash_mix(acc[i] ^ key[HASH_LANES + i],
+                         acc[i + 1] ^ key[HASH_LANES + i + 1]);
+    }
+
+    hash ^= hash >> 37;
+    hash *= 0x165667919e3779f9ULL;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+//------------------------------------------------------------------------|
+uint64_t hash_bytes_path(const void * data,
+                         size_t size,
+                         uint64_t seed,
+                         cpu_path_t path)
+{
+    const uint8_t * p = (const uint8_t *) data;
+    uint64_t a;
+    uint64_t b;
+
+    if (size > HASH_LONG)
+    {
+        return hash_long(p, size, seed, hash_kernel(path));
+    }
+
+    seed ^= hash_mix(seed ^ HASH_P0, HASH_P1);
+
+    if (size <= 16)
+    {
+        if (size >= 4)
+        {
+            // Two overlapping reads from each end cover 4 to 16 bytes
+            size_t skip = (size >> 3) << 2;
+            a = (hash_read32(p) << 32) | hash_read32(p + skip);
+            b = (hash_read32(p + size - 4) << 32) |
+                hash_read32(p + size - 4 - skip);
+        }
+        else if (size > 0)
+        {
+            a = hash_read_small(p, size);
+            b = 0;
+        }
+        else
+        {
+            a = 0;
+            b = 0;
+        }
+    }
+    else
+    {
+        size_t left = size;
+
+        if (left > 48)
+        {
+            uint64_t see1 = seed;
+            uint64_t see2 = seed;
+
+            do
+            {
+                seed = hash_mix(hash_read64(p) ^ HASH_P1,
+                                hash_read64(p + 8) ^ seed);
+                see1 = hash_mix(hash_read64(p + 16) ^ HASH_P2,
+                                hash_read64(p + 24) ^ see1);
+                see2 = hash_mix(hash_read64(p + 32) ^ HASH_P3,
+                                hash_read64(p + 40) ^ see2);
+                p += 48;
+                left -= 48;
+            }
+            while (left > 48);
+
+            seed ^= see1 ^ see2;
+        }
+
+        while (left > 16)
+        {
+            seed = hash_mix(hash_read64(p) ^ HASH_P1,
+                            hash_read64(p + 8) ^ seed);
+            p += 16;
+            left -= 16;
+        }
+
+        // The last 16 bytes, overlapping what came before if need be
+        a = hash_read64(p + left - 16);
+        b = hash_read64(p + left - 8);
+    }
+
+    a ^= HASH_P1;
+    b ^= seed;
+    hash_mum(&a, &b);
+    return hash_mix(a ^ HASH_P0 ^ size, b ^ HASH_P1);
+}
+
+//------------------------------------------------------------------------|
+uint64_t hash_bytes(const void * data, size_t size, uint64_t seed)
+{
+    return hash_bytes_path(data, size, seed, CPU_PATH_AUTO);
+}
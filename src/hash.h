@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "utils.h"
+
+//------------------------------------------------------------------------|
+// Fast 64-bit non-cryptographic hashing of arbitrary byte buffers, for
+// hash tables and similar.  Short inputs take a wyhash-style path built
+// on 64x64->128 bit multiplies.  Long inputs are consumed in 64-byte
+// stripes by eight independent accumulators, in the style of xxh3, which
+// vectorizes well: SSE2 and AVX2 versions are picked at runtime when the
+// CPU has them.  Every path computes exactly the same function, so the
+// hash of a buffer does not depend on which one ran.  Hashes do depend
+// on byte order, and are not meant to resist deliberate collisions.
+
+//------------------------------------------------------------------------|
+// Hash 'size' bytes at 'data'.  Different seeds give unrelated hash
+// functions.
+uint64_t hash_bytes(const void * data, size_t size, uint64_t seed);
+
+// hash_bytes() with the long-input accumulation loop on a particular code
+// path, for testing and benchmarking
+uint64_t hash_bytes_path(const void * data,
+                         size_t size,
+                         uint64_t seed,
+                         cpu_path_t path);
+
+// Name of the accumulation kernel a path gets, with CPU_PATH_AUTO resolved
+// to the chosen one
+const char * hash_path_name(cpu_path_t path);
@@ -0,0 +1,544 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "matcher.h"
+#include "utils.h"
+#include "blammo.h"
+
+//------------------------------------------------------------------------|
+// Set on transitions into states where some pattern ends, so that the
+// scanning loop only has to test the value it already loaded
+#define MATCHER_OUTPUT              0x80000000U
+
+// No pattern, or no state
+#define MATCHER_NONE                UINT32_MAX
+
+//------------------------------------------------------------------------|
+// matcher private implementation data
+typedef struct
+{
+    // Number of patterns, and the size of each
+    size_t count;
+    size_t * sizes;
+
+    // For each pattern, the next pattern that ends in the same state
+    // (identical patterns), or MATCHER_NONE
+    uint32_t * next;
+
+    // Byte classes: every byte used in a pattern has its own, and all
+    // others share class 0
+    uint8_t classes[256];
+    size_t nclasses;
+
+    // Transition table, one row of nclasses entries per state.  Entries
+    // are the offset of the next state's row, rather than its number,
+    // sparing a multiply per byte, plus MATCHER_OUTPUT.
+    uint32_t * table;
+    size_t nstates;
+
+    // For each state, the first pattern ending there, the nearest state
+    // along the failure links where some other pattern ends, and the
+    // total number of patterns ending there either way
+    uint32_t * first;
+    uint32_t * dict;
+    uint32_t * outputs;
+}
+matcher_priv_t;
+
+//------------------------------------------------------------------------|
+// Private helper that grows the trie to hold at least 'nodes' nodes
+static bool matcher_grow(uint32_t ** trie,
+                         uint32_t ** first,
+                         size_t * capacity,
+                         size_t nodes,
+                         size_t nclasses)
+{
+    size_t grown = MAX(nodes, *capacity * 2);
+    uint32_t * array;
+
+    if (nodes <= *capacity)
+    {
+        return true;
+    }
+
+    array = (uint32_t *) realloc(*trie, sizeof(uint32_t) * nclasses * grown);
+    if (!array)
+    {
+        BLAMMO(FATAL, "realloc(%zu) failed",
+               sizeof(uint32_t) * nclasses * grown);
+        return false;
+    }
+
+    memset(array + nclasses * *capacity, 0,
+           sizeof(uint32_t) * nclasses * (grown - *capacity));
+    *trie = array;
+
+    array = (uint32_t *) realloc(*first, sizeof(uint32_t) * grown);
+    if (!array)
+    {
+        BLAMMO(FATAL, "realloc(%zu) failed", sizeof(uint32_t) * grown);
+        return false;
+    }
+
+    memset(array + *capacity, 0xff, sizeof(uint32_t) * (grown - *capacity));
+    *first = array;
+    *capacity = grown;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Private helper that builds the automaton.  First a plain trie of the
+// patterns, then a breadth-first pass that finds each node's failure
+// link (the longest proper suffix of its path that is also in the trie)
+// and fills in each missing transition from the failure link's, and last
+// a copy of it all with states renumbered in breadth-first order.
+static bool matcher_build(matcher_priv_t * priv,
+                          const void * const * patterns,
+                          const size_t * sizes)
+{
+    const size_t count = priv->count;
+    uint32_t * trie = NULL;
+    uint32_t * first = NULL;
+    uint32_t * order = NULL;
+    uint32_t * fail = NULL;
+    uint32_t * renumber = NULL;
+    size_t capacity = 0;
+    size_t nodes = 1;
+    size_t nc;
+    size_t head;
+    size_t tail;
+    size_t i;
+    size_t j;
+    bool used[256] = { false };
+    bool ok = false;
+
+    // Byte classes
+    for (i = 0; i < count; i++)
+    {
+        for (j = 0; j < sizes[i]; j++)
+        {
+            used[((const uint8_t *) patterns[i])[j]] = true;
+        }
+    }
+
+    nc = 1;
+    for (i = 0; i < 256; i++)
+    {
+        priv->classes[i] = used[i] ? nc++ : 0;
+    }
+
+    priv->nclasses = nc;
+
+    // The trie, with each pattern added to the list at its last node
+    if (!matcher_grow(&trie, &first, &capacity, 64, nc))
+    {
+        free(trie);
+        free(first);
+        return false;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        const uint8_t * pattern = (const uint8_t *) patterns[i];
+        uint32_t * link;
+        size_t u = 0;
+
+        priv->next[i] = MATCHER_NONE;
+        if (sizes[i] == 0)
+        {
+            continue;
+        }
+
+        for (j = 0; j < sizes[i]; j++)
+        {
+            uint32_t * edge = &trie[u * nc + priv->classes[pattern[j]]];
+            if (!*edge)
+            {
+                if (!matcher_grow(&trie, &first, &capacity, nodes + 1, nc))
+                {
+                    free(trie);
+                    free(first);
+                    return false;
+                }
+
+                // Growing may have moved the trie
+                edge = &trie[u * nc + priv->classes[pattern[j]]];
+                *edge = nodes++;
+            }
+
+            u = *edge;
+        }
+
+        // Keep identical patterns in order of id
+        link = &first[u];
+        while (*link != MATCHER_NONE)
+        {
+            link = &priv->next[*link];
+        }
+
+        *link = i;
+    }
+
+    // The table must leave the top bit of its entries free
+    if (nodes * nc > MATCHER_OUTPUT)
+    {
+        BLAMMO(ERROR, "%zu states of %zu classes is too many", nodes, nc);
+        free(trie);
+        free(first);
+        return false;
+    }
+
+    priv->nstates = nodes;
+    order = (uint32_t *) malloc(sizeof(uint32_t) * nodes);
+    fail = (uint32_t *) malloc(sizeof(uint32_t) * nodes);
+    renumber = (uint32_t *) malloc(sizeof(uint32_t) * nodes);
+    priv->table = (uint32_t *) malloc(sizeof(uint32_t) * nodes * nc);
+    priv->first = (uint32_t *) malloc(sizeof(uint32_t) * nodes);
+    priv->dict = (uint32_t *) malloc(sizeof(uint32_t) * nodes);
+    priv->outputs = (uint32_t *) malloc(sizeof(uint32_t) * nodes);
+
+    if (order && fail && renumber && priv->table && priv->first &&
+        priv->dict && priv->outputs)
+    {
+        ok = true;
+    }
+    else
+    {
+        BLAMMO(FATAL, "malloc() failed for %zu states", nodes);
+    }
+
+    // Breadth-first pass.  A node's failure link is shallower than the
+    // node, so its row is already complete when the node's row is filled.
+    // The dictionary link and output count of a node follow from those
+    // of its failure link, which reuses priv->dict and priv->outputs
+    // indexed by trie node for now.
+    head = 0;
+    tail = 1;
+    order[0] = 0;
+    fail[0] = 0;
+    while (ok && head < tail)
+    {
+        size_t u = order[head++];
+        size_t own = 0;
+
+        for (j = first[u]; j != MATCHER_NONE; j = priv->next[j])
+        {
+            own++;
+        }
+
+        if (u == 0)
+        {
+            priv->dict[u] = MATCHER_NONE;
+            priv->outputs[u] = 0;
+        }
+        else
+        {
+            size_t f = fail[u];
+            priv->dict[u] = first[f] != MATCHER_NONE ? f : priv->dict[f];
+            priv->outputs[u] = own + priv->outputs[f];
+        }
+
+        for (j = 0; j < nc; j++)
+        {
+            uint32_t v = trie[u * nc + j];
+
+            if (v)
+            {
+                fail[v] = u ? trie[fail[u] * nc + j] : 0;
+                order[tail++] = v;
+            }
+            else if (u)
+            {
+                trie[u * nc + j] = trie[fail[u] * nc + j];
+            }
+        }
+    }
+
+    // Copy it all over in breadth-first order
+    for (i = 0; ok && i < nodes; i++)
+    {
+        renumber[order[i]] = i;
+    }
+
+    for (i = 0; ok && i < nodes; i++)
+    {
+        size_t u = order[i];
+
+        for (j = 0; j < nc; j++)
+        {
+            size_t v = trie[u * nc + j];
+            bool output = first[v] != MATCHER_NONE ||
+                          priv->dict[v] != MATCHER_NONE;
+
+            priv->table[i * nc + j] = (renumber[v] * nc) |
+                                      (output ? MATCHER_OUTPUT : 0);
+        }
+
+        // Each node is visited once, so order[] and fail[] can hold the
+        // dictionary links and output counts in the new order while the
+        // old ones are still being read through the table entries above
+        order[i] = priv->dict[u];
+        fail[i] = priv->outputs[u];
+        priv->first[i] = first[u];
+    }
+
+    if (ok)
+    {
+        for (i = 0; i < nodes; i++)
+        {
+            priv->dict[i] = order[i] == MATCHER_NONE ? MATCHER_NONE
+                                                     : renumber[order[i]];
+            priv->outputs[i] = fail[i];
+        }
+    }
+
+    free(renumber);
+    free(fail);
+    free(order);
+    free(first);
+    free(trie);
+    return ok;
+}
+
+//------------------------------------------------------------------------|
+// Private helper that reports the matches ending in a state, given as the
+// offset of its row
+static inline bool matcher_report(const matcher_priv_t * priv,
+                                  uint32_t row,
+                                  size_t end,
+                                  matcher_found_f found,
+                                  void * object,
+                                  size_t * matches)
+{
+    uint32_t state = row / priv->nclasses;
+    uint32_t id;
+
+    if (!found)
+    {
+        *matches += priv->outputs[state];
+        return true;
+    }
+
+    for (; state != MATCHER_NONE; state = priv->dict[state])
+    {
+        for (id = priv->first[state]; id != MATCHER_NONE; id = priv->next[id])
+        {
+            (*matches)++;
+            if (!found(object, id, end - priv->sizes[id]))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static matcher_t * matcher_create(const void * const * patterns,
+                                  const size_t * sizes,
+                                  size_t count)
+{
+    if (count >= MATCHER_NONE)
+    {
+        BLAMMO(ERROR, "%zu patterns is too many", count);
+        return NULL;
+    }
+
+    matcher_t * matcher = (matcher_t *) malloc(sizeof(matcher_t));
+    if (!matcher)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(matcher_t)) failed");
+        return NULL;
+    }
+
+    memcpy(matcher, &matcher_pub, sizeof(matcher_t));
+
+    matcher_priv_t * priv = (matcher_priv_t *) malloc(sizeof(matcher_priv_t));
+    if (!priv)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(matcher_priv_t)) failed");
+        free(matcher);
+        return NULL;
+    }
+
+    memzero(priv, sizeof(matcher_priv_t));
+    matcher->priv = priv;
+    priv->count = count;
+
+    // One extra, so that an empty set still allocates
+    priv->sizes = (size_t *) malloc(sizeof(size_t) * (count + 1));
+    priv->next = (uint32_t *) malloc(sizeof(uint32_t) * (count + 1));
+    if (!priv->sizes || !priv->next)
+    {
+        BLAMMO(FATAL, "malloc() failed for %zu patterns", count);
+        matcher->destroy(matcher);
+        return NULL;
+    }
+
+    if (count > 0)
+    {
+        memcpy(priv->sizes, sizes, sizeof(size_t) * count);
+    }
+
+    if (!matcher_build(priv, patterns, sizes))
+    {
+        matcher->destroy(matcher);
+        return NULL;
+    }
+
+    return matcher;
+}
+
+//------------------------------------------------------------------------|
+static void matcher_destroy(void * matcher_ptr)
+{
+    matcher_t * matcher = (matcher_t *) matcher_ptr;
+
+    // guard against accidental double-destroy or early-destroy
+    if (!matcher || !matcher->priv)
+    {
+        BLAMMO(WARNING, "attempt to early or double-destroy");
+        return;
+    }
+
+    matcher_priv_t * priv = (matcher_priv_t *) matcher->priv;
+    free(priv->sizes);
+    free(priv->next);
+    free(priv->table);
+    free(priv->first);
+    free(priv->dict);
+    free(priv->outputs);
+
+    // zero out and destroy the private data
+    memzero(matcher->priv, sizeof(matcher_priv_t));
+    free(matcher->priv);
+
+    // zero out and destroy the public interface
+    memzero(matcher, sizeof(matcher_t));
+    free(matcher);
+}
+
+//------------------------------------------------------------------------|
+static size_t matcher_length(const matcher_t * matcher)
+{
+    return ((matcher_priv_t *) matcher->priv)->count;
+}
+
+//------------------------------------------------------------------------|
+static size_t matcher_size(const matcher_t * matcher, size_t id)
+{
+    matcher_priv_t * priv = (matcher_priv_t *) matcher->priv;
+    return id < priv->count ? priv->sizes[id] : 0;
+}
+
+//------------------------------------------------------------------------|
+static size_t matcher_states(const matcher_t * matcher)
+{
+    return ((matcher_priv_t *) matcher->priv)->nstates;
+}
+
+//------------------------------------------------------------------------|
+static size_t matcher_table_size(const matcher_t * matcher)
+{
+    matcher_priv_t * priv = (matcher_priv_t *) matcher->priv;
+    return sizeof(uint32_t) * priv->nstates * priv->nclasses;
+}
+
+//------------------------------------------------------------------------|
+static size_t matcher_feed(const matcher_t * matcher,
+                           matcher_stream_t * stream,
+                           const void * data,
+                           size_t size,
+                           matcher_found_f found,
+                           void * object)
+{
+    const matcher_priv_t * priv = (const matcher_priv_t *) matcher->priv;
+    const uint32_t * table = priv->table;
+    const uint8_t * classes = priv->classes;
+    const uint8_t * bytes = (const uint8_t *) data;
+    uint32_t state = stream->state;
+    size_t matches = 0;
+    size_t i;
+
+    // The loop carries only the state, one dependent load per byte
+    for (i = 0; i < size; i++)
+    {
+        state = table[state + classes[bytes[i]]];
+        if (state & MATCHER_OUTPUT)
+        {
+            state &= ~MATCHER_OUTPUT;
+            if (!matcher_report(priv, state, stream->offset + i + 1,
+                                found, object, &matches))
+            {
+                i++;
+                break;
+            }
+        }
+    }
+
+    stream->state = state;
+    stream->offset += i;
+    return matches;
+}
+
+//------------------------------------------------------------------------|
+static size_t matcher_scan(const matcher_t * matcher,
+                           const void * data,
+                           size_t size,
+                           matcher_found_f found,
+                           void * object)
+{
+    matcher_stream_t stream = { 0, 0 };
+    return matcher_feed(matcher, &stream, data, size, found, object);
+}
+
+//------------------------------------------------------------------------|
+static size_t matcher_scan_bytes(const matcher_t * matcher,
+                                 const bytes_t * bytes,
+                                 matcher_found_f found,
+                                 void * object)
+{
+    return matcher_scan(matcher, bytes->data(bytes), bytes->size(bytes),
+                        found, object);
+}
+
+//------------------------------------------------------------------------|
+const matcher_t matcher_pub = {
+    &matcher_create,
+    &matcher_destroy,
+    &matcher_length,
+    &matcher_size,
+    &matcher_states,
+    &matcher_table_size,
+    &matcher_scan,
+    &matcher_scan_bytes,
+    &matcher_feed,
+    NULL
+};
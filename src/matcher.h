@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <sys/types.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "bytes.h"
+
+//------------------------------------------------------------------------|
+// Multi-pattern search: finds every occurrence of any of a fixed set of
+// byte patterns in a single pass, however many patterns there are.  The
+// patterns are compiled up front into an Aho-Corasick automaton, stored
+// as a fully resolved transition table (no failure links to chase while
+// scanning), so each input byte costs one table lookup.
+//
+// To keep the table small and cache friendly, bytes are first mapped to
+// classes: each byte that occurs in some pattern gets a class of its own,
+// and all other bytes share one.  A row of the table then has only as
+// many entries as there are classes, rather than 256.  States are
+// numbered breadth-first, so the shallow states that most input bytes
+// land in share the first few rows.
+//
+// Input can be scanned in one piece, or fed in chunks through a
+// matcher_stream_t, finding matches that span chunk boundaries.
+
+//------------------------------------------------------------------------|
+// Callback for each match.  'object' is the caller's context, 'id' is the
+// index of the pattern that matched, and 'offset' is where the match
+// starts, counted from the start of the input (or the stream).  Return
+// false to stop scanning.
+typedef bool (*matcher_found_f)(void * object, size_t id, size_t offset);
+
+// Scanning state for input fed in chunks.  Zero it to start a stream.
+typedef struct
+{
+    uint32_t state;     // automaton state after the last byte fed
+    size_t offset;      // number of bytes fed so far
+}
+matcher_stream_t;
+
+//------------------------------------------------------------------------|
+typedef struct matcher_t
+{
+    // Matcher factory function.  Compiles 'count' patterns, the i'th
+    // having 'sizes[i]' bytes at 'patterns[i]', which is also its id.
+    // Patterns may contain any bytes, and need not outlive the matcher.
+    // Empty patterns never match.  Returns NULL if memory could not be
+    // allocated or the automaton would be too large.
+    struct matcher_t * (*create)(const void * const * patterns,
+                                 const size_t * sizes,
+                                 size_t count);
+
+    // Matcher destructor function
+    void (*destroy)(void * matcher);
+
+    // Number of patterns, and their sizes by id
+    size_t (*length)(const struct matcher_t * matcher);
+    size_t (*size)(const struct matcher_t * matcher, size_t id);
+
+    // Number of automaton states, and bytes used by the transition table
+    size_t (*states)(const struct matcher_t * matcher);
+    size_t (*table_size)(const struct matcher_t * matcher);
+
+    // Report every match in a buffer, in order of where matches end, and
+    // longest first among those ending at the same byte.  Matches may
+    // overlap.  'found' may be NULL to only count them.  Returns the
+    // number of matches reported.
+    size_t (*scan)(const struct matcher_t * matcher,
+                   const void * data,
+                   size_t size,
+                   matcher_found_f found,
+                   void * object);
+
+    // Same as scan() on the contents of a bytes object
+    size_t (*scan_bytes)(const struct matcher_t * matcher,
+                         const struct bytes_t * bytes,
+                         matcher_found_f found,
+                         void * object);
+
+    // Same as scan(), continuing from where the last chunk fed to this
+    // stream left off.  If 'found' stops the scan, the stream stops just
+    // after the byte that completed the match (other matches ending
+    // there go unreported), and the next chunk should start from there.
+    size_t (*feed)(const struct matcher_t * matcher,
+                   matcher_stream_t * stream,
+                   const void * data,
+                   size_t size,
+                   matcher_found_f found,
+                   void * object);
+
+    // Private data
+    void * priv;
+}
+matcher_t;
+
+//------------------------------------------------------------------------|
+extern const matcher_t matcher_pub;
@@ -0,0 +1,762 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#define _GNU_SOURCE              // strtod_l(), newlocale()
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <locale.h>
+#include <pthread.h>
+
+#include "number.h"
+
+//------------------------------------------------------------------------|
+// Significant digits that number_parse_double() passes on to strtod_l().
+// Correct rounding never depends on more than 768 of them, as long as a
+// nonzero digit stands in for any that are dropped.
+#define NUMBER_SLOW_DIGITS          800
+
+//------------------------------------------------------------------------|
+// "00" through "99", so that integers are formatted two digits per
+// division rather than one
+static const char number_pairs[201] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
+static const char number_hex[17] = "0123456789abcdef";
+
+static const uint64_t number_pow10[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+    100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL,
+    10000000000000000000ULL
+};
+
+// Powers of ten that doubles hold exactly
+static const double number_exact10[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+//------------------------------------------------------------------------|
+// A double's significand and binary exponent, widened for Grisu
+typedef struct
+{
+    uint64_t f;
+    int e;
+}
+number_fp_t;
+
+// Normalized 64-bit approximations of 10^k for k = -348, -340 ... 340,
+// each rounded to nearest, for Grisu to scale by
+static const number_fp_t number_cached[87] = {
+    { 0xfa8fd5a0081c0288ULL, -1220 }, { 0xbaaee17fa23ebf76ULL, -1193 },
+    { 0x8b16fb203055ac76ULL, -1166 }, { 0xcf42894a5dce35eaULL, -1140 },
+    { 0x9a6bb0aa55653b2dULL, -1113 }, { 0xe61acf033d1a45dfULL, -1087 },
+    { 0xab70fe17c79ac6caULL, -1060 }, { 0xff77b1fcbebcdc4fULL, -1034 },
+    { 0xbe5691ef416bd60cULL, -1007 }, { 0x8dd01fad907ffc3cULL,  -980 },
+    { 0xd3515c2831559a83ULL,  -954 }, { 0x9d71ac8fada6c9b5ULL,  -927 },
+    { 0xea9c227723ee8bcbULL,  -901 }, { 0xaecc49914078536dULL,  -874 },
+    { 0x823c12795db6ce57ULL,  -847 }, { 0xc21094364dfb5637ULL,  -821 },
+    { 0x9096ea6f3848984fULL,  -794 }, { 0xd77485cb25823ac7ULL,  -768 },
+    { 0xa086cfcd97bf97f4ULL,  -741 }, { 0xef340a98172aace5ULL,  -715 },
+    { 0xb23867fb2a35b28eULL,  -688 }, { 0x84c8d4dfd2c63f3bULL,  -661 },
+    { 0xc5dd44271ad3cdbaULL,  -635 }, { 0x936b9fcebb25c996ULL,  -608 },
+    { 0xdbac6c247d62a584ULL,  -582 }, { 0xa3ab66580d5fdaf6ULL,  -555 },
+    { 0xf3e2f893dec3f126ULL,  -529 }, { 0xb5b5ada8aaff80b8ULL,  -502 },
+    { 0x87625f056c7c4a8bULL,  -475 }, { 0xc9bcff6034c13053ULL,  -449 },
+    { 0x964e858c91ba2655ULL,  -422 }, { 0xdff9772470297ebdULL,  -396 },
+    { 0xa6dfbd9fb8e5b88fULL,  -369 }, { 0xf8a95fcf88747d94ULL,  -343 },
+    { 0xb94470938fa89bcfULL,  -316 }, { 0x8a08f0f8bf0f156bULL,  -289 },
+    { 0xcdb02555653131b6ULL,  -263 }, { 0x993fe2c6d07b7facULL,  -236 },
+    { 0xe45c10c42a2b3b06ULL,  -210 }, { 0xaa242499697392d3ULL,  -183 },
+    { 0xfd87b5f28300ca0eULL,  -157 }, { 0xbce5086492111aebULL,  -130 },
+    { 0x8cbccc096f5088ccULL,  -103 }, { 0xd1b71758e219652cULL,   -77 },
+    { 0x9c40000000000000ULL,   -50 }, { 0xe8d4a51000000000ULL,   -24 },
+    { 0xad78ebc5ac620000ULL,     3 }, { 0x813f3978f8940984ULL,    30 },
+    { 0xc097ce7bc90715b3ULL,    56 }, { 0x8f7e32ce7bea5c70ULL,    83 },
+    { 0xd5d238a4abe98068ULL,   109 }, { 0x9f4f2726179a2245ULL,   136 },
+    { 0xed63a231d4c4fb27ULL,   162 }, { 0xb0de65388cc8ada8ULL,   189 },
+    { 0x83c7088e1aab65dbULL,   216 }, { 0xc45d1df942711d9aULL,   242 },
+    { 0x924d692ca61be758ULL,   269 }, { 0xda01ee641a708deaULL,   295 },
+    { 0xa26da3999aef774aULL,   322 }, { 0xf209787bb47d6b85ULL,   348 },
+    { 0xb454e4a179dd1877ULL,   375 }, { 0x865b86925b9bc5c2ULL,   402 },
+    { 0xc83553c5c8965d3dULL,   428 }, { 0x952ab45cfa97a0b3ULL,   455 },
+    { 0xde469fbd99a05fe3ULL,   481 }, { 0xa59bc234db398c25ULL,   508 },
+    { 0xf6c69a72a3989f5cULL,   534 }, { 0xb7dcbf5354e9beceULL,   561 },
+    { 0x88fcf317f22241e2ULL,   588 }, { 0xcc20ce9bd35c78a5ULL,   614 },
+    { 0x98165af37b2153dfULL,   641 }, { 0xe2a0b5dc971f303aULL,   667 },
+    { 0xa8d9d1535ce3b396ULL,   694 }, { 0xfb9b7cd9a4a7443cULL,   720 },
+    { 0xbb764c4ca7a44410ULL,   747 }, { 0x8bab8eefb6409c1aULL,   774 },
+    { 0xd01fef10a657842cULL,   800 }, { 0x9b10a4e5e9913129ULL,   827 },
+    { 0xe7109bfba19c0c9dULL,   853 }, { 0xac2820d9623bf429ULL,   880 },
+    { 0x80444b5e7aa7cf85ULL,   907 }, { 0xbf21e44003acdd2dULL,   933 },
+    { 0x8e679c2f5e44ff8fULL,   960 }, { 0xd433179d9c8cb841ULL,   986 },
+    { 0x9e19db92b4e31ba9ULL,  1013 }, { 0xeb96bf6ebadf77d9ULL,  1039 },
+    { 0xaf87023b9bf0ee6bULL,  1066 },
+};
+
+//------------------------------------------------------------------------|
+// Private helper that counts a value's decimal digits, at least one
+static inline size_t number_digits(uint64_t value)
+{
+    // Approximate log10 from log2, then correct it by one comparison.
+    // Setting the low bit never changes the count, and makes zero one.
+    size_t guess;
+
+    value |= 1;
+    guess = ((size_t) (64 - __builtin_clzll(value)) * 1233) >> 12;
+    return guess + (value >= number_pow10[guess]);
+}
+
+//------------------------------------------------------------------------|
+// Private helper that writes a value's decimal digits, ending at 'end'
+static inline void number_write_digits(char * end, uint64_t value)
+{
+    while (value >= 100)
+    {
+        end -= 2;
+        memcpy(end, number_pairs + (value % 100) * 2, 2);
+        value /= 100;
+    }
+
+    if (value >= 10)
+    {
+        memcpy(end - 2, number_pairs + value * 2, 2);
+    }
+    else
+    {
+        end[-1] = (char) ('0' + value);
+    }
+}
+
+//------------------------------------------------------------------------|
+size_t number_format_u64(char * out, uint64_t value)
+{
+    size_t ndigits = number_digits(value);
+
+    number_write_digits(out + ndigits, value);
+    return ndigits;
+}
+
+//------------------------------------------------------------------------|
+size_t number_format_i64(char * out, int64_t value)
+{
+    if (value < 0)
+    {
+        *out = '-';
+        return 1 + number_format_u64(out + 1, 0 - (uint64_t) value);
+    }
+
+    return number_format_u64(out, (uint64_t) value);
+}
+
+//------------------------------------------------------------------------|
+size_t number_format_hex(char * out, uint64_t value, size_t width)
+{
+    size_t ndigits = (size_t) (64 - __builtin_clzll(value | 1) + 3) / 4;
+    size_t i;
+
+    ndigits = ndigits < width ? (width < 16 ? width : 16) : ndigits;
+    for (i = ndigits; i > 0; i--)
+    {
+        out[i - 1] = number_hex[value & 0xf];
+        value >>= 4;
+    }
+
+    return ndigits;
+}
+
+//------------------------------------------------------------------------|
+// Private helper that multiplies two Grisu values, rounding the high half
+static inline number_fp_t number_fp_mul(number_fp_t x, number_fp_t y)
+{
+    unsigned __int128 product = (unsigned __int128) x.f * y.f;
+    number_fp_t result;
+
+    result.f = (uint64_t) (product >> 64) + ((uint64_t) (product >> 63) & 1);
+    result.e = x.e + y.e + 64;
+    return result;
+}
+
+//------------------------------------------------------------------------|
+static inline number_fp_t number_fp_normalize(number_fp_t x)
+{
+    int shift = __builtin_clzll(x.f);
+
+    x.f <<= shift;
+    x.e -= shift;
+    return x;
+}
+
+//------------------------------------------------------------------------|
+// Private helper for Grisu2 that steps the last digit down towards the
+// value while that stays within the boundaries and gets closer
+static inline void number_grisu_round(char * digits,
+                                      size_t ndigits,
+                                      uint64_t delta,
+                                      uint64_t rest,
+                                      uint64_t ten_kappa,
+                                      uint64_t wp_w)
+{
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w ||
+            wp_w - rest > rest + ten_kappa - wp_w))
+    {
+        digits[ndigits - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+//------------------------------------------------------------------------|
+// Private helper that writes the Grisu2 digits of a finite, positive
+// double, returning how many there are, with the value being those
+// digits times 10^*k
+static size_t number_grisu2(double value, char * digits, int * k)
+{
+    uint64_t bits;
+    number_fp_t v;
+    number_fp_t plus;
+    number_fp_t minus;
+
+    memcpy(&bits, &value, sizeof(bits));
+    v.f = bits & 0x000fffffffffffffULL;
+    v.e = (int) ((bits >> 52) & 0x7ff);
+    if (v.e)
+    {
+        v.f += 0x0010000000000000ULL;
+        v.e -= 1075;
+    }
+    else
+    {
+        v.e = -1074;
+    }
+
+    // Boundaries halfway to the neighboring doubles, the lower one being
+    // closer at a power of two
+    plus.f = (v.f << 1) + 1;
+    plus.e = v.e - 1;
+    plus = number_fp_normalize(plus);
+    if (v.f == 0x0010000000000000ULL)
+    {
+        minus.f = (v.f << 2) - 1;
+        minus.e = v.e - 2;
+    }
+    else
+    {
+        minus.f = (v.f << 1) - 1;
+        minus.e = v.e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    // Scale by a cached power of ten that brings the upper boundary's
+    // exponent into [-60, -32]
+    double dk = (-61 - plus.e) * 0.30102999566398114 + 347;
+    int ck = (int) dk;
+    ck += (dk - ck > 0.0);
+    size_t index = (size_t) (ck >> 3) + 1;
+    number_fp_t c = number_cached[index];
+    *k = -(-348 + (int) index * 8);
+
+    number_fp_t w = number_fp_mul(number_fp_normalize(v), c);
+    number_fp_t wp = number_fp_mul(plus, c);
+    number_fp_t wm = number_fp_mul(minus, c);
+    wm.f++;
+    wp.f--;
+
+    // Generate digits of the upper boundary until they are within
+    // 'delta' of it, integral part first
+    uint64_t delta = wp.f - wm.f;
+    uint64_t wp_w = wp.f - w.f;
+    uint64_t one = 1ULL << -wp.e;
+    uint32_t p1 = (uint32_t) (wp.f >> -wp.e);
+    uint64_t p2 = wp.f & (one - 1);
+    int kappa = (int) number_digits(p1);
+    size_t ndigits = 0;
+
+    while (kappa > 0)
+    {
+        uint32_t d = (uint32_t) (p1 / number_pow10[kappa - 1]);
+
+        p1 %= (uint32_t) number_pow10[kappa - 1];
+        if (d || ndigits)
+        {
+            digits[ndigits++] = (char) ('0' + d);
+        }
+
+        kappa--;
+        uint64_t rest = ((uint64_t) p1 << -wp.e) + p2;
+        if (rest <= delta)
+        {
+            *k += kappa;
+            number_grisu_round(digits, ndigits, delta, rest,
+                               number_pow10[kappa] << -wp.e, wp_w);
+            return ndigits;
+        }
+    }
+
+    for (;;)
+    {
+        p2 *= 10;
+        delta *= 10;
+
+        char d = (char) (p2 >> -wp.e);
+        if (d || ndigits)
+        {
+            digits[ndigits++] = (char) ('0' + d);
+        }
+
+        p2 &= one - 1;
+        kappa--;
+        if (p2 < delta)
+        {
+            *k += kappa;
+            number_grisu_round(digits, ndigits, delta, p2, one,
+                               -kappa < 20 ? wp_w * number_pow10[-kappa]
+                                           : 0);
+            return ndigits;
+        }
+    }
+}
+
+//------------------------------------------------------------------------|
+size_t number_format_double(char * out, double value)
+{
+    char digits[20];
+    uint64_t bits;
+    size_t length = 0;
+    int k;
+
+    memcpy(&bits, &value, sizeof(bits));
+    if (bits >> 63)
+    {
+        out[length++] = '-';
+        bits &= ~(1ULL << 63);
+        memcpy(&value, &bits, sizeof(bits));
+    }
+
+    if ((bits >> 52) == 0x7ff)
+    {
+        if (bits & 0x000fffffffffffffULL)
+        {
+            memcpy(out, "nan", 3);
+            return 3;
+        }
+
+        memcpy(out + length, "inf", 3);
+        return length + 3;
+    }
+    else if (bits == 0)
+    {
+        out[length] = '0';
+        return length + 1;
+    }
+
+    size_t ndigits = number_grisu2(value, digits, &k);
+    int point = (int) ndigits + k;
+    char * p = out + length;
+
+    if (k >= 0 && point <= 21)
+    {
+        // 1234e2 is 123400
+        memcpy(p, digits, ndigits);
+        memset(p + ndigits, '0', (size_t) k);
+        return length + (size_t) point;
+    }
+    else if (point > 0 && point <= 21)
+    {
+        // 1234e-2 is 12.34
+        memcpy(p, digits, (size_t) point);
+        p[point] = '.';
+        memcpy(p + point + 1, digits + point, ndigits - (size_t) point);
+        return length + ndigits + 1;
+    }
+    else if (point > -6 && point <= 0)
+    {
+        // 1234e-6 is 0.001234
+        p[0] = '0';
+        p[1] = '.';
+        memset(p + 2, '0', (size_t) -point);
+        memcpy(p + 2 - point, digits, ndigits);
+        return length + 2 + (size_t) -point + ndigits;
+    }
+
+    // 1234e30 is 1.234e+33, 1e-7 stays as is
+    *p++ = digits[0];
+    if (ndigits > 1)
+    {
+        *p++ = '.';
+        memcpy(p, digits + 1, ndigits - 1);
+        p += ndigits - 1;
+    }
+
+    *p++ = 'e';
+    *p++ = point - 1 < 0 ? '-' : '+';
+    p += number_format_u64(p, (uint64_t) (point - 1 < 0 ? 1 - point
+                                                        : point - 1));
+    return (size_t) (p - out);
+}
+
+//------------------------------------------------------------------------|
+static inline bool number_is_digit(uint8_t c)
+{
+    return (uint8_t) (c - '0') < 10;
+}
+
+// Value of a hex digit, or 16 if it isn't one
+static inline unsigned number_hex_value(uint8_t c)
+{
+    if ((uint8_t) (c - '0') < 10)
+    {
+        return c - '0';
+    }
+
+    c |= 0x20;
+    return (uint8_t) (c - 'a') < 6 ? c - 'a' + 10 : 16;
+}
+
+//------------------------------------------------------------------------|
+ssize_t number_parse_u64(const void * data, size_t size, uint64_t * value)
+{
+    const uint8_t * text = (const uint8_t *) data;
+    uint64_t result = 0;
+    size_t start;
+    size_t i = 0;
+
+    // Leading zeros don't count towards overflow
+    while (i < size && text[i] == '0')
+    {
+        i++;
+    }
+
+    // Nineteen digits always fit, so only a twentieth needs checking
+    start = i;
+    while (i < size && i - start < 19 && number_is_digit(text[i]))
+    {
+        result = result * 10 + (text[i++] - '0');
+    }
+
+    if (i < size && number_is_digit(text[i]))
+    {
+        unsigned d = text[i++] - '0';
+
+        if (result > (UINT64_MAX - d) / 10 ||
+            (i < size && number_is_digit(text[i])))
+        {
+            return -1;
+        }
+
+        result = result * 10 + d;
+    }
+
+    if (i == 0)
+    {
+        return -1;
+    }
+
+    *value = result;
+    return (ssize_t) i;
+}
+
+//------------------------------------------------------------------------|
+ssize_t number_parse_i64(const void * data, size_t size, int64_t * value)
+{
+    const uint8_t * text = (const uint8_t *) data;
+    bool negative = size > 0 && text[0] == '-';
+    size_t sign = size > 0 && (text[0] == '-' || text[0] == '+');
+    uint64_t magnitude;
+    ssize_t length = number_parse_u64(text + sign, size - sign, &magnitude);
+
+    if (length < 0 ||
+        magnitude > (uint64_t) INT64_MAX + (negative ? 1 : 0))
+    {
+        return -1;
+    }
+
+    *value = negative ? (int64_t) (0 - magnitude) : (int64_t) magnitude;
+    return length + (ssize_t) sign;
+}
+
+//------------------------------------------------------------------------|
+ssize_t number_parse_hex(const void * data, size_t size, uint64_t * value)
+{
+    const uint8_t * text = (const uint8_t *) data;
+    uint64_t result = 0;
+    size_t ndigits = 0;
+    size_t i = 0;
+    unsigned d;
+
+    // Take the prefix only if digits follow it, leaving "0x" as zero
+    if (size > 2 && text[0] == '0' && (text[1] | 0x20) == 'x' &&
+        number_hex_value(text[2]) < 16)
+    {
+        i = 2;
+    }
+
+    while (i < size && text[i] == '0')
+    {
+        i++;
+        ndigits++;
+    }
+
+    for (; i < size && (d = number_hex_value(text[i])) < 16; i++)
+    {
+        if (result >> 60)
+        {
+            return -1;
+        }
+
+        result = (result << 4) | d;
+        ndigits++;
+    }
+
+    if (ndigits == 0)
+    {
+        return -1;
+    }
+
+    *value = result;
+    return (ssize_t) i;
+}
+
+//------------------------------------------------------------------------|
+// Private helper that matches a word, in any case, at the start of text
+static inline bool number_word(const uint8_t * text,
+                               size_t size,
+                               const char * word)
+{
+    size_t i;
+
+    for (i = 0; word[i]; i++)
+    {
+        if (i >= size || (text[i] | 0x20) != word[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// The "C" locale for strtod_l(), so that the decimal point is '.' however
+// the process's locale is set.  Created once on first use.
+static locale_t number_locale = (locale_t) 0;
+static pthread_once_t number_once = PTHREAD_ONCE_INIT;
+
+static void number_locale_init(void)
+{
+    number_locale = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
+}
+
+//------------------------------------------------------------------------|
+// Private helper for inputs that number_parse_double() can't convert
+// exactly by itself.  Rewrites the mantissa it has already checked, of
+// 'size' bytes, as significant digits and an exponent in a stack buffer,
+// keeping at most NUMBER_SLOW_DIGITS of them and a sticky '1' if any
+// dropped digit was nonzero, then hands that to strtod_l().  'power' is
+// the explicit exponent.  Returns false if the locale is unavailable.
+static bool number_strtod(const uint8_t * text,
+                          size_t size,
+                          long power,
+                          bool negative,
+                          double * value)
+{
+    char buffer[NUMBER_SLOW_DIGITS + NUMBER_MAX_CHARS + 4];
+    long exponent = power;
+    bool point = false;
+    bool sticky = false;
+    size_t ndigits = 0;
+    size_t n = 0;
+    size_t i;
+
+    pthread_once(&number_once, number_locale_init);
+    if (number_locale == (locale_t) 0)
+    {
+        return false;
+    }
+
+    buffer[n++] = negative ? '-' : '+';
+
+    // The value is the kept digits as an integer, times 10^exponent
+    for (i = 0; i < size; i++)
+    {
+        if (text[i] == '.')
+        {
+            point = true;
+            continue;
+        }
+
+        exponent -= point;
+        if (ndigits == 0 && text[i] == '0')
+        {
+            continue;
+        }
+        else if (ndigits < NUMBER_SLOW_DIGITS)
+        {
+            buffer[n++] = (char) text[i];
+            ndigits++;
+        }
+        else
+        {
+            sticky = sticky || text[i] != '0';
+            exponent++;
+        }
+    }
+
+    if (sticky)
+    {
+        buffer[n++] = '1';
+        exponent--;
+    }
+
+    buffer[n++] = 'e';
+    n += number_format_i64(buffer + n, exponent);
+    buffer[n] = '\0';
+
+    *value = strtod_l(buffer, NULL, number_locale);
+    return true;
+}
+
+//------------------------------------------------------------------------|
+ssize_t number_parse_double(const void * data, size_t size, double * value)
+{
+    const uint8_t * text = (const uint8_t *) data;
+    bool negative = size > 0 && text[0] == '-';
+    size_t i = size > 0 && (text[0] == '-' || text[0] == '+');
+    uint64_t mantissa = 0;
+    size_t nsignificant = 0;
+    size_t nmantissa = 0;
+    bool exact = true;
+    long exponent = 0;
+    double result;
+
+    if (number_word(text + i, size - i, "inf"))
+    {
+        i += number_word(text + i, size - i, "infinity") ? 8 : 3;
+        *value = negative ? -__builtin_inf() : __builtin_inf();
+        return (ssize_t) i;
+    }
+    else if (number_word(text + i, size - i, "nan"))
+    {
+        *value = negative ? -__builtin_nan("") : __builtin_nan("");
+        return (ssize_t) i + 3;
+    }
+
+    // Up to 19 significant digits are kept, and the decimal exponent
+    // adjusted for any after the point or dropped from the integer part
+    for (; i < size && number_is_digit(text[i]); i++, nmantissa++)
+    {
+        if (nsignificant < 19)
+        {
+            mantissa = mantissa * 10 + (text[i] - '0');
+            nsignificant += (mantissa != 0);
+        }
+        else
+        {
+            exact = exact && text[i] == '0';
+            exponent++;
+        }
+    }
+
+    if (i < size && text[i] == '.')
+    {
+        for (i++; i < size && number_is_digit(text[i]); i++, nmantissa++)
+        {
+            if (nsignificant < 19)
+            {
+                mantissa = mantissa * 10 + (text[i] - '0');
+                nsignificant += (mantissa != 0);
+                exponent--;
+            }
+            else
+            {
+                exact = exact && text[i] == '0';
+            }
+        }
+    }
+
+    if (nmantissa == 0)
+    {
+        return -1;
+    }
+
+    // The exponent only counts if it has digits
+    size_t mantissa_end = i;
+    long power = 0;
+
+    if (i + 1 < size && (text[i] | 0x20) == 'e')
+    {
+        size_t j = i + 1 + (text[i + 1] == '-' || text[i + 1] == '+');
+
+        if (j < size && number_is_digit(text[j]))
+        {
+            for (; j < size && number_is_digit(text[j]); j++)
+            {
+                power = power < 100000 ? power * 10 + (text[j] - '0')
+                                       : power;
+            }
+
+            power = text[i + 1] == '-' ? -power : power;
+            exponent += power;
+            i = j;
+        }
+    }
+
+    // Both the mantissa and the power of ten are exact as doubles, so one
+    // multiply or divide rounds correctly
+    if (mantissa == 0)
+    {
+        result = 0.0;
+    }
+    else if (exact && mantissa <= (1ULL << 53) &&
+             exponent >= -22 && exponent <= 22)
+    {
+        result = (double) mantissa;
+        result = exponent < 0 ? result / number_exact10[-exponent]
+                              : result * number_exact10[exponent];
+    }
+    else
+    {
+        size_t sign = size > 0 && (text[0] == '-' || text[0] == '+');
+
+        if (!number_strtod(text + sign, mantissa_end - sign, power,
+                           negative, value))
+        {
+            return -1;
+        }
+
+        return (ssize_t) i;
+    }
+
+    *value = negative ? -result : result;
+    return (ssize_t) i;
+}
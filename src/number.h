@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <sys/types.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------|
+// Number formatting and parsing without printf(), for building and
+// reading text a field at a time.  Nothing here allocates, and the
+// decimal point is always '.' whatever the process's locale.
+//
+// Integers are formatted two digits at a time from a table of digit
+// pairs.  Doubles are formatted with Grisu2, which gives the shortest
+// digits that read back as the same double in all but about one case in
+// a thousand, and otherwise a digit or two more, but always reads back
+// exactly.  They are laid out as JavaScript does: plain up to 21 integer
+// digits and down to 0.000001, with an exponent beyond, as in "1e+21"
+// and "1.5e-7".  Non-finite values are "inf", "-inf" and "nan".
+//
+// Doubles are parsed exactly by one multiply or divide when the mantissa
+// fits in 53 bits and the power of ten is at most 22, as most written
+// values do.  Otherwise up to 800 significant digits, enough to round
+// correctly, are rewritten in a stack buffer and passed to strtod_l()
+// with the "C" locale.
+
+// Enough room for any of the formatters' output.  No terminator is
+// written.
+#define NUMBER_MAX_CHARS            32
+
+//------------------------------------------------------------------------|
+// Formatters write into 'out', which must hold NUMBER_MAX_CHARS, and
+// return the number of characters written.  Hex digits are lowercase
+// without a prefix, zero-padded to at least 'width' digits, up to 16.
+size_t number_format_u64(char * out, uint64_t value);
+size_t number_format_i64(char * out, int64_t value);
+size_t number_format_hex(char * out, uint64_t value, size_t width);
+size_t number_format_double(char * out, double value);
+
+//------------------------------------------------------------------------|
+// Parsers read a number from the start of 'data', without skipping
+// whitespace, and return the number of bytes it took up.  Returns
+// negative, leaving 'value' alone, if there is no number there or it is
+// out of range.  Integers are decimal, with a sign for i64 only.  Hex
+// takes an optional "0x" prefix.  Doubles take the usual decimal forms
+// with an optional exponent, and "inf", "infinity" and "nan" in any
+// case.  They are correctly rounded, and beyond the range of doubles
+// become infinity or zero, as with strtod().  Parsing a double also fails
+// if the "C" locale could not be created.
+ssize_t number_parse_u64(const void * data, size_t size, uint64_t * value);
+ssize_t number_parse_i64(const void * data, size_t size, int64_t * value);
+ssize_t number_parse_hex(const void * data, size_t size, uint64_t * value);
+ssize_t number_parse_double(const void * data, size_t size, double * value);
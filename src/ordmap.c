@@ -0,0 +1,981 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ordmap.h"
+#include "utils.h"              // memzero(), function signatures
+#include "blammo.h"
+
+//------------------------------------------------------------------------|
+// Nodes are sized so that the item pointer array plus bookkeeping of a
+// node occupies exactly one cache line.  Leaf nodes (the overwhelming
+// majority of nodes in any B-tree) are allocated without a child pointer
+// array at all, so an entire leaf is one line.  Interior nodes carry a
+// second line worth of child pointers.  The maximum item count must be
+// odd for the classic split/merge algorithm: 7 on 64-bit, 15 on 32-bit.
+#define ORDMAP_CACHE_LINE       64
+#define ORDMAP_NODE_ITEMS       ((ORDMAP_CACHE_LINE / sizeof(void *)) - 1)
+#define ORDMAP_MIN_DEGREE       ((ORDMAP_NODE_ITEMS + 1) / 2)
+#define ORDMAP_MIN_ITEMS        (ORDMAP_MIN_DEGREE - 1)
+
+//------------------------------------------------------------------------|
+// Item container for heterogeneous key/object pair payload.  Items are
+// referenced from exactly one B-tree node and also threaded onto a sorted
+// doubly-linked list.  The key is stored inline with the container to
+// avoid an extra pointer chase on every comparison during a search.
+typedef struct ordmap_item_t
+{
+    // In-order neighbors.  NULL indicates either end of the map.
+    struct ordmap_item_t * next;
+    struct ordmap_item_t * prev;
+
+    // Pointer to the object managed by this map
+    void * object;
+
+    // Object deep-copy function
+    generic_copy_f object_copy;
+
+    // Object destructor function
+    generic_destroy_f object_destroy;
+
+    // Dictionary-style keyword associated with this object
+    char key[];
+}
+ordmap_item_t;
+
+// B-tree node.  'children' only exists for interior nodes.
+typedef struct ordmap_node_t
+{
+    ordmap_item_t * items[ORDMAP_NODE_ITEMS];
+    uint16_t count;
+    bool leaf;
+    struct ordmap_node_t * children[];
+}
+ordmap_node_t;
+
+// Ordered map private implementation data
+typedef struct
+{
+    // Root node of the B-tree, NULL when empty
+    ordmap_node_t * root;
+
+    // Lowest and highest items in the threaded list
+    ordmap_item_t * first;
+    ordmap_item_t * last;
+
+    // Number of items in the map
+    size_t length;
+
+    // Some dynamically-sized pointer arrays for array-style iteration.
+    char ** keys;
+    void ** objects;
+}
+ordmap_priv_t;
+
+//------------------------------------------------------------------------|
+static ordmap_node_t * ordmap_node_create(bool leaf)
+{
+    size_t size = sizeof(ordmap_node_t);
+    if (!leaf)
+    {
+        size += sizeof(ordmap_node_t *) * (ORDMAP_NODE_ITEMS + 1);
+    }
+
+    ordmap_node_t * node = (ordmap_node_t *) malloc(size);
+    if (!node)
+    {
+        BLAMMO(FATAL, "malloc(%zu) failed", size);
+        return NULL;
+    }
+
+    memzero(node, size);
+    node->leaf = leaf;
+    return node;
+}
+
+//------------------------------------------------------------------------|
+// Recursively free all nodes beneath and including the given one.
+// Items are NOT touched here, they are owned by the threaded list.
+static void ordmap_node_destroy(ordmap_node_t * node)
+{
+    size_t i;
+
+    if (!node)
+    {
+        return;
+    }
+
+    if (!node->leaf)
+    {
+        for (i = 0; i <= node->count; i++)
+        {
+            ordmap_node_destroy(node->children[i]);
+        }
+    }
+
+    free(node);
+}
+
+//------------------------------------------------------------------------|
+// Find the index of the first item in a node whose key is greater than
+// or equal to the given key.  'found' is set if the key matches exactly.
+static inline size_t ordmap_node_index(ordmap_node_t * node,
+                                       const char * key,
+                                       bool * found)
+{
+    size_t i = 0;
+    int cmp = 0;
+
+    *found = false;
+    while (i < node->count)
+    {
+        cmp = strcmp(node->items[i]->key, key);
+        if (cmp >= 0)
+        {
+            *found = (cmp == 0);
+            break;
+        }
+
+        i++;
+    }
+
+    return i;
+}
+
+//------------------------------------------------------------------------|
+// Private helper for get(), set(), and remove()
+static ordmap_item_t * ordmap_item_find(ordmap_priv_t * priv,
+                                        const char * key)
+{
+    ordmap_node_t * node = priv->root;
+    bool found = false;
+    size_t i;
+
+    while (node)
+    {
+        i = ordmap_node_index(node, key, &found);
+        if (found)
+        {
+            return node->items[i];
+        }
+
+        node = node->leaf ? NULL : node->children[i];
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------|
+// Find the lowest item with a key greater than or equal to (inclusive)
+// or strictly greater than (not inclusive) the given key.  Each level of
+// the descent may only ever narrow the candidate, so the last candidate
+// seen on the way down is the answer.
+static ordmap_item_t * ordmap_item_bound(ordmap_priv_t * priv,
+                                         const char * key,
+                                         bool inclusive)
+{
+    ordmap_node_t * node = priv->root;
+    ordmap_item_t * candidate = NULL;
+    bool found = false;
+    size_t i;
+
+    while (node)
+    {
+        i = ordmap_node_index(node, key, &found);
+        if (found)
+        {
+            return inclusive ? node->items[i] : node->items[i]->next;
+        }
+
+        if (i < node->count)
+        {
+            candidate = node->items[i];
+        }
+
+        node = node->leaf ? NULL : node->children[i];
+    }
+
+    return candidate;
+}
+
+//------------------------------------------------------------------------|
+// Split the full child at index i of a non-full node x into two nodes,
+// moving the median item up into x.
+static bool ordmap_node_split(ordmap_node_t * x, size_t i)
+{
+    ordmap_node_t * y = x->children[i];
+    ordmap_node_t * z = ordmap_node_create(y->leaf);
+    size_t j;
+
+    if (!z)
+    {
+        return false;
+    }
+
+    // upper half of y moves over to z
+    z->count = ORDMAP_MIN_ITEMS;
+    for (j = 0; j < ORDMAP_MIN_ITEMS; j++)
+    {
+        z->items[j] = y->items[j + ORDMAP_MIN_DEGREE];
+    }
+
+    if (!y->leaf)
+    {
+        for (j = 0; j < ORDMAP_MIN_DEGREE; j++)
+        {
+            z->children[j] = y->children[j + ORDMAP_MIN_DEGREE];
+        }
+    }
+
+    y->count = ORDMAP_MIN_ITEMS;
+
+    // make room in x for the new child and the median item
+    for (j = x->count; j > i; j--)
+    {
+        x->children[j + 1] = x->children[j];
+        x->items[j] = x->items[j - 1];
+    }
+
+    x->children[i + 1] = z;
+    x->items[i] = y->items[ORDMAP_MIN_ITEMS];
+    x->count++;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Insert an item known not to be present into the tree, splitting full
+// nodes on the way down so that a single descent suffices.
+static bool ordmap_node_insert(ordmap_priv_t * priv, ordmap_item_t * item)
+{
+    ordmap_node_t * node = priv->root;
+    bool found = false;
+    size_t i;
+
+    if (!node)
+    {
+        priv->root = ordmap_node_create(true);
+        if (!priv->root)
+        {
+            return false;
+        }
+
+        priv->root->items[0] = item;
+        priv->root->count = 1;
+        return true;
+    }
+
+    // The tree only ever grows in height at the root
+    if (node->count == ORDMAP_NODE_ITEMS)
+    {
+        node = ordmap_node_create(false);
+        if (!node)
+        {
+            return false;
+        }
+
+        node->children[0] = priv->root;
+        if (!ordmap_node_split(node, 0))
+        {
+            free(node);
+            return false;
+        }
+
+        priv->root = node;
+    }
+
+    while (!node->leaf)
+    {
+        i = ordmap_node_index(node, item->key, &found);
+        if (node->children[i]->count == ORDMAP_NODE_ITEMS)
+        {
+            if (!ordmap_node_split(node, i))
+            {
+                return false;
+            }
+
+            if (strcmp(item->key, node->items[i]->key) > 0)
+            {
+                i++;
+            }
+        }
+
+        node = node->children[i];
+    }
+
+    i = ordmap_node_index(node, item->key, &found);
+    memmove(&node->items[i + 1], &node->items[i],
+            sizeof(ordmap_item_t *) * (node->count - i));
+    node->items[i] = item;
+    node->count++;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Merge child i+1 of x and the separating item i of x into child i.
+// Both children are expected to be at minimum occupancy.
+static void ordmap_node_merge(ordmap_node_t * x, size_t i)
+{
+    ordmap_node_t * y = x->children[i];
+    ordmap_node_t * z = x->children[i + 1];
+    size_t j;
+
+    y->items[y->count] = x->items[i];
+    for (j = 0; j < z->count; j++)
+    {
+        y->items[y->count + 1 + j] = z->items[j];
+    }
+
+    if (!y->leaf)
+    {
+        for (j = 0; j <= z->count; j++)
+        {
+            y->children[y->count + 1 + j] = z->children[j];
+        }
+    }
+
+    y->count += z->count + 1;
+
+    // close the gap left in x
+    for (j = i; j + 1 < x->count; j++)
+    {
+        x->items[j] = x->items[j + 1];
+        x->children[j + 1] = x->children[j + 2];
+    }
+
+    x->count--;
+    free(z);
+}
+
+//------------------------------------------------------------------------|
+// Rotate one item from the left sibling of child i, through x, into it
+static void ordmap_node_borrow_left(ordmap_node_t * x, size_t i)
+{
+    ordmap_node_t * child = x->children[i];
+    ordmap_node_t * left = x->children[i - 1];
+
+    memmove(&child->items[1], &child->items[0],
+            sizeof(ordmap_item_t *) * child->count);
+    if (!child->leaf)
+    {
+        memmove(&child->children[1], &child->children[0],
+                sizeof(ordmap_node_t *) * (child->count + 1));
+        child->children[0] = left->children[left->count];
+    }
+
+    child->items[0] = x->items[i - 1];
+    x->items[i - 1] = left->items[left->count - 1];
+    left->count--;
+    child->count++;
+}
+
+//------------------------------------------------------------------------|
+// Rotate one item from the right sibling of child i, through x, into it
+static void ordmap_node_borrow_right(ordmap_node_t * x, size_t i)
+{
+    ordmap_node_t * child = x->children[i];
+    ordmap_node_t * right = x->children[i + 1];
+
+    child->items[child->count] = x->items[i];
+    if (!child->leaf)
+    {
+        child->children[child->count + 1] = right->children[0];
+        memmove(&right->children[0], &right->children[1],
+                sizeof(ordmap_node_t *) * right->count);
+    }
+
+    x->items[i] = right->items[0];
+    memmove(&right->items[0], &right->items[1],
+            sizeof(ordmap_item_t *) * (right->count - 1));
+    right->count--;
+    child->count++;
+}
+
+//------------------------------------------------------------------------|
+// Delete the item with the given key (known to be present) from the
+// tree.  This is the single-pass top-down algorithm: every node that is
+// descended into is first topped up above minimum occupancy, so that the
+// eventual removal from a leaf never needs to back up the tree.
+static void ordmap_node_delete(ordmap_priv_t * priv, const char * key)
+{
+    ordmap_node_t * node = priv->root;
+    ordmap_node_t * child = NULL;
+    ordmap_node_t * walk = NULL;
+    bool found = false;
+    size_t i;
+
+    while (node)
+    {
+        i = ordmap_node_index(node, key, &found);
+
+        if (found && node->leaf)
+        {
+            memmove(&node->items[i], &node->items[i + 1],
+                    sizeof(ordmap_item_t *) * (node->count - i - 1));
+            node->count--;
+            break;
+        }
+        else if (found)
+        {
+            // Replace with in-order predecessor or successor, whichever
+            // sibling can spare it, then go delete that one instead.
+            // Keys of the replacement items remain valid throughout.
+            if (node->children[i]->count > ORDMAP_MIN_ITEMS)
+            {
+                walk = node->children[i];
+                while (!walk->leaf)
+                {
+                    walk = walk->children[walk->count];
+                }
+
+                node->items[i] = walk->items[walk->count - 1];
+                key = node->items[i]->key;
+                node = node->children[i];
+            }
+            else if (node->children[i + 1]->count > ORDMAP_MIN_ITEMS)
+            {
+                walk = node->children[i + 1];
+                while (!walk->leaf)
+                {
+                    walk = walk->children[0];
+                }
+
+                node->items[i] = walk->items[0];
+                key = node->items[i]->key;
+                node = node->children[i + 1];
+            }
+            else
+            {
+                child = node->children[i];
+                ordmap_node_merge(node, i);
+                node = child;
+            }
+        }
+        else if (node->leaf)
+        {
+            BLAMMO(ERROR, "key %s not found in tree", key);
+            break;
+        }
+        else
+        {
+            child = node->children[i];
+            if (child->count == ORDMAP_MIN_ITEMS)
+            {
+                if (i > 0 && node->children[i - 1]->count > ORDMAP_MIN_ITEMS)
+                {
+                    ordmap_node_borrow_left(node, i);
+                }
+                else if (i < node->count &&
+                         node->children[i + 1]->count > ORDMAP_MIN_ITEMS)
+                {
+                    ordmap_node_borrow_right(node, i);
+                }
+                else if (i < node->count)
+                {
+                    ordmap_node_merge(node, i);
+                }
+                else
+                {
+                    child = node->children[i - 1];
+                    ordmap_node_merge(node, i - 1);
+                }
+            }
+
+            node = child;
+        }
+    }
+
+    // The tree only ever shrinks in height at the root
+    node = priv->root;
+    if (node && node->count == 0)
+    {
+        priv->root = node->leaf ? NULL : node->children[0];
+        free(node);
+    }
+}
+
+//------------------------------------------------------------------------|
+static ordmap_t * ordmap_create()
+{
+    // Allocate and initialize public interface
+    ordmap_t * ordmap = (ordmap_t *) malloc(sizeof(ordmap_t));
+    if (!ordmap)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(ordmap_t)) failed");
+        return NULL;
+    }
+
+    // bulk copy all function pointers and init opaque ptr
+    memcpy(ordmap, &ordmap_pub, sizeof(ordmap_t));
+
+    // Allocate and initialize private implementation
+    ordmap->priv = malloc(sizeof(ordmap_priv_t));
+    if (!ordmap->priv)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(ordmap_priv_t)) failed");
+        free(ordmap);
+        return NULL;
+    }
+
+    memzero(ordmap->priv, sizeof(ordmap_priv_t));
+
+    return ordmap;
+}
+
+//------------------------------------------------------------------------|
+static void ordmap_destroy(void * ordmap_ptr)
+{
+    ordmap_t * ordmap = (ordmap_t *) ordmap_ptr;
+
+    // guard against accidental double-destroy or early-destroy
+    if (!ordmap || !ordmap->priv)
+    {
+        BLAMMO(WARNING, "attempt to early or double-destroy");
+        return;
+    }
+
+    // remove all objects and destroy their data
+    ordmap->clear(ordmap);
+
+    // zero out and destroy the private data
+    memzero(ordmap->priv, sizeof(ordmap_priv_t));
+    free(ordmap->priv);
+
+    // zero out and destroy the public interface
+    memzero(ordmap, sizeof(ordmap_t));
+    free(ordmap);
+}
+
+//------------------------------------------------------------------------|
+static void ordmap_clear(ordmap_t * ordmap)
+{
+    ordmap_priv_t * priv = (ordmap_priv_t *) ordmap->priv;
+    ordmap_item_t * item = priv->first;
+    ordmap_item_t * next = NULL;
+
+    if (priv->objects)
+    {
+        free(priv->objects);
+        priv->objects = NULL;
+    }
+
+    if (priv->keys)
+    {
+        free(priv->keys);
+        priv->keys = NULL;
+    }
+
+    // The list owns the items, the tree only references them.
+    while (item)
+    {
+        next = item->next;
+        if (item->object && item->object_destroy)
+        {
+            item->object_destroy(item->object);
+        }
+
+        free(item);
+        item = next;
+    }
+
+    ordmap_node_destroy(priv->root);
+    priv->root = NULL;
+    priv->first = NULL;
+    priv->last = NULL;
+    priv->length = 0;
+}
+
+//------------------------------------------------------------------------|
+static inline bool ordmap_empty(ordmap_t * ordmap)
+{
+    return (NULL == ((ordmap_priv_t *) ordmap->priv)->root);
+}
+
+//------------------------------------------------------------------------|
+static inline size_t ordmap_length(ordmap_t * ordmap)
+{
+    return ((ordmap_priv_t *) ordmap->priv)->length;
+}
+
+//------------------------------------------------------------------------|
+static ordmap_t * ordmap_copy(ordmap_t * ordmap)
+{
+    ordmap_priv_t * priv = (ordmap_priv_t *) ordmap->priv;
+    ordmap_item_t * item = priv->first;
+    ordmap_t * copy = ordmap_pub.create();
+
+    if (!copy)
+    {
+        BLAMMO(ERROR, "ordmap_create() copy failed");
+        return NULL;
+    }
+
+    // Unlike collect_t, ordering is intrinsic so a straight walk works
+    while (item)
+    {
+        copy->set(copy,
+                  item->key,
+                  item->object_copy ?
+                          item->object_copy(item->object) :
+                          item->object,
+                  item->object_copy,
+                  item->object_destroy);
+        item = item->next;
+    }
+
+    return copy;
+}
+
+//------------------------------------------------------------------------|
+static inline void * ordmap_get(ordmap_t * ordmap, const char * key)
+{
+    ordmap_item_t * item = ordmap_item_find(
+            (ordmap_priv_t *) ordmap->priv, key);
+    return item ? item->object : NULL;
+}
+
+//------------------------------------------------------------------------|
+static void ordmap_set(ordmap_t * ordmap,
+                       const char * key,
+                       void * object,
+                       generic_copy_f object_copy,
+                       generic_destroy_f object_destroy)
+{
+    ordmap_priv_t * priv = (ordmap_priv_t *) ordmap->priv;
+    ordmap_item_t * item = ordmap_item_find(priv, key);
+    ordmap_item_t * succ = NULL;
+    size_t keylen = 0;
+
+    if (item)
+    {
+        // If found, destroy the object (if allocated/valid).
+        // To make way for the replacement object.
+        if (item->object && item->object_destroy)
+        {
+            item->object_destroy(item->object);
+        }
+    }
+    else
+    {
+        keylen = strlen(key);
+        item = (ordmap_item_t *) malloc(sizeof(ordmap_item_t) + keylen + 1);
+        if (!item)
+        {
+            BLAMMO(FATAL, "malloc(sizeof(ordmap_item_t) + %zu) failed",
+                   keylen + 1);
+            return;
+        }
+
+        memzero(item, sizeof(ordmap_item_t));
+        memcpy(item->key, key, keylen + 1);
+
+        // Find the in-order successor before the tree is modified
+        succ = ordmap_item_bound(priv, key, true);
+        if (!ordmap_node_insert(priv, item))
+        {
+            BLAMMO(FATAL, "ordmap_node_insert(%s) failed!", key);
+            free(item);
+            return;
+        }
+
+        // Splice into the threaded list just before the successor
+        item->next = succ;
+        item->prev = succ ? succ->prev : priv->last;
+        if (item->prev)
+        {
+            item->prev->next = item;
+        }
+        else
+        {
+            priv->first = item;
+        }
+
+        if (succ)
+        {
+            succ->prev = item;
+        }
+        else
+        {
+            priv->last = item;
+        }
+
+        priv->length++;
+    }
+
+    item->object = object;
+    item->object_copy = object_copy;
+    item->object_destroy = object_destroy;
+}
+
+//------------------------------------------------------------------------|
+static bool ordmap_remove(ordmap_t * ordmap, const char * key)
+{
+    ordmap_priv_t * priv = (ordmap_priv_t *) ordmap->priv;
+    ordmap_item_t * item = ordmap_item_find(priv, key);
+
+    if (!item)
+    {
+        return false;
+    }
+
+    // Key is inline in the item, so it must outlive the tree deletion
+    ordmap_node_delete(priv, item->key);
+
+    if (item->prev)
+    {
+        item->prev->next = item->next;
+    }
+    else
+    {
+        priv->first = item->next;
+    }
+
+    if (item->next)
+    {
+        item->next->prev = item->prev;
+    }
+    else
+    {
+        priv->last = item->prev;
+    }
+
+    if (item->object && item->object_destroy)
+    {
+        item->object_destroy(item->object);
+    }
+
+    memzero(item, sizeof(ordmap_item_t));
+    free(item);
+    priv->length--;
+
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Private helper for all of the iterator functions
+static inline void * ordmap_iterator(ordmap_item_t * item,
+                                     char ** key, void ** object)
+{
+    if (!item)
+    {
+        *key = NULL;
+        *object = NULL;
+        return NULL;
+    }
+
+    *key = item->key;
+    *object = item->object;
+    return (void *) item;
+}
+
+//------------------------------------------------------------------------|
+static void * ordmap_first(ordmap_t * ordmap,
+                           char ** key, void ** object)
+{
+    ordmap_priv_t * priv = (ordmap_priv_t *) ordmap->priv;
+    return ordmap_iterator(priv->first, key, object);
+}
+
+//------------------------------------------------------------------------|
+static void * ordmap_next(void * iterator,
+                          char ** key, void ** object)
+{
+    ordmap_item_t * item = (ordmap_item_t *) iterator;
+    return ordmap_iterator(item ? item->next : NULL, key, object);
+}
+
+//------------------------------------------------------------------------|
+static void * ordmap_lower_bound(ordmap_t * ordmap,
+                                 const char * key,
+                                 char ** found_key,
+                                 void ** object)
+{
+    ordmap_priv_t * priv = (ordmap_priv_t *) ordmap->priv;
+    return ordmap_iterator(ordmap_item_bound(priv, key, true),
+                           found_key, object);
+}
+
+//------------------------------------------------------------------------|
+static void * ordmap_upper_bound(ordmap_t * ordmap,
+                                 const char * key,
+                                 char ** found_key,
+                                 void ** object)
+{
+    ordmap_priv_t * priv = (ordmap_priv_t *) ordmap->priv;
+    return ordmap_iterator(ordmap_item_bound(priv, key, false),
+                           found_key, object);
+}
+
+//------------------------------------------------------------------------|
+static void * ordmap_range_first(ordmap_t * ordmap,
+                                 const char * begin,
+                                 const char * end,
+                                 char ** key,
+                                 void ** object)
+{
+    ordmap_priv_t * priv = (ordmap_priv_t *) ordmap->priv;
+    ordmap_item_t * item = begin ?
+            ordmap_item_bound(priv, begin, true) : priv->first;
+
+    if (item && end && strcmp(item->key, end) >= 0)
+    {
+        item = NULL;
+    }
+
+    return ordmap_iterator(item, key, object);
+}
+
+//------------------------------------------------------------------------|
+static void * ordmap_range_next(void * iterator,
+                                const char * end,
+                                char ** key,
+                                void ** object)
+{
+    ordmap_item_t * item = (ordmap_item_t *) iterator;
+    item = item ? item->next : NULL;
+
+    if (item && end && strcmp(item->key, end) >= 0)
+    {
+        item = NULL;
+    }
+
+    return ordmap_iterator(item, key, object);
+}
+
+//------------------------------------------------------------------------|
+static void * ordmap_prefix_first(ordmap_t * ordmap,
+                                  const char * prefix,
+                                  char ** key,
+                                  void ** object)
+{
+    ordmap_priv_t * priv = (ordmap_priv_t *) ordmap->priv;
+    ordmap_item_t * item = ordmap_item_bound(priv, prefix, true);
+
+    // All keys sharing a prefix are contiguous and begin at the lower
+    // bound of the prefix itself, so only one comparison is needed.
+    if (item && strncmp(item->key, prefix, strlen(prefix)) != 0)
+    {
+        item = NULL;
+    }
+
+    return ordmap_iterator(item, key, object);
+}
+
+//------------------------------------------------------------------------|
+static void * ordmap_prefix_next(void * iterator,
+                                 const char * prefix,
+                                 char ** key,
+                                 void ** object)
+{
+    ordmap_item_t * item = (ordmap_item_t *) iterator;
+    item = item ? item->next : NULL;
+
+    if (item && strncmp(item->key, prefix, strlen(prefix)) != 0)
+    {
+        item = NULL;
+    }
+
+    return ordmap_iterator(item, key, object);
+}
+
+//------------------------------------------------------------------------|
+static const char ** ordmap_keys(ordmap_t * ordmap)
+{
+    ordmap_priv_t * priv = (ordmap_priv_t *) ordmap->priv;
+    ordmap_item_t * item = priv->first;
+
+    // size the string pointer array appropriately
+    // allow 1 extra to NULL terminate the array.
+    size_t size = sizeof(char *) * (priv->length + 1);
+    priv->keys = (char **) realloc(priv->keys, size);
+    if (!priv->keys)
+    {
+        BLAMMO(FATAL, "realloc(%zu) failed", size);
+        return NULL;
+    }
+
+    size_t i = 0;
+    while (item)
+    {
+        priv->keys[i++] = item->key;
+        item = item->next;
+    }
+
+    priv->keys[i] = NULL;
+    return (const char **) priv->keys;
+}
+
+//------------------------------------------------------------------------|
+static void ** ordmap_objects(ordmap_t * ordmap)
+{
+    ordmap_priv_t * priv = (ordmap_priv_t *) ordmap->priv;
+    ordmap_item_t * item = priv->first;
+
+    // size the object pointer array appropriately
+    // allow 1 extra to NULL terminate the array.
+    size_t size = sizeof(void *) * (priv->length + 1);
+    priv->objects = (void **) realloc(priv->objects, size);
+    if (!priv->objects)
+    {
+        BLAMMO(FATAL, "realloc(%zu) failed", size);
+        return NULL;
+    }
+
+    size_t i = 0;
+    while (item)
+    {
+        priv->objects[i++] = item->object;
+        item = item->next;
+    }
+
+    priv->objects[i] = NULL;
+    return priv->objects;
+}
+
+//------------------------------------------------------------------------|
+const ordmap_t ordmap_pub = {
+    &ordmap_create,
+    &ordmap_destroy,
+    &ordmap_clear,
+    &ordmap_empty,
+    &ordmap_length,
+    &ordmap_copy,
+    &ordmap_get,
+    &ordmap_set,
+    &ordmap_remove,
+    &ordmap_first,
+    &ordmap_next,
+    &ordmap_lower_bound,
+    &ordmap_upper_bound,
+    &ordmap_range_first,
+    &ordmap_range_next,
+    &ordmap_prefix_first,
+    &ordmap_prefix_next,
+    &ordmap_keys,
+    &ordmap_objects,
+    NULL
+};
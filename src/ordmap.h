@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------|
+// An ordered map is a collection of heterogeneous objects (exactly like
+// collect_t) that keeps its keys in sorted (strcmp) order.  Internally it
+// is a B-tree whose nodes are sized to a cache line, with all items also
+// threaded onto an in-order list so that iteration is Order-1 per step.
+// The get/set/remove/first/next/keys/objects methods intentionally have
+// the same semantics as their collect_t counterparts, except that order
+// is always ascending by key rather than most-recently-added first.
+#include "utils.h"          // generic function signatures
+
+//------------------------------------------------------------------------|
+typedef struct ordmap_t
+{
+    // Ordered map factory function
+    struct ordmap_t * (*create)();
+
+    // Ordered map destructor function
+    void (*destroy)(void * ordmap);
+
+    // Empty the map: Removes all items and destroys their data.
+    void (*clear)(struct ordmap_t * ordmap);
+
+    // Whether the map is empty or not
+    bool (*empty)(struct ordmap_t * ordmap);
+
+    // Gets the length of the map: the number of objects stored.
+    size_t (*length)(struct ordmap_t * ordmap);
+
+    // Produce a full deep copy of the map, including individual
+    // objects within the map.
+    struct ordmap_t * (*copy)(struct ordmap_t * ordmap);
+
+    // Get an object by keyword.  Returns NULL if it doesn't exist.
+    void * (*get)(struct ordmap_t * ordmap, const char * key);
+
+    // Set an object.  Adds it to the map if it does not exist,
+    // or else destroys and overwrites the previous object instance
+    // if it does.
+    void (*set)(struct ordmap_t * ordmap,
+                const char * key,
+                void * object,
+                generic_copy_f object_copy,
+                generic_destroy_f object_destroy);
+
+    // Remove a specific object entry by key.
+    // returns true if the object was found and removed,
+    // or false if the object was not found
+    bool (*remove)(struct ordmap_t * ordmap, const char * key);
+
+    // Starting iterator for the map.  Returns an iterator pointer
+    // to be used in subsequent calls to 'next', and sets the 'key' and
+    // 'object' pointers to the lowest key/object in the map.
+    void * (*first)(struct ordmap_t * ordmap,
+                    char ** key, void ** object);
+
+    // Regular forward iterator function for the map.  Pass in
+    // the iterator pointer from any of the starting iterators or a
+    // previous call to next.  key/object are set to the next item
+    // in ascending key order.
+    void * (*next)(void * iterator,
+                   char ** key, void ** object);
+
+    // Positions an iterator at the first item whose key is greater than
+    // or equal to the given key.  Returns NULL if there is no such item.
+    void * (*lower_bound)(struct ordmap_t * ordmap,
+                          const char * key,
+                          char ** found_key,
+                          void ** object);
+
+    // Positions an iterator at the first item whose key is strictly
+    // greater than the given key.  Returns NULL if there is no such item.
+    void * (*upper_bound)(struct ordmap_t * ordmap,
+                          const char * key,
+                          char ** found_key,
+                          void ** object);
+
+    // Range iterators over the half-open interval [begin, end).  Either
+    // bound may be NULL to leave that side of the range unbounded.
+    // range_next() returns NULL once the end of the range is reached.
+    void * (*range_first)(struct ordmap_t * ordmap,
+                          const char * begin,
+                          const char * end,
+                          char ** key,
+                          void ** object);
+
+    void * (*range_next)(void * iterator,
+                         const char * end,
+                         char ** key,
+                         void ** object);
+
+    // Prefix iterators: visit every item whose key starts with 'prefix'
+    // in ascending order.  For example, prefix "net." visits "net.ip" and
+    // "net.mask" but not "netmask".  Returns NULL when exhausted.
+    void * (*prefix_first)(struct ordmap_t * ordmap,
+                           const char * prefix,
+                           char ** key,
+                           void ** object);
+
+    void * (*prefix_next)(void * iterator,
+                          const char * prefix,
+                          char ** key,
+                          void ** object);
+
+    // Returns a linear array of all keys associated with objects, NULL
+    // terminated.  Order is ascending by key.
+    const char ** (*keys)(struct ordmap_t * ordmap);
+
+    // Returns a linear array of all object pointers, NULL terminated.
+    // Order is ascending by key.
+    void ** (*objects)(struct ordmap_t * ordmap);
+
+    // Private data
+    void * priv;
+}
+ordmap_t;
+
+//------------------------------------------------------------------------|
+extern const ordmap_t ordmap_pub;
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "phash.h"
+#include "utils.h"
+#include "blammo.h"
+
+//------------------------------------------------------------------------|
+bool phash_build(const uint64_t * hashes,
+                 size_t count,
+                 uint32_t * disp,
+                 size_t * placed)
+{
+    size_t buckets = phash_buckets(count);
+    size_t i;
+
+    // Scratch space: keys grouped by bucket, bucket boundaries, buckets
+    // ordered largest first, and which slots are already taken.
+    size_t * keyed = (size_t *) malloc(sizeof(size_t) * (count + 1));
+    size_t * start = (size_t *) calloc(buckets + 1, sizeof(size_t));
+    size_t * order = (size_t *) malloc(sizeof(size_t) * buckets);
+    size_t * positions = (size_t *) malloc(sizeof(size_t) * (count + 1));
+    bool * taken = (bool *) calloc(count + 1, sizeof(bool));
+    bool success = keyed && start && order && positions && taken;
+
+    if (!success)
+    {
+        BLAMMO(FATAL, "phash_build() scratch allocation failed");
+        free(keyed);
+        free(start);
+        free(order);
+        free(positions);
+        free(taken);
+        return false;
+    }
+
+    // Counting sort of keys by bucket
+    for (i = 0; i < count; i++)
+    {
+        start[phash_bucket(hashes[i], buckets) + 1]++;
+    }
+
+    size_t largest = 0;
+    for (i = 0; i < buckets; i++)
+    {
+        largest = start[i + 1] > largest ? start[i + 1] : largest;
+        start[i + 1] += start[i];
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        keyed[start[phash_bucket(hashes[i], buckets)]++] = i;
+    }
+
+    // start[b] now marks the end of bucket b, so shift to get its start
+    for (i = buckets; i > 0; i--)
+    {
+        start[i] = start[i - 1];
+    }
+
+    start[0] = 0;
+
+    // Order buckets largest first, since those are the hardest to place
+    size_t filled = 0;
+    size_t width;
+    for (width = largest; width > 0; width--)
+    {
+        for (i = 0; i < buckets; i++)
+        {
+            if (start[i + 1] - start[i] == width)
+            {
+                order[filled++] = i;
+            }
+        }
+    }
+
+    memzero(disp, sizeof(uint32_t) * buckets);
+
+    // Find a displacement for each bucket that lands all of its keys in
+    // distinct free slots
+    for (i = 0; i < filled; i++)
+    {
+        size_t b = order[i];
+        width = start[b + 1] - start[b];
+        uint32_t d;
+        size_t k;
+
+        for (d = 0; d < PHASH_MAX_DISP; d++)
+        {
+            for (k = 0; k < width; k++)
+            {
+                positions[k] = phash_slot(hashes[keyed[start[b] + k]],
+                                          d, count);
+                if (taken[positions[k]])
+                {
+                    break;
+                }
+
+                taken[positions[k]] = true;
+            }
+
+            if (k == width)
+            {
+                break;
+            }
+
+            // collision: release what this attempt claimed
+            while (k-- > 0)
+            {
+                taken[positions[k]] = false;
+            }
+        }
+
+        if (d == PHASH_MAX_DISP)
+        {
+            BLAMMO(ERROR, "no displacement found for bucket %zu", b);
+            success = false;
+            break;
+        }
+
+        disp[b] = d;
+        for (k = 0; k < width; k++)
+        {
+            placed[positions[k]] = keyed[start[b] + k];
+        }
+    }
+
+    free(keyed);
+    free(start);
+    free(order);
+    free(positions);
+    free(taken);
+    return success;
+}
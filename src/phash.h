@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------|
+// Minimal perfect hashing in the hash-and-displace (CHD) style.  Keys are
+// hashed into a few buckets, and each bucket stores the displacement that
+// places all of its keys into distinct, otherwise unused slots.  There
+// are exactly as many slots as keys.  Only the 64-bit key hashes are
+// needed to build or probe a table, so the same table can index memory,
+// a file, or anything else that can be addressed by slot number.
+
+// Average number of keys per displacement bucket.  Larger buckets mean a
+// smaller table but a slower build.
+#define PHASH_LAMBDA                4
+
+// Give up on a bucket after this many displacements.  Only reachable if
+// two distinct keys share the same 64-bit hash.
+#define PHASH_MAX_DISP              (1UL << 24)
+
+//------------------------------------------------------------------------|
+// Finalizer from splitmix64, used to derive independent positions from
+// one key hash.
+static inline uint64_t phash_mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Map a hash onto [0, range) without a division
+static inline size_t phash_range(uint64_t hash, size_t range)
+{
+    return (size_t) (((hash >> 32) * (uint64_t) range) >> 32);
+}
+
+// Number of displacement buckets for a table of 'count' keys
+static inline size_t phash_buckets(size_t count)
+{
+    return count / PHASH_LAMBDA + 1;
+}
+
+// Displacement bucket of a key hash
+static inline size_t phash_bucket(uint64_t hash, size_t buckets)
+{
+    return phash_range(phash_mix(hash), buckets);
+}
+
+// Slot of a key hash, given its bucket's displacement
+static inline size_t phash_slot(uint64_t hash, uint32_t disp, size_t count)
+{
+    return phash_range(phash_mix(hash + (disp + 1) * 0x9e3779b97f4a7c15ULL),
+                       count);
+}
+
+//------------------------------------------------------------------------|
+// Build a table over 'count' key hashes.  Fills in phash_buckets(count)
+// displacements, and for each slot the index into 'hashes' of the key
+// that lands there.  Returns false if scratch memory runs out or two
+// keys share a hash.
+bool phash_build(const uint64_t * hashes,
+                 size_t count,
+                 uint32_t * disp,
+                 size_t * placed);
@@ -0,0 +1,763 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rope.h"
+#include "utils.h"
+#include "blammo.h"
+
+//------------------------------------------------------------------------|
+// Inserted bytes are appended to blocks of at least this size, so that
+// many small inserts share one allocation
+#define ROPE_BLOCK_SIZE             (64 * 1024)
+
+//------------------------------------------------------------------------|
+// Storage for the bytes of some pieces.  Bytes are only ever appended, up
+// to 'size', so a piece never sees its bytes change.  Every piece that
+// refers to a block, and the rope appending to it, holds a reference.
+typedef struct
+{
+    size_t refs;
+    size_t size;
+    size_t used;
+    uint8_t data[];
+}
+rope_block_t;
+
+// A piece of the contents, as a node of the treap.  Nodes are ordered by
+// position, and heap-ordered by a random priority, which keeps the tree
+// balanced whatever the order of edits.
+typedef struct rope_node_t
+{
+    struct rope_node_t * left;
+    struct rope_node_t * right;
+
+    // The piece: 'length' bytes of 'block' from 'start' on
+    rope_block_t * block;
+    size_t start;
+    size_t length;
+
+    // Bytes in this subtree, this piece included
+    size_t total;
+
+    uint32_t priority;
+}
+rope_node_t;
+
+// rope private implementation data
+typedef struct
+{
+    rope_node_t * root;
+
+    // Block that inserted bytes are appended to, or NULL
+    rope_block_t * add;
+
+    // Number of pieces
+    size_t pieces;
+
+    // xorshift state for node priorities
+    uint64_t seed;
+}
+rope_priv_t;
+
+//------------------------------------------------------------------------|
+static rope_block_t * rope_block_create(size_t size)
+{
+    rope_block_t * block = (rope_block_t *) malloc(sizeof(rope_block_t) + size);
+    if (!block)
+    {
+        BLAMMO(FATAL, "malloc(%zu) failed", sizeof(rope_block_t) + size);
+        return NULL;
+    }
+
+    block->refs = 1;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+//------------------------------------------------------------------------|
+static void rope_block_release(rope_block_t * block)
+{
+    if (block && --block->refs == 0)
+    {
+        free(block);
+    }
+}
+
+//------------------------------------------------------------------------|
+static inline size_t rope_total(const rope_node_t * node)
+{
+    return node ? node->total : 0;
+}
+
+//------------------------------------------------------------------------|
+static inline void rope_update(rope_node_t * node)
+{
+    node->total = rope_total(node->left) + node->length +
+                  rope_total(node->right);
+}
+
+//------------------------------------------------------------------------|
+// Private helper that turns an allocated node into a single piece, taking
+// a reference to its block
+static rope_node_t * rope_node_init(rope_priv_t * priv,
+                                    rope_node_t * node,
+                                    rope_block_t * block,
+                                    size_t start,
+                                    size_t length)
+{
+    // xorshift64
+    priv->seed ^= priv->seed << 13;
+    priv->seed ^= priv->seed >> 7;
+    priv->seed ^= priv->seed << 17;
+
+    node->left = NULL;
+    node->right = NULL;
+    node->block = block;
+    node->start = start;
+    node->length = length;
+    node->total = length;
+    node->priority = (uint32_t) (priv->seed >> 32);
+
+    block->refs++;
+    priv->pieces++;
+    return node;
+}
+
+//------------------------------------------------------------------------|
+static rope_node_t * rope_node_alloc(void)
+{
+    rope_node_t * node = (rope_node_t *) malloc(sizeof(rope_node_t));
+    if (!node)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(rope_node_t)) failed");
+    }
+
+    return node;
+}
+
+//------------------------------------------------------------------------|
+static void rope_free_tree(rope_priv_t * priv, rope_node_t * node)
+{
+    while (node)
+    {
+        rope_node_t * right = node->right;
+
+        rope_free_tree(priv, node->left);
+        rope_block_release(node->block);
+        free(node);
+        priv->pieces--;
+        node = right;
+    }
+}
+
+//------------------------------------------------------------------------|
+// Private helper that joins two trees, every piece of 'left' coming before
+// every piece of 'right'
+static rope_node_t * rope_merge(rope_node_t * left, rope_node_t * right)
+{
+    if (!left)
+    {
+        return right;
+    }
+    else if (!right)
+    {
+        return left;
+    }
+    else if (left->priority >= right->priority)
+    {
+        left->right = rope_merge(left->right, right);
+        rope_update(left);
+        return left;
+    }
+
+    right->left = rope_merge(left, right->left);
+    rope_update(right);
+    return right;
+}
+
+//------------------------------------------------------------------------|
+// Private helper that divides a tree in two at 'pos', which must fall
+// between pieces
+static void rope_divide(rope_node_t * node,
+                        size_t pos,
+                        rope_node_t ** left,
+                        rope_node_t ** right)
+{
+    if (!node)
+    {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+
+    size_t before = rope_total(node->left);
+
+    if (pos <= before)
+    {
+        rope_divide(node->left, pos, left, &node->left);
+        *right = node;
+    }
+    else
+    {
+        rope_divide(node->right, pos - before - node->length,
+                    &node->right, right);
+        *left = node;
+    }
+
+    rope_update(node);
+}
+
+//------------------------------------------------------------------------|
+// Private helper that cuts the piece that 'pos' falls inside of, if any,
+// so that a piece ends there.  The piece keeps its bytes up to 'pos', and
+// the rest are described in 'tail' and taken out of the tree, for the
+// caller to put back.  Returns false if 'pos' is already between pieces.
+static bool rope_cut(rope_node_t * node, size_t pos, rope_node_t * tail)
+{
+    bool cut;
+
+    if (!node)
+    {
+        return false;
+    }
+
+    size_t before = rope_total(node->left);
+
+    if (pos < before)
+    {
+        cut = rope_cut(node->left, pos, tail);
+    }
+    else if (pos - before >= node->length)
+    {
+        cut = rope_cut(node->right, pos - before - node->length, tail);
+    }
+    else if (pos == before)
+    {
+        return false;
+    }
+    else
+    {
+        tail->block = node->block;
+        tail->start = node->start + pos - before;
+        tail->length = node->length - (pos - before);
+        node->length = pos - before;
+        cut = true;
+    }
+
+    if (cut)
+    {
+        node->total -= tail->length;
+    }
+
+    return cut;
+}
+
+//------------------------------------------------------------------------|
+// Private helper that splits a tree in two at any 'pos'.  Cutting a piece
+// in two takes a node, which the caller allocates beforehand in 'spare',
+// so that this cannot fail partway.  The spare is set to NULL if used.
+static void rope_split(rope_priv_t * priv,
+                       rope_node_t * node,
+                       size_t pos,
+                       rope_node_t ** spare,
+                       rope_node_t ** left,
+                       rope_node_t ** right)
+{
+    rope_node_t * tail = *spare;
+
+    if (!rope_cut(node, pos, tail))
+    {
+        rope_divide(node, pos, left, right);
+        return;
+    }
+
+    // The tail goes back in as a piece of its own, with its own priority
+    *spare = NULL;
+    rope_node_init(priv, tail, tail->block, tail->start, tail->length);
+    rope_divide(node, pos, left, right);
+    *right = rope_merge(tail, *right);
+}
+
+//------------------------------------------------------------------------|
+// Private helper that tries to insert by extending the piece that ends at
+// 'pos', which works when it is the last piece added to the current add
+// block, as when typing, and the block has room.  Returns false, having
+// changed nothing, if it doesn't.
+static bool rope_extend(rope_priv_t * priv,
+                        rope_node_t * node,
+                        size_t pos,
+                        const void * data,
+                        size_t size)
+{
+    bool extended;
+
+    if (!node)
+    {
+        return false;
+    }
+
+    size_t before = rope_total(node->left);
+
+    if (pos <= before)
+    {
+        extended = rope_extend(priv, node->left, pos, data, size);
+    }
+    else if (pos > before + node->length)
+    {
+        extended = rope_extend(priv, node->right, pos - before - node->length,
+                               data, size);
+    }
+    else if (pos < before + node->length ||
+             node->block != priv->add ||
+             node->start + node->length != priv->add->used ||
+             priv->add->size - priv->add->used < size)
+    {
+        return false;
+    }
+    else
+    {
+        memcpy(priv->add->data + priv->add->used, data, size);
+        priv->add->used += size;
+        node->length += size;
+        extended = true;
+    }
+
+    if (extended)
+    {
+        node->total += size;
+    }
+
+    return extended;
+}
+
+//------------------------------------------------------------------------|
+// Callback for each piece from rope_range(): 'some' bytes of the piece in
+// 'node', from 'skip' bytes into it
+typedef bool (*rope_piece_f)(void * object,
+                             const rope_node_t * node,
+                             size_t skip,
+                             size_t some);
+
+//------------------------------------------------------------------------|
+// Private helper that passes the pieces of a subtree within [offset,
+// offset + count), which must be within it, to 'piece' in order
+static bool rope_range(const rope_node_t * node,
+                       size_t offset,
+                       size_t count,
+                       rope_piece_f piece,
+                       void * object)
+{
+    while (node && count > 0)
+    {
+        size_t before = rope_total(node->left);
+
+        if (offset < before)
+        {
+            size_t some = before - offset < count ? before - offset : count;
+
+            if (!rope_range(node->left, offset, some, piece, object))
+            {
+                return false;
+            }
+
+            count -= some;
+            offset = before;
+        }
+
+        if (count > 0 && offset < before + node->length)
+        {
+            size_t skip = offset - before;
+            size_t some = node->length - skip < count ? node->length - skip
+                                                      : count;
+
+            if (!piece(object, node, skip, some))
+            {
+                return false;
+            }
+
+            count -= some;
+            offset += some;
+        }
+
+        // Continue into the right subtree
+        offset -= before + node->length;
+        node = node->right;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// rope_range() callback for read_at(), copying out to a moving pointer
+static bool rope_copy_piece(void * object,
+                            const rope_node_t * node,
+                            size_t skip,
+                            size_t some)
+{
+    uint8_t ** data = (uint8_t **) object;
+
+    memcpy(*data, node->block->data + node->start + skip, some);
+    *data += some;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Caller's callback and context for walk()
+typedef struct
+{
+    rope_visit_f visit;
+    void * object;
+}
+rope_walk_t;
+
+// rope_range() callback for walk()
+static bool rope_walk_piece(void * object,
+                            const rope_node_t * node,
+                            size_t skip,
+                            size_t some)
+{
+    rope_walk_t * walk = (rope_walk_t *) object;
+
+    return walk->visit(walk->object, node->block->data + node->start + skip,
+                       some);
+}
+
+//------------------------------------------------------------------------|
+// rope_range() callback for slice(), appending a piece sharing the block
+// to the new rope
+static bool rope_slice_piece(void * object,
+                             const rope_node_t * node,
+                             size_t skip,
+                             size_t some)
+{
+    rope_priv_t * priv = (rope_priv_t *) object;
+    rope_node_t * piece = rope_node_alloc();
+
+    if (!piece)
+    {
+        return false;
+    }
+
+    rope_node_init(priv, piece, node->block, node->start + skip, some);
+    priv->root = rope_merge(priv->root, piece);
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Private helper for flatten()
+static bool rope_append_piece(void * object, const uint8_t * data, size_t size)
+{
+    bytes_t * bytes = (bytes_t *) object;
+
+    bytes->append(bytes, data, size);
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static rope_t * rope_create(const void * data, size_t size)
+{
+    rope_t * rope = (rope_t *) malloc(sizeof(rope_t));
+    if (!rope)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(rope_t)) failed");
+        return NULL;
+    }
+
+    memcpy(rope, &rope_pub, sizeof(rope_t));
+
+    rope_priv_t * priv = (rope_priv_t *) malloc(sizeof(rope_priv_t));
+    if (!priv)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(rope_priv_t)) failed");
+        free(rope);
+        return NULL;
+    }
+
+    memzero(priv, sizeof(rope_priv_t));
+    rope->priv = priv;
+    priv->seed = 0x9E3779B97F4A7C15ULL;
+
+    if (data && size > 0)
+    {
+        rope_block_t * block = rope_block_create(size);
+        rope_node_t * node = rope_node_alloc();
+
+        if (!block || !node)
+        {
+            free(block);
+            free(node);
+            rope->destroy(rope);
+            return NULL;
+        }
+
+        memcpy(block->data, data, size);
+        block->used = size;
+        priv->root = rope_node_init(priv, node, block, 0, size);
+
+        // The piece holds the only reference
+        rope_block_release(block);
+    }
+
+    return rope;
+}
+
+//------------------------------------------------------------------------|
+static void rope_destroy(void * rope_ptr)
+{
+    rope_t * rope = (rope_t *) rope_ptr;
+
+    // guard against accidental double-destroy or early-destroy
+    if (!rope || !rope->priv)
+    {
+        BLAMMO(WARNING, "attempt to early or double-destroy");
+        return;
+    }
+
+    rope_priv_t * priv = (rope_priv_t *) rope->priv;
+
+    rope_free_tree(priv, priv->root);
+    rope_block_release(priv->add);
+
+    // zero out and destroy the private data
+    memzero(rope->priv, sizeof(rope_priv_t));
+    free(rope->priv);
+
+    // zero out and destroy the public interface
+    memzero(rope, sizeof(rope_t));
+    free(rope);
+}
+
+//------------------------------------------------------------------------|
+static size_t rope_size(const rope_t * rope)
+{
+    return rope_total(((rope_priv_t *) rope->priv)->root);
+}
+
+//------------------------------------------------------------------------|
+static size_t rope_pieces(const rope_t * rope)
+{
+    return ((rope_priv_t *) rope->priv)->pieces;
+}
+
+//------------------------------------------------------------------------|
+static ssize_t rope_insert(rope_t * rope,
+                           size_t offset,
+                           const void * data,
+                           size_t size)
+{
+    rope_priv_t * priv = (rope_priv_t *) rope->priv;
+    size_t total = rope_total(priv->root);
+
+    if (offset > total)
+    {
+        BLAMMO(ERROR, "offset %zu is after data size %zu", offset, total);
+        return -1;
+    }
+    else if (size == 0)
+    {
+        return (ssize_t) total;
+    }
+    else if (offset > 0 && rope_extend(priv, priv->root, offset, data, size))
+    {
+        return (ssize_t) (total + size);
+    }
+
+    rope_node_t * piece = rope_node_alloc();
+    rope_node_t * spare = rope_node_alloc();
+    rope_node_t * left;
+    rope_node_t * right;
+
+    if (!piece || !spare)
+    {
+        free(piece);
+        free(spare);
+        return -1;
+    }
+
+    // Start a new add block if this doesn't fit in the current one
+    if (!priv->add || priv->add->size - priv->add->used < size)
+    {
+        rope_block_t * block = rope_block_create(size > ROPE_BLOCK_SIZE ?
+                                                 size : ROPE_BLOCK_SIZE);
+        if (!block)
+        {
+            free(piece);
+            free(spare);
+            return -1;
+        }
+
+        rope_block_release(priv->add);
+        priv->add = block;
+    }
+
+    memcpy(priv->add->data + priv->add->used, data, size);
+    rope_node_init(priv, piece, priv->add, priv->add->used, size);
+    priv->add->used += size;
+
+    rope_split(priv, priv->root, offset, &spare, &left, &right);
+    priv->root = rope_merge(rope_merge(left, piece), right);
+
+    free(spare);
+    return (ssize_t) (total + size);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t rope_remove(rope_t * rope, size_t begin, size_t size)
+{
+    rope_priv_t * priv = (rope_priv_t *) rope->priv;
+    size_t total = rope_total(priv->root);
+
+    if (begin > total || size > total - begin)
+    {
+        BLAMMO(ERROR, "begin %zu + size %zu is after data size %zu",
+                      begin, size, total);
+        return -1;
+    }
+    else if (size == 0)
+    {
+        return (ssize_t) total;
+    }
+
+    rope_node_t * spares[2] = { rope_node_alloc(), rope_node_alloc() };
+    rope_node_t * left;
+    rope_node_t * middle;
+    rope_node_t * right;
+
+    if (!spares[0] || !spares[1])
+    {
+        free(spares[0]);
+        free(spares[1]);
+        return -1;
+    }
+
+    rope_split(priv, priv->root, begin, &spares[0], &left, &middle);
+    rope_split(priv, middle, size, &spares[1], &middle, &right);
+    rope_free_tree(priv, middle);
+    priv->root = rope_merge(left, right);
+
+    free(spares[0]);
+    free(spares[1]);
+    return (ssize_t) (total - size);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t rope_read_at(const rope_t * rope,
+                            void * data,
+                            size_t count,
+                            size_t offset)
+{
+    rope_priv_t * priv = (rope_priv_t *) rope->priv;
+    size_t total = rope_total(priv->root);
+
+    if (offset > total || count > total - offset)
+    {
+        BLAMMO(ERROR, "offset %zu + count %zu is out of bounds for size %zu",
+                      offset, count, total);
+        return -1;
+    }
+
+    uint8_t * out = (uint8_t *) data;
+
+    rope_range(priv->root, offset, count, rope_copy_piece, &out);
+    return (ssize_t) count;
+}
+
+//------------------------------------------------------------------------|
+static rope_t * rope_slice(const rope_t * rope, size_t offset, size_t size)
+{
+    rope_priv_t * priv = (rope_priv_t *) rope->priv;
+    size_t total = rope_total(priv->root);
+
+    if (offset > total || size > total - offset)
+    {
+        BLAMMO(ERROR, "offset %zu + size %zu is out of bounds for size %zu",
+                      offset, size, total);
+        return NULL;
+    }
+
+    rope_t * slice = rope_create(NULL, 0);
+    if (!slice)
+    {
+        return NULL;
+    }
+
+    if (!rope_range(priv->root, offset, size, rope_slice_piece, slice->priv))
+    {
+        slice->destroy(slice);
+        return NULL;
+    }
+
+    return slice;
+}
+
+//------------------------------------------------------------------------|
+static bytes_t * rope_flatten(const rope_t * rope)
+{
+    rope_priv_t * priv = (rope_priv_t *) rope->priv;
+    bytes_t * bytes = bytes_pub.create(NULL, 0);
+
+    if (!bytes)
+    {
+        return NULL;
+    }
+    else if (!bytes->reserve(bytes, rope_total(priv->root)))
+    {
+        bytes->destroy(bytes);
+        return NULL;
+    }
+
+    rope->walk(rope, rope_append_piece, bytes);
+    return bytes;
+}
+
+//------------------------------------------------------------------------|
+static bool rope_walk(const rope_t * rope, rope_visit_f visit, void * object)
+{
+    rope_priv_t * priv = (rope_priv_t *) rope->priv;
+    rope_walk_t walk = { visit, object };
+
+    return rope_range(priv->root, 0, rope_total(priv->root),
+                      rope_walk_piece, &walk);
+}
+
+//------------------------------------------------------------------------|
+const rope_t rope_pub = {
+    &rope_create,
+    &rope_destroy,
+    &rope_size,
+    &rope_pieces,
+    &rope_insert,
+    &rope_remove,
+    &rope_read_at,
+    &rope_slice,
+    &rope_flatten,
+    &rope_walk,
+    NULL
+};
@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <sys/types.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "bytes.h"
+
+//------------------------------------------------------------------------|
+// Editable text for large buffers.  Where bytes_t keeps its contents in
+// one contiguous array, so that an insert or remove moves everything
+// after it, a rope keeps a piece table: a sequence of pieces, each a run
+// of bytes in some block of storage.  Blocks are never written over.  The
+// original contents are one block, and inserted bytes are appended to
+// another, so an edit only adds or splits pieces and never moves text.
+//
+// The pieces are kept in a balanced tree (a treap) ordered by position,
+// each node counting the bytes below it, so that insert(), remove() and
+// read_at() find their offset in O(log n) of the number of pieces.
+// Typing at one spot extends the piece it last added rather than adding
+// a piece per insert.  Blocks are shared by reference count, so slice()
+// copies pieces but never bytes.  A rope, and those sliced from it, must
+// not be used from several threads at once.
+
+//------------------------------------------------------------------------|
+// Callback for each run of contiguous bytes, from walk().  Return false
+// to stop.
+typedef bool (*rope_visit_f)(void * object, const uint8_t * data, size_t size);
+
+//------------------------------------------------------------------------|
+typedef struct rope_t
+{
+    // Rope factory function.  The initial contents are copied.  'data'
+    // may be NULL for an empty rope.
+    struct rope_t * (*create)(const void * data, size_t size);
+
+    // Rope destructor function
+    void (*destroy)(void * rope);
+
+    // Get the rope's current length
+    size_t (*size)(const struct rope_t * rope);
+
+    // Number of pieces the contents are split into, a measure of how
+    // fragmented edits have left it
+    size_t (*pieces)(const struct rope_t * rope);
+
+    // Insert new data at an arbitrary offset, no further than the end.
+    // Returns new size or else negative if error occurs.
+    ssize_t (*insert)(struct rope_t * rope,
+                      size_t offset,
+                      const void * data,
+                      size_t size);
+
+    // Remove an arbitrary chunk of data.  Returns new size or else
+    // negative if error occurs.
+    ssize_t (*remove)(struct rope_t * rope, size_t begin, size_t size);
+
+    // Analogous to pread(), this will read 'count' bytes from an offset,
+    // all of which must be in bounds.  Return value is number of bytes
+    // read or negative if an error occurred.
+    ssize_t (*read_at)(const struct rope_t * rope,
+                       void * data,
+                       size_t count,
+                       size_t offset);
+
+    // Create a new rope holding 'size' bytes from 'offset' on, sharing
+    // storage with this one, so that it costs O(log n) plus the number
+    // of pieces in the range.  The two can be edited independently.
+    // Returns NULL if the range is out of bounds or memory could not be
+    // allocated.
+    struct rope_t * (*slice)(const struct rope_t * rope,
+                             size_t offset,
+                             size_t size);
+
+    // Copy the contents into a new contiguous bytes_t, for code that
+    // needs them in one piece.  Caller is responsible for destroying it.
+    bytes_t * (*flatten)(const struct rope_t * rope);
+
+    // Pass the contents to 'visit' in order, one piece at a time, without
+    // copying them.  Returns false if 'visit' stopped the walk.
+    bool (*walk)(const struct rope_t * rope, rope_visit_f visit, void * object);
+
+    // Private data
+    void * priv;
+}
+rope_t;
+
+//------------------------------------------------------------------------|
+extern const rope_t rope_pub;
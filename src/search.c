@@ -0,0 +1,1411 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#define _GNU_SOURCE             // memrchr()
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SEARCH_X86
+#endif
+
+#include "search.h"
+#include "utils.h"
+#include "blammo.h"
+
+//------------------------------------------------------------------------|
+// The filter gives up on Two-Way once false candidates outnumber what it
+// is allowed, given how many haystack positions it has covered.  Each
+// false candidate costs up to a needle's worth of comparisons, so this
+// keeps the total linear in the haystack size.
+#define SEARCH_TOO_MANY(misses, covered, n) \
+    ((misses) > 64 && ((misses) - 64) * MAX((size_t) 16, (n)) > (covered))
+
+// Returned by the filter kernels when giving up
+#define SEARCH_GAVE_UP              (-2)
+
+//------------------------------------------------------------------------|
+// Filter kernels.  Each takes a needle of at least 2 bytes, and a haystack
+// at least as long.  Candidates are positions where the first needle byte
+// and the one at 'pair' both match, and only those are compared in full.
+// Returns the offset of the first (or last) match, -1 for none, or
+// SEARCH_GAVE_UP.  When giving up, 'resume' is set to what is left to
+// search: the offset to continue from going forward, or the length of the
+// prefix still to be searched going in reverse.
+typedef ssize_t (*search_kernel_f)(const uint8_t * haystack,
+                                   size_t size,
+                                   const uint8_t * needle,
+                                   size_t needle_size,
+                                   size_t pair,
+                                   size_t * resume);
+
+// Number of times a byte occurs in a buffer
+typedef size_t (*search_count_f)(const uint8_t * haystack,
+                                 size_t size,
+                                 uint8_t c);
+
+// Length of the initial run of bytes that are in the set, if 'in' is
+// true, or that are not
+typedef size_t (*search_skip_f)(const uint8_t * data,
+                                size_t size,
+                                const search_set_t * set,
+                                bool in);
+
+typedef struct
+{
+    cpu_kernel_t base;
+    search_kernel_f forward;
+    search_kernel_f reverse;
+    search_count_f count;
+    search_skip_f skip;
+}
+search_kernel_t;
+
+// Two-Way preprocessing of a needle, read either forward or backward.
+// See Crochemore and Perrin, "Two-way string-matching" (1991).
+typedef struct
+{
+    // Critical factorization: the right half starts at split + 1, where
+    // split may be SIZE_MAX (the right half being the whole needle)
+    size_t split;
+
+    // Shift after a full match, and the prefix length known to match
+    // again after that shift (non-zero only for periodic needles)
+    size_t period;
+    size_t memory;
+
+    // For each byte in the needle, one past its last position, for
+    // skipping on the byte at the end of the window
+    uint64_t byteset[4];
+    size_t shift[256];
+}
+search_twoway_t;
+
+//------------------------------------------------------------------------|
+// The needle byte to pair with the first one in the filter: the last one
+// that differs from it, if any.  Pairing two different bytes means that
+// long runs of one byte in the haystack produce no candidates.
+static inline size_t search_pair(const uint8_t * needle, size_t needle_size)
+{
+    size_t pair = needle_size - 1;
+
+    while (pair > 1 && needle[pair] == needle[0])
+    {
+        pair--;
+    }
+
+    return needle[pair] == needle[0] ? needle_size - 1 : pair;
+}
+
+//------------------------------------------------------------------------|
+// Whether the rest of a candidate (all but the first byte, which the
+// caller already matched) matches
+static inline bool search_rest(const uint8_t * candidate,
+                               const uint8_t * needle,
+                               size_t needle_size)
+{
+    return !memcmp(candidate + 1, needle + 1, needle_size - 1);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t search_forward_scalar(const uint8_t * haystack,
+                                     size_t size,
+                                     const uint8_t * needle,
+                                     size_t needle_size,
+                                     size_t pair,
+                                     size_t * resume)
+{
+    const uint8_t second = needle[pair];
+    const size_t end = size - needle_size + 1;
+    size_t misses = 0;
+    size_t i = 0;
+
+    while (i < end)
+    {
+        const uint8_t * p = memchr(haystack + i, needle[0], end - i);
+        if (!p)
+        {
+            return -1;
+        }
+
+        i = p - haystack;
+        if (p[pair] == second && search_rest(p, needle, needle_size))
+        {
+            return i;
+        }
+
+        i++;
+        misses++;
+        if (SEARCH_TOO_MANY(misses, i, needle_size))
+        {
+            *resume = i;
+            return SEARCH_GAVE_UP;
+        }
+    }
+
+    return -1;
+}
+
+//------------------------------------------------------------------------|
+static ssize_t search_reverse_scalar(const uint8_t * haystack,
+                                     size_t size,
+                                     const uint8_t * needle,
+                                     size_t needle_size,
+                                     size_t pair,
+                                     size_t * resume)
+{
+    const uint8_t second = needle[pair];
+    const size_t positions = size - needle_size + 1;
+    size_t misses = 0;
+    size_t end = positions;
+
+    while (end > 0)
+    {
+        const uint8_t * p = memrchr(haystack, needle[0], end);
+        if (!p)
+        {
+            return -1;
+        }
+
+        end = p - haystack;
+        if (p[pair] == second && search_rest(p, needle, needle_size))
+        {
+            return end;
+        }
+
+        misses++;
+        if (SEARCH_TOO_MANY(misses, positions - end, needle_size))
+        {
+            *resume = end + needle_size - 1;
+            return SEARCH_GAVE_UP;
+        }
+    }
+
+    return -1;
+}
+
+//------------------------------------------------------------------------|
+static size_t search_count_scalar(const uint8_t * haystack,
+                                  size_t size,
+                                  uint8_t c)
+{
+    size_t count = 0;
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        count += haystack[i] == c;
+    }
+
+    return count;
+}
+
+//------------------------------------------------------------------------|
+static size_t search_skip_scalar(const uint8_t * data,
+                                 size_t size,
+                                 const search_set_t * set,
+                                 bool in)
+{
+    size_t i = 0;
+
+    while (i < size && (set->member[data[i]] != 0) == in)
+    {
+        i++;
+    }
+
+    return i;
+}
+
+//------------------------------------------------------------------------|
+#if defined(SEARCH_X86)
+__attribute__((target("sse2")))
+static size_t search_count_sse2(const uint8_t * haystack,
+                                size_t size,
+                                uint8_t c)
+{
+    const __m128i match = _mm_set1_epi8((char) c);
+    const __m128i zero = _mm_setzero_si128();
+    size_t count = 0;
+    size_t i = 0;
+
+    // Per-lane byte counters, each matching lane subtracting -1, are
+    // summed up before they can wrap
+    while (i + 16 <= size)
+    {
+        __m128i counters = zero;
+        size_t rounds = MIN((size - i) / 16, (size_t) 255);
+        size_t r;
+
+        for (r = 0; r < rounds; r++, i += 16)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i *) (haystack + i));
+            counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(a, match));
+        }
+
+        uint64_t sums[2];
+        _mm_storeu_si128((__m128i *) sums, _mm_sad_epu8(counters, zero));
+        count += (size_t) (sums[0] + sums[1]);
+    }
+
+    return count + search_count_scalar(haystack + i, size - i, c);
+}
+
+//------------------------------------------------------------------------|
+__attribute__((target("avx2")))
+static size_t search_count_avx2(const uint8_t * haystack,
+                                size_t size,
+                                uint8_t c)
+{
+    const __m256i match = _mm256_set1_epi8((char) c);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t count = 0;
+    size_t i = 0;
+
+    while (i + 32 <= size)
+    {
+        __m256i counters = zero;
+        size_t rounds = MIN((size - i) / 32, (size_t) 255);
+        size_t r;
+
+        for (r = 0; r < rounds; r++, i += 32)
+        {
+            __m256i a = _mm256_loadu_si256((const __m256i *) (haystack + i));
+            counters = _mm256_sub_epi8(counters,
+                                       _mm256_cmpeq_epi8(a, match));
+        }
+
+        uint64_t sums[4];
+        _mm256_storeu_si256((__m256i *) sums,
+                            _mm256_sad_epu8(counters, zero));
+        count += (size_t) (sums[0] + sums[1] + sums[2] + sums[3]);
+    }
+
+    return count + search_count_sse2(haystack + i, size - i, c);
+}
+
+//------------------------------------------------------------------------|
+// Each block is compared against every byte of the set, and the first
+// lane that is in the set (or out of it, with the mask flipped) ends the
+// run
+__attribute__((target("sse2")))
+static size_t search_skip_sse2(const uint8_t * data,
+                               size_t size,
+                               const search_set_t * set,
+                               bool in)
+{
+    const uint32_t flip = in ? 0xffff : 0;
+    __m128i members[SEARCH_SET_VECTOR];
+    size_t i = 0;
+    size_t k;
+
+    if (set->count > SEARCH_SET_VECTOR)
+    {
+        return search_skip_scalar(data, size, set, in);
+    }
+
+    for (k = 0; k < set->count; k++)
+    {
+        members[k] = _mm_set1_epi8((char) set->bytes[k]);
+    }
+
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *) (data + i));
+        __m128i hits = _mm_setzero_si128();
+
+        for (k = 0; k < set->count; k++)
+        {
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(a, members[k]));
+        }
+
+        uint32_t mask = (uint32_t) _mm_movemask_epi8(hits) ^ flip;
+        if (mask)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return i + search_skip_scalar(data + i, size - i, set, in);
+}
+
+//------------------------------------------------------------------------|
+__attribute__((target("avx2")))
+static size_t search_skip_avx2(const uint8_t * data,
+                               size_t size,
+                               const search_set_t * set,
+                               bool in)
+{
+    const uint32_t flip = in ? 0xffffffff : 0;
+    __m256i members[SEARCH_SET_VECTOR];
+    size_t i = 0;
+    size_t k;
+
+    if (set->count > SEARCH_SET_VECTOR)
+    {
+        return search_skip_scalar(data, size, set, in);
+    }
+
+    for (k = 0; k < set->count; k++)
+    {
+        members[k] = _mm256_set1_epi8((char) set->bytes[k]);
+    }
+
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (data + i));
+        __m256i hits = _mm256_setzero_si256();
+
+        for (k = 0; k < set->count; k++)
+        {
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(a, members[k]));
+        }
+
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(hits) ^ flip;
+        if (mask)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return i + search_skip_sse2(data + i, size - i, set, in);
+}
+
+//------------------------------------------------------------------------|
+__attribute__((target("sse2")))
+static ssize_t search_forward_sse2(const uint8_t * haystack,
+                                   size_t size,
+                                   const uint8_t * needle,
+                                   size_t needle_size,
+                                   size_t pair,
+                                   size_t * resume)
+{
+    const __m128i first = _mm_set1_epi8((char) needle[0]);
+    const __m128i second = _mm_set1_epi8((char) needle[pair]);
+    const size_t end = size - needle_size + 1;
+    size_t misses = 0;
+    size_t i = 0;
+    ssize_t found;
+
+    // Each round tests the 16 positions from i on
+    for (; i + 16 <= end; i += 16)
+    {
+        const uint8_t * p = haystack + i;
+        __m128i a = _mm_loadu_si128((const __m128i *) p);
+        __m128i b = _mm_loadu_si128((const __m128i *) (p + pair));
+        uint32_t mask = _mm_movemask_epi8(
+                            _mm_and_si128(_mm_cmpeq_epi8(a, first),
+                                          _mm_cmpeq_epi8(b, second)));
+
+        while (mask)
+        {
+            size_t j = __builtin_ctz(mask);
+            if (search_rest(p + j, needle, needle_size))
+            {
+                return i + j;
+            }
+
+            misses++;
+            mask &= mask - 1;
+        }
+
+        if (SEARCH_TOO_MANY(misses, i + 16, needle_size))
+        {
+            *resume = i + 16;
+            return SEARCH_GAVE_UP;
+        }
+    }
+
+    // Fewer than 16 positions left
+    found = search_forward_scalar(haystack + i, size - i,
+                                  needle, needle_size, pair, resume);
+    if (found >= 0)
+    {
+        return found + i;
+    }
+
+    if (found == SEARCH_GAVE_UP)
+    {
+        *resume += i;
+    }
+
+    return found;
+}
+
+//------------------------------------------------------------------------|
+__attribute__((target("sse2")))
+static ssize_t search_reverse_sse2(const uint8_t * haystack,
+                                   size_t size,
+                                   const uint8_t * needle,
+                                   size_t needle_size,
+                                   size_t pair,
+                                   size_t * resume)
+{
+    const __m128i first = _mm_set1_epi8((char) needle[0]);
+    const __m128i second = _mm_set1_epi8((char) needle[pair]);
+    const size_t positions = size - needle_size + 1;
+    size_t misses = 0;
+    size_t end = positions;
+
+    // Each round tests the 16 positions just below end
+    while (end >= 16)
+    {
+        const uint8_t * p = haystack + end - 16;
+        __m128i a = _mm_loadu_si128((const __m128i *) p);
+        __m128i b = _mm_loadu_si128((const __m128i *) (p + pair));
+        uint32_t mask = _mm_movemask_epi8(
+                            _mm_and_si128(_mm_cmpeq_epi8(a, first),
+                                          _mm_cmpeq_epi8(b, second)));
+
+        while (mask)
+        {
+            size_t j = 31 - __builtin_clz(mask);
+            if (search_rest(p + j, needle, needle_size))
+            {
+                return end - 16 + j;
+            }
+
+            misses++;
+            mask &= ~(1U << j);
+        }
+
+        end -= 16;
+        if (SEARCH_TOO_MANY(misses, positions - end, needle_size))
+        {
+            *resume = end + needle_size - 1;
+            return SEARCH_GAVE_UP;
+        }
+    }
+
+    // Fewer than 16 positions left
+    if (end == 0)
+    {
+        return -1;
+    }
+
+    return search_reverse_scalar(haystack, end + needle_size - 1,
+                                 needle, needle_size, pair, resume);
+}
+
+//------------------------------------------------------------------------|
+__attribute__((target("avx2")))
+static ssize_t search_forward_avx2(const uint8_t * haystack,
+                                   size_t size,
+                                   const uint8_t * needle,
+                                   size_t needle_size,
+                                   size_t pair,
+                                   size_t * resume)
+{
+    const __m256i first = _mm256_set1_epi8((char) needle[0]);
+    const __m256i second = _mm256_set1_epi8((char) needle[pair]);
+    const size_t end = size - needle_size + 1;
+    size_t misses = 0;
+    size_t i = 0;
+    ssize_t found;
+
+    // Each round tests the 32 positions from i on
+    for (; i + 32 <= end; i += 32)
+    {
+        const uint8_t * p = haystack + i;
+        __m256i a = _mm256_loadu_si256((const __m256i *) p);
+        __m256i b = _mm256_loadu_si256((const __m256i *) (p + pair));
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(
+                            _mm256_and_si256(_mm256_cmpeq_epi8(a, first),
+                                             _mm256_cmpeq_epi8(b, second)));
+
+        while (mask)
+        {
+            size_t j = __builtin_ctz(mask);
+            if (search_rest(p + j, needle, needle_size))
+            {
+                return i + j;
+            }
+
+            misses++;
+            mask &= mask - 1;
+        }
+
+        if (SEARCH_TOO_MANY(misses, i + 32, needle_size))
+        {
+            *resume = i + 32;
+            return SEARCH_GAVE_UP;
+        }
+    }
+
+    // Fewer than 32 positions left
+    found = search_forward_sse2(haystack + i, size - i,
+                                needle, needle_size, pair, resume);
+    if (found >= 0)
+    {
+        return found + i;
+    }
+
+    if (found == SEARCH_GAVE_UP)
+    {
+        *resume += i;
+    }
+
+    return found;
+}
+
+//------------------------------------------------------------------------|
+__attribute__((target("avx2")))
+static ssize_t search_reverse_avx2(const uint8_t * haystack,
+                                   size_t size,
+                                   const uint8_t * needle,
+                                   size_t needle_size,
+                                   size_t pair,
+                                   size_t * resume)
+{
+    const __m256i first = _mm256_set1_epi8((char) needle[0]);
+    const __m256i second = _mm256_set1_epi8((char) needle[pair]);
+    const size_t positions = size - needle_size + 1;
+    size_t misses = 0;
+    size_t end = positions;
+
+    // Each round tests the 32 positions just below end
+    while (end >= 32)
+    {
+        const uint8_t * p = haystack + end - 32;
+        __m256i a = _mm256_loadu_si256((const __m256i *) p);
+        __m256i b = _mm256_loadu_si256((const __m256i *) (p + pair));
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(
+                            _mm256_and_si256(_mm256_cmpeq_epi8(a, first),
+                                             _mm256_cmpeq_epi8(b, second)));
+
+        while (mask)
+        {
+            size_t j = 31 - __builtin_clz(mask);
+            if (search_rest(p + j, needle, needle_size))
+            {
+                return end - 32 + j;
+            }
+
+            misses++;
+            mask &= ~(1U << j);
+        }
+
+        end -= 32;
+        if (SEARCH_TOO_MANY(misses, positions - end, needle_size))
+        {
+            *resume = end + needle_size - 1;
+            return SEARCH_GAVE_UP;
+        }
+    }
+
+    // Fewer than 32 positions left
+    if (end == 0)
+    {
+        return -1;
+    }
+
+    return search_reverse_sse2(haystack, end + needle_size - 1,
+                               needle, needle_size, pair, resume);
+}
+#endif
+
+//------------------------------------------------------------------------|
+static const search_kernel_t search_kernels[] = {
+    { { CPU_PATH_SCALAR, "scalar" },
+      &search_forward_scalar, &search_reverse_scalar, &search_count_scalar,
+      &search_skip_scalar },
+#if defined(SEARCH_X86)
+    { { CPU_PATH_SSE2, "sse2" },
+      &search_forward_sse2, &search_reverse_sse2, &search_count_sse2,
+      &search_skip_sse2 },
+    { { CPU_PATH_AVX2, "avx2" },
+      &search_forward_avx2, &search_reverse_avx2, &search_count_avx2,
+      &search_skip_avx2 },
+#endif
+};
+
+#define SEARCH_KERNELS (sizeof(search_kernels) / sizeof(search_kernels[0]))
+
+//------------------------------------------------------------------------|
+static const search_kernel_t * search_kernel(cpu_path_t path)
+{
+    static const void * best = NULL;
+
+    return cpu_kernel_select(search_kernels, SEARCH_KERNELS,
+                             sizeof(search_kernel_t), path, &best);
+}
+
+//------------------------------------------------------------------------|
+const char * search_path_name(cpu_path_t path)
+{
+    if (!cpu_path_supported(path))
+    {
+        return "unsupported";
+    }
+
+    return search_kernel(path)->base.name;
+}
+
+//------------------------------------------------------------------------|
+// Byte 'i' of a buffer of 'size' bytes, read forward or backward.  The
+// Two-Way code below runs on these, and is specialized for each direction
+// by being inlined with a constant 'reverse'.
+static inline uint8_t search_at(const uint8_t * data,
+                                size_t size,
+                                size_t i,
+                                bool reverse)
+{
+    return reverse ? data[size - 1 - i] : data[i];
+}
+
+//------------------------------------------------------------------------|
+// Start of the maximal suffix of the needle under one byte ordering or
+// the other (minus one, so possibly SIZE_MAX), and its period
+static inline size_t search_maximal_suffix(const uint8_t * needle,
+                                           size_t size,
+                                           bool reverse,
+                                           bool inverted,
+                                           size_t * period)
+{
+    size_t ip = SIZE_MAX;
+    size_t jp = 0;
+    size_t k = 1;
+    size_t p = 1;
+
+    while (jp + k < size)
+    {
+        uint8_t a = search_at(needle, size, ip + k, reverse);
+        uint8_t b = search_at(needle, size, jp + k, reverse);
+
+        if (a == b)
+        {
+            if (k == p)
+            {
+                jp += p;
+                k = 1;
+            }
+            else
+            {
+                k++;
+            }
+        }
+        else if (inverted ? a < b : a > b)
+        {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        }
+        else
+        {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+
+    *period = p;
+    return ip;
+}
+
+//------------------------------------------------------------------------|
+static inline void search_twoway_prepare(search_twoway_t * twoway,
+                                         const uint8_t * needle,
+                                         size_t size,
+                                         bool reverse)
+{
+    size_t period = 0;
+    size_t other = 0;
+    size_t split;
+    size_t i;
+
+    memset(twoway->byteset, 0, sizeof(twoway->byteset));
+    for (i = 0; i < size; i++)
+    {
+        uint8_t c = search_at(needle, size, i, reverse);
+        twoway->byteset[c >> 6] |= 1ULL << (c & 63);
+        twoway->shift[c] = i + 1;
+    }
+
+    // The critical factorization is the later of the two maximal suffixes
+    split = search_maximal_suffix(needle, size, reverse, false, &period);
+    i = search_maximal_suffix(needle, size, reverse, true, &other);
+    if (i + 1 > split + 1)
+    {
+        split = i;
+        period = other;
+    }
+
+    // Periodic needle?  That is, does the left half recur one period on
+    for (i = 0; i < split + 1; i++)
+    {
+        if (search_at(needle, size, i, reverse) !=
+            search_at(needle, size, i + period, reverse))
+        {
+            break;
+        }
+    }
+
+    twoway->split = split;
+    if (i < split + 1)
+    {
+        twoway->period = MAX(split + 1, size - split - 1) + 1;
+        twoway->memory = 0;
+    }
+    else
+    {
+        twoway->period = period;
+        twoway->memory = size - period;
+    }
+}
+
+//------------------------------------------------------------------------|
+// First match at or after position 'start' of the haystack, read in the
+// given direction, or -1
+static inline ssize_t search_twoway(const search_twoway_t * twoway,
+                                    const uint8_t * haystack,
+                                    size_t size,
+                                    const uint8_t * needle,
+                                    size_t needle_size,
+                                    size_t start,
+                                    bool reverse)
+{
+    const size_t split = twoway->split;
+    size_t h = start;
+    size_t memory = 0;
+    size_t k;
+
+    while (h + needle_size <= size)
+    {
+        // Skip ahead on the last byte of the window unless it lines up
+        // with the last byte of the needle
+        uint8_t c = search_at(haystack, size, h + needle_size - 1, reverse);
+        if (!(twoway->byteset[c >> 6] & (1ULL << (c & 63))))
+        {
+            h += needle_size;
+            memory = 0;
+            continue;
+        }
+
+        k = needle_size - twoway->shift[c];
+        if (k)
+        {
+            h += MAX(k, memory);
+            memory = 0;
+            continue;
+        }
+
+        // Compare the right half, then the left half
+        k = MAX(split + 1, memory);
+        while (k < needle_size)
+        {
+            if (search_at(needle, needle_size, k, reverse) !=
+                search_at(haystack, size, h + k, reverse))
+            {
+                break;
+            }
+
+            k++;
+        }
+
+        if (k < needle_size)
+        {
+            h += k - split;
+            memory = 0;
+            continue;
+        }
+
+        k = split + 1;
+        while (k > memory)
+        {
+            if (search_at(needle, needle_size, k - 1, reverse) !=
+                search_at(haystack, size, h + k - 1, reverse))
+            {
+                break;
+            }
+
+            k--;
+        }
+
+        if (k <= memory)
+        {
+            return (ssize_t) h;
+        }
+
+        h += twoway->period;
+        memory = twoway->memory;
+    }
+
+    return -1;
+}
+
+//------------------------------------------------------------------------|
+// search_forward() with the kernel chosen, and 'twoway' prepared for the
+// needle if available.  Otherwise it is prepared here, if the filter
+// gives up.
+static ssize_t search_forward_with(const uint8_t * haystack,
+                                   size_t size,
+                                   const uint8_t * needle,
+                                   size_t needle_size,
+                                   const search_kernel_t * kernel,
+                                   const search_twoway_t * twoway)
+{
+    search_twoway_t local;
+    size_t start = 0;
+    ssize_t found;
+
+    if (needle_size == 0)
+    {
+        return 0;
+    }
+
+    if (size < needle_size)
+    {
+        return -1;
+    }
+
+    if (needle_size == 1)
+    {
+        const uint8_t * p = memchr(haystack, needle[0], size);
+        return p ? p - haystack : -1;
+    }
+
+    found = kernel->forward(haystack, size, needle, needle_size,
+                            search_pair(needle, needle_size), &start);
+    if (found != SEARCH_GAVE_UP)
+    {
+        return found;
+    }
+
+    if (!twoway)
+    {
+        search_twoway_prepare(&local, needle, needle_size, false);
+        twoway = &local;
+    }
+
+    return search_twoway(twoway, haystack, size, needle, needle_size,
+                         start, false);
+}
+
+//------------------------------------------------------------------------|
+// As above, in reverse
+static ssize_t search_reverse_with(const uint8_t * haystack,
+                                   size_t size,
+                                   const uint8_t * needle,
+                                   size_t needle_size,
+                                   const search_kernel_t * kernel,
+                                   const search_twoway_t * twoway)
+{
+    search_twoway_t local;
+    size_t remaining = size;
+    ssize_t found;
+
+    if (needle_size == 0)
+    {
+        return (ssize_t) size;
+    }
+
+    if (size < needle_size)
+    {
+        return -1;
+    }
+
+    if (needle_size == 1)
+    {
+        const uint8_t * p = memrchr(haystack, needle[0], size);
+        return p ? p - haystack : -1;
+    }
+
+    found = kernel->reverse(haystack, size, needle, needle_size,
+                            search_pair(needle, needle_size), &remaining);
+    if (found != SEARCH_GAVE_UP)
+    {
+        return found;
+    }
+
+    if (!twoway)
+    {
+        search_twoway_prepare(&local, needle, needle_size, true);
+        twoway = &local;
+    }
+
+    // Searching the reversed prefix for the reversed needle
+    found = search_twoway(twoway, haystack, remaining, needle, needle_size,
+                          0, true);
+    if (found < 0)
+    {
+        return found;
+    }
+
+    return (ssize_t) (remaining - needle_size) - found;
+}
+
+//------------------------------------------------------------------------|
+// Append an offset to a caller's array, growing it as needed
+static bool search_record(size_t ** offsets,
+                          size_t * capacity,
+                          size_t count,
+                          size_t offset)
+{
+    if (count == *capacity)
+    {
+        size_t grown = MAX((size_t) 16, *capacity * 2);
+        size_t * array = (size_t *) realloc(*offsets,
+                                            sizeof(size_t) * grown);
+        if (!array)
+        {
+            BLAMMO(FATAL, "realloc(%zu) failed", sizeof(size_t) * grown);
+            return false;
+        }
+
+        *offsets = array;
+        *capacity = grown;
+    }
+
+    (*offsets)[count] = offset;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Every match in one pass, recorded in 'offsets' unless that is NULL.
+// The filter picks up after each match where it left off, and once it
+// gives up, Two-Way takes the rest of the haystack.  Returns the number
+// of matches, or negative if the array could not be grown.
+static ssize_t search_all_with(const uint8_t * haystack,
+                               size_t size,
+                               const uint8_t * needle,
+                               size_t needle_size,
+                               bool overlapping,
+                               const search_kernel_t * kernel,
+                               const search_twoway_t * twoway,
+                               size_t ** offsets,
+                               size_t * capacity)
+{
+    const size_t step = overlapping ? 1 : needle_size;
+    search_twoway_t local;
+    bool filtering = true;
+    size_t pair = 0;
+    size_t count = 0;
+    size_t pos = 0;
+
+    if (needle_size == 0 || size < needle_size)
+    {
+        return 0;
+    }
+
+    // Bytes can simply be counted, without finding each one
+    if (needle_size == 1 && !offsets)
+    {
+        return (ssize_t) kernel->count(haystack, size, needle[0]);
+    }
+
+    if (needle_size > 1)
+    {
+        pair = search_pair(needle, needle_size);
+    }
+
+    while (pos + needle_size <= size)
+    {
+        ssize_t found;
+
+        if (needle_size == 1)
+        {
+            const uint8_t * p = memchr(haystack + pos, needle[0], size - pos);
+            found = p ? p - haystack : -1;
+        }
+        else if (filtering)
+        {
+            size_t resume = 0;
+
+            found = kernel->forward(haystack + pos, size - pos, needle,
+                                    needle_size, pair, &resume);
+            if (found == SEARCH_GAVE_UP)
+            {
+                if (!twoway)
+                {
+                    search_twoway_prepare(&local, needle, needle_size,
+                                          false);
+                    twoway = &local;
+                }
+
+                filtering = false;
+                pos += resume;
+                continue;
+            }
+
+            found = found < 0 ? found : found + (ssize_t) pos;
+        }
+        else
+        {
+            found = search_twoway(twoway, haystack, size, needle,
+                                  needle_size, pos, false);
+        }
+
+        if (found < 0)
+        {
+            break;
+        }
+
+        if (offsets && !search_record(offsets, capacity, count, found))
+        {
+            return -1;
+        }
+
+        count++;
+        pos = (size_t) found + step;
+    }
+
+    return (ssize_t) count;
+}
+
+//------------------------------------------------------------------------|
+ssize_t search_all(const void * haystack,
+                   size_t size,
+                   const void * needle,
+                   size_t needle_size,
+                   bool overlapping,
+                   size_t ** offsets,
+                   size_t * capacity)
+{
+    return search_all_with((const uint8_t *) haystack, size,
+                           (const uint8_t *) needle, needle_size,
+                           overlapping, search_kernel(CPU_PATH_AUTO),
+                           NULL, offsets, capacity);
+}
+
+//------------------------------------------------------------------------|
+size_t search_count(const void * haystack,
+                    size_t size,
+                    const void * needle,
+                    size_t needle_size,
+                    bool overlapping)
+{
+    return (size_t) search_all_with((const uint8_t *) haystack, size,
+                                    (const uint8_t *) needle, needle_size,
+                                    overlapping,
+                                    search_kernel(CPU_PATH_AUTO),
+                                    NULL, NULL, NULL);
+}
+
+//------------------------------------------------------------------------|
+void search_set_init(search_set_t * set, const void * bytes, size_t count)
+{
+    const uint8_t * b = (const uint8_t *) bytes;
+    size_t i;
+
+    memset(set, 0, sizeof(search_set_t));
+    for (i = 0; i < count; i++)
+    {
+        if (!set->member[b[i]])
+        {
+            set->member[b[i]] = 1;
+            if (set->count < SEARCH_SET_VECTOR)
+            {
+                set->bytes[set->count] = b[i];
+            }
+
+            set->count++;
+        }
+    }
+}
+
+//------------------------------------------------------------------------|
+size_t search_span(const void * data, size_t size, const search_set_t * set)
+{
+    return search_kernel(CPU_PATH_AUTO)->skip((const uint8_t *) data,
+                                                 size, set, true);
+}
+
+//------------------------------------------------------------------------|
+size_t search_cspan(const void * data, size_t size, const search_set_t * set)
+{
+    return search_kernel(CPU_PATH_AUTO)->skip((const uint8_t *) data,
+                                                 size, set, false);
+}
+
+//------------------------------------------------------------------------|
+size_t search_span_path(const void * data,
+                        size_t size,
+                        const search_set_t * set,
+                        cpu_path_t path)
+{
+    return search_kernel(path)->skip((const uint8_t *) data, size, set, true);
+}
+
+//------------------------------------------------------------------------|
+size_t search_cspan_path(const void * data,
+                         size_t size,
+                         const search_set_t * set,
+                         cpu_path_t path)
+{
+    return search_kernel(path)->skip((const uint8_t *) data, size, set, false);
+}
+
+//------------------------------------------------------------------------|
+ssize_t search_forward_path(const void * haystack,
+                            size_t size,
+                            const void * needle,
+                            size_t needle_size,
+                            cpu_path_t path)
+{
+    return search_forward_with((const uint8_t *) haystack, size,
+                               (const uint8_t *) needle, needle_size,
+                               search_kernel(path), NULL);
+}
+
+//------------------------------------------------------------------------|
+ssize_t search_reverse_path(const void * haystack,
+                            size_t size,
+                            const void * needle,
+                            size_t needle_size,
+                            cpu_path_t path)
+{
+    return search_reverse_with((const uint8_t *) haystack, size,
+                               (const uint8_t *) needle, needle_size,
+                               search_kernel(path), NULL);
+}
+
+//------------------------------------------------------------------------|
+ssize_t search_forward(const void * haystack,
+                       size_t size,
+                       const void * needle,
+                       size_t needle_size)
+{
+    return search_forward_path(haystack, size, needle, needle_size,
+                               CPU_PATH_AUTO);
+}
+
+//------------------------------------------------------------------------|
+ssize_t search_reverse(const void * haystack,
+                       size_t size,
+                       const void * needle,
+                       size_t needle_size)
+{
+    return search_reverse_path(haystack, size, needle, needle_size,
+                               CPU_PATH_AUTO);
+}
+
+//------------------------------------------------------------------------|
+// Searcher private implementation data
+typedef struct
+{
+    // Copy of the needle, and its size
+    uint8_t * needle;
+    size_t size;
+
+    // Filter kernel for this CPU
+    const search_kernel_t * kernel;
+
+    // Two-Way preprocessing for either direction
+    search_twoway_t forward;
+    search_twoway_t reverse;
+}
+bytes_searcher_priv_t;
+
+//------------------------------------------------------------------------|
+static bytes_searcher_t * bytes_searcher_create(const void * needle,
+                                                size_t size)
+{
+    bytes_searcher_t * searcher = (bytes_searcher_t *)
+                                  malloc(sizeof(bytes_searcher_t));
+    if (!searcher)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(bytes_searcher_t)) failed");
+        return NULL;
+    }
+
+    memcpy(searcher, &bytes_searcher_pub, sizeof(bytes_searcher_t));
+
+    bytes_searcher_priv_t * priv = (bytes_searcher_priv_t *)
+                                   malloc(sizeof(bytes_searcher_priv_t));
+    if (!priv)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(bytes_searcher_priv_t)) failed");
+        free(searcher);
+        return NULL;
+    }
+
+    memzero(priv, sizeof(bytes_searcher_priv_t));
+    searcher->priv = priv;
+
+    // Keep a terminator on the copy, for the sake of debugging
+    priv->needle = (uint8_t *) malloc(size + 1);
+    if (!priv->needle)
+    {
+        BLAMMO(FATAL, "malloc(%zu) failed", size + 1);
+        free(priv);
+        free(searcher);
+        return NULL;
+    }
+
+    if (size > 0)
+    {
+        memcpy(priv->needle, needle, size);
+    }
+
+    priv->needle[size] = 0;
+    priv->size = size;
+    priv->kernel = search_kernel(CPU_PATH_AUTO);
+
+    if (size > 1)
+    {
+        search_twoway_prepare(&priv->forward, priv->needle, size, false);
+        search_twoway_prepare(&priv->reverse, priv->needle, size, true);
+    }
+
+    return searcher;
+}
+
+//------------------------------------------------------------------------|
+static void bytes_searcher_destroy(void * searcher_ptr)
+{
+    bytes_searcher_t * searcher = (bytes_searcher_t *) searcher_ptr;
+
+    // guard against accidental double-destroy or early-destroy
+    if (!searcher || !searcher->priv)
+    {
+        BLAMMO(WARNING, "attempt to early or double-destroy");
+        return;
+    }
+
+    bytes_searcher_priv_t * priv = (bytes_searcher_priv_t *) searcher->priv;
+    memzero(priv->needle, priv->size + 1);
+    free(priv->needle);
+
+    // zero out and destroy the private data
+    memzero(searcher->priv, sizeof(bytes_searcher_priv_t));
+    free(searcher->priv);
+
+    // zero out and destroy the public interface
+    memzero(searcher, sizeof(bytes_searcher_t));
+    free(searcher);
+}
+
+//------------------------------------------------------------------------|
+static const uint8_t * bytes_searcher_needle(const bytes_searcher_t * searcher)
+{
+    return ((bytes_searcher_priv_t *) searcher->priv)->needle;
+}
+
+//------------------------------------------------------------------------|
+static size_t bytes_searcher_size(const bytes_searcher_t * searcher)
+{
+    return ((bytes_searcher_priv_t *) searcher->priv)->size;
+}
+
+//------------------------------------------------------------------------|
+static ssize_t bytes_searcher_forward(const bytes_searcher_t * searcher,
+                                      const void * haystack,
+                                      size_t size)
+{
+    bytes_searcher_priv_t * priv = (bytes_searcher_priv_t *) searcher->priv;
+    return search_forward_with((const uint8_t *) haystack, size,
+                               priv->needle, priv->size,
+                               priv->kernel, &priv->forward);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t bytes_searcher_reverse(const bytes_searcher_t * searcher,
+                                      const void * haystack,
+                                      size_t size)
+{
+    bytes_searcher_priv_t * priv = (bytes_searcher_priv_t *) searcher->priv;
+    return search_reverse_with((const uint8_t *) haystack, size,
+                               priv->needle, priv->size,
+                               priv->kernel, &priv->reverse);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t bytes_searcher_all(const bytes_searcher_t * searcher,
+                                  const void * haystack,
+                                  size_t size,
+                                  bool overlapping,
+                                  size_t ** offsets,
+                                  size_t * capacity)
+{
+    bytes_searcher_priv_t * priv = (bytes_searcher_priv_t *) searcher->priv;
+    return search_all_with((const uint8_t *) haystack, size,
+                           priv->needle, priv->size, overlapping,
+                           priv->kernel, &priv->forward, offsets, capacity);
+}
+
+//------------------------------------------------------------------------|
+static size_t bytes_searcher_count(const bytes_searcher_t * searcher,
+                                   const void * haystack,
+                                   size_t size,
+                                   bool overlapping)
+{
+    bytes_searcher_priv_t * priv = (bytes_searcher_priv_t *) searcher->priv;
+    return (size_t) search_all_with((const uint8_t *) haystack, size,
+                                    priv->needle, priv->size, overlapping,
+                                    priv->kernel, &priv->forward,
+                                    NULL, NULL);
+}
+
+//------------------------------------------------------------------------|
+static ssize_t bytes_searcher_find_forward(const bytes_searcher_t * searcher,
+                                           const bytes_t * bytes,
+                                           size_t start_offset)
+{
+    size_t size = bytes->size(bytes);
+    ssize_t found;
+
+    if (start_offset > size)
+    {
+        return -1;
+    }
+
+    found = searcher->forward(searcher, bytes->data(bytes) + start_offset,
+                              size - start_offset);
+
+    return found < 0 ? found : found + (ssize_t) start_offset;
+}
+
+//------------------------------------------------------------------------|
+static ssize_t bytes_searcher_find_reverse(const bytes_searcher_t * searcher,
+                                           const bytes_t * bytes,
+                                           size_t start_offset)
+{
+    size_t size = bytes->size(bytes);
+
+    if (start_offset > size)
+    {
+        BLAMMO(WARNING, "start_offset %zu is larger than size %zu",
+                        start_offset, size);
+        start_offset = size;
+    }
+
+    return searcher->reverse(searcher, bytes->data(bytes), start_offset);
+}
+
+//------------------------------------------------------------------------|
+const bytes_searcher_t bytes_searcher_pub = {
+    &bytes_searcher_create,
+    &bytes_searcher_destroy,
+    &bytes_searcher_needle,
+    &bytes_searcher_size,
+    &bytes_searcher_forward,
+    &bytes_searcher_reverse,
+    &bytes_searcher_all,
+    &bytes_searcher_count,
+    &bytes_searcher_find_forward,
+    &bytes_searcher_find_reverse,
+    NULL
+};
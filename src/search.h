@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <sys/types.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "utils.h"
+#include "bytes.h"
+
+//------------------------------------------------------------------------|
+// Substring search over arbitrary byte buffers, as used by bytes->find_*.
+//
+// - A single byte goes straight to memchr()/memrchr().
+// - Longer needles go through a filter that compares the first needle
+//   byte, and the last one that differs from it, against 16 or 32
+//   haystack positions at a time (SSE2/AVX2, picked at runtime).  Only
+//   positions where both match are compared in full.
+// - Input that keeps the filter finding false candidates (periodic text,
+//   for instance) hands over to Two-Way string matching, with a skip
+//   table on the last byte of each window as in Boyer-Moore-Horspool.
+//   Two-Way never looks at a haystack byte more than a few times, so no
+//   input takes worse than linear time.
+//
+// For searching repeatedly for the same needle, bytes_searcher_t does the
+// Two-Way preprocessing once up front.
+
+//------------------------------------------------------------------------|
+// Offset of the first occurrence of 'needle' in 'haystack', or negative
+// if there is none.  An empty needle is found at offset 0.
+ssize_t search_forward(const void * haystack,
+                       size_t size,
+                       const void * needle,
+                       size_t needle_size);
+
+// Offset of the last occurrence of 'needle' in 'haystack', or negative
+// if there is none.  An empty needle is found at offset 'size'.
+ssize_t search_reverse(const void * haystack,
+                       size_t size,
+                       const void * needle,
+                       size_t needle_size);
+
+// Every occurrence of 'needle' in 'haystack', found in one pass.  Matches
+// may overlap if 'overlapping' is true, otherwise each match starts after
+// the end of the previous one.  Their offsets are written in order to the
+// array at '*offsets', which holds '*capacity' of them and is grown with
+// realloc() as needed.  Both may start out NULL and zero.  The caller
+// owns the array, and frees it with free().  Returns the number of
+// matches, or negative if the array could not be grown.  An empty needle
+// matches nowhere.
+ssize_t search_all(const void * haystack,
+                   size_t size,
+                   const void * needle,
+                   size_t needle_size,
+                   bool overlapping,
+                   size_t ** offsets,
+                   size_t * capacity);
+
+// Number of occurrences, as above, without recording where they are.
+// Single bytes are counted 16 or 32 at a time.
+size_t search_count(const void * haystack,
+                    size_t size,
+                    const void * needle,
+                    size_t needle_size,
+                    bool overlapping);
+
+//------------------------------------------------------------------------|
+// A set of bytes, for finding where a run of bytes in the set (or out of
+// it) ends, as strspn() and strcspn() do for C strings.  Sets of up to
+// SEARCH_SET_VECTOR distinct bytes are checked 16 or 32 bytes at a time,
+// and larger ones a byte at a time.
+#define SEARCH_SET_VECTOR   8
+
+typedef struct
+{
+    uint8_t member[256];                // nonzero for bytes in the set
+    uint8_t bytes[SEARCH_SET_VECTOR];   // the distinct bytes, if few
+    size_t count;                       // number of distinct bytes
+}
+search_set_t;
+
+// Fill in a set from 'count' bytes, which may repeat
+void search_set_init(search_set_t * set, const void * bytes, size_t count);
+
+// Length of the initial run of 'data' made only of bytes in the set, or
+// only of bytes not in it.  Returns 'size' if the run takes up all of it.
+size_t search_span(const void * data, size_t size, const search_set_t * set);
+size_t search_cspan(const void * data, size_t size, const search_set_t * set);
+
+// The above with the filter on a particular code path, for testing and
+// benchmarking.  The scalar filter runs memchr() on the first byte, and
+// SSE2 and AVX2 check 16 and 32 positions at a time.
+ssize_t search_forward_path(const void * haystack,
+                            size_t size,
+                            const void * needle,
+                            size_t needle_size,
+                            cpu_path_t path);
+
+ssize_t search_reverse_path(const void * haystack,
+                            size_t size,
+                            const void * needle,
+                            size_t needle_size,
+                            cpu_path_t path);
+
+size_t search_span_path(const void * data,
+                        size_t size,
+                        const search_set_t * set,
+                        cpu_path_t path);
+
+size_t search_cspan_path(const void * data,
+                         size_t size,
+                         const search_set_t * set,
+                         cpu_path_t path);
+
+// Name of the filter a path gets, with CPU_PATH_AUTO resolved to the
+// chosen one
+const char * search_path_name(cpu_path_t path);
+
+//------------------------------------------------------------------------|
+// A needle prepared for repeated searches
+typedef struct bytes_searcher_t
+{
+    // Factory function.  Copies the needle, so it need not outlive the
+    // searcher.
+    struct bytes_searcher_t * (*create)(const void * needle, size_t size);
+
+    // Searcher destructor function
+    void (*destroy)(void * searcher);
+
+    // The needle and its size
+    const uint8_t * (*needle)(const struct bytes_searcher_t * searcher);
+    size_t (*size)(const struct bytes_searcher_t * searcher);
+
+    // Same as search_forward() and search_reverse() with this needle
+    ssize_t (*forward)(const struct bytes_searcher_t * searcher,
+                       const void * haystack,
+                       size_t size);
+
+    ssize_t (*reverse)(const struct bytes_searcher_t * searcher,
+                       const void * haystack,
+                       size_t size);
+
+    // Same as search_all() and search_count() with this needle
+    ssize_t (*all)(const struct bytes_searcher_t * searcher,
+                   const void * haystack,
+                   size_t size,
+                   bool overlapping,
+                   size_t ** offsets,
+                   size_t * capacity);
+
+    size_t (*count)(const struct bytes_searcher_t * searcher,
+                    const void * haystack,
+                    size_t size,
+                    bool overlapping);
+
+    // Same as bytes->find_forward() and bytes->find_reverse() with this
+    // needle
+    ssize_t (*find_forward)(const struct bytes_searcher_t * searcher,
+                            const struct bytes_t * bytes,
+                            size_t start_offset);
+
+    ssize_t (*find_reverse)(const struct bytes_searcher_t * searcher,
+                            const struct bytes_t * bytes,
+                            size_t start_offset);
+
+    // Private data
+    void * priv;
+}
+bytes_searcher_t;
+
+//------------------------------------------------------------------------|
+extern const bytes_searcher_t bytes_searcher_pub;
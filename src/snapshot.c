@@ -0,0 +1,698 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "snapshot.h"
+#include "phash.h"
+#include "hash.h"
+#include "utils.h"
+#include "blammo.h"
+
+//------------------------------------------------------------------------|
+#define SNAPSHOT_MAGIC              "RAYCOSNP"
+#define SNAPSHOT_VERSION            2
+
+// Written in native byte order, so that a reader can tell whether the
+// file came from a machine of the same endianness
+#define SNAPSHOT_ORDER              0x01020304UL
+
+// Everything in the file starts on this boundary
+#define SNAPSHOT_ALIGN              8
+
+//------------------------------------------------------------------------|
+// File layout, in order: header, displacements, slots, records.  All
+// positions are byte offsets from the start of the file.
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t order;
+
+    // Number of keys, and of perfect hash displacement buckets
+    uint64_t count;
+    uint64_t buckets;
+
+    // Offsets of the uint32_t displacements, the slots, and the first
+    // record, followed by the total file size
+    uint64_t disp;
+    uint64_t slots;
+    uint64_t records;
+    uint64_t size;
+}
+snapshot_header_t;
+
+// One slot of the perfect hash table: the key's full hash, so that most
+// misses are rejected without touching the records, and where its record is
+typedef struct
+{
+    uint64_t hash;
+    uint64_t record;
+}
+snapshot_slot_t;
+
+// Record header.  Followed by the key and its null terminator, padding up
+// to the alignment, then the serialized object and more padding.  Records
+// are stored back to back in collection order.
+typedef struct
+{
+    uint64_t key_size;
+    uint64_t object_size;
+}
+snapshot_record_t;
+
+// Snapshot private implementation data
+typedef struct
+{
+    // The whole mapped file
+    const uint8_t * base;
+    size_t size;
+
+    // Views into the mapping, taken from the header
+    const snapshot_header_t * header;
+    const uint32_t * disp;
+    const snapshot_slot_t * slots;
+}
+snapshot_priv_t;
+
+//------------------------------------------------------------------------|
+static inline uint64_t snapshot_align(uint64_t size)
+{
+    return (size + SNAPSHOT_ALIGN - 1) & ~((uint64_t) SNAPSHOT_ALIGN - 1);
+}
+
+// Offset of a record's object, relative to the record
+static inline uint64_t snapshot_object_offset(uint64_t key_size)
+{
+    return snapshot_align(sizeof(snapshot_record_t) + key_size + 1);
+}
+
+// Total size of a record including padding
+static inline uint64_t snapshot_record_size(uint64_t key_size,
+                                            uint64_t object_size)
+{
+    return snapshot_object_offset(key_size) + snapshot_align(object_size);
+}
+
+//------------------------------------------------------------------------|
+// Bounds-checked access to the record at an offset.  Files are trusted no
+// further than their size, so a damaged one yields misses, not faults.
+static const snapshot_record_t * snapshot_record(snapshot_priv_t * priv,
+                                                 uint64_t offset)
+{
+    if (offset < priv->header->records ||
+        offset > priv->size - sizeof(snapshot_record_t))
+    {
+        return NULL;
+    }
+
+    const snapshot_record_t * record =
+            (const snapshot_record_t *) (priv->base + offset);
+
+    uint64_t room = priv->size - offset;
+    if (record->key_size >= room || record->object_size >= room ||
+        snapshot_record_size(record->key_size, record->object_size) > room ||
+        ((const char *) (record + 1))[record->key_size] != '\0')
+    {
+        return NULL;
+    }
+
+    return record;
+}
+
+//------------------------------------------------------------------------|
+static void * snapshot_entry(const snapshot_record_t * record,
+                             const char ** key,
+                             const void ** object,
+                             size_t * size)
+{
+    if (!record)
+    {
+        *key = NULL;
+        *object = NULL;
+        if (size)
+        {
+            *size = 0;
+        }
+
+        return NULL;
+    }
+
+    const uint8_t * base = (const uint8_t *) record;
+    *key = (const char *) (record + 1);
+    *object = base + snapshot_object_offset(record->key_size);
+    if (size)
+    {
+        *size = (size_t) record->object_size;
+    }
+
+    return (void *) record;
+}
+
+//------------------------------------------------------------------------|
+// Write zero bytes up to the next alignment boundary
+static bool snapshot_pad(FILE * file, uint64_t size)
+{
+    static const uint8_t zeros[SNAPSHOT_ALIGN] = { 0 };
+    size_t pad = (size_t) (snapshot_align(size) - size);
+    return fwrite(zeros, 1, pad, file) == pad;
+}
+
+//------------------------------------------------------------------------|
+static bool snapshot_write(collect_t * collect,
+                           FILE * file,
+                           generic_serialize_f serialize)
+{
+    size_t n = collect->length(collect);
+    size_t buckets = phash_buckets(n);
+    size_t i;
+
+    // Per-key hash, record offset and serialized size, then the table
+    const char ** keys = (const char **) malloc(sizeof(char *) * (n + 1));
+    void ** objects = (void **) malloc(sizeof(void *) * (n + 1));
+    uint64_t * hashes = (uint64_t *) malloc(sizeof(uint64_t) * (n + 1));
+    uint64_t * offsets = (uint64_t *) malloc(sizeof(uint64_t) * (n + 1));
+    uint64_t * sizes = (uint64_t *) malloc(sizeof(uint64_t) * (n + 1));
+    size_t * placed = (size_t *) malloc(sizeof(size_t) * (n + 1));
+    uint32_t * disp = (uint32_t *) malloc(sizeof(uint32_t) * buckets);
+    snapshot_slot_t * slots = (snapshot_slot_t *)
+            malloc(sizeof(snapshot_slot_t) * (n + 1));
+    bool success = keys && objects && hashes && offsets && sizes &&
+                   placed && disp && slots;
+
+    if (!success)
+    {
+        BLAMMO(FATAL, "save() scratch allocation failed");
+    }
+
+    snapshot_header_t header;
+    memzero(&header, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.order = SNAPSHOT_ORDER;
+    header.count = n;
+    header.buckets = buckets;
+    header.disp = sizeof(header);
+    header.slots = snapshot_align(header.disp + sizeof(uint32_t) * buckets);
+    header.records = header.slots + sizeof(snapshot_slot_t) * n;
+    header.size = header.records;
+
+    // First pass: lay out the records
+    char * key = NULL;
+    void * object = NULL;
+    void * iterator = collect->first(collect, &key, &object);
+
+    for (i = 0; success && iterator && i < n; i++)
+    {
+        ssize_t size = 0;
+        if (serialize && object)
+        {
+            size = serialize(object, NULL, 0);
+        }
+
+        if (size < 0)
+        {
+            BLAMMO(ERROR, "serialize(%s) failed", key);
+            success = false;
+            break;
+        }
+
+        keys[i] = key;
+        objects[i] = object;
+        hashes[i] = hash_bytes(key, strlen(key), 0);
+        offsets[i] = header.size;
+        sizes[i] = (uint64_t) size;
+        header.size += snapshot_record_size(strlen(key), sizes[i]);
+
+        iterator = collect->next(iterator, &key, &object);
+    }
+
+    success = success && phash_build(hashes, n, disp, placed);
+
+    if (success)
+    {
+        for (i = 0; i < n; i++)
+        {
+            slots[i].hash = hashes[placed[i]];
+            slots[i].record = offsets[placed[i]];
+        }
+
+        success = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  fwrite(disp, sizeof(uint32_t), buckets, file) == buckets &&
+                  snapshot_pad(file, header.disp +
+                                     sizeof(uint32_t) * buckets) &&
+                  fwrite(slots, sizeof(snapshot_slot_t), n, file) == n;
+    }
+
+    // Second pass: write the records, serializing through one buffer
+    uint8_t * buffer = NULL;
+    size_t capacity = 0;
+
+    for (i = 0; success && i < n; i++)
+    {
+        snapshot_record_t record;
+        record.key_size = strlen(keys[i]);
+        record.object_size = sizes[i];
+
+        if (sizes[i] > capacity)
+        {
+            uint8_t * grown = (uint8_t *) realloc(buffer, sizes[i]);
+            if (!grown)
+            {
+                BLAMMO(FATAL, "realloc(%zu) failed", (size_t) sizes[i]);
+                success = false;
+                break;
+            }
+
+            buffer = grown;
+            capacity = sizes[i];
+        }
+
+        if (sizes[i] > 0 &&
+            serialize(objects[i], buffer, sizes[i]) != (ssize_t) sizes[i])
+        {
+            BLAMMO(ERROR, "serialize(%s) changed size", keys[i]);
+            success = false;
+            break;
+        }
+
+        success = fwrite(&record, sizeof(record), 1, file) == 1 &&
+                  fwrite(keys[i], 1, record.key_size + 1, file) ==
+                          record.key_size + 1 &&
+                  snapshot_pad(file, sizeof(record) + record.key_size + 1) &&
+                  (sizes[i] == 0 ||
+                   fwrite(buffer, 1, sizes[i], file) == sizes[i]) &&
+                  snapshot_pad(file, sizes[i]);
+    }
+
+    free(buffer);
+    free(keys);
+    free(objects);
+    free(hashes);
+    free(offsets);
+    free(sizes);
+    free(placed);
+    free(disp);
+    free(slots);
+    return success;
+}
+
+//------------------------------------------------------------------------|
+static bool snapshot_save(collect_t * collect,
+                          const char * path,
+                          generic_serialize_f serialize)
+{
+    // Write to a temporary file and rename it into place, so that nobody
+    // ever maps a partial snapshot, and existing mappings of an older
+    // snapshot at the same path stay intact.
+    size_t length = strlen(path);
+    char * temp = (char *) malloc(length + 5);
+    if (!temp)
+    {
+        BLAMMO(FATAL, "malloc(%zu) failed", length + 5);
+        return false;
+    }
+
+    memcpy(temp, path, length);
+    memcpy(temp + length, ".tmp", 5);
+
+    FILE * file = fopen(temp, "wb");
+    if (!file)
+    {
+        BLAMMO(ERROR, "fopen(%s) failed", temp);
+        free(temp);
+        return false;
+    }
+
+    bool success = snapshot_write(collect, file, serialize);
+    success = (fclose(file) == 0) && success;
+    success = success && (rename(temp, path) == 0);
+
+    if (!success)
+    {
+        BLAMMO(ERROR, "failed to save snapshot %s", path);
+        remove(temp);
+    }
+
+    free(temp);
+    return success;
+}
+
+//------------------------------------------------------------------------|
+// Check that a mapped file is a snapshot this build can read, and that
+// its tables lie within the file.
+static bool snapshot_valid(const uint8_t * base, size_t size)
+{
+    const snapshot_header_t * header = (const snapshot_header_t *) base;
+
+    if (size < sizeof(snapshot_header_t) ||
+        memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) ||
+        header->version != SNAPSHOT_VERSION ||
+        header->order != SNAPSHOT_ORDER)
+    {
+        BLAMMO(ERROR, "not a readable snapshot");
+        return false;
+    }
+
+    // Bound the counts first so that none of the sums below can wrap
+    if (header->size != size ||
+        header->count > size / sizeof(snapshot_slot_t) ||
+        header->buckets != phash_buckets(header->count) ||
+        header->disp != sizeof(snapshot_header_t) ||
+        header->slots != snapshot_align(header->disp +
+                                        sizeof(uint32_t) * header->buckets) ||
+        header->records != header->slots +
+                           sizeof(snapshot_slot_t) * header->count ||
+        header->records > size)
+    {
+        BLAMMO(ERROR, "snapshot tables are inconsistent");
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static snapshot_t * snapshot_open(const char * path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        BLAMMO(ERROR, "open(%s) failed", path);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < (off_t) sizeof(snapshot_header_t))
+    {
+        BLAMMO(ERROR, "%s is too small to be a snapshot", path);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t) st.st_size;
+    void * base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED)
+    {
+        BLAMMO(ERROR, "mmap(%s) failed", path);
+        return NULL;
+    }
+
+    if (!snapshot_valid((const uint8_t *) base, size))
+    {
+        munmap(base, size);
+        return NULL;
+    }
+
+    // Allocate and initialize public interface
+    snapshot_t * snapshot = (snapshot_t *) malloc(sizeof(snapshot_t));
+    if (!snapshot)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(snapshot_t)) failed");
+        munmap(base, size);
+        return NULL;
+    }
+
+    // bulk copy all function pointers and init opaque ptr
+    memcpy(snapshot, &snapshot_pub, sizeof(snapshot_t));
+
+    // Allocate and initialize private implementation
+    snapshot->priv = malloc(sizeof(snapshot_priv_t));
+    if (!snapshot->priv)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(snapshot_priv_t)) failed");
+        munmap(base, size);
+        free(snapshot);
+        return NULL;
+    }
+
+    memzero(snapshot->priv, sizeof(snapshot_priv_t));
+    snapshot_priv_t * priv = (snapshot_priv_t *) snapshot->priv;
+
+    priv->base = (const uint8_t *) base;
+    priv->size = size;
+    priv->header = (const snapshot_header_t *) base;
+    priv->disp = (const uint32_t *) (priv->base + priv->header->disp);
+    priv->slots = (const snapshot_slot_t *)
+            (priv->base + priv->header->slots);
+    return snapshot;
+}
+
+//------------------------------------------------------------------------|
+static void snapshot_destroy(void * snapshot_ptr)
+{
+    snapshot_t * snapshot = (snapshot_t *) snapshot_ptr;
+
+    // guard against accidental double-destroy or early-destroy
+    if (!snapshot || !snapshot->priv)
+    {
+        BLAMMO(WARNING, "attempt to early or double-destroy");
+        return;
+    }
+
+    snapshot_priv_t * priv = (snapshot_priv_t *) snapshot->priv;
+    munmap((void *) priv->base, priv->size);
+
+    // zero out and destroy the private data
+    memzero(snapshot->priv, sizeof(snapshot_priv_t));
+    free(snapshot->priv);
+
+    // zero out and destroy the public interface
+    memzero(snapshot, sizeof(snapshot_t));
+    free(snapshot);
+}
+
+//------------------------------------------------------------------------|
+static bool snapshot_empty(snapshot_t * snapshot)
+{
+    snapshot_priv_t * priv = (snapshot_priv_t *) snapshot->priv;
+    return priv->header->count == 0;
+}
+
+//------------------------------------------------------------------------|
+static size_t snapshot_length(snapshot_t * snapshot)
+{
+    snapshot_priv_t * priv = (snapshot_priv_t *) snapshot->priv;
+    return (size_t) priv->header->count;
+}
+
+//------------------------------------------------------------------------|
+static const void * snapshot_get(snapshot_t * snapshot,
+                                 const char * key,
+                                 size_t * size)
+{
+    snapshot_priv_t * priv = (snapshot_priv_t *) snapshot->priv;
+    const snapshot_header_t * header = priv->header;
+
+    if (header->count == 0)
+    {
+        return NULL;
+    }
+
+    size_t length = strlen(key);
+    uint64_t hash = hash_bytes(key, length, 0);
+    uint32_t disp = priv->disp[phash_bucket(hash, header->buckets)];
+    const snapshot_slot_t * slot =
+            &priv->slots[phash_slot(hash, disp, header->count)];
+
+    if (slot->hash != hash)
+    {
+        return NULL;
+    }
+
+    const snapshot_record_t * record = snapshot_record(priv, slot->record);
+    if (!record || record->key_size != length ||
+        memcmp(record + 1, key, length))
+    {
+        return NULL;
+    }
+
+    const char * found_key;
+    const void * object;
+    snapshot_entry(record, &found_key, &object, size);
+    return object;
+}
+
+//------------------------------------------------------------------------|
+static bool snapshot_contains(snapshot_t * snapshot, const char * key)
+{
+    return snapshot_get(snapshot, key, NULL) != NULL;
+}
+
+//------------------------------------------------------------------------|
+static void * snapshot_first(snapshot_t * snapshot,
+                             const char ** key,
+                             const void ** object,
+                             size_t * size)
+{
+    snapshot_priv_t * priv = (snapshot_priv_t *) snapshot->priv;
+    const snapshot_record_t * record = NULL;
+
+    if (priv->header->count > 0)
+    {
+        record = snapshot_record(priv, priv->header->records);
+    }
+
+    return snapshot_entry(record, key, object, size);
+}
+
+//------------------------------------------------------------------------|
+static void * snapshot_next(snapshot_t * snapshot,
+                            void * iterator,
+                            const char ** key,
+                            const void ** object,
+                            size_t * size)
+{
+    snapshot_priv_t * priv = (snapshot_priv_t *) snapshot->priv;
+    const snapshot_record_t * record = (const snapshot_record_t *) iterator;
+
+    if (record)
+    {
+        uint64_t offset = (uint64_t) ((const uint8_t *) record - priv->base);
+        offset += snapshot_record_size(record->key_size, record->object_size);
+        record = offset < priv->size ? snapshot_record(priv, offset) : NULL;
+    }
+
+    return snapshot_entry(record, key, object, size);
+}
+
+//------------------------------------------------------------------------|
+static collect_t * snapshot_restore(snapshot_t * snapshot,
+                                    generic_deserialize_f deserialize,
+                                    generic_destroy_f destroy)
+{
+    size_t n = snapshot_length(snapshot);
+    size_t i = 0;
+
+    collect_t * collect = collect_pub.create();
+    const char ** keys = (const char **) malloc(sizeof(char *) * (n + 1));
+    void ** objects = (void **) calloc(n + 1, sizeof(void *));
+    generic_destroy_f * destroy_fns = (generic_destroy_f *)
+            malloc(sizeof(generic_destroy_f) * (n + 1));
+
+    if (!collect || !keys || !objects || !destroy_fns)
+    {
+        BLAMMO(FATAL, "restore() allocation failed");
+        free(keys);
+        free(objects);
+        free(destroy_fns);
+        if (collect)
+        {
+            collect->destroy(collect);
+        }
+
+        return NULL;
+    }
+
+    const char * key;
+    const void * object;
+    size_t size;
+    void * iterator = snapshot_first(snapshot, &key, &object, &size);
+    bool success = true;
+
+    while (iterator && i < n)
+    {
+        keys[i] = key;
+        destroy_fns[i] = destroy;
+        if (deserialize)
+        {
+            objects[i] = deserialize(object, size);
+            if (!objects[i])
+            {
+                BLAMMO(ERROR, "deserialize(%s) failed", key);
+                success = false;
+                break;
+            }
+        }
+
+        i++;
+        iterator = snapshot_next(snapshot, iterator, &key, &object, &size);
+    }
+
+    // Keys are copied by the collection, so the mapping is not needed
+    // after this.  set_many() puts the first key on the bottom, so feed
+    // the snapshot in reverse to keep its order.
+    if (success)
+    {
+        size_t j;
+        for (j = 0; j < i / 2; j++)
+        {
+            const char * k = keys[j];
+            void * o = objects[j];
+            keys[j] = keys[i - 1 - j];
+            objects[j] = objects[i - 1 - j];
+            keys[i - 1 - j] = k;
+            objects[i - 1 - j] = o;
+        }
+
+        success = collect->set_many(collect, keys, objects, NULL,
+                                    destroy_fns, i);
+    }
+
+    if (!success)
+    {
+        // Only objects not yet handed over to the collection remain ours
+        while (i-- > 0)
+        {
+            if (objects[i] && destroy && !collect->get(collect, keys[i]))
+            {
+                destroy(objects[i]);
+            }
+        }
+
+        collect->destroy(collect);
+        collect = NULL;
+    }
+
+    free(keys);
+    free(objects);
+    free(destroy_fns);
+    return collect;
+}
+
+//------------------------------------------------------------------------|
+const snapshot_t snapshot_pub = {
+    &snapshot_save,
+    &snapshot_open,
+    &snapshot_destroy,
+    &snapshot_empty,
+    &snapshot_length,
+    &snapshot_get,
+    &snapshot_contains,
+    &snapshot_first,
+    &snapshot_next,
+    &snapshot_restore,
+    NULL
+};
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <sys/types.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------|
+// A read-only collection backed by a memory-mapped file.  save() writes
+// the keys of a collect_t, along with each object as flattened by a
+// caller-supplied serializer, into a flat file where everything is found
+// by offset.  open() maps such a file and serves lookups and iteration
+// directly out of the mapping: nothing is parsed or copied up front, so
+// opening costs about the same whatever the size, and pages are only
+// read in as lookups touch them.
+//
+// Lookups go through a minimal perfect hash table stored in the file,
+// built at save() time (see phash.h).  The format is tied to the byte
+// order and hash function of the machine that wrote it; open() refuses
+// files it cannot read.
+#include "utils.h"          // generic function signatures
+#include "collect.h"
+
+//------------------------------------------------------------------------|
+typedef struct snapshot_t
+{
+    // Write the keys and objects of a collection to a snapshot file at
+    // 'path', replacing any existing file.  Objects are flattened with
+    // 'serialize', which may be NULL to store the keys alone.  NULL
+    // objects are stored as empty.  Returns false on I/O or serializer
+    // errors, in which case no file is left behind.
+    bool (*save)(struct collect_t * collect,
+                 const char * path,
+                 generic_serialize_f serialize);
+
+    // Snapshot factory function.  Maps the snapshot file at 'path'.
+    // Returns NULL if it cannot be opened or is not a valid snapshot.
+    struct snapshot_t * (*open)(const char * path);
+
+    // Snapshot destructor function.  Unmaps the file, invalidating all
+    // keys and objects obtained from the snapshot.
+    void (*destroy)(void * snapshot);
+
+    // Whether the snapshot is empty or not
+    bool (*empty)(struct snapshot_t * snapshot);
+
+    // Number of keys in the snapshot
+    size_t (*length)(struct snapshot_t * snapshot);
+
+    // Get the serialized object stored under a key, and optionally its
+    // size.  Points into the mapping, and is aligned to 8 bytes.  Returns
+    // NULL if the key is not present.
+    const void * (*get)(struct snapshot_t * snapshot,
+                        const char * key,
+                        size_t * size);
+
+    // Whether a key is present or not
+    bool (*contains)(struct snapshot_t * snapshot, const char * key);
+
+    // Starting iterator for the snapshot, in the order of the collection
+    // that was saved.  Returns an iterator pointer to be used in
+    // subsequent calls to 'next', and sets the 'key', 'object' and
+    // optionally 'size' to the first entry.  Returns NULL at the end.
+    void * (*first)(struct snapshot_t * snapshot,
+                    const char ** key,
+                    const void ** object,
+                    size_t * size);
+
+    // Regular forward iterator function.  Pass in the iterator pointer
+    // from first or a previous call to next.
+    void * (*next)(struct snapshot_t * snapshot,
+                   void * iterator,
+                   const char ** key,
+                   const void ** object,
+                   size_t * size);
+
+    // Rebuild an ordinary, mutable collection from the snapshot, with
+    // each object made by 'deserialize' and destroyed by 'destroy'.
+    // 'deserialize' may be NULL to get NULL objects.  Returns NULL on
+    // error.
+    struct collect_t * (*restore)(struct snapshot_t * snapshot,
+                                  generic_deserialize_f deserialize,
+                                  generic_destroy_f destroy);
+
+    // Private data
+    void * priv;
+}
+snapshot_t;
+
+//------------------------------------------------------------------------|
+extern const snapshot_t snapshot_pub;
@@ -0,0 +1,813 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "trie.h"
+#include "utils.h"              // memzero(), function signatures
+#include "blammo.h"
+
+//------------------------------------------------------------------------|
+// A node in the radix tree.  Each node owns the edge label leading into
+// it from its parent, stored inline to avoid a pointer chase per edge.
+typedef struct trie_node_t
+{
+    // Child nodes, sorted by the first byte of their labels.  The first
+    // bytes are also kept in their own compact array so that selecting
+    // a child touches as little memory as possible.
+    struct trie_node_t ** children;
+    uint8_t * firsts;
+    uint16_t count;
+    uint16_t capacity;
+
+    // Whether a key terminates at this node, and its payload if so.
+    bool terminal;
+    void * data;
+
+    // Edge label leading into this node
+    size_t size;
+    uint8_t label[];
+}
+trie_node_t;
+
+// Trie private implementation data
+typedef struct
+{
+    // The root node always exists and always has an empty label
+    trie_node_t * root;
+
+    // Number of keys stored
+    size_t length;
+
+    // Payload copy and destructor functions for all keys.
+    // These can be NULL for static or unmanaged data.
+    generic_copy_f data_copy;
+    generic_destroy_f data_destroy;
+
+    // Working buffer used to reconstruct keys during enumeration
+    uint8_t * keybuf;
+    size_t keycap;
+}
+trie_priv_t;
+
+//------------------------------------------------------------------------|
+static trie_node_t * trie_node_create(const uint8_t * label, size_t size)
+{
+    trie_node_t * node = (trie_node_t *) malloc(sizeof(trie_node_t) + size);
+    if (!node)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(trie_node_t) + %zu) failed", size);
+        return NULL;
+    }
+
+    memzero(node, sizeof(trie_node_t));
+    if (size > 0)
+    {
+        memcpy(node->label, label, size);
+    }
+
+    node->size = size;
+    return node;
+}
+
+//------------------------------------------------------------------------|
+// Ensure room for at least one more child
+static bool trie_node_reserve(trie_node_t * node)
+{
+    size_t capacity = node->capacity ? node->capacity << 1 : 2;
+    trie_node_t ** children = NULL;
+    uint8_t * firsts = NULL;
+
+    if (node->count < node->capacity)
+    {
+        return true;
+    }
+
+    // There can never be more than one child per byte value
+    capacity = MIN(capacity, (size_t) 256);
+
+    children = (trie_node_t **) realloc(node->children,
+                                        sizeof(trie_node_t *) * capacity);
+    if (!children)
+    {
+        BLAMMO(FATAL, "realloc(children) failed");
+        return false;
+    }
+
+    node->children = children;
+
+    firsts = (uint8_t *) realloc(node->firsts, capacity);
+    if (!firsts)
+    {
+        BLAMMO(FATAL, "realloc(firsts) failed");
+        return false;
+    }
+
+    node->firsts = firsts;
+    node->capacity = (uint16_t) capacity;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Binary search for the child whose label begins with the given byte.
+// Returns its index if found, or else the index at which it belongs.
+static inline size_t trie_child_index(const trie_node_t * node,
+                                      uint8_t byte,
+                                      bool * found)
+{
+    size_t lo = 0;
+    size_t hi = node->count;
+    size_t mid;
+
+    while (lo < hi)
+    {
+        mid = (lo + hi) >> 1;
+        if (node->firsts[mid] < byte)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    *found = (lo < node->count) && (node->firsts[lo] == byte);
+    return lo;
+}
+
+//------------------------------------------------------------------------|
+// Insert a child at the given index.  Capacity must already be reserved.
+static void trie_child_insert(trie_node_t * node,
+                              size_t index,
+                              trie_node_t * child)
+{
+    memmove(&node->children[index + 1], &node->children[index],
+            sizeof(trie_node_t *) * (node->count - index));
+    memmove(&node->firsts[index + 1], &node->firsts[index],
+            node->count - index);
+
+    node->children[index] = child;
+    node->firsts[index] = child->label[0];
+    node->count++;
+}
+
+//------------------------------------------------------------------------|
+static void trie_child_remove(trie_node_t * node, size_t index)
+{
+    memmove(&node->children[index], &node->children[index + 1],
+            sizeof(trie_node_t *) * (node->count - index - 1));
+    memmove(&node->firsts[index], &node->firsts[index + 1],
+            node->count - index - 1);
+    node->count--;
+}
+
+//------------------------------------------------------------------------|
+// Free a single node, leaving its children and payload alone
+static void trie_node_free(trie_node_t * node)
+{
+    free(node->children);
+    free(node->firsts);
+    free(node);
+}
+
+//------------------------------------------------------------------------|
+// Recursively destroy a node, all nodes beneath it, and their payloads
+static void trie_node_destroy(trie_priv_t * priv, trie_node_t * node)
+{
+    size_t i;
+
+    for (i = 0; i < node->count; i++)
+    {
+        trie_node_destroy(priv, node->children[i]);
+    }
+
+    if (node->terminal && node->data && priv->data_destroy)
+    {
+        priv->data_destroy(node->data);
+    }
+
+    trie_node_free(node);
+}
+
+//------------------------------------------------------------------------|
+// Recursively clone a node and everything beneath it
+static trie_node_t * trie_node_clone(trie_priv_t * priv, trie_node_t * node)
+{
+    trie_node_t * clone = trie_node_create(node->label, node->size);
+    size_t i;
+
+    if (!clone)
+    {
+        return NULL;
+    }
+
+    clone->terminal = node->terminal;
+    if (node->terminal)
+    {
+        clone->data = priv->data_copy ?
+                priv->data_copy(node->data) : node->data;
+    }
+
+    for (i = 0; i < node->count; i++)
+    {
+        if (!trie_node_reserve(clone))
+        {
+            trie_node_destroy(priv, clone);
+            return NULL;
+        }
+
+        clone->children[i] = trie_node_clone(priv, node->children[i]);
+        if (!clone->children[i])
+        {
+            trie_node_destroy(priv, clone);
+            return NULL;
+        }
+
+        clone->firsts[i] = node->firsts[i];
+        clone->count++;
+    }
+
+    return clone;
+}
+
+//------------------------------------------------------------------------|
+// Collapse a non-terminal node that has exactly one child into that
+// child, by prepending this node's label to the child's label.  Returns
+// the combined node, or NULL if memory could not be allocated (in which
+// case the tree is simply left uncompressed at this point).
+static trie_node_t * trie_node_merge(trie_node_t * node)
+{
+    trie_node_t * child = node->children[0];
+    size_t size = node->size + child->size;
+
+    child = (trie_node_t *) realloc(child, sizeof(trie_node_t) + size);
+    if (!child)
+    {
+        BLAMMO(WARNING, "realloc(%zu) failed", sizeof(trie_node_t) + size);
+        return NULL;
+    }
+
+    memmove(child->label + node->size, child->label, child->size);
+    memcpy(child->label, node->label, node->size);
+    child->size = size;
+
+    trie_node_free(node);
+    return child;
+}
+
+//------------------------------------------------------------------------|
+// Length of the common prefix of two byte arrays
+static inline size_t trie_common(const uint8_t * a, size_t asize,
+                                 const uint8_t * b, size_t bsize)
+{
+    size_t n = MIN(asize, bsize);
+    size_t i = 0;
+
+    while (i < n && a[i] == b[i])
+    {
+        i++;
+    }
+
+    return i;
+}
+
+//------------------------------------------------------------------------|
+// Find the node at which the exact key terminates, or NULL
+static trie_node_t * trie_node_find(trie_priv_t * priv,
+                                    const uint8_t * key,
+                                    size_t size)
+{
+    trie_node_t * node = priv->root;
+    trie_node_t * child = NULL;
+    bool found = false;
+    size_t index;
+
+    while (size > 0)
+    {
+        index = trie_child_index(node, key[0], &found);
+        if (!found)
+        {
+            return NULL;
+        }
+
+        child = node->children[index];
+        if (child->size > size || memcmp(child->label, key, child->size))
+        {
+            return NULL;
+        }
+
+        key += child->size;
+        size -= child->size;
+        node = child;
+    }
+
+    return node->terminal ? node : NULL;
+}
+
+//------------------------------------------------------------------------|
+// Recursive helper for remove().  After removing beneath a child, the
+// child is pruned if it became a dead leaf, or merged into its own only
+// child if it became a redundant pass-through node.
+static bool trie_node_remove(trie_priv_t * priv,
+                             trie_node_t * node,
+                             const uint8_t * key,
+                             size_t size)
+{
+    trie_node_t * child = NULL;
+    trie_node_t * merged = NULL;
+    bool found = false;
+    size_t index;
+
+    if (size == 0)
+    {
+        if (!node->terminal)
+        {
+            return false;
+        }
+
+        if (node->data && priv->data_destroy)
+        {
+            priv->data_destroy(node->data);
+        }
+
+        node->terminal = false;
+        node->data = NULL;
+        priv->length--;
+        return true;
+    }
+
+    index = trie_child_index(node, key[0], &found);
+    if (!found)
+    {
+        return false;
+    }
+
+    child = node->children[index];
+    if (child->size > size || memcmp(child->label, key, child->size))
+    {
+        return false;
+    }
+
+    if (!trie_node_remove(priv, child, key + child->size, size - child->size))
+    {
+        return false;
+    }
+
+    if (!child->terminal && child->count == 0)
+    {
+        trie_child_remove(node, index);
+        trie_node_free(child);
+    }
+    else if (!child->terminal && child->count == 1)
+    {
+        merged = trie_node_merge(child);
+        if (merged)
+        {
+            node->children[index] = merged;
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Make sure the key buffer can hold 'size' bytes plus a terminator
+static bool trie_keybuf_reserve(trie_priv_t * priv, size_t size)
+{
+    size_t keycap = priv->keycap ? priv->keycap : 64;
+    uint8_t * keybuf = NULL;
+
+    if (size + 1 <= priv->keycap)
+    {
+        return true;
+    }
+
+    while (keycap < size + 1)
+    {
+        keycap <<= 1;
+    }
+
+    keybuf = (uint8_t *) realloc(priv->keybuf, keycap);
+    if (!keybuf)
+    {
+        BLAMMO(FATAL, "realloc(%zu) failed", keycap);
+        return false;
+    }
+
+    priv->keybuf = keybuf;
+    priv->keycap = keycap;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+// Depth-first, in-order walk for complete().  The key buffer holds the
+// full key leading up to and including this node's label.  Returns false
+// if the visitor asked to stop.
+static bool trie_node_walk(trie_priv_t * priv,
+                           trie_node_t * node,
+                           size_t keylen,
+                           trie_visit_f visit,
+                           void * object,
+                           size_t * count)
+{
+    trie_node_t * child = NULL;
+    size_t i;
+
+    if (node->terminal)
+    {
+        (*count)++;
+        priv->keybuf[keylen] = '\0';
+        if (visit && !visit(object, (const char *) priv->keybuf,
+                            keylen, node->data))
+        {
+            return false;
+        }
+    }
+
+    for (i = 0; i < node->count; i++)
+    {
+        child = node->children[i];
+        if (!trie_keybuf_reserve(priv, keylen + child->size))
+        {
+            return false;
+        }
+
+        memcpy(priv->keybuf + keylen, child->label, child->size);
+        if (!trie_node_walk(priv, child, keylen + child->size,
+                            visit, object, count))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static trie_t * trie_create(generic_copy_f data_copy,
+                            generic_destroy_f data_destroy)
+{
+    // Allocate and initialize public interface
+    trie_t * trie = (trie_t *) malloc(sizeof(trie_t));
+    if (!trie)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(trie_t)) failed");
+        return NULL;
+    }
+
+    // bulk copy all function pointers and init opaque ptr
+    memcpy(trie, &trie_pub, sizeof(trie_t));
+
+    // Allocate and initialize private implementation
+    trie->priv = malloc(sizeof(trie_priv_t));
+    if (!trie->priv)
+    {
+        BLAMMO(FATAL, "malloc(sizeof(trie_priv_t)) failed");
+        free(trie);
+        return NULL;
+    }
+
+    memzero(trie->priv, sizeof(trie_priv_t));
+
+    trie_priv_t * priv = (trie_priv_t *) trie->priv;
+    priv->data_copy = data_copy;
+    priv->data_destroy = data_destroy;
+
+    priv->root = trie_node_create(NULL, 0);
+    if (!priv->root)
+    {
+        free(trie->priv);
+        free(trie);
+        return NULL;
+    }
+
+    return trie;
+}
+
+//------------------------------------------------------------------------|
+static void trie_destroy(void * trie_ptr)
+{
+    trie_t * trie = (trie_t *) trie_ptr;
+
+    // guard against accidental double-destroy or early-destroy
+    if (!trie || !trie->priv)
+    {
+        BLAMMO(WARNING, "attempt to early or double-destroy");
+        return;
+    }
+
+    trie_priv_t * priv = (trie_priv_t *) trie->priv;
+
+    // remove all keys and destroy their data, including the root
+    trie_node_destroy(priv, priv->root);
+    free(priv->keybuf);
+
+    // zero out and destroy the private data
+    memzero(trie->priv, sizeof(trie_priv_t));
+    free(trie->priv);
+
+    // zero out and destroy the public interface
+    memzero(trie, sizeof(trie_t));
+    free(trie);
+}
+
+//------------------------------------------------------------------------|
+static void trie_clear(trie_t * trie)
+{
+    trie_priv_t * priv = (trie_priv_t * ) trie->priv;
+    trie_node_t * root = trie_node_create(NULL, 0);
+
+    if (!root)
+    {
+        return;
+    }
+
+    trie_node_destroy(priv, priv->root);
+    priv->root = root;
+    priv->length = 0;
+}
+
+//------------------------------------------------------------------------|
+static inline bool trie_empty(trie_t * trie)
+{
+    return (0 == ((trie_priv_t *) trie->priv)->length);
+}
+
+//------------------------------------------------------------------------|
+static inline size_t trie_length(trie_t * trie)
+{
+    return ((trie_priv_t *) trie->priv)->length;
+}
+
+//------------------------------------------------------------------------|
+static trie_t * trie_copy(trie_t * trie)
+{
+    trie_priv_t * priv = (trie_priv_t *) trie->priv;
+    trie_t * copy = trie_create(priv->data_copy, priv->data_destroy);
+    trie_node_t * root = NULL;
+
+    if (!copy)
+    {
+        BLAMMO(ERROR, "trie_create() copy failed");
+        return NULL;
+    }
+
+    // Structure is cloned as-is, no need to re-insert every key
+    root = trie_node_clone(priv, priv->root);
+    if (!root)
+    {
+        copy->destroy(copy);
+        return NULL;
+    }
+
+    trie_priv_t * copy_priv = (trie_priv_t *) copy->priv;
+    trie_node_free(copy_priv->root);
+    copy_priv->root = root;
+    copy_priv->length = priv->length;
+    return copy;
+}
+
+//------------------------------------------------------------------------|
+static void * trie_get(trie_t * trie, const void * key, size_t size)
+{
+    trie_node_t * node = trie_node_find((trie_priv_t *) trie->priv,
+                                        (const uint8_t *) key, size);
+    return node ? node->data : NULL;
+}
+
+//------------------------------------------------------------------------|
+static bool trie_contains(trie_t * trie, const void * key, size_t size)
+{
+    return NULL != trie_node_find((trie_priv_t *) trie->priv,
+                                  (const uint8_t *) key, size);
+}
+
+//------------------------------------------------------------------------|
+static bool trie_set(trie_t * trie,
+                     const void * key_ptr,
+                     size_t size,
+                     void * data)
+{
+    trie_priv_t * priv = (trie_priv_t *) trie->priv;
+    const uint8_t * key = (const uint8_t *) key_ptr;
+    trie_node_t * node = priv->root;
+    trie_node_t * child = NULL;
+    trie_node_t * split = NULL;
+    bool found = false;
+    size_t common;
+    size_t index;
+
+    while (size > 0)
+    {
+        index = trie_child_index(node, key[0], &found);
+
+        // Nothing shares this byte: the remainder becomes one new leaf
+        if (!found)
+        {
+            if (!trie_node_reserve(node))
+            {
+                return false;
+            }
+
+            child = trie_node_create(key, size);
+            if (!child)
+            {
+                return false;
+            }
+
+            trie_child_insert(node, index, child);
+            node = child;
+            break;
+        }
+
+        // A child shares at least the first byte.  If the key diverges
+        // part-way along its label, split the label at that point.
+        child = node->children[index];
+        common = trie_common(child->label, child->size, key, size);
+        if (common < child->size)
+        {
+            split = trie_node_create(child->label, common);
+            if (!split || !trie_node_reserve(split))
+            {
+                if (split)
+                {
+                    trie_node_free(split);
+                }
+
+                return false;
+            }
+
+            memmove(child->label, child->label + common, child->size - common);
+            child->size -= common;
+            trie_child_insert(split, 0, child);
+            node->children[index] = split;
+            child = split;
+        }
+
+        key += common;
+        size -= common;
+        node = child;
+    }
+
+    if (node->terminal)
+    {
+        if (node->data && priv->data_destroy)
+        {
+            priv->data_destroy(node->data);
+        }
+    }
+    else
+    {
+        node->terminal = true;
+        priv->length++;
+    }
+
+    node->data = data;
+    return true;
+}
+
+//------------------------------------------------------------------------|
+static bool trie_remove(trie_t * trie, const void * key, size_t size)
+{
+    trie_priv_t * priv = (trie_priv_t *) trie->priv;
+    return trie_node_remove(priv, priv->root, (const uint8_t *) key, size);
+}
+
+//------------------------------------------------------------------------|
+static void * trie_longest_prefix(trie_t * trie,
+                                  const void * key_ptr,
+                                  size_t size,
+                                  size_t * matched)
+{
+    trie_priv_t * priv = (trie_priv_t *) trie->priv;
+    const uint8_t * key = (const uint8_t *) key_ptr;
+    trie_node_t * node = priv->root;
+    trie_node_t * child = NULL;
+    trie_node_t * best = node->terminal ? node : NULL;
+    bool found = false;
+    size_t depth = 0;
+    size_t index;
+
+    *matched = 0;
+    while (depth < size)
+    {
+        index = trie_child_index(node, key[depth], &found);
+        if (!found)
+        {
+            break;
+        }
+
+        child = node->children[index];
+        if (child->size > size - depth ||
+            memcmp(child->label, key + depth, child->size))
+        {
+            break;
+        }
+
+        depth += child->size;
+        node = child;
+
+        if (node->terminal)
+        {
+            best = node;
+            *matched = depth;
+        }
+    }
+
+    return best ? best->data : NULL;
+}
+
+//------------------------------------------------------------------------|
+static size_t trie_complete(trie_t * trie,
+                            const void * prefix_ptr,
+                            size_t size,
+                            trie_visit_f visit,
+                            void * object)
+{
+    trie_priv_t * priv = (trie_priv_t *) trie->priv;
+    const uint8_t * prefix = (const uint8_t *) prefix_ptr;
+    trie_node_t * node = priv->root;
+    trie_node_t * child = NULL;
+    bool found = false;
+    size_t keylen = 0;
+    size_t count = 0;
+    size_t index;
+    size_t n;
+
+    if (!trie_keybuf_reserve(priv, size))
+    {
+        return 0;
+    }
+
+    // Descend to the node covering the prefix.  The prefix may end part
+    // way along an edge, in which case that whole subtree still matches.
+    while (keylen < size)
+    {
+        index = trie_child_index(node, prefix[keylen], &found);
+        if (!found)
+        {
+            return 0;
+        }
+
+        child = node->children[index];
+        n = MIN(child->size, size - keylen);
+        if (memcmp(child->label, prefix + keylen, n))
+        {
+            return 0;
+        }
+
+        if (!trie_keybuf_reserve(priv, keylen + child->size))
+        {
+            return 0;
+        }
+
+        memcpy(priv->keybuf + keylen, child->label, child->size);
+        keylen += child->size;
+        node = child;
+    }
+
+    trie_node_walk(priv, node, keylen, visit, object, &count);
+    return count;
+}
+
+//------------------------------------------------------------------------|
+const trie_t trie_pub = {
+    &trie_create,
+    &trie_destroy,
+    &trie_clear,
+    &trie_empty,
+    &trie_length,
+    &trie_copy,
+    &trie_get,
+    &trie_contains,
+    &trie_set,
+    &trie_remove,
+    &trie_longest_prefix,
+    &trie_complete,
+    NULL
+};
@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------|
+// A compressed radix tree (a.k.a. PATRICIA trie) over arbitrary byte
+// keys.  Runs of single-child nodes are collapsed into one edge label, so
+// lookups cost Order-key-length regardless of the number of keys stored.
+// Like chain_t, payloads are homogeneous and managed by the copy and
+// destroy callbacks provided at creation (either may be NULL).
+#include "utils.h"          // generic function signatures
+
+//------------------------------------------------------------------------|
+// Visitor callback used for prefix enumeration.  The key is always NUL
+// terminated for convenience (e.g. tab-completion strings) but may also
+// contain embedded NUL bytes, hence the explicit size.  Return false to
+// stop the enumeration early.
+typedef bool (*trie_visit_f)(void * object,
+                             const char * key,
+                             size_t size,
+                             void * data);
+
+//------------------------------------------------------------------------|
+typedef struct trie_t
+{
+    // Trie factory function.  Payload copy and destroy functions work
+    // exactly as they do for chain_t.
+    struct trie_t * (*create)(generic_copy_f data_copy,
+                              generic_destroy_f data_destroy);
+
+    // Trie destructor function
+    void (*destroy)(void * trie);
+
+    // Empty the trie: Removes all keys and destroys their data.
+    void (*clear)(struct trie_t * trie);
+
+    // Whether the trie is empty or not
+    bool (*empty)(struct trie_t * trie);
+
+    // Gets the number of keys stored in the trie
+    size_t (*length)(struct trie_t * trie);
+
+    // Produce a full deep copy of the trie, including all payloads
+    struct trie_t * (*copy)(struct trie_t * trie);
+
+    // Get the payload for an exact key.  Returns NULL if it doesn't exist.
+    void * (*get)(struct trie_t * trie, const void * key, size_t size);
+
+    // Returns true if the exact key exists (payloads may be NULL)
+    bool (*contains)(struct trie_t * trie, const void * key, size_t size);
+
+    // Set the payload for a key, adding the key if it does not exist, or
+    // else destroying and overwriting the previous payload if it does.
+    // Returns false only if memory could not be allocated.
+    bool (*set)(struct trie_t * trie,
+                const void * key,
+                size_t size,
+                void * data);
+
+    // Remove a key and destroy its payload.  Returns true if the key
+    // was found and removed, or false if the key was not found.
+    bool (*remove)(struct trie_t * trie, const void * key, size_t size);
+
+    // Find the longest stored key that is a prefix of the given key.
+    // Returns its payload and sets 'matched' to its length, or returns
+    // NULL with 'matched' set to zero if no stored key is a prefix.
+    void * (*longest_prefix)(struct trie_t * trie,
+                             const void * key,
+                             size_t size,
+                             size_t * matched);
+
+    // Enumerate every key beginning with the given prefix in ascending
+    // byte order, calling 'visit' for each.  Locating the prefix costs
+    // Order-prefix-length.  Returns the number of keys visited.
+    size_t (*complete)(struct trie_t * trie,
+                       const void * prefix,
+                       size_t size,
+                       trie_visit_f visit,
+                       void * object);
+
+    // Private data
+    void * priv;
+}
+trie_t;
+
+//------------------------------------------------------------------------|
+// Public trie interface
+extern const trie_t trie_pub;
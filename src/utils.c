@@ -116,11 +116,86 @@ bool str_to_bool(const char * str)
     return false;
 }
 
+//------------------------------------------------------------------------|
+bool cpu_path_supported(cpu_path_t path)
+{
+    switch (path)
+    {
+    case CPU_PATH_AUTO:
+    case CPU_PATH_SCALAR:
+        return true;
+#if defined(__x86_64__) || defined(__i386__)
+    case CPU_PATH_SSE2:
+        return __builtin_cpu_supports("sse2");
+    case CPU_PATH_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+//------------------------------------------------------------------------|
+const void * cpu_kernel_select(const void * kernels,
+                               size_t count,
+                               size_t stride,
+                               cpu_path_t path,
+                               const void ** best)
+{
+    const uint8_t * table = (const uint8_t *) kernels;
+    const cpu_kernel_t * kernel;
+    size_t i;
+
+    if (path == CPU_PATH_AUTO)
+    {
+        // Probing the CPU again on every call is cheap but not free.
+        // Racing threads all arrive at the same answer.
+        const void * found = __atomic_load_n(best, __ATOMIC_RELAXED);
+        if (found)
+        {
+            return found;
+        }
+
+        found = table;
+        for (i = 1; i < count; i++)
+        {
+            kernel = (const cpu_kernel_t *) (table + i * stride);
+            if (cpu_path_supported(kernel->path))
+            {
+                found = kernel;
+            }
+        }
+
+        __atomic_store_n(best, found, __ATOMIC_RELAXED);
+        return found;
+    }
+
+    if (cpu_path_supported(path))
+    {
+        for (i = 0; i < count; i++)
+        {
+            kernel = (const cpu_kernel_t *) (table + i * stride);
+            if (kernel->path == path)
+            {
+                return kernel;
+            }
+        }
+    }
+
+    return table;
+}
+
 //------------------------------------------------------------------------|
 inline void * memzero(void * ptr, size_t size)
 {
 #ifdef __STDC_LIB_EXT1__
     memset_s(pointer, size, 0, size);
+#elif defined(__GNUC__)
+    // Plain memset() is much faster than a volatile byte loop.  The empty
+    // asm that claims to read the memory keeps it from being dropped as a
+    // dead store, the same way glibc's explicit_bzero() does.
+    memset(ptr, 0, size);
+    __asm__ __volatile__ ("" : : "r" (ptr) : "memory");
 #else
     volatile unsigned char *p = ptr;
     while (size--)
@@ -25,8 +25,10 @@
 #pragma once
 
 //-----------------------------------------------------------------------------+
+#include <sys/types.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 //------------------------------------------------------------------------|
@@ -68,7 +70,61 @@ typedef void * (*generic_copy_f)(const void * object);
 // deallocated.  These are used all over the place for garbage collection.
 typedef void (*generic_destroy_f)(void * object);
 
-// TODO: consider serialization/de-serialization function signatures.
+// Generic hash function signature.  Returns a 64-bit hash of the passed-in
+// object, such that objects that compare equal hash equally.  Used by hash
+// tables and filters that hold objects of a type they know nothing about.
+typedef uint64_t (*generic_hash_f)(const void * object);
+
+// Generic object serializer signature.  Similar to snprintf(): writes the
+// flattened object into 'buffer', which holds 'size' bytes, and returns the
+// full serialized size, which may be larger than 'size' (notably when
+// 'buffer' is NULL and 'size' is zero).  Returns negative on error.  The
+// output must not contain pointers, so that it stays valid in another
+// process or a later run.
+typedef ssize_t (*generic_serialize_f)(const void * object,
+                                       void * buffer,
+                                       size_t size);
+
+// Generic object deserializer signature.  The inverse of the above: builds
+// a heap-allocated object from 'size' bytes of serialized data, or
+// returns NULL on error.
+typedef void * (*generic_deserialize_f)(const void * data, size_t size);
+
+//-----------------------------------------------------------------------------+
+// Code paths for functions that pick a SIMD kernel at runtime, such as
+// hash_bytes() and the search_*() functions.  Asking for a path the CPU does
+// not support gets the scalar one.
+typedef enum
+{
+    CPU_PATH_AUTO = 0,      // best path this CPU supports
+    CPU_PATH_SCALAR,        // portable C
+    CPU_PATH_SSE2,          // x86 SSE2
+    CPU_PATH_AVX2,          // x86 AVX2
+}
+cpu_path_t;
+
+// The first member of each entry in a table of kernels: the path the entry
+// implements, and its name
+typedef struct
+{
+    cpu_path_t path;
+    const char * name;
+}
+cpu_kernel_t;
+
+// Whether a code path can run on this CPU
+bool cpu_path_supported(cpu_path_t path);
+
+// Pick the entry for 'path' from a table of 'count' kernels, 'stride' bytes
+// apart, each starting with a cpu_kernel_t.  The first entry must be the
+// scalar one, and is picked for paths that are unsupported or not in the
+// table.  For CPU_PATH_AUTO the best supported entry is picked once, and
+// remembered in '*best', which starts out NULL.
+const void * cpu_kernel_select(const void * kernels,
+                               size_t count,
+                               size_t stride,
+                               cpu_path_t path,
+                               const void ** best);
 
 //-----------------------------------------------------------------------------+
 void hexdump(const void * buf, size_t len, size_t addr);
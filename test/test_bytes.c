@@ -26,9 +26,45 @@
 
 #include "blammo.h"
 #include "bytes.h"
+#include "chronom.h"
+#include "hash.h"
 #include "prng.h"
 #include "mut.h"
 
+//------------------------------------------------------------------------|
+// Tokens from a bytes_tokenizer_t, checked against expected spans as they
+// come, if there are any
+typedef struct
+{
+    const char * text;
+    const bytes_span_t * expect;
+    size_t count;
+    size_t stop;        // stop after this many, if nonzero
+    bool same;
+}
+streamed_t;
+
+static streamed_t streamed;
+
+static bool stream_token(void * object,
+                         const uint8_t * token,
+                         const bytes_span_t * span)
+{
+    streamed_t * s = (streamed_t *) object;
+
+    if (s->expect)
+    {
+        const bytes_span_t * e = &s->expect[s->count];
+        s->same &= span->offset == e->offset &&
+                   span->length == e->length &&
+                   span->encaps == e->encaps &&
+                   !memcmp(token, s->text + e->offset, e->length);
+    }
+
+    s->count++;
+    return s->count != s->stop;
+}
+
 TESTSUITE_BEGIN
 
     // Simple test of the blammo logger
@@ -92,6 +128,38 @@ TEST_BEGIN("compare")
     d->destroy(d);
 TEST_END
 
+TEST_BEGIN("hash")
+    bytes_t * a = bytes_pub.create("asdfvcxz", 8);
+    bytes_t * b = bytes_pub.create("asdfvcxz", 8);
+    bytes_t * c = bytes_pub.create("asdfvcx", 7);
+    bytes_t * e = bytes_pub.create(NULL, 0);
+
+    CHECK(a->hash(a) == b->hash(b));
+    CHECK(a->hash(a) != c->hash(c));
+    CHECK(a->hash(a) == hash_bytes("asdfvcxz", 8, 0));
+    CHECK(e->hash(e) == hash_bytes(NULL, 0, 0));
+
+    a->destroy(a);
+    b->destroy(b);
+    c->destroy(c);
+    e->destroy(e);
+TEST_END
+
+TEST_BEGIN("checksum")
+    bytes_t * a = bytes_pub.create("123456789", 9);
+    bytes_t * e = bytes_pub.create(NULL, 0);
+
+    CHECK(a->checksum(a, CHECKSUM_CRC32C) == 0xe3069283UL);
+    CHECK(a->checksum(a, CHECKSUM_CRC32) == 0xcbf43926UL);
+    CHECK(a->checksum(a, CHECKSUM_CRC16) == 0x29b1);
+    CHECK(a->checksum(a, CHECKSUM_ADLER32) == 0x091e01deUL);
+    CHECK(e->checksum(e, CHECKSUM_CRC32) == 0);
+    CHECK(e->checksum(e, CHECKSUM_ADLER32) == 1);
+
+    a->destroy(a);
+    e->destroy(e);
+TEST_END
+
 TEST_BEGIN("data")
     const uint8_t stuff[] = {
         0xDE, 0xAD, 0xBE, 0xEF,
@@ -216,6 +284,146 @@ TEST_BEGIN("append")
 
 TEST_END
 
+TEST_BEGIN("capacity/reserve/shrink_to_fit")
+    bytes_t * bytes = bytes_pub.create(NULL, 0);
+    CHECK(bytes->capacity(bytes) == 0);
+
+    // Reserving must not change size or contents
+    CHECK(bytes->reserve(bytes, 1000));
+    CHECK(bytes->capacity(bytes) >= 1000);
+    CHECK(bytes->size(bytes) == 0);
+    CHECK(!bytes->empty(bytes));
+    CHECK(bytes->cstr(bytes)[0] == 0);
+
+    // Appends within the reservation do not move the data
+    const uint8_t * data = bytes->data(bytes);
+    for (size_t i = 0; i < 100; i++)
+    {
+        bytes->append(bytes, "0123456789", 10);
+    }
+    CHECK(bytes->data(bytes) == data);
+    CHECK(bytes->size(bytes) == 1000);
+    CHECK(bytes->cstr(bytes)[1000] == 0);
+    CHECK(memcmp(bytes->cstr(bytes) + 990, "0123456789", 10) == 0);
+
+    // Growth is geometric, and shrinking the size keeps the capacity
+    bytes->append(bytes, "x", 1);
+    size_t capacity = bytes->capacity(bytes);
+    CHECK(capacity >= 2000);
+    bytes->resize(bytes, 10);
+    CHECK(bytes->capacity(bytes) == capacity);
+    CHECK(strcmp(bytes->cstr(bytes), "0123456789") == 0);
+
+    // Re-growing must zero what was left over in the spare capacity
+    bytes->resize(bytes, 20);
+    CHECK(bytes->data(bytes)[10] == 0);
+    CHECK(bytes->data(bytes)[19] == 0);
+    bytes->resize(bytes, 10);
+
+    // A smaller reservation is a no-op
+    CHECK(bytes->reserve(bytes, 5));
+    CHECK(bytes->capacity(bytes) == capacity);
+
+    // Short enough to move back into the inline buffer
+    CHECK(bytes->shrink_to_fit(bytes));
+    CHECK(bytes->capacity(bytes) < capacity);
+    CHECK(bytes->capacity(bytes) >= 10);
+    CHECK(strcmp(bytes->cstr(bytes), "0123456789") == 0);
+
+    // print() reuses spare capacity and still terminates
+    bytes->reserve(bytes, 64);
+    CHECK(bytes->print(bytes, "%d-%s", 42, "abc") == 6);
+    CHECK(bytes->size(bytes) == 6);
+    CHECK(strcmp(bytes->cstr(bytes), "42-abc") == 0);
+
+    bytes->clear(bytes);
+    CHECK(bytes->capacity(bytes) == 0);
+    CHECK(bytes->empty(bytes));
+    bytes->destroy(bytes);
+TEST_END
+
+TEST_BEGIN("short strings")
+    // Short contents live inline, so the data pointer stays put while
+    // growing up to the inline capacity, then moves out to the heap
+    bytes_t * bytes = bytes_pub.create("short", 5);
+    size_t inline_capacity = bytes->capacity(bytes);
+    const uint8_t * data = bytes->data(bytes);
+    CHECK(inline_capacity >= 23);
+
+    while (bytes->size(bytes) < inline_capacity)
+    {
+        bytes->append(bytes, "x", 1);
+        CHECK(bytes->data(bytes) == data);
+    }
+
+    bytes->append(bytes, "y", 1);
+    CHECK(bytes->data(bytes) != data);
+    CHECK(bytes->size(bytes) == inline_capacity + 1);
+    CHECK(bytes->cstr(bytes)[bytes->size(bytes)] == 0);
+    CHECK(strncmp(bytes->cstr(bytes), "shortxxx", 8) == 0);
+    CHECK(bytes->cstr(bytes)[inline_capacity] == 'y');
+
+    // Copies of short buffers are independent
+    bytes->resize(bytes, 5);
+    CHECK(bytes->shrink_to_fit(bytes));
+    bytes_t * copy = bytes->copy(bytes);
+    CHECK(copy->data(copy) != bytes->data(bytes));
+    CHECK(bytes->compare(bytes, copy) == 0);
+    copy->fill(copy, 'z');
+    CHECK(strcmp(bytes->cstr(bytes), "short") == 0);
+    CHECK(strcmp(copy->cstr(copy), "zzzzz") == 0);
+
+    copy->destroy(copy);
+    bytes->destroy(bytes);
+TEST_END
+
+TEST_BEGIN("short create/destroy throughput")
+    const size_t count = 1000000;
+    const char * key = "user:12345:session";
+    chronom_t * chronom = chronom_pub.create();
+    size_t total = 0;
+
+    chronom->start(chronom);
+    for (size_t i = 0; i < count; i++)
+    {
+        bytes_t * bytes = bytes_pub.create(key, 18);
+        total += bytes->size(bytes);
+        bytes->destroy(bytes);
+    }
+    chronom->stop(chronom);
+
+    CHECK(total == count * 18);
+    BLAMMO(INFO, "create/destroy of 18-byte buffers: %.1f ns each",
+                 chronom->elapsed_seconds(chronom) * 1e9 / count);
+    chronom->destroy(chronom);
+TEST_END
+
+TEST_BEGIN("append throughput")
+    // Build a large buffer from small appends.  This used to realloc() on
+    // every call, now capacity doubles so copying is amortized Order-1.
+    const size_t target = 100 * 1024 * 1024;
+    const char chunk[] = "0123456789abcdef";
+    chronom_t * chronom = chronom_pub.create();
+    bytes_t * bytes = bytes_pub.create(NULL, 0);
+
+    chronom->start(chronom);
+    for (size_t i = 0; i < target; i += 16)
+    {
+        bytes->append(bytes, chunk, 16);
+    }
+    chronom->stop(chronom);
+
+    CHECK(bytes->size(bytes) == target);
+    CHECK(bytes->capacity(bytes) >= target);
+    CHECK(bytes->cstr(bytes)[target] == 0);
+    CHECK(memcmp(bytes->data(bytes) + target - 16, chunk, 16) == 0);
+    BLAMMO(INFO, "%zu MiB from 16-byte appends: %.1f ms",
+                 target >> 20, chronom->elapsed_seconds(chronom) * 1e3);
+
+    bytes->destroy(bytes);
+    chronom->destroy(chronom);
+TEST_END
+
 TEST_BEGIN("print/append")
     bytes_t * a = bytes_pub.create(NULL, 0);
     bytes_t * b = bytes_pub.create(NULL, 0);
@@ -236,6 +444,123 @@ TEST_BEGIN("print/append")
 
 TEST_END
 
+TEST_BEGIN("append_print")
+    bytes_t * bytes = bytes_pub.create("abc", 3);
+    char expect[64];
+
+    CHECK(bytes->append_print(bytes, "%d-%s", 42, "x") == 4);
+    CHECK(strcmp(bytes->cstr(bytes), "abc42-x") == 0);
+    CHECK(bytes->size(bytes) == 7);
+    CHECK(bytes->append_print(bytes, "%s", "") == 0);
+    CHECK(bytes->size(bytes) == 7);
+
+    // Past the inline buffer and the current capacity, needing the
+    // second pass, with the earlier contents kept intact
+    CHECK(bytes->append_print(bytes, "%040d", 7) == 40);
+    CHECK(bytes->size(bytes) == 47);
+    CHECK(memcmp(bytes->cstr(bytes), "abc42-x000", 10) == 0);
+    CHECK(strcmp(bytes->cstr(bytes) + 45, "07") == 0);
+    CHECK(bytes->append_print(bytes, NULL) < 0);
+    CHECK(bytes->size(bytes) == 47);
+
+    // print() still replaces, and appending from empty works
+    CHECK(bytes->print(bytes, "%u", 5u) == 1);
+    CHECK(strcmp(bytes->cstr(bytes), "5") == 0);
+    bytes->clear(bytes);
+    CHECK(bytes->append_print(bytes, "%c%c", 'h', 'i') == 2);
+    CHECK(strcmp(bytes->cstr(bytes), "hi") == 0);
+    bytes->destroy(bytes);
+
+    // Many fragments, formatted into one buffer versus through a
+    // temporary object each, as report builders used to
+    const size_t count = 1000000;
+    chronom_t * chronom = chronom_pub.create();
+    bytes_t * direct = bytes_pub.create(NULL, 0);
+    bytes_t * joined = bytes_pub.create(NULL, 0);
+    double seconds[2];
+
+    chronom->start(chronom);
+    for (size_t i = 0; i < count; i++)
+    {
+        bytes_t * temp = bytes_pub.print_create("%zu:%x ", i, (unsigned) i);
+        joined->append(joined, temp->data(temp), temp->size(temp));
+        temp->destroy(temp);
+    }
+    chronom->stop(chronom);
+    seconds[0] = chronom->elapsed_seconds(chronom);
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (size_t i = 0; i < count; i++)
+    {
+        direct->append_print(direct, "%zu:%x ", i, (unsigned) i);
+    }
+    chronom->stop(chronom);
+    seconds[1] = chronom->elapsed_seconds(chronom);
+
+    CHECK(direct->compare(direct, joined) == 0);
+    snprintf(expect, sizeof(expect), "%zu:%x ", count - 1,
+             (unsigned) (count - 1));
+    CHECK(strcmp(direct->cstr(direct) + direct->size(direct) -
+                 strlen(expect), expect) == 0);
+    BLAMMO(INFO, "%zu formatted fragments: print_create()+append() "
+                 "%.1f ms, append_print() %.1f ms", count,
+                 seconds[0] * 1e3, seconds[1] * 1e3);
+
+    direct->destroy(direct);
+    joined->destroy(joined);
+    chronom->destroy(chronom);
+TEST_END
+
+TEST_BEGIN("append/parse numbers")
+    bytes_t * bytes = bytes_pub.create("n=", 2);
+    uint64_t u = 0;
+    int64_t s = 0;
+    double d = 0.0;
+    ssize_t length;
+
+    bytes->append_u64(bytes, 18446744073709551615ULL);
+    bytes->append(bytes, " ", 1);
+    bytes->append_i64(bytes, -42);
+    bytes->append(bytes, " 0x", 3);
+    bytes->append_hex(bytes, 0xbeef, 8);
+    bytes->append(bytes, " ", 1);
+    bytes->append_double(bytes, 0.1);
+    bytes->append(bytes, " ", 1);
+    bytes->append_double(bytes, -1.5e300);
+    CHECK(strcmp(bytes->cstr(bytes),
+                 "n=18446744073709551615 -42 0x0000beef 0.1 -1.5e+300") == 0);
+
+    // Walk the fields back, each parse saying where the next begins
+    length = bytes->parse_u64(bytes, 2, &u);
+    CHECK(length == 20 && u == 18446744073709551615ULL);
+    length = bytes->parse_i64(bytes, 23, &s);
+    CHECK(length == 3 && s == -42);
+    length = bytes->parse_hex(bytes, 27, &u);
+    CHECK(length == 10 && u == 0xbeef);
+    length = bytes->parse_double(bytes, 38, &d);
+    CHECK(length == 3 && d == 0.1);
+    length = bytes->parse_double(bytes, 42, &d);
+    CHECK(length == 9 && d == -1.5e300);
+
+    CHECK(bytes->parse_u64(bytes, 0, &u) < 0);
+    CHECK(bytes->parse_u64(bytes, bytes->size(bytes), &u) < 0);
+    CHECK(bytes->parse_double(bytes, bytes->size(bytes) + 1, &d) < 0);
+    bytes->destroy(bytes);
+
+    // Appending numbers to an empty buffer, past the inline storage
+    bytes = bytes_pub.create(NULL, 0);
+    for (int i = 0; i < 1000; i++)
+    {
+        bytes->append_i64(bytes, i - 500);
+        bytes->append(bytes, ",", 1);
+    }
+    CHECK(memcmp(bytes->cstr(bytes), "-500,-499,", 10) == 0);
+    CHECK(strcmp(bytes->cstr(bytes) + bytes->size(bytes) - 8, "498,499,")
+          == 0);
+    bytes->destroy(bytes);
+TEST_END
+
 TEST_BEGIN("read_at")
     const char * str = "abc123";
     size_t len = strlen(str);
@@ -296,6 +621,46 @@ TEST_BEGIN("find_reverse")
     bytes->destroy(bytes);
 TEST_END
 
+TEST_BEGIN("find_all/count")
+    bytes_t * bytes = bytes_pub.create("aaa,bb,aaaa,,c", 14);
+    size_t count = 99;
+    const size_t * offsets;
+
+    offsets = bytes->find_all(bytes, 0, ",", 1, false, &count);
+    CHECK(count == 4);
+    CHECK(offsets[0] == 3 && offsets[1] == 6 && offsets[2] == 11 &&
+          offsets[3] == 12);
+    CHECK(bytes->count(bytes, 0, ",", 1, false) == 4);
+
+    offsets = bytes->find_all(bytes, 0, "aa", 2, false, &count);
+    CHECK(count == 3);
+    CHECK(offsets[0] == 0 && offsets[1] == 7 && offsets[2] == 9);
+    CHECK(bytes->count(bytes, 0, "aa", 2, false) == 3);
+
+    offsets = bytes->find_all(bytes, 0, "aa", 2, true, &count);
+    CHECK(count == 5);
+    CHECK(offsets[0] == 0 && offsets[1] == 1 && offsets[2] == 7 &&
+          offsets[3] == 8 && offsets[4] == 9);
+    CHECK(bytes->count(bytes, 0, "aa", 2, true) == 5);
+
+    // Offsets are absolute when starting part way through
+    offsets = bytes->find_all(bytes, 5, "aa", 2, false, &count);
+    CHECK(count == 2);
+    CHECK(offsets[0] == 7 && offsets[1] == 9);
+    CHECK(bytes->count(bytes, 5, "aa", 2, false) == 2);
+    CHECK(bytes->count(bytes, 8, "aa", 2, true) == 2);
+
+    // No matches gives an empty array rather than NULL
+    CHECK(bytes->find_all(bytes, 0, "x", 1, false, &count) != NULL);
+    CHECK(count == 0);
+    CHECK(bytes->find_all(bytes, 99, "a", 1, false, &count) != NULL);
+    CHECK(count == 0);
+    CHECK(bytes->count(bytes, 99, "a", 1, false) == 0);
+    CHECK(bytes->count(bytes, 0, "", 0, false) == 0);
+
+    bytes->destroy(bytes);
+TEST_END
+
 TEST_BEGIN("fill")
     bytes_t * bytes = bytes_pub.create(NULL, 20);
     bytes->fill(bytes, 'A');
@@ -403,7 +768,7 @@ TEST_BEGIN("tokenizer")
     tokens = bytes->tokenizer(bytes, split, encaps, " ", "#", &ntokens);
     CHECK(ntokens == 3);
     CHECK(!strcmp(tokens[0], "token_one"));
-    CHECK(!strcmp(tokens[1], "\"token two quoted\""));
+    CHECK(!strcmp(tokens[1], "token two quoted"));
     CHECK(!strcmp(tokens[2], "token_three"));
     CHECK(tokens[3] == NULL);
 
@@ -413,10 +778,238 @@ TEST_BEGIN("tokenizer")
     CHECK(!strcmp(tokens[0], "((x == y) && (w != z))"));
     CHECK(!strcmp(tokens[1], "two"));
     CHECK(!strcmp(tokens[2], "three"));
-    CHECK(!strcmp(tokens[3], "\"four is quoted\""));
+    CHECK(!strcmp(tokens[3], "four is quoted"));
     CHECK(!strcmp(tokens[4], "five"));
     CHECK(tokens[5] == NULL);
 
+    // Without splitting, quotes stay and the buffer is left alone
+    bytes->assign(bytes, c, strlen(c));
+    tokens = bytes->tokenizer(bytes, false, encaps, " ", "#", &ntokens);
+    CHECK(ntokens == 5);
+    CHECK(!strncmp(tokens[0], "((x == y) && (w != z))", 22));
+    CHECK(!strncmp(tokens[3], "\"four is quoted\"", 16));
+    CHECK(!strcmp(tokens[4], "five #comment"));
+    CHECK(!strcmp(bytes->cstr(bytes), c));
+
+    bytes->destroy(bytes);
+TEST_END
+
+TEST_BEGIN("spans")
+    const char * c = "((x == y) && (w != z)) two three \"four is quoted\" five #comment";
+    const char * encaps[] = { "\"\"", "()", NULL };
+    const char * alphabet = "ab  \t#\"()";
+    bytes_t * bytes = bytes_pub.create(c, strlen(c));
+    bytes_t * other = bytes_pub.create(NULL, 0);
+    bytes_span_t * array = NULL;
+    size_t capacity = 0;
+    size_t ntokens = 0;
+    size_t round;
+    size_t i;
+
+    const bytes_span_t * spans = bytes->spans(bytes, encaps, " ", "#",
+                                              &ntokens);
+    CHECK(ntokens == 5);
+    CHECK(spans[0].offset == 0 && spans[0].length == 22);
+    CHECK(spans[0].encaps == 1);
+    CHECK(spans[1].offset == 23 && spans[1].length == 3);
+    CHECK(spans[1].encaps < 0);
+    CHECK(spans[3].offset == 33 && spans[3].length == 16);
+    CHECK(spans[3].encaps == 0);
+    CHECK(spans[4].offset == 50 && spans[4].length == 4);
+    CHECK(!strcmp(bytes->cstr(bytes), c));
+
+    // String literals are read-only, and the array is reused once it is
+    // large enough
+    CHECK(bytes_tokenize(c, strlen(c), encaps, " ", NULL, &array,
+                         &capacity) == 6);
+    CHECK(array[5].offset == 55 && array[5].length == 8);
+    bytes_span_t * first = array;
+    CHECK(bytes_tokenize(c, strlen(c), NULL, " ", "#", &array,
+                         &capacity) == 13);
+    CHECK(array == first);
+    CHECK(bytes_tokenize("", 0, NULL, " ", NULL, &array, &capacity) == 0);
+    free(array);
+
+    // Same tokens as tokenizer() without splitting, on random input
+    prng_seed(29);
+    for (round = 0; round < 2000; round++)
+    {
+        char text[80];
+        size_t size = prng_next() % sizeof(text);
+
+        for (i = 0; i < size; i++)
+        {
+            text[i] = alphabet[prng_next() % strlen(alphabet)];
+        }
+
+        bytes->assign(bytes, text, size);
+        other->assign(other, text, size);
+        char ** tokens = other->tokenizer(other, false, encaps, " \t", "#",
+                                          &ntokens);
+        spans = bytes->spans(bytes, encaps, " \t", "#", &i);
+        CHECK(i == (tokens ? ntokens : 0));
+        for (i = 0; tokens && i < ntokens; i++)
+        {
+            CHECK(spans[i].offset ==
+                  (size_t) (tokens[i] - other->cstr(other)));
+        }
+    }
+
+    other->destroy(other);
+    bytes->destroy(bytes);
+TEST_END
+
+TEST_BEGIN("streaming tokenizer")
+    // Random input in random chunks, some empty, gives the same tokens as
+    // the whole of it at once.  Small alphabets make for tokens, nesting
+    // and 'ignore' strings across chunk boundaries.
+    const char * encaps[] = { "\"\"", "()", NULL };
+    const char * alphabet = "aab  \t#/\"(()";
+    bytes_tokenizer_t * tokenizer = bytes_tokenizer_pub.create(encaps, " \t",
+                                                               "//");
+    bytes_span_t * spans = NULL;
+    size_t capacity = 0;
+    char text[300];
+    size_t round;
+    size_t i;
+
+    streamed.count = 0;
+    streamed.stop = 0;
+    prng_seed(31);
+    for (round = 0; round < 3000; round++)
+    {
+        size_t size = prng_next() % sizeof(text);
+        size_t at = 0;
+        ssize_t count;
+        ssize_t total = 0;
+
+        for (i = 0; i < size; i++)
+        {
+            text[i] = alphabet[prng_next() % strlen(alphabet)];
+        }
+
+        if (round % 16 == 0 && size > 0)
+        {
+            text[prng_next() % size] = '\0';
+        }
+
+        count = bytes_tokenize(text, size, encaps, " \t", "//",
+                               &spans, &capacity);
+        streamed.text = text;
+        streamed.expect = spans;
+        streamed.count = 0;
+        streamed.same = true;
+        while (at < size)
+        {
+            size_t chunk = prng_next() % 24;
+
+            chunk = chunk < size - at ? chunk : size - at;
+            total += tokenizer->feed(tokenizer, text + at, chunk,
+                                     stream_token, &streamed);
+            at += chunk;
+        }
+
+        total += tokenizer->finish(tokenizer, stream_token, &streamed);
+        CHECK(total == count);
+        CHECK(streamed.count == (size_t) count);
+        CHECK(streamed.same);
+    }
+
+    // Stopping early skips the rest until the tokenizer is reset
+    const char * line = "one \"two (2)\" (three \"3\") four";
+    streamed.stop = 2;
+    streamed.count = 0;
+    CHECK(tokenizer->feed(tokenizer, line, 10, stream_token, &streamed) == 1);
+    CHECK(tokenizer->feed(tokenizer, line + 10, strlen(line) - 10,
+                          stream_token, &streamed) == 1);
+    CHECK(tokenizer->feed(tokenizer, line, strlen(line),
+                          stream_token, &streamed) == 0);
+    CHECK(tokenizer->finish(tokenizer, stream_token, &streamed) == 0);
+    CHECK(streamed.count == 2);
+
+    streamed.stop = 0;
+    streamed.count = 0;
+    streamed.expect = NULL;
+    CHECK(tokenizer->feed(tokenizer, line, strlen(line),
+                          stream_token, &streamed) == 3);
+    CHECK(tokenizer->finish(tokenizer, stream_token, &streamed) == 1);
+
+    free(spans);
+    tokenizer->destroy(tokenizer);
+TEST_END
+
+TEST_BEGIN("tokenizer throughput")
+    // A multi-megabyte command script, one line repeated with the usual
+    // mix of plain, quoted and parenthesized tokens and runs of blanks
+    const char * line = "set   name_1234 \"a quoted value\"\t(x + (y * z))"
+                        "    another_plain_token\n";
+    const size_t lines = 1 << 16;
+    const char * delim = " \t\n";
+    const char * encaps[] = { "\"\"", "()", NULL };
+    bytes_t * bytes = bytes_pub.create(NULL, 0);
+    chronom_t * chronom = chronom_pub.create();
+    size_t ntokens = 0;
+    size_t i;
+
+    bytes->reserve(bytes, lines * strlen(line));
+    for (i = 0; i < lines; i++)
+    {
+        bytes->append(bytes, line, strlen(line));
+    }
+
+    // Spans first, as splitting alters the data
+    chronom->start(chronom);
+    const bytes_span_t * spans = bytes->spans(bytes, encaps, delim, NULL,
+                                              &ntokens);
+    chronom->stop(chronom);
+
+    CHECK(ntokens == lines * 5);
+    CHECK(spans[ntokens - 2].length == strlen("(x + (y * z))"));
+    CHECK(spans[ntokens - 2].encaps == 1);
+    BLAMMO(INFO, "spans of %zu bytes, %zu tokens in %.2f ms",
+           lines * strlen(line), ntokens,
+           chronom->elapsed_seconds(chronom) * 1e3);
+
+    // Streamed in 64 KiB chunks, as from a pipe
+    bytes_tokenizer_t * tokenizer = bytes_tokenizer_pub.create(encaps, delim,
+                                                               NULL);
+    ssize_t streamed_tokens = 0;
+
+    streamed.expect = NULL;
+    streamed.stop = 0;
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < bytes->size(bytes); i += 1 << 16)
+    {
+        streamed_tokens += tokenizer->feed(tokenizer, bytes->data(bytes) + i,
+                                           bytes->size(bytes) - i < (1 << 16) ?
+                                           bytes->size(bytes) - i : 1 << 16,
+                                           stream_token, &streamed);
+    }
+
+    streamed_tokens += tokenizer->finish(tokenizer, stream_token, &streamed);
+    chronom->stop(chronom);
+
+    CHECK(streamed_tokens == (ssize_t) (lines * 5));
+    BLAMMO(INFO, "streamed %zu bytes, %zd tokens in %.2f ms",
+           lines * strlen(line), streamed_tokens,
+           chronom->elapsed_seconds(chronom) * 1e3);
+    tokenizer->destroy(tokenizer);
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    char ** tokens = bytes->tokenizer(bytes, true, encaps, delim, NULL,
+                                      &ntokens);
+    chronom->stop(chronom);
+
+    CHECK(ntokens == lines * 5);
+    CHECK(!strcmp(tokens[ntokens - 3], "a quoted value"));
+    CHECK(!strcmp(tokens[ntokens - 2], "(x + (y * z))"));
+    BLAMMO(INFO, "tokenized %zu bytes into %zu tokens in %.2f ms",
+           lines * strlen(line), ntokens,
+           chronom->elapsed_seconds(chronom) * 1e3);
+
+    chronom->destroy(chronom);
     bytes->destroy(bytes);
 TEST_END
 
@@ -0,0 +1,230 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "cache.h"
+#include "prng.h"
+#include "mut.h"
+#include "fixture.h"
+
+#include <string.h>
+#include <stdio.h>
+
+//------------------------------------------------------------------------|
+// Draw a rank in [0, n) from a Zipf distribution with exponent 1, given
+// the cumulative distribution of the ranks.
+static size_t zipf_draw(const double * cdf, size_t n)
+{
+    double u = (double) (prng_next() >> 11) / (double) (1ULL << 53);
+    size_t lo = 0;
+    size_t hi = n - 1;
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (cdf[mid] < u)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+//------------------------------------------------------------------------|
+TESTSUITE_BEGIN
+
+    // Simple test of the blammo logger
+    BLAMMO_LEVEL(INFO);
+    BLAMMO_FILE("test_cache.log");
+    BLAMMO(INFO, "cache tests...");
+
+    // because these aren't always used, some warning eaters:
+    (void) fixture_reset;
+    (void) fixture_report;
+    (void) fixture_payload_two;
+
+TEST_BEGIN("create")
+    CHECK(cache_pub.create(0, 0) == NULL);
+
+    cache_t * cache = cache_pub.create(4, 0);
+    CHECK(cache != NULL);
+    CHECK(cache->priv != NULL);
+    CHECK(cache->empty(cache));
+    CHECK(cache->length(cache) == 0);
+    CHECK(cache->cost(cache) == 0);
+    cache->destroy(cache);
+TEST_END
+
+TEST_BEGIN("least recently used eviction")
+    cache_t * cache = cache_pub.create(3, 0);
+    cache_stats_t stats;
+
+    CHECK(cache->put(cache, "a", (void *) 1, 1, NULL));
+    CHECK(cache->put(cache, "b", (void *) 2, 1, NULL));
+    CHECK(cache->put(cache, "c", (void *) 3, 1, NULL));
+    CHECK(cache->length(cache) == 3);
+
+    // touching 'a' leaves 'b' as the least recently used
+    CHECK(cache->get(cache, "a") == (void *) 1);
+    CHECK(cache->put(cache, "d", (void *) 4, 1, NULL));
+    CHECK(cache->length(cache) == 3);
+    CHECK(!cache->contains(cache, "b"));
+    CHECK(cache->get(cache, "b") == NULL);
+
+    // replacing refreshes recency as well
+    CHECK(cache->put(cache, "c", (void *) 33, 1, NULL));
+    CHECK(cache->put(cache, "e", (void *) 5, 1, NULL));
+    CHECK(!cache->contains(cache, "a"));
+    CHECK(cache->get(cache, "c") == (void *) 33);
+    CHECK(cache->get(cache, "d") == (void *) 4);
+    CHECK(cache->get(cache, "e") == (void *) 5);
+
+    cache->stats(cache, &stats);
+    CHECK(stats.hits == 4);
+    CHECK(stats.misses == 1);
+    CHECK(stats.inserts == 5);
+    CHECK(stats.evictions == 2);
+    CHECK(stats.hit_rate == 0.8);
+
+    CHECK(cache->remove(cache, "d"));
+    CHECK(!cache->remove(cache, "d"));
+    CHECK(cache->length(cache) == 2);
+
+    cache->reset_stats(cache);
+    cache->stats(cache, &stats);
+    CHECK(stats.hits == 0);
+    CHECK(stats.hit_rate == 0.0);
+
+    cache->clear(cache);
+    CHECK(cache->empty(cache));
+    CHECK(cache->get(cache, "c") == NULL);
+
+    cache->destroy(cache);
+TEST_END
+
+TEST_BEGIN("cost limit")
+    cache_t * cache = cache_pub.create(100, 100);
+
+    CHECK(cache->put(cache, "a", (void *) 1, 40, NULL));
+    CHECK(cache->put(cache, "b", (void *) 2, 40, NULL));
+    CHECK(cache->cost(cache) == 80);
+
+    // too expensive to ever fit, so it is refused outright
+    CHECK(!cache->put(cache, "huge", (void *) 3, 101, NULL));
+    CHECK(cache->length(cache) == 2);
+
+    CHECK(cache->put(cache, "c", (void *) 3, 30, NULL));
+    CHECK(!cache->contains(cache, "a"));
+    CHECK(cache->cost(cache) == 70);
+
+    // growing an object's cost may push out others
+    CHECK(cache->put(cache, "c", (void *) 3, 90, NULL));
+    CHECK(!cache->contains(cache, "b"));
+    CHECK(cache->length(cache) == 1);
+    CHECK(cache->cost(cache) == 90);
+
+    cache->destroy(cache);
+TEST_END
+
+TEST_BEGIN("managed payloads")
+    fixture_reset();
+    cache_t * cache = cache_pub.create(2, 0);
+
+    cache->put(cache, "one", payload_one_create(1), 1, payload_one_destroy);
+    cache->put(cache, "two", payload_one_create(2), 1, payload_one_destroy);
+    cache->put(cache, "three", payload_one_create(3), 1, payload_one_destroy);
+
+    // eviction hands the oldest object to its destructor
+    CHECK(fixture_payload_one(0)->is_destroyed);
+    CHECK(!fixture_payload_one(1)->is_destroyed);
+
+    CHECK(cache->remove(cache, "two"));
+    CHECK(fixture_payload_one(1)->is_destroyed);
+
+    cache->destroy(cache);
+    CHECK(fixture_payload_one(2)->is_destroyed);
+TEST_END
+
+TEST_BEGIN("zipf workload benchmark")
+    // Read-through use: look up a Zipf-distributed key, and put it on a
+    // miss.  Hit rate should climb steeply with capacity.
+    const size_t nkeys = 10000;
+    const size_t nlookups = 200000;
+    double * cdf = (double *) malloc(sizeof(double) * nkeys);
+    double total = 0.0;
+    double previous = 0.0;
+    char key[32];
+    size_t capacity;
+    size_t i;
+
+    for (i = 0; i < nkeys; i++)
+    {
+        total += 1.0 / (double) (i + 1);
+        cdf[i] = total;
+    }
+
+    for (i = 0; i < nkeys; i++)
+    {
+        cdf[i] /= total;
+    }
+
+    prng_seed(31);
+
+    for (capacity = 10; capacity <= 10000; capacity *= 10)
+    {
+        cache_t * cache = cache_pub.create(capacity, 0);
+        cache_stats_t stats;
+
+        cache->timing(cache, true);
+
+        for (i = 0; i < nlookups; i++)
+        {
+            snprintf(key, sizeof(key), "object.%zu", zipf_draw(cdf, nkeys));
+            if (!cache->get(cache, key))
+            {
+                cache->put(cache, key, (void *) (i + 1), 1, NULL);
+            }
+        }
+
+        cache->stats(cache, &stats);
+        BLAMMO(INFO, "capacity %5zu: hit rate %.3f, get %.1f ns, "
+                     "%zu evictions", capacity, stats.hit_rate,
+                     stats.get_nsec, stats.evictions);
+
+        CHECK(stats.hits + stats.misses == nlookups);
+        CHECK(stats.hit_rate > previous);
+        CHECK(cache->length(cache) <= capacity);
+        previous = stats.hit_rate;
+
+        cache->destroy(cache);
+    }
+
+    free(cdf);
+TEST_END
+
+TESTSUITE_END
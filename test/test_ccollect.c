@@ -0,0 +1,435 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "ccollect.h"
+#include "collect.h"
+#include "chronom.h"
+#include "mut.h"
+#include "fixture.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <time.h>
+
+//------------------------------------------------------------------------|
+// Heap payload that is poisoned on destruction, so that a reader that is
+// handed an object after it was reclaimed will notice.
+#define STRESS_LIVE     0x4c4956454c495645ULL
+#define STRESS_DEAD     0x4445414444454144ULL
+#define STRESS_KEYS     64
+
+typedef struct
+{
+    uint64_t magic;
+    size_t value;
+}
+stress_t;
+
+static void * stress_create(size_t value)
+{
+    stress_t * stress = (stress_t *) malloc(sizeof(stress_t));
+    stress->magic = STRESS_LIVE;
+    stress->value = value;
+    return stress;
+}
+
+static void stress_destroy(void * ptr)
+{
+    stress_t * stress = (stress_t *) ptr;
+    stress->magic = STRESS_DEAD;
+    free(stress);
+}
+
+typedef struct
+{
+    ccollect_t * ccollect;
+    size_t iterations;
+    size_t found;
+    size_t corrupt;
+}
+stress_reader_t;
+
+static void * stress_reader(void * arg)
+{
+    stress_reader_t * reader = (stress_reader_t *) arg;
+    char key[32];
+    size_t i;
+
+    for (i = 0; i < reader->iterations; i++)
+    {
+        snprintf(key, sizeof(key), "key%zu", i % STRESS_KEYS);
+
+        reader->ccollect->read_lock(reader->ccollect);
+        stress_t * stress = (stress_t *) reader->ccollect->get(
+                reader->ccollect, key);
+        if (stress)
+        {
+            reader->found++;
+            if (stress->magic != STRESS_LIVE)
+            {
+                reader->corrupt++;
+            }
+        }
+        reader->ccollect->read_unlock(reader->ccollect);
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------|
+// Read-mostly benchmark: every thread looks up random keys while one
+// writer replaces an object every so often.  The baseline is a regular
+// indexed collect_t behind a reader/writer lock.
+#define BENCH_KEYS      1024
+#define BENCH_LOOKUPS   50000
+
+typedef struct
+{
+    ccollect_t * ccollect;
+    collect_t * collect;
+    pthread_rwlock_t * rwlock;
+    pthread_barrier_t * barrier;
+    const char ** keys;
+    unsigned int seed;
+    size_t found;
+    bool * stop;
+}
+bench_t;
+
+static void * bench_reader(void * arg)
+{
+    bench_t * bench = (bench_t *) arg;
+    size_t i;
+
+    pthread_barrier_wait(bench->barrier);
+
+    for (i = 0; i < BENCH_LOOKUPS; i++)
+    {
+        bench->seed = bench->seed * 1103515245 + 12345;
+        const char * key = bench->keys[(bench->seed >> 8) % BENCH_KEYS];
+
+        if (bench->ccollect)
+        {
+            bench->found += bench->ccollect->get(bench->ccollect, key) != NULL;
+        }
+        else
+        {
+            pthread_rwlock_rdlock(bench->rwlock);
+            bench->found += bench->collect->get(bench->collect, key) != NULL;
+            pthread_rwlock_unlock(bench->rwlock);
+        }
+    }
+
+    return NULL;
+}
+
+static void * bench_writer(void * arg)
+{
+    bench_t * bench = (bench_t *) arg;
+    struct timespec pause = { 0, 50000 };
+    size_t i = 0;
+
+    pthread_barrier_wait(bench->barrier);
+
+    while (!__atomic_load_n(bench->stop, __ATOMIC_ACQUIRE))
+    {
+        const char * key = bench->keys[i++ % BENCH_KEYS];
+
+        if (bench->ccollect)
+        {
+            bench->ccollect->set(bench->ccollect, key, (void *) i,
+                                 NULL, NULL);
+        }
+        else
+        {
+            pthread_rwlock_wrlock(bench->rwlock);
+            bench->collect->set(bench->collect, key, (void *) i, NULL, NULL);
+            pthread_rwlock_unlock(bench->rwlock);
+        }
+
+        nanosleep(&pause, NULL);
+    }
+
+    return NULL;
+}
+
+static double bench_run(ccollect_t * ccollect,
+                        collect_t * collect,
+                        pthread_rwlock_t * rwlock,
+                        const char ** keys,
+                        size_t nthreads)
+{
+    chronom_t * chronom = chronom_pub.create();
+    pthread_t threads[33];
+    bench_t bench[33];
+    pthread_barrier_t barrier;
+    bool stop = false;
+    size_t i;
+
+    pthread_barrier_init(&barrier, NULL, nthreads + 2);
+
+    for (i = 0; i <= nthreads; i++)
+    {
+        bench[i].ccollect = ccollect;
+        bench[i].collect = collect;
+        bench[i].rwlock = rwlock;
+        bench[i].barrier = &barrier;
+        bench[i].keys = keys;
+        bench[i].seed = (unsigned int) (i + 1);
+        bench[i].found = 0;
+        bench[i].stop = &stop;
+        pthread_create(&threads[i], NULL,
+                       i < nthreads ? bench_reader : bench_writer,
+                       &bench[i]);
+    }
+
+    pthread_barrier_wait(&barrier);
+    chronom->start(chronom);
+
+    for (i = 0; i < nthreads; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    chronom->stop(chronom);
+    __atomic_store_n(&stop, true, __ATOMIC_RELEASE);
+    pthread_join(threads[nthreads], NULL);
+    pthread_barrier_destroy(&barrier);
+
+    double seconds = chronom->elapsed_seconds(chronom);
+    chronom->destroy(chronom);
+
+    return (double) (nthreads * BENCH_LOOKUPS) / seconds / 1e6;
+}
+
+//------------------------------------------------------------------------|
+TESTSUITE_BEGIN
+
+    // Simple test of the blammo logger
+    BLAMMO_LEVEL(INFO);
+    BLAMMO_FILE("test_ccollect.log");
+    BLAMMO(INFO, "ccollect tests...");
+
+    // because these aren't always used, some warning eaters:
+    (void) fixture_reset;
+    (void) fixture_report;
+    (void) fixture_payload_two;
+
+TEST_BEGIN("create")
+    ccollect_t * ccollect = ccollect_pub.create(0);
+    CHECK(ccollect != NULL);
+    CHECK(ccollect->priv != NULL);
+    CHECK(ccollect->empty(ccollect));
+    CHECK(ccollect->length(ccollect) == 0);
+    ccollect->destroy(ccollect);
+TEST_END
+
+TEST_BEGIN("set, get, remove, clear (scalar)")
+    // a single bucket forces every key into one chain
+    ccollect_t * ccollect = ccollect_pub.create(1);
+
+    CHECK(ccollect->set(ccollect, "one", (void *) 1, NULL, NULL));
+    CHECK(ccollect->set(ccollect, "two", (void *) 2, NULL, NULL));
+    CHECK(ccollect->set(ccollect, "three", (void *) 3, NULL, NULL));
+    CHECK(ccollect->length(ccollect) == 3);
+    CHECK(!ccollect->empty(ccollect));
+
+    CHECK(ccollect->get(ccollect, "one") == (void *) 1);
+    CHECK(ccollect->get(ccollect, "two") == (void *) 2);
+    CHECK(ccollect->get(ccollect, "three") == (void *) 3);
+    CHECK(ccollect->get(ccollect, "four") == NULL);
+
+    // replace in the middle of the chain
+    CHECK(ccollect->set(ccollect, "two", (void *) 22, NULL, NULL));
+    CHECK(ccollect->length(ccollect) == 3);
+    CHECK(ccollect->get(ccollect, "two") == (void *) 22);
+    CHECK(ccollect->get(ccollect, "one") == (void *) 1);
+    CHECK(ccollect->get(ccollect, "three") == (void *) 3);
+
+    CHECK(ccollect->remove(ccollect, "two"));
+    CHECK(!ccollect->remove(ccollect, "two"));
+    CHECK(ccollect->length(ccollect) == 2);
+    CHECK(ccollect->get(ccollect, "two") == NULL);
+    CHECK(ccollect->get(ccollect, "one") == (void *) 1);
+    CHECK(ccollect->get(ccollect, "three") == (void *) 3);
+
+    ccollect->clear(ccollect);
+    CHECK(ccollect->empty(ccollect));
+    CHECK(ccollect->get(ccollect, "one") == NULL);
+    CHECK(ccollect->reclaim(ccollect) == 0);
+
+    ccollect->destroy(ccollect);
+TEST_END
+
+TEST_BEGIN("managed payloads, copy")
+    fixture_reset();
+    ccollect_t * ccollect = ccollect_pub.create(16);
+    payload_one_t * one = payload_one_create(1);
+    payload_one_t * two = payload_one_create(2);
+
+    ccollect->set(ccollect, "one", one, payload_one_copy, payload_one_destroy);
+    ccollect->set(ccollect, "two", two, payload_one_copy, payload_one_destroy);
+
+    ccollect_t * copy = ccollect->copy(ccollect);
+    CHECK(copy != NULL);
+    CHECK(copy->length(copy) == 2);
+
+    payload_one_t * other = (payload_one_t *) copy->get(copy, "one");
+    CHECK(other != NULL);
+    CHECK(other != one);
+    CHECK(other->copy_of == one);
+
+    // nobody is reading, so replaced objects are destroyed right away
+    ccollect->set(ccollect, "one", NULL, NULL, NULL);
+    CHECK(one->is_destroyed);
+    CHECK(!other->is_destroyed);
+
+    copy->destroy(copy);
+    CHECK(other->is_destroyed);
+    CHECK(!two->is_destroyed);
+
+    ccollect->destroy(ccollect);
+    CHECK(two->is_destroyed);
+TEST_END
+
+TEST_BEGIN("deferred destruction")
+    fixture_reset();
+    ccollect_t * ccollect = ccollect_pub.create(0);
+    payload_one_t * one = payload_one_create(1);
+    payload_one_t * two = payload_one_create(2);
+
+    ccollect->set(ccollect, "key", one, NULL, payload_one_destroy);
+
+    CHECK(ccollect->read_lock(ccollect));
+    CHECK(ccollect->get(ccollect, "key") == one);
+
+    // The reader may still be holding 'one', so replacing it must not
+    // destroy it until the reader has left.  Nesting is allowed.
+    ccollect->set(ccollect, "key", two, NULL, payload_one_destroy);
+    CHECK(ccollect->get(ccollect, "key") == two);
+    CHECK(!one->is_destroyed);
+
+    CHECK(ccollect->read_lock(ccollect));
+    ccollect->read_unlock(ccollect);
+    CHECK(ccollect->reclaim(ccollect) == 1);
+    CHECK(!one->is_destroyed);
+
+    ccollect->read_unlock(ccollect);
+    CHECK(ccollect->reclaim(ccollect) == 0);
+    CHECK(one->is_destroyed);
+
+    CHECK(ccollect->remove(ccollect, "key"));
+    CHECK(two->is_destroyed);
+
+    ccollect->destroy(ccollect);
+TEST_END
+
+TEST_BEGIN("concurrent readers and writer")
+    ccollect_t * ccollect = ccollect_pub.create(16);
+    stress_reader_t readers[4];
+    pthread_t threads[4];
+    char key[32];
+    size_t i;
+
+    for (i = 0; i < STRESS_KEYS; i++)
+    {
+        snprintf(key, sizeof(key), "key%zu", i);
+        ccollect->set(ccollect, key, stress_create(i), NULL, stress_destroy);
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        memzero(&readers[i], sizeof(stress_reader_t));
+        readers[i].ccollect = ccollect;
+        readers[i].iterations = 100000;
+        pthread_create(&threads[i], NULL, stress_reader, &readers[i]);
+    }
+
+    // churn every key while the readers run
+    for (i = 0; i < 20000; i++)
+    {
+        snprintf(key, sizeof(key), "key%zu", i % STRESS_KEYS);
+        if (i % 7 == 0)
+        {
+            ccollect->remove(ccollect, key);
+        }
+        else
+        {
+            ccollect->set(ccollect, key, stress_create(i), NULL,
+                          stress_destroy);
+        }
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        pthread_join(threads[i], NULL);
+        CHECK(readers[i].corrupt == 0);
+    }
+
+    // all readers are gone, so nothing may be left pending
+    CHECK(ccollect->reclaim(ccollect) == 0);
+    ccollect->destroy(ccollect);
+TEST_END
+
+TEST_BEGIN("read-mostly scaling benchmark")
+    ccollect_t * ccollect = ccollect_pub.create(BENCH_KEYS);
+    collect_t * collect = collect_pub.create();
+    pthread_rwlock_t rwlock;
+    static char names[BENCH_KEYS][32];
+    const char * keys[BENCH_KEYS];
+    size_t nthreads;
+    size_t i;
+
+    pthread_rwlock_init(&rwlock, NULL);
+    collect->index(collect, true);
+
+    for (i = 0; i < BENCH_KEYS; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "setting.%zu", i);
+        keys[i] = names[i];
+        ccollect->set(ccollect, keys[i], (void *) (i + 1), NULL, NULL);
+        collect->set(collect, keys[i], (void *) (i + 1), NULL, NULL);
+    }
+
+    for (nthreads = 1; nthreads <= 32; nthreads *= 2)
+    {
+        double lockfree = bench_run(ccollect, NULL, NULL, keys, nthreads);
+        double locked = bench_run(NULL, collect, &rwlock, keys, nthreads);
+
+        BLAMMO(INFO, "%2zu readers: ccollect %.2f Mops/s, "
+                     "rwlock collect %.2f Mops/s",
+                     nthreads, lockfree, locked);
+        CHECK(lockfree > 0.0);
+        CHECK(locked > 0.0);
+    }
+
+    CHECK(ccollect->length(ccollect) == BENCH_KEYS);
+
+    pthread_rwlock_destroy(&rwlock);
+    ccollect->destroy(ccollect);
+    collect->destroy(collect);
+TEST_END
+
+TESTSUITE_END
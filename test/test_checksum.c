@@ -0,0 +1,246 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "checksum.h"
+#include "prng.h"
+#include "chronom.h"
+#include "mut.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//------------------------------------------------------------------------|
+// Bit-at-a-time reference implementations, straight from the definitions
+static uint32_t reference_crc32(uint32_t poly, const uint8_t * p,
+                                size_t size)
+{
+    uint32_t crc = 0xffffffffUL;
+    int k;
+
+    while (size--)
+    {
+        crc ^= *p++;
+        for (k = 0; k < 8; k++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+        }
+    }
+
+    return ~crc;
+}
+
+static uint16_t reference_crc16(const uint8_t * p, size_t size)
+{
+    uint16_t crc = 0xffff;
+    int k;
+
+    while (size--)
+    {
+        crc ^= (uint16_t) (*p++ << 8);
+        for (k = 0; k < 8; k++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x1021) :
+                                   (uint16_t) (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+static uint32_t reference_adler32(const uint8_t * p, size_t size)
+{
+    uint32_t a = 1;
+    uint32_t b = 0;
+
+    while (size--)
+    {
+        a = (a + *p++) % 65521;
+        b = (b + a) % 65521;
+    }
+
+    return (b << 16) | a;
+}
+
+//------------------------------------------------------------------------|
+TESTSUITE_BEGIN
+
+    // Simple test of the blammo logger
+    BLAMMO_LEVEL(INFO);
+    BLAMMO_FILE("test_checksum.log");
+    BLAMMO(INFO, "checksum tests...");
+
+TEST_BEGIN("check values")
+    // The standard "123456789" check value of each algorithm
+    const char * check = "123456789";
+
+    CHECK(checksum_crc32c(CHECKSUM_CRC32C_INIT, check, 9) == 0xe3069283UL);
+    CHECK(checksum_crc32c_portable(CHECKSUM_CRC32C_INIT, check, 9) ==
+          0xe3069283UL);
+    CHECK(checksum_crc32(CHECKSUM_CRC32_INIT, check, 9) == 0xcbf43926UL);
+    CHECK(checksum_crc16(CHECKSUM_CRC16_INIT, check, 9) == 0x29b1);
+    CHECK(checksum_adler32(CHECKSUM_ADLER32_INIT, check, 9) ==
+          0x091e01deUL);
+
+    CHECK(checksum_of(CHECKSUM_CRC32C, check, 9) == 0xe3069283UL);
+    CHECK(checksum_of(CHECKSUM_CRC32, check, 9) == 0xcbf43926UL);
+    CHECK(checksum_of(CHECKSUM_CRC16, check, 9) == 0x29b1);
+    CHECK(checksum_of(CHECKSUM_ADLER32, check, 9) == 0x091e01deUL);
+
+    // Nothing at all leaves the starting value
+    CHECK(checksum_of(CHECKSUM_CRC32C, NULL, 0) == CHECKSUM_CRC32C_INIT);
+    CHECK(checksum_of(CHECKSUM_CRC16, NULL, 0) == CHECKSUM_CRC16_INIT);
+    CHECK(checksum_of(CHECKSUM_ADLER32, NULL, 0) == CHECKSUM_ADLER32_INIT);
+
+    BLAMMO(INFO, "crc32c hardware acceleration: %s",
+           checksum_crc32c_accelerated() ? "yes" : "no");
+TEST_END
+
+TEST_BEGIN("against reference")
+    // Every length and alignment across the slicing boundaries, plus a
+    // buffer long enough to need several Adler32 reductions
+    uint8_t * data = (uint8_t *) malloc(20000);
+    size_t size;
+
+    prng_seed(53);
+    prng_fill(data, 20000);
+
+    for (size = 0; size < 300; size++)
+    {
+        const uint8_t * p = data + (size % 11);
+        uint32_t crc32c = reference_crc32(0x82f63b78UL, p, size);
+
+        CHECK(checksum_crc32c(0, p, size) == crc32c);
+        CHECK(checksum_crc32c_portable(0, p, size) == crc32c);
+        CHECK(checksum_crc32(0, p, size) ==
+              reference_crc32(0xedb88320UL, p, size));
+        CHECK(checksum_crc16(0xffff, p, size) == reference_crc16(p, size));
+        CHECK(checksum_adler32(1, p, size) == reference_adler32(p, size));
+    }
+
+    CHECK(checksum_crc32c(0, data, 20000) ==
+          reference_crc32(0x82f63b78UL, data, 20000));
+    CHECK(checksum_adler32(1, data, 20000) ==
+          reference_adler32(data, 20000));
+
+    // Saturated input is the worst case for the Adler32 sums
+    memset(data, 0xff, 20000);
+    CHECK(checksum_adler32(1, data, 20000) ==
+          reference_adler32(data, 20000));
+
+    free(data);
+TEST_END
+
+TEST_BEGIN("streaming")
+    // Checking in pieces gives the same result as all at once
+    uint8_t data[4096];
+    size_t trial;
+
+    prng_seed(59);
+    prng_fill(data, sizeof(data));
+
+    uint32_t crc32c = checksum_crc32c(0, data, sizeof(data));
+    uint32_t crc32 = checksum_crc32(0, data, sizeof(data));
+    uint16_t crc16 = checksum_crc16(0xffff, data, sizeof(data));
+    uint32_t adler = checksum_adler32(1, data, sizeof(data));
+
+    for (trial = 0; trial < 50; trial++)
+    {
+        uint32_t c32c = CHECKSUM_CRC32C_INIT;
+        uint32_t c32 = CHECKSUM_CRC32_INIT;
+        uint16_t c16 = CHECKSUM_CRC16_INIT;
+        uint32_t a32 = CHECKSUM_ADLER32_INIT;
+        size_t offset = 0;
+
+        while (offset < sizeof(data))
+        {
+            size_t piece = prng_next() % 700;
+            if (piece > sizeof(data) - offset)
+            {
+                piece = sizeof(data) - offset;
+            }
+
+            c32c = checksum_crc32c(c32c, data + offset, piece);
+            c32 = checksum_crc32(c32, data + offset, piece);
+            c16 = checksum_crc16(c16, data + offset, piece);
+            a32 = checksum_adler32(a32, data + offset, piece);
+            offset += piece;
+        }
+
+        CHECK(c32c == crc32c);
+        CHECK(c32 == crc32);
+        CHECK(c16 == crc16);
+        CHECK(a32 == adler);
+    }
+TEST_END
+
+TEST_BEGIN("throughput benchmark")
+    const size_t size = 1 << 20;
+    const size_t rounds = 32;
+    uint8_t * data = (uint8_t *) malloc(size);
+    chronom_t * chronom = chronom_pub.create();
+    uint32_t sink = 0;
+    size_t r;
+    int algorithm;
+
+    prng_seed(61);
+    prng_fill(data, size);
+
+    const char * names[] = {
+        "crc32c", "crc32c (portable)", "crc32", "crc16", "adler32",
+        "crc32c (bitwise)",
+    };
+
+    for (algorithm = 0; algorithm < 6; algorithm++)
+    {
+        // The bitwise loop this replaces is far slower, so give it less
+        size_t n = algorithm == 5 ? 1 : rounds;
+
+        chronom->reset(chronom);
+        chronom->start(chronom);
+        for (r = 0; r < n; r++)
+        {
+            switch (algorithm)
+            {
+            case 0: sink += checksum_crc32c(sink, data, size); break;
+            case 1: sink += checksum_crc32c_portable(sink, data, size); break;
+            case 2: sink += checksum_crc32(sink, data, size); break;
+            case 3: sink += checksum_crc16((uint16_t) sink, data, size); break;
+            case 4: sink += checksum_adler32(sink, data, size); break;
+            case 5: sink += reference_crc32(0x82f63b78UL, data, size); break;
+            }
+        }
+        chronom->stop(chronom);
+
+        double seconds = chronom->elapsed_seconds(chronom);
+        BLAMMO(INFO, "%-18s %8.3f GB/s", names[algorithm],
+               (double) (size * n) / seconds / 1e9);
+    }
+
+    CHECK(sink != 0);
+    chronom->destroy(chronom);
+    free(data);
+TEST_END
+
+TESTSUITE_END
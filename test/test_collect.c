@@ -23,11 +23,14 @@
 
 #include "blammo.h"
 #include "collect.h"
+#include "chronom.h"
 #include "mut.h"
 #include "fixture.h"
 
 #include <string.h>
+#include <stdio.h>
 #include <limits.h>
+#include <malloc.h>
 
 TESTSUITE_BEGIN
 
@@ -322,6 +325,313 @@ TEST_BEGIN("next")
     collect->destroy(collect);
 TEST_END
 
+TEST_BEGIN("key index")
+    fixture_reset();
+
+    collect_t * collect = collect_pub.create();
+    collect->set(collect, "one", (void *) 1, NULL, NULL);
+    collect->set(collect, "two", payload_one_create(2),
+                                 payload_one_copy,
+                                 payload_one_destroy);
+
+    // indexing existing keys, then mixing in more
+    CHECK(collect->index(collect, true));
+    collect->set(collect, "three", (void *) 3, NULL, NULL);
+    collect->set(collect, "one", (void *) 11, NULL, NULL);
+    CHECK(collect->length(collect) == 3);
+    CHECK(collect->get(collect, "one") == (void *) 11);
+    CHECK(collect->get(collect, "three") == (void *) 3);
+    CHECK(collect->get(collect, "four") == NULL);
+
+    CHECK(collect->remove(collect, "two"));
+    CHECK(fixture_payload_one(0)->is_destroyed);
+    CHECK(!collect->remove(collect, "two"));
+    CHECK(collect->get(collect, "two") == NULL);
+
+    // copies carry the index along
+    collect_t * copy = collect->copy(collect);
+    CHECK(copy->get(copy, "three") == (void *) 3);
+    copy->destroy(copy);
+
+    // order is unaffected by indexing
+    const char ** keys = collect->keys(collect);
+    CHECK(strcmp("three", keys[0]) == 0);
+    CHECK(strcmp("one", keys[1]) == 0);
+
+    collect->clear(collect);
+    CHECK(collect->get(collect, "one") == NULL);
+    collect->set(collect, "five", (void *) 5, NULL, NULL);
+    CHECK(collect->get(collect, "five") == (void *) 5);
+
+    CHECK(collect->index(collect, false));
+    CHECK(collect->get(collect, "five") == (void *) 5);
+
+    collect->destroy(collect);
+TEST_END
+
+TEST_BEGIN("freeze")
+    fixture_reset();
+
+    collect_t * collect = collect_pub.create();
+    CHECK(collect->freeze(collect, true));
+    CHECK(collect->frozen(collect));
+    CHECK(collect->get(collect, "one") == NULL);
+
+    collect->set(collect, "one", (void *) 1, NULL, NULL);
+    CHECK(!collect->frozen(collect));
+    collect->set(collect, "two", payload_one_create(2),
+                                 payload_one_copy,
+                                 payload_one_destroy);
+    collect->set(collect, "three", (void *) 3, NULL, NULL);
+
+    CHECK(collect->freeze(collect, true));
+    CHECK(collect->frozen(collect));
+    CHECK(collect->get(collect, "one") == (void *) 1);
+    CHECK(collect->get(collect, "two") == fixture_payload_one(0));
+    CHECK(collect->get(collect, "three") == (void *) 3);
+    CHECK(collect->get(collect, "four") == NULL);
+    CHECK(collect->get(collect, "on") == NULL);
+
+    // replacing an object leaves the keys, and so the table, intact
+    collect->set(collect, "one", (void *) 11, NULL, NULL);
+    CHECK(collect->frozen(collect));
+    CHECK(collect->get(collect, "one") == (void *) 11);
+
+    // copies come out frozen too
+    collect_t * copy = collect->copy(collect);
+    CHECK(copy->frozen(copy));
+    CHECK(copy->get(copy, "one") == (void *) 11);
+    copy->destroy(copy);
+
+    // removing a key thaws
+    CHECK(collect->remove(collect, "two"));
+    CHECK(fixture_payload_one(0)->is_destroyed);
+    CHECK(!collect->frozen(collect));
+    CHECK(collect->get(collect, "two") == NULL);
+    CHECK(collect->get(collect, "one") == (void *) 11);
+
+    CHECK(collect->freeze(collect, true));
+    CHECK(collect->freeze(collect, false));
+    CHECK(!collect->frozen(collect));
+    CHECK(collect->get(collect, "three") == (void *) 3);
+
+    collect->destroy(collect);
+TEST_END
+
+TEST_BEGIN("freeze latency & memory")
+    // Every key must be found at its own slot, and the table's cost is
+    // weighed against the live structure holding the same keys.
+    const size_t nkeys = 2000;
+    const size_t nlookups = 20000;
+    collect_t * collect = collect_pub.create();
+    chronom_t * chronom = chronom_pub.create();
+    char key[32];
+    size_t found = 0;
+    size_t i;
+
+    size_t before = mallinfo2().uordblks;
+    for (i = 0; i < nkeys; i++)
+    {
+        snprintf(key, sizeof(key), "config.item.%zu", i);
+        collect->set(collect, key, (void *) (i + 1), NULL, NULL);
+    }
+
+    size_t live_bytes = mallinfo2().uordblks - before;
+
+    chronom->start(chronom);
+    for (i = 0; i < nlookups; i++)
+    {
+        snprintf(key, sizeof(key), "config.item.%zu", (i * 7919) % nkeys);
+        found += collect->get(collect, key) != NULL;
+    }
+    chronom->stop(chronom);
+    double live_us = chronom->elapsed_seconds(chronom) * 1e6 / nlookups;
+
+    before = mallinfo2().uordblks;
+    CHECK(collect->index(collect, true));
+    size_t index_bytes = mallinfo2().uordblks - before;
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < nlookups; i++)
+    {
+        snprintf(key, sizeof(key), "config.item.%zu", (i * 7919) % nkeys);
+        found += collect->get(collect, key) != NULL;
+    }
+    chronom->stop(chronom);
+    double index_us = chronom->elapsed_seconds(chronom) * 1e6 / nlookups;
+
+    before = mallinfo2().uordblks;
+    CHECK(collect->freeze(collect, true));
+    size_t frozen_bytes = mallinfo2().uordblks - before;
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < nlookups; i++)
+    {
+        snprintf(key, sizeof(key), "config.item.%zu", (i * 7919) % nkeys);
+        found += collect->get(collect, key) != NULL;
+    }
+    chronom->stop(chronom);
+    double frozen_us = chronom->elapsed_seconds(chronom) * 1e6 / nlookups;
+
+    CHECK(found == 3 * nlookups);
+    for (i = 0; i < nkeys; i++)
+    {
+        snprintf(key, sizeof(key), "config.item.%zu", i);
+        CHECK(collect->get(collect, key) == (void *) (i + 1));
+    }
+
+    BLAMMO(INFO, "lookup latency: list %.3f us, index %.3f us, "
+                 "frozen %.3f us", live_us, index_us, frozen_us);
+    BLAMMO(INFO, "memory for %zu keys: live %zu bytes, index +%zu bytes, "
+                 "frozen table +%zu bytes", nkeys, live_bytes, index_bytes,
+                 frozen_bytes);
+
+    chronom->destroy(chronom);
+    collect->destroy(collect);
+TEST_END
+
+TEST_BEGIN("filter")
+    collect_t * collect = collect_pub.create();
+    char key[32];
+    size_t i;
+
+    // Enabling over existing keys, then growing well past the initial size
+    for (i = 0; i < 10; i++)
+    {
+        snprintf(key, sizeof(key), "early.%zu", i);
+        collect->set(collect, key, (void *) (i + 1), NULL, NULL);
+    }
+
+    CHECK(collect->filter(collect, true));
+    CHECK(collect->filter(collect, true));
+
+    for (i = 0; i < 1000; i++)
+    {
+        snprintf(key, sizeof(key), "filtered.%zu", i);
+        collect->set(collect, key, (void *) (i + 1), NULL, NULL);
+    }
+
+    for (i = 0; i < 10; i++)
+    {
+        snprintf(key, sizeof(key), "early.%zu", i);
+        CHECK(collect->get(collect, key) == (void *) (i + 1));
+    }
+
+    for (i = 0; i < 1000; i++)
+    {
+        snprintf(key, sizeof(key), "filtered.%zu", i);
+        CHECK(collect->get(collect, key) == (void *) (i + 1));
+        snprintf(key, sizeof(key), "missing.%zu", i);
+        CHECK(collect->get(collect, key) == NULL);
+    }
+
+    // Removed keys are taken back out, without disturbing the rest
+    for (i = 0; i < 1000; i += 2)
+    {
+        snprintf(key, sizeof(key), "filtered.%zu", i);
+        CHECK(collect->remove(collect, key));
+    }
+
+    for (i = 0; i < 1000; i++)
+    {
+        snprintf(key, sizeof(key), "filtered.%zu", i);
+        CHECK(collect->get(collect, key) ==
+              ((i & 1) ? (void *) (i + 1) : NULL));
+    }
+
+    // Copies are filtered too
+    collect_t * copy = collect->copy(collect);
+    CHECK(copy->length(copy) == collect->length(collect));
+    CHECK(copy->get(copy, "filtered.999") == (void *) 1000);
+    CHECK(copy->get(copy, "filtered.998") == NULL);
+    copy->destroy(copy);
+
+    // Starting over empty, the filter still tracks new keys
+    collect->clear(collect);
+    CHECK(collect->get(collect, "filtered.999") == NULL);
+
+    for (i = 0; i < 100; i++)
+    {
+        snprintf(key, sizeof(key), "again.%zu", i);
+        collect->set(collect, key, (void *) (i + 1), NULL, NULL);
+    }
+
+    CHECK(collect->get(collect, "again.42") == (void *) 43);
+    CHECK(collect->get(collect, "filtered.999") == NULL);
+
+    // Filtering combines with the key index, and can be switched off
+    CHECK(collect->index(collect, true));
+    CHECK(collect->get(collect, "again.7") == (void *) 8);
+    CHECK(collect->get(collect, "again.100") == NULL);
+    CHECK(collect->filter(collect, false));
+    CHECK(collect->get(collect, "again.7") == (void *) 8);
+
+    collect->destroy(collect);
+TEST_END
+
+TEST_BEGIN("filter miss latency")
+    // Probing for keys that are not there, which without a filter walks
+    // the whole list every time
+    const size_t nkeys = 2000;
+    const size_t nlookups = 20000;
+    collect_t * collect = collect_pub.create();
+    chronom_t * chronom = chronom_pub.create();
+    char key[32];
+    size_t found = 0;
+    size_t i;
+
+    for (i = 0; i < nkeys; i++)
+    {
+        snprintf(key, sizeof(key), "option.%zu", i);
+        collect->set(collect, key, (void *) (i + 1), NULL, NULL);
+    }
+
+    chronom->start(chronom);
+    for (i = 0; i < nlookups; i++)
+    {
+        snprintf(key, sizeof(key), "absent.%zu", i);
+        found += collect->get(collect, key) != NULL;
+    }
+    chronom->stop(chronom);
+    double list_us = chronom->elapsed_seconds(chronom) * 1e6 / nlookups;
+
+    CHECK(collect->filter(collect, true));
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < nlookups; i++)
+    {
+        snprintf(key, sizeof(key), "absent.%zu", i);
+        found += collect->get(collect, key) != NULL;
+    }
+    chronom->stop(chronom);
+    double filter_us = chronom->elapsed_seconds(chronom) * 1e6 / nlookups;
+
+    CHECK(found == 0);
+    CHECK(filter_us < list_us);
+
+    // Hits still pay for the list walk
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < nlookups; i++)
+    {
+        snprintf(key, sizeof(key), "option.%zu", (i * 7919) % nkeys);
+        found += collect->get(collect, key) != NULL;
+    }
+    chronom->stop(chronom);
+    double hit_us = chronom->elapsed_seconds(chronom) * 1e6 / nlookups;
+
+    CHECK(found == nlookups);
+
+    BLAMMO(INFO, "miss latency: list %.3f us, filtered %.3f us; "
+                 "filtered hit %.3f us", list_us, filter_us, hit_us);
+
+    chronom->destroy(chronom);
+    collect->destroy(collect);
+TEST_END
+
 TEST_BEGIN("keys & objects")
     collect_t * collect = collect_pub.create();
 
@@ -343,4 +653,288 @@ TEST_BEGIN("keys & objects")
 
 TEST_END
 
+TEST_BEGIN("cached keys & objects, span")
+    collect_t * collect = collect_pub.create();
+    const char ** keys = NULL;
+    void ** objects = NULL;
+
+    CHECK(collect->span(collect, &keys, &objects) == 0);
+    CHECK(keys[0] == NULL);
+    CHECK(objects[0] == NULL);
+
+    collect->set(collect, "one", (void *) 1, NULL, NULL);
+    collect->set(collect, "two", NULL, NULL, NULL);
+
+    // unchanged collection: the very same arrays come back
+    CHECK(collect->span(collect, &keys, &objects) == 2);
+    CHECK(collect->keys(collect) == keys);
+    CHECK(collect->objects(collect) == objects);
+    CHECK(strcmp("two", keys[0]) == 0);
+    CHECK(objects[0] == NULL);
+    CHECK(objects[1] == (void *) 1);
+
+    // new items grow the current arrays at the front, past the
+    // initial capacity
+    char key[32];
+    size_t i;
+    for (i = 3; i <= 20; i++)
+    {
+        snprintf(key, sizeof(key), "%zu", i);
+        collect->set(collect, key, (void *) i, NULL, NULL);
+    }
+
+    CHECK(collect->span(collect, &keys, &objects) == 20);
+    CHECK(strcmp("20", keys[0]) == 0);
+    CHECK(strcmp("3", keys[17]) == 0);
+    CHECK(strcmp("two", keys[18]) == 0);
+    CHECK(strcmp("one", keys[19]) == 0);
+    CHECK(keys[20] == NULL);
+    CHECK(objects[0] == (void *) 20);
+    CHECK(objects[19] == (void *) 1);
+
+    // replacing an object and removing a key are both picked up
+    collect->set(collect, "two", (void *) 2, NULL, NULL);
+    CHECK(collect->objects(collect)[18] == (void *) 2);
+    CHECK(collect->remove(collect, "20"));
+    CHECK(collect->span(collect, &keys, &objects) == 19);
+    CHECK(strcmp("19", keys[0]) == 0);
+    CHECK(objects[0] == (void *) 19);
+    CHECK(keys[19] == NULL);
+
+    collect->clear(collect);
+    CHECK(collect->span(collect, &keys, NULL) == 0);
+    CHECK(keys[0] == NULL);
+
+    // repeated calls on a large unchanged collection cost nothing
+    chronom_t * chronom = chronom_pub.create();
+    for (i = 0; i < 10000; i++)
+    {
+        snprintf(key, sizeof(key), "key%zu", i);
+        collect->set(collect, key, (void *) i, NULL, NULL);
+    }
+
+    chronom->start(chronom);
+    for (i = 0; i < 1000; i++)
+    {
+        CHECK(collect->keys(collect)[0] != NULL);
+    }
+    chronom->stop(chronom);
+
+    BLAMMO(INFO, "1000 keys() calls on 10000 keys: %.3f ms",
+                 chronom->elapsed_seconds(chronom) * 1e3);
+
+    chronom->destroy(chronom);
+    collect->destroy(collect);
+TEST_END
+
+TEST_BEGIN("small collections")
+    fixture_reset();
+    collect_t * collect = collect_pub.create();
+    char key[32];
+    size_t i;
+
+    // fill the inline slots, then spill past them and come back
+    for (i = 0; i < 40; i++)
+    {
+        snprintf(key, sizeof(key), "attribute-%zu", i);
+        collect->set(collect, key, (void *) (i + 1), NULL, NULL);
+    }
+
+    collect->set(collect, "", (void *) 100, NULL, NULL);
+    collect->set(collect, "a-rather-long-key-that-cannot-be-kept-inline",
+                 payload_one_create(1), payload_one_copy,
+                 payload_one_destroy);
+    CHECK(collect->length(collect) == 42);
+
+    for (i = 0; i < 40; i++)
+    {
+        snprintf(key, sizeof(key), "attribute-%zu", i);
+        CHECK(collect->get(collect, key) == (void *) (i + 1));
+    }
+
+    CHECK(collect->get(collect, "") == (void *) 100);
+    CHECK(collect->get(collect, "attribute-") == NULL);
+
+    for (i = 0; i < 40; i += 2)
+    {
+        snprintf(key, sizeof(key), "attribute-%zu", i);
+        CHECK(collect->remove(collect, key));
+    }
+
+    CHECK(collect->remove(collect,
+                          "a-rather-long-key-that-cannot-be-kept-inline"));
+    CHECK(fixture_payload_one(0)->is_destroyed);
+    CHECK(collect->length(collect) == 21);
+
+    for (i = 0; i < 40; i++)
+    {
+        snprintf(key, sizeof(key), "attribute-%zu", i);
+        CHECK(collect->get(collect, key) ==
+              ((i % 2) ? (void *) (i + 1) : NULL));
+    }
+
+    // order of keys is still newest first
+    const char ** keys = collect->keys(collect);
+    CHECK(strcmp(keys[0], "") == 0);
+    CHECK(strcmp(keys[1], "attribute-39") == 0);
+    CHECK(strcmp(keys[20], "attribute-1") == 0);
+
+    collect->destroy(collect);
+TEST_END
+
+TEST_BEGIN("small collection benchmark")
+    // Typical per-request attribute sets: build, look everything up a
+    // few times, throw away.
+    static const char * names[16] = {
+        "method", "path", "host", "user-agent", "accept", "content-type",
+        "content-length", "cookie", "referer", "origin", "connection",
+        "cache-control", "authorization", "x-request-id", "x-forwarded",
+        "accept-encoding"
+    };
+    chronom_t * chronom = chronom_pub.create();
+    const size_t rounds = 20000;
+    size_t found = 0;
+    size_t sizes[3] = { 4, 8, 16 };
+    size_t s;
+
+    for (s = 0; s < 3; s++)
+    {
+        size_t i;
+        size_t r;
+
+        chronom->reset(chronom);
+        chronom->start(chronom);
+        for (r = 0; r < rounds; r++)
+        {
+            collect_t * collect = collect_pub.create();
+            for (i = 0; i < sizes[s]; i++)
+            {
+                collect->set(collect, names[i], (void *) (i + 1), NULL, NULL);
+            }
+
+            for (i = 0; i < 4 * sizes[s]; i++)
+            {
+                found += collect->get(collect, names[i % sizes[s]]) != NULL;
+            }
+
+            collect->destroy(collect);
+        }
+        chronom->stop(chronom);
+
+        BLAMMO(INFO, "%2zu items: create+populate+lookup+destroy %.3f us",
+                     sizes[s], chronom->elapsed_seconds(chronom) * 1e6 / rounds);
+    }
+
+    CHECK(found == 4 * (4 + 8 + 16) * rounds);
+    chronom->destroy(chronom);
+TEST_END
+
+TEST_BEGIN("reserve, set_many")
+    fixture_reset();
+    collect_t * collect = collect_pub.create();
+    const char * keys[5] = { "one", "two", "three", "two", "four" };
+    void * objects[5] = { (void *) 1, payload_one_create(2), (void *) 3,
+                          (void *) 22, (void *) 4 };
+    generic_destroy_f destroys[5] = { NULL, payload_one_destroy,
+                                      NULL, NULL, NULL };
+
+    collect->set(collect, "four", payload_one_create(4), payload_one_copy,
+                 payload_one_destroy);
+
+    CHECK(collect->reserve(collect, 100));
+    CHECK(collect->set_many(collect, keys, objects, NULL, destroys, 5));
+
+    // duplicates and existing keys are replaced, just as with set()
+    CHECK(collect->length(collect) == 4);
+    CHECK(fixture_payload_one(0)->is_destroyed);
+    CHECK(fixture_payload_one(1)->is_destroyed);
+    CHECK(collect->get(collect, "one") == (void *) 1);
+    CHECK(collect->get(collect, "two") == (void *) 22);
+    CHECK(collect->get(collect, "three") == (void *) 3);
+    CHECK(collect->get(collect, "four") == (void *) 4);
+
+    const char ** order = collect->keys(collect);
+    CHECK(strcmp(order[0], "three") == 0);
+    CHECK(strcmp(order[3], "four") == 0);
+
+    // fill well past the inline containers, through the reserve
+    char names[100][16];
+    const char * many[100];
+    size_t i;
+    for (i = 0; i < 100; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "many.%zu", i);
+        many[i] = names[i];
+    }
+
+    CHECK(collect->set_many(collect, many, NULL, NULL, NULL, 100));
+    CHECK(collect->length(collect) == 104);
+    CHECK(collect->remove(collect, "many.50"));
+    collect->set(collect, "again", (void *) 5, NULL, NULL);
+    CHECK(collect->get(collect, "again") == (void *) 5);
+    CHECK(collect->get(collect, "many.99") == NULL);
+    CHECK(collect->get(collect, "many.50") == NULL);
+    CHECK(collect->get(collect, "two") == (void *) 22);
+
+    collect->clear(collect);
+    CHECK(collect->set_many(collect, keys, NULL, NULL, NULL, 5));
+    CHECK(collect->length(collect) == 4);
+
+    collect->destroy(collect);
+TEST_END
+
+TEST_BEGIN("bulk load benchmark")
+    const size_t nkeys = 5000;
+    char (*names)[32] = malloc(sizeof(*names) * nkeys);
+    const char ** keys = malloc(sizeof(char *) * nkeys);
+    void ** objects = malloc(sizeof(void *) * nkeys);
+    chronom_t * chronom = chronom_pub.create();
+    double seconds[3];
+    size_t i;
+
+    for (i = 0; i < nkeys; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "section.%zu.option", i);
+        keys[i] = names[i];
+        objects[i] = (void *) (i + 1);
+    }
+
+    size_t mode;
+    for (mode = 0; mode < 3; mode++)
+    {
+        collect_t * collect = collect_pub.create();
+
+        chronom->reset(chronom);
+        chronom->start(chronom);
+        if (mode == 2)
+        {
+            collect->reserve(collect, nkeys);
+            collect->set_many(collect, keys, objects, NULL, NULL, nkeys);
+        }
+        else
+        {
+            collect->index(collect, mode == 1);
+            for (i = 0; i < nkeys; i++)
+            {
+                collect->set(collect, keys[i], objects[i], NULL, NULL);
+            }
+        }
+        chronom->stop(chronom);
+        seconds[mode] = chronom->elapsed_seconds(chronom);
+
+        CHECK(collect->length(collect) == nkeys);
+        CHECK(collect->get(collect, keys[nkeys / 2]) == objects[nkeys / 2]);
+        collect->destroy(collect);
+    }
+
+    BLAMMO(INFO, "loading %zu keys: set() %.2f ms, indexed set() %.2f ms, "
+                 "set_many() %.2f ms", nkeys, seconds[0] * 1e3,
+                 seconds[1] * 1e3, seconds[2] * 1e3);
+
+    chronom->destroy(chronom);
+    free(names);
+    free(keys);
+    free(objects);
+TEST_END
+
 TESTSUITE_END
@@ -0,0 +1,292 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "gapbuf.h"
+#include "bytes.h"
+#include "prng.h"
+#include "chronom.h"
+#include "utils.h"
+#include "mut.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//------------------------------------------------------------------------|
+// Check a gap buffer against the bytes it should hold, through flatten(),
+// read_at() and segments()
+static bool same(const gapbuf_t * gapbuf, const bytes_t * bytes)
+{
+    size_t size = bytes->size(bytes);
+    bytes_t * flat = gapbuf->flatten(gapbuf);
+    uint8_t * read = (uint8_t *) malloc(size + 1);
+    gapbuf_segments_t segs;
+    bool result;
+
+    gapbuf->segments(gapbuf, &segs);
+    result = flat && read &&
+             gapbuf->size(gapbuf) == size &&
+             flat->compare(flat, bytes) == 0 &&
+             gapbuf->read_at(gapbuf, read, size, 0) == (ssize_t) size &&
+             memcmp(read, bytes->data(bytes), size) == 0 &&
+             segs.front_size == gapbuf->cursor(gapbuf) &&
+             segs.front_size + segs.back_size == size &&
+             memcmp(segs.front, bytes->data(bytes), segs.front_size) == 0 &&
+             memcmp(segs.back, bytes->data(bytes) + segs.front_size,
+                    segs.back_size) == 0;
+
+    if (flat)
+    {
+        flat->destroy(flat);
+    }
+
+    free(read);
+    return result;
+}
+
+//------------------------------------------------------------------------|
+TESTSUITE_BEGIN
+
+    // Test setup code goes here
+    prng_seed(48);
+
+TEST_BEGIN("basics")
+    gapbuf_t * gapbuf = gapbuf_pub.create("hello world", 11);
+    gapbuf_segments_t segs;
+    char buffer[64];
+
+    CHECK(gapbuf != NULL);
+    CHECK(gapbuf->size(gapbuf) == 11);
+    CHECK(gapbuf->cursor(gapbuf) == 11);
+
+    CHECK(gapbuf->insert(gapbuf, "!", 1) == 12);
+    CHECK(gapbuf->seek(gapbuf, 5) == 5);
+    CHECK(gapbuf->insert(gapbuf, ",", 1) == 13);
+    CHECK(gapbuf->cursor(gapbuf) == 6);
+    CHECK(gapbuf->read_at(gapbuf, buffer, 13, 0) == 13);
+    CHECK(memcmp(buffer, "hello, world!", 13) == 0);
+
+    gapbuf->segments(gapbuf, &segs);
+    CHECK(segs.front_size == 6);
+    CHECK(memcmp(segs.front, "hello,", 6) == 0);
+    CHECK(segs.back_size == 7);
+    CHECK(memcmp(segs.back, " world!", 7) == 0);
+
+    // Out of bounds
+    CHECK(gapbuf->seek(gapbuf, 14) < 0);
+    CHECK(gapbuf->cursor(gapbuf) == 6);
+    CHECK(gapbuf->read_at(gapbuf, buffer, 2, 12) < 0);
+
+    // Reads straddling the gap, or on one side of it
+    CHECK(gapbuf->read_at(gapbuf, buffer, 4, 4) == 4);
+    CHECK(memcmp(buffer, "o, w", 4) == 0);
+    CHECK(gapbuf->read_at(gapbuf, buffer, 3, 8) == 3);
+    CHECK(memcmp(buffer, "orl", 3) == 0);
+    CHECK(gapbuf->read_at(gapbuf, buffer, 0, 13) == 0);
+
+    // Removing either side of the cursor, clamped at the ends
+    CHECK(gapbuf->backspace(gapbuf, 1) == 12);
+    CHECK(gapbuf->erase(gapbuf, 6) == 6);
+    CHECK(gapbuf->read_at(gapbuf, buffer, 6, 0) == 6);
+    CHECK(memcmp(buffer, "hello!", 6) == 0);
+    CHECK(gapbuf->erase(gapbuf, 10) == 5);
+    CHECK(gapbuf->backspace(gapbuf, 10) == 0);
+    CHECK(gapbuf->cursor(gapbuf) == 0);
+
+    gapbuf->clear(gapbuf);
+    CHECK(gapbuf->size(gapbuf) == 0);
+    CHECK(gapbuf->insert(gapbuf, "again", 5) == 5);
+    bytes_t * flat = gapbuf->flatten(gapbuf);
+    CHECK(strcmp(flat->cstr(flat), "again") == 0);
+    flat->destroy(flat);
+    gapbuf->destroy(gapbuf);
+
+    // Starting empty, and growing well past the first allocation
+    gapbuf = gapbuf_pub.create(NULL, 0);
+    CHECK(gapbuf->size(gapbuf) == 0);
+    gapbuf->segments(gapbuf, &segs);
+    CHECK(segs.front_size == 0 && segs.back_size == 0);
+    for (size_t i = 0; i < 10000; i++)
+    {
+        CHECK(gapbuf->insert(gapbuf, "abcdefghij" + i % 10, 1) ==
+              (ssize_t) i + 1);
+        if (i % 100 == 99)
+        {
+            gapbuf->seek(gapbuf, i / 2);
+        }
+    }
+    CHECK(gapbuf->size(gapbuf) == 10000);
+    gapbuf->destroy(gapbuf);
+TEST_END
+
+TEST_BEGIN("agrees with bytes_t")
+    // Mirror random cursor moves and edits in a bytes_t
+    bytes_t * bytes = bytes_pub.create("The quick brown fox", 19);
+    gapbuf_t * gapbuf = gapbuf_pub.create(bytes->data(bytes),
+                                          bytes->size(bytes));
+    uint8_t data[64];
+    size_t cursor = bytes->size(bytes);
+    size_t agreed = 0;
+    size_t i;
+
+    for (i = 0; i < 20000; i++)
+    {
+        size_t size = bytes->size(bytes);
+        size_t length = 1 + prng_next() % 16;
+
+        switch (prng_next() % 4)
+        {
+        case 0:
+            // Mostly short hops, as a cursor moves
+            cursor = prng_next() % 4 ? MIN(size, cursor + prng_next() % 8)
+                                     : prng_next() % (size + 1);
+            CHECK(gapbuf->seek(gapbuf, cursor) == (ssize_t) cursor);
+            break;
+
+        case 1:
+            length = MIN(length, cursor);
+            bytes->remove(bytes, cursor - length, length);
+            cursor -= length;
+            CHECK(gapbuf->backspace(gapbuf, length) ==
+                  (ssize_t) bytes->size(bytes));
+            break;
+
+        case 2:
+            if (size > 100 && cursor < size)
+            {
+                length = MIN(length, size - cursor);
+                bytes->remove(bytes, cursor, length);
+                CHECK(gapbuf->erase(gapbuf, length) ==
+                      (ssize_t) bytes->size(bytes));
+                break;
+            }
+            // fall through
+
+        default:
+            prng_fill(data, length);
+            bytes->insert(bytes, cursor, data, length);
+            cursor += length;
+            CHECK(gapbuf->insert(gapbuf, data, length) ==
+                  (ssize_t) bytes->size(bytes));
+            break;
+        }
+
+        CHECK(gapbuf->cursor(gapbuf) == cursor);
+
+        size = bytes->size(bytes);
+        size_t offset = prng_next() % (size + 1);
+        length = MIN(prng_next() % (size - offset + 1), sizeof(data));
+        CHECK(gapbuf->read_at(gapbuf, data, length, offset) ==
+              (ssize_t) length);
+        CHECK(memcmp(data, bytes->data(bytes) + offset, length) == 0);
+
+        if (i % 1000 == 0)
+        {
+            agreed += same(gapbuf, bytes);
+        }
+    }
+
+    CHECK(agreed == 20);
+    CHECK(same(gapbuf, bytes));
+
+    gapbuf->destroy(gapbuf);
+    bytes->destroy(bytes);
+TEST_END
+
+TEST_BEGIN("benchmark")
+    // Typing and backspacing near a wandering cursor in a 1 MB document,
+    // as bytes_t insert()/remove() and as a gap buffer
+    const size_t size = 1 << 20;
+    const size_t nedits = 200000;
+    chronom_t * chronom = chronom_pub.create();
+    uint8_t * data = (uint8_t *) malloc(size);
+    double seconds[2];
+    size_t cursor;
+    size_t i;
+
+    prng_fill(data, size);
+    bytes_t * bytes = bytes_pub.create(data, size);
+    gapbuf_t * gapbuf = gapbuf_pub.create(data, size);
+    free(data);
+
+    prng_seed(4848);
+    cursor = size / 2;
+    chronom->start(chronom);
+    for (i = 0; i < nedits; i++)
+    {
+        if (i % 64 == 0)
+        {
+            cursor = MIN(bytes->size(bytes), cursor + prng_next() % 256);
+        }
+
+        if (i % 4 == 3)
+        {
+            bytes->remove(bytes, --cursor, 1);
+        }
+        else
+        {
+            bytes->insert(bytes, cursor++, "x", 1);
+        }
+    }
+    chronom->stop(chronom);
+    seconds[0] = chronom->elapsed_seconds(chronom);
+
+    prng_seed(4848);
+    cursor = size / 2;
+    gapbuf->seek(gapbuf, cursor);
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < nedits; i++)
+    {
+        if (i % 64 == 0)
+        {
+            cursor = MIN(gapbuf->size(gapbuf), cursor + prng_next() % 256);
+            gapbuf->seek(gapbuf, cursor);
+        }
+
+        if (i % 4 == 3)
+        {
+            gapbuf->backspace(gapbuf, 1);
+            cursor--;
+        }
+        else
+        {
+            gapbuf->insert(gapbuf, "x", 1);
+            cursor++;
+        }
+    }
+    chronom->stop(chronom);
+    seconds[1] = chronom->elapsed_seconds(chronom);
+    CHECK(same(gapbuf, bytes));
+
+    BLAMMO(INFO, "edits at a cursor in %zu bytes: bytes_t %.3f us/edit, "
+           "gapbuf %.4f us/edit", size, seconds[0] * 1e6 / nedits,
+           seconds[1] * 1e6 / nedits);
+
+    gapbuf->destroy(gapbuf);
+    bytes->destroy(bytes);
+    chronom->destroy(chronom);
+TEST_END
+
+TESTSUITE_END
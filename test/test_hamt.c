@@ -0,0 +1,278 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "hamt.h"
+#include "collect.h"
+#include "chronom.h"
+#include "prng.h"
+#include "mut.h"
+#include "fixture.h"
+
+#include <string.h>
+#include <stdio.h>
+
+//------------------------------------------------------------------------|
+static void * string_copy(const void * str)
+{
+    return strdup((const char *) str);
+}
+
+// Visitor that checks every item against a reference collection
+static bool visit_check(void * object, const char * key, void * data)
+{
+    collect_t * model = (collect_t *) object;
+    return model->get(model, key) == data;
+}
+
+//------------------------------------------------------------------------|
+TESTSUITE_BEGIN
+
+    // Simple test of the blammo logger
+    BLAMMO_LEVEL(INFO);
+    BLAMMO_FILE("test_hamt.log");
+    BLAMMO(INFO, "hamt tests...");
+
+    // because these aren't always used, some warning eaters:
+    (void) fixture_reset;
+    (void) fixture_report;
+    (void) fixture_payload_two;
+
+TEST_BEGIN("create")
+    hamt_t * hamt = hamt_pub.create();
+    CHECK(hamt != NULL);
+    CHECK(hamt->priv != NULL);
+    CHECK(hamt->empty(hamt));
+    CHECK(hamt->length(hamt) == 0);
+    CHECK(hamt->get(hamt, "one") == NULL);
+    CHECK(hamt->foreach(hamt, NULL, NULL) == 0);
+    hamt->destroy(hamt);
+TEST_END
+
+TEST_BEGIN("versions")
+    hamt_t * v0 = hamt_pub.create();
+    hamt_t * v1 = v0->set(v0, "one", (void *) 1, NULL);
+    hamt_t * v2 = v1->set(v1, "two", (void *) 2, NULL);
+    hamt_t * v3 = v2->set(v2, "one", (void *) 11, NULL);
+
+    CHECK(v0->length(v0) == 0);
+    CHECK(v1->length(v1) == 1);
+    CHECK(v2->length(v2) == 2);
+    CHECK(v3->length(v3) == 2);
+
+    // every version keeps its own view
+    CHECK(v0->get(v0, "one") == NULL);
+    CHECK(v1->get(v1, "one") == (void *) 1);
+    CHECK(v1->get(v1, "two") == NULL);
+    CHECK(v2->get(v2, "one") == (void *) 1);
+    CHECK(v2->get(v2, "two") == (void *) 2);
+    CHECK(v3->get(v3, "one") == (void *) 11);
+    CHECK(v3->get(v3, "two") == (void *) 2);
+
+    hamt_t * v4 = v3->remove(v3, "two");
+    hamt_t * v5 = v4->remove(v4, "two");
+    hamt_t * v6 = v5->remove(v5, "one");
+    CHECK(v4->length(v4) == 1);
+    CHECK(v4->get(v4, "two") == NULL);
+    CHECK(v5->length(v5) == 1);
+    CHECK(v5->get(v5, "one") == (void *) 11);
+    CHECK(v6->empty(v6));
+    CHECK(v3->get(v3, "two") == (void *) 2);
+
+    // destroying older versions does not disturb newer ones
+    v0->destroy(v0);
+    v1->destroy(v1);
+    v2->destroy(v2);
+    CHECK(v3->get(v3, "one") == (void *) 11);
+
+    v3->destroy(v3);
+    v4->destroy(v4);
+    v5->destroy(v5);
+    v6->destroy(v6);
+TEST_END
+
+TEST_BEGIN("shared payloads")
+    fixture_reset();
+    payload_one_t * one = payload_one_create(1);
+    payload_one_t * two = payload_one_create(2);
+
+    hamt_t * hamt = hamt_pub.create();
+    hamt_t * next = hamt->set(hamt, "one", one, payload_one_destroy);
+    hamt->destroy(hamt);
+    hamt = next;
+
+    hamt_t * snapshot = hamt->copy(hamt);
+    CHECK(snapshot->get(snapshot, "one") == one);
+
+    // replaced in the newest version, but the snapshot still holds it
+    next = hamt->set(hamt, "one", two, payload_one_destroy);
+    hamt->destroy(hamt);
+    hamt = next;
+    CHECK(!one->is_destroyed);
+    CHECK(hamt->get(hamt, "one") == two);
+
+    snapshot->destroy(snapshot);
+    CHECK(one->is_destroyed);
+    CHECK(!two->is_destroyed);
+
+    next = hamt->remove(hamt, "one");
+    CHECK(!two->is_destroyed);
+    hamt->destroy(hamt);
+    CHECK(two->is_destroyed);
+    next->destroy(next);
+TEST_END
+
+TEST_BEGIN("random operations against a reference")
+    // Few enough distinct keys that branches are split and merged
+    // repeatedly, checking an old version along the way.
+    collect_t * model = collect_pub.create();
+    collect_t * saved = NULL;
+    hamt_t * hamt = hamt_pub.create();
+    hamt_t * old = NULL;
+    char key[32];
+    size_t i;
+
+    model->index(model, true);
+    prng_seed(32);
+
+    for (i = 0; i < 20000; i++)
+    {
+        uint64_t r = prng_next();
+        snprintf(key, sizeof(key), "k%u", (unsigned int) (r % 3000));
+
+        hamt_t * next = NULL;
+        if ((r >> 32) % 3 == 0)
+        {
+            next = hamt->remove(hamt, key);
+            model->remove(model, key);
+        }
+        else
+        {
+            next = hamt->set(hamt, key, (void *) (i + 1), NULL);
+            model->set(model, key, (void *) (i + 1), NULL, NULL);
+        }
+
+        CHECK(next != NULL);
+        hamt->destroy(hamt);
+        hamt = next;
+
+        if (i == 10000)
+        {
+            old = hamt->copy(hamt);
+            saved = model->copy(model);
+        }
+    }
+
+    CHECK(hamt->length(hamt) == model->length(model));
+    CHECK(hamt->foreach(hamt, visit_check, model) == model->length(model));
+    CHECK(old->length(old) == saved->length(saved));
+    CHECK(old->foreach(old, visit_check, saved) == saved->length(saved));
+
+    for (i = 0; i < 3000; i++)
+    {
+        snprintf(key, sizeof(key), "k%zu", i);
+        CHECK(hamt->get(hamt, key) == model->get(model, key));
+        CHECK(old->get(old, key) == saved->get(saved, key));
+    }
+
+    // drain the newest version completely
+    const char ** keys = model->keys(model);
+    size_t length = model->length(model);
+    for (i = 0; i < length; i++)
+    {
+        hamt_t * next = hamt->remove(hamt, keys[i]);
+        hamt->destroy(hamt);
+        hamt = next;
+    }
+
+    CHECK(hamt->empty(hamt));
+    CHECK(old->length(old) == saved->length(saved));
+
+    hamt->destroy(hamt);
+    old->destroy(old);
+    model->destroy(model);
+    saved->destroy(saved);
+TEST_END
+
+TEST_BEGIN("snapshot benchmark")
+    const size_t nitems = 20000;
+    collect_t * collect = collect_pub.create();
+    hamt_t * hamt = hamt_pub.create();
+    chronom_t * chronom = chronom_pub.create();
+    char key[32];
+    size_t i;
+
+    collect->index(collect, true);
+
+    for (i = 0; i < nitems; i++)
+    {
+        snprintf(key, sizeof(key), "object.%zu", i);
+        collect->set(collect, key, strdup(key), string_copy, free);
+
+        hamt_t * next = hamt->set(hamt, key, strdup(key), free);
+        hamt->destroy(hamt);
+        hamt = next;
+    }
+
+    chronom->start(chronom);
+    collect_t * deep = collect->copy(collect);
+    chronom->stop(chronom);
+    double deep_us = chronom->elapsed_seconds(chronom) * 1e6;
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    hamt_t * snapshot = hamt->copy(hamt);
+    chronom->stop(chronom);
+    double snapshot_us = chronom->elapsed_seconds(chronom) * 1e6;
+
+    // updates after the snapshot copy only their own path
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < 1000; i++)
+    {
+        snprintf(key, sizeof(key), "object.%zu", i * 7);
+        hamt_t * next = hamt->set(hamt, key, strdup("updated"), free);
+        hamt->destroy(hamt);
+        hamt = next;
+    }
+    chronom->stop(chronom);
+    double update_us = chronom->elapsed_seconds(chronom) * 1e6 / 1000;
+
+    CHECK(deep->length(deep) == nitems);
+    CHECK(snapshot->length(snapshot) == nitems);
+    CHECK(strcmp((char *) snapshot->get(snapshot, "object.7"),
+                 "object.7") == 0);
+    CHECK(strcmp((char *) hamt->get(hamt, "object.7"), "updated") == 0);
+
+    BLAMMO(INFO, "snapshot of %zu items: collect copy %.1f us, "
+                 "hamt copy %.3f us, hamt update %.2f us",
+                 nitems, deep_us, snapshot_us, update_us);
+
+    chronom->destroy(chronom);
+    deep->destroy(deep);
+    snapshot->destroy(snapshot);
+    collect->destroy(collect);
+    hamt->destroy(hamt);
+TEST_END
+
+TESTSUITE_END
@@ -0,0 +1,237 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "hash.h"
+#include "prng.h"
+#include "chronom.h"
+#include "mut.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//------------------------------------------------------------------------|
+static const cpu_path_t paths[] = {
+    CPU_PATH_SCALAR,
+    CPU_PATH_SSE2,
+    CPU_PATH_AVX2,
+};
+
+#define NUM_PATHS (sizeof(paths) / sizeof(paths[0]))
+
+//------------------------------------------------------------------------|
+TESTSUITE_BEGIN
+
+    // Simple test of the blammo logger
+    BLAMMO_LEVEL(INFO);
+    BLAMMO_FILE("test_hash.log");
+    BLAMMO(INFO, "hash tests...");
+
+TEST_BEGIN("known values")
+    // Hashes end up in files (see snapshot_t), so they must not change
+    // from one release to the next.  These hold on little-endian CPUs.
+    uint8_t data[1000];
+    size_t i;
+
+    for (i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t) i;
+    }
+
+    BLAMMO(INFO, "auto path is %s", hash_path_name(CPU_PATH_AUTO));
+
+    CHECK(hash_bytes("", 0, 0) == 0x0409638ee2bde459ULL);
+    CHECK(hash_bytes("a", 1, 0) == 0x28d2053309d28531ULL);
+    CHECK(hash_bytes("abc", 3, 0) == 0x02a4f1d7cb516c72ULL);
+    CHECK(hash_bytes("hello, world", 12, 0) == 0xa62febd64a684677ULL);
+    CHECK(hash_bytes("0123456789abcdef0123456789abcdef"
+                     "0123456789abcdef0123456789", 58, 0) ==
+          0xf051b9eb7b49421bULL);
+    CHECK(hash_bytes(data, sizeof(data), 0) == 0x2bc63bde26ff0ea6ULL);
+    CHECK(hash_bytes(data, sizeof(data), 42) == 0x136a9ceb85aad70fULL);
+TEST_END
+
+TEST_BEGIN("paths agree")
+    // Every length through a few blocks of the striped path, at every
+    // alignment, must hash identically on every path
+    const size_t max = 2300;
+    uint8_t * data = (uint8_t *) malloc(max + 8);
+    size_t size;
+    size_t p;
+
+    prng_seed(37);
+    prng_fill(data, max + 8);
+
+    for (p = 0; p < NUM_PATHS; p++)
+    {
+        BLAMMO(INFO, "%s path: %s", hash_path_name(paths[p]),
+               cpu_path_supported(paths[p]) ? "supported" : "unsupported");
+    }
+
+    CHECK(cpu_path_supported(CPU_PATH_SCALAR));
+    CHECK(cpu_path_supported(CPU_PATH_AUTO));
+
+    for (size = 0; size <= max; size++)
+    {
+        const uint8_t * start = data + (size & 7);
+        uint64_t seed = size * 0x9e3779b97f4a7c15ULL;
+        uint64_t expect = hash_bytes_path(start, size, seed,
+                                          CPU_PATH_SCALAR);
+
+        CHECK(hash_bytes(start, size, seed) == expect);
+        for (p = 1; p < NUM_PATHS; p++)
+        {
+            CHECK(hash_bytes_path(start, size, seed, paths[p]) == expect);
+        }
+    }
+
+    free(data);
+TEST_END
+
+TEST_BEGIN("distribution")
+    // No collisions among many similar short keys
+    const size_t nkeys = 100000;
+    uint64_t * hashes = (uint64_t *) malloc(sizeof(uint64_t) * nkeys);
+    char key[32];
+    size_t i;
+
+    for (i = 0; i < nkeys; i++)
+    {
+        snprintf(key, sizeof(key), "key.%zu", i);
+        hashes[i] = hash_bytes(key, strlen(key), 0);
+    }
+
+    // Sort-free duplicate check through an open addressed table
+    size_t capacity = 1 << 18;
+    uint64_t * table = (uint64_t *) calloc(capacity, sizeof(uint64_t));
+    size_t duplicates = 0;
+
+    for (i = 0; i < nkeys; i++)
+    {
+        size_t slot = hashes[i] & (capacity - 1);
+        while (table[slot] && table[slot] != hashes[i])
+        {
+            slot = (slot + 1) & (capacity - 1);
+        }
+
+        duplicates += table[slot] == hashes[i];
+        table[slot] = hashes[i];
+    }
+
+    CHECK(duplicates == 0);
+    free(table);
+    free(hashes);
+
+    // Flipping any one input bit flips about half the output bits, on
+    // both the short and the striped paths
+    const size_t sizes[] = { 3, 8, 16, 40, 200, 1500 };
+    uint8_t data[1500];
+    size_t s;
+
+    prng_seed(41);
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        size_t flips = 0;
+        size_t trials = 0;
+        size_t bit;
+
+        prng_fill(data, sizes[s]);
+        uint64_t base = hash_bytes(data, sizes[s], 0);
+
+        for (bit = 0; bit < sizes[s] * 8; bit += 1 + sizes[s] / 64)
+        {
+            data[bit / 8] ^= 1 << (bit % 8);
+            flips += __builtin_popcountll(base ^
+                                          hash_bytes(data, sizes[s], 0));
+            data[bit / 8] ^= 1 << (bit % 8);
+            trials++;
+        }
+
+        double average = (double) flips / trials;
+        BLAMMO(INFO, "%4zu bytes: %.2f of 64 bits flip on average",
+               sizes[s], average);
+        CHECK(average > 29.0 && average < 35.0);
+    }
+TEST_END
+
+TEST_BEGIN("seeds")
+    const char * text = "the quick brown fox";
+    uint8_t data[600] = { 0 };
+
+    CHECK(hash_bytes(text, 19, 0) != hash_bytes(text, 19, 1));
+    CHECK(hash_bytes(text, 19, 1) != hash_bytes(text, 19, 2));
+    CHECK(hash_bytes(data, 600, 0) != hash_bytes(data, 600, 1));
+
+    // All-zero input of different lengths still hashes differently
+    CHECK(hash_bytes(data, 599, 0) != hash_bytes(data, 600, 0));
+    CHECK(hash_bytes(data, 0, 0) != hash_bytes(data, 1, 0));
+TEST_END
+
+TEST_BEGIN("throughput benchmark")
+    const size_t sizes[] = { 8, 64, 256, 1024, 4096, 65536, 1 << 20 };
+    const size_t total = 1 << 24;
+    uint8_t * data = (uint8_t *) malloc(1 << 20);
+    chronom_t * chronom = chronom_pub.create();
+    uint64_t sink = 0;
+    size_t s;
+    size_t p;
+
+    prng_seed(43);
+    prng_fill(data, 1 << 20);
+
+    for (p = 0; p < NUM_PATHS; p++)
+    {
+        if (!cpu_path_supported(paths[p]))
+        {
+            continue;
+        }
+
+        for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+        {
+            size_t rounds = total / sizes[s];
+            size_t r;
+
+            chronom->reset(chronom);
+            chronom->start(chronom);
+            for (r = 0; r < rounds; r++)
+            {
+                sink += hash_bytes_path(data + (r & 7) * (sizes[s] < 64),
+                                        sizes[s], sink, paths[p]);
+            }
+            chronom->stop(chronom);
+
+            double seconds = chronom->elapsed_seconds(chronom);
+            BLAMMO(INFO, "%-6s %8zu bytes: %8.3f GB/s, %7.1f ns/hash",
+                   hash_path_name(paths[p]), sizes[s],
+                   (double) total / seconds / 1e9,
+                   seconds * 1e9 / rounds);
+        }
+    }
+
+    CHECK(sink != 0);
+    chronom->destroy(chronom);
+    free(data);
+TEST_END
+
+TESTSUITE_END
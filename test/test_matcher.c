@@ -0,0 +1,377 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "matcher.h"
+#include "bytes.h"
+#include "prng.h"
+#include "chronom.h"
+#include "utils.h"
+#include "mut.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//------------------------------------------------------------------------|
+#define MAX_MATCHES 100000
+
+// Matches as reported, in order
+typedef struct
+{
+    size_t id[MAX_MATCHES];
+    size_t offset[MAX_MATCHES];
+    size_t count;
+    size_t stop;        // stop after this many, if nonzero
+}
+record_t;
+
+static bool record(void * object, size_t id, size_t offset)
+{
+    record_t * r = (record_t *) object;
+
+    if (r->count < MAX_MATCHES)
+    {
+        r->id[r->count] = id;
+        r->offset[r->count] = offset;
+    }
+
+    r->count++;
+    return r->count != r->stop;
+}
+
+// The obvious memcmp() of every pattern at every offset, as the reference,
+// in the order the matcher reports: by where matches end, longest first,
+// then by id
+static void naive_scan(const uint8_t * data,
+                       size_t size,
+                       const uint8_t * const * patterns,
+                       const size_t * sizes,
+                       size_t count,
+                       record_t * r)
+{
+    size_t longest = 0;
+    size_t end;
+    size_t n;
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        longest = sizes[i] > longest ? sizes[i] : longest;
+    }
+
+    r->count = 0;
+    for (end = 1; end <= size; end++)
+    {
+        for (n = MIN(longest, end); n > 0; n--)
+        {
+            for (i = 0; i < count; i++)
+            {
+                if (sizes[i] == n &&
+                    !memcmp(data + end - n, patterns[i], n))
+                {
+                    record(r, i, end - n);
+                }
+            }
+        }
+    }
+}
+
+static bool same(const record_t * a, const record_t * b)
+{
+    return a->count == b->count &&
+           !memcmp(a->id, b->id, sizeof(size_t) * MIN(a->count, MAX_MATCHES)) &&
+           !memcmp(a->offset, b->offset,
+                   sizeof(size_t) * MIN(a->count, MAX_MATCHES));
+}
+
+// Fill with bytes from a small alphabet, so that partial matches abound
+static void fill_alphabet(uint8_t * data, size_t size, size_t letters)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        data[i] = 'a' + prng_next() % letters;
+    }
+}
+
+static record_t expected;
+static record_t actual;
+
+//------------------------------------------------------------------------|
+TESTSUITE_BEGIN
+
+    // Simple test of the blammo logger
+    BLAMMO_LEVEL(INFO);
+    BLAMMO_FILE("test_matcher.log");
+    BLAMMO(INFO, "matcher tests...");
+
+TEST_BEGIN("basics")
+    const char * words[] = { "he", "she", "his", "hers", "", "she" };
+    size_t sizes[6];
+    const char * text = "ushers and his shed";
+    bytes_t * bytes = bytes_pub.create(text, strlen(text));
+    matcher_t * matcher;
+    size_t i;
+
+    for (i = 0; i < 6; i++)
+    {
+        sizes[i] = strlen(words[i]);
+    }
+
+    matcher = matcher_pub.create((const void * const *) words, sizes, 6);
+    CHECK(matcher != NULL);
+    CHECK(matcher->length(matcher) == 6);
+    CHECK(matcher->size(matcher, 3) == 4);
+    CHECK(matcher->size(matcher, 4) == 0);
+    CHECK(matcher->size(matcher, 6) == 0);
+
+    // Root, h, he, her, hers, hi, his, s, sh, she, with 'h' 'e' 'i' 'r'
+    // 's' and everything else as classes
+    CHECK(matcher->states(matcher) == 10);
+    CHECK(matcher->table_size(matcher) == 10 * 6 * sizeof(uint32_t));
+
+    // "ushers": she and its duplicate, he, hers.  "his", and "she", "he"
+    // again in "shed".  The empty pattern never matches.
+    memset(&actual, 0, sizeof(actual));
+    CHECK(matcher->scan_bytes(matcher, bytes, record, &actual) == 8);
+    CHECK(actual.count == 8);
+    CHECK(actual.id[0] == 1 && actual.offset[0] == 1);
+    CHECK(actual.id[1] == 5 && actual.offset[1] == 1);
+    CHECK(actual.id[2] == 0 && actual.offset[2] == 2);
+    CHECK(actual.id[3] == 3 && actual.offset[3] == 2);
+    CHECK(actual.id[4] == 2 && actual.offset[4] == 11);
+    CHECK(actual.id[5] == 1 && actual.offset[5] == 15);
+    CHECK(actual.id[6] == 5 && actual.offset[6] == 15);
+    CHECK(actual.id[7] == 0 && actual.offset[7] == 16);
+    CHECK(matcher->scan(matcher, text, strlen(text), NULL, NULL) == 8);
+
+    // Stopping early, then picking the stream up after the stopping byte
+    matcher_stream_t stream = { 0, 0 };
+    memset(&actual, 0, sizeof(actual));
+    actual.stop = 1;
+    CHECK(matcher->feed(matcher, &stream, text, strlen(text),
+                        record, &actual) == 1);
+    CHECK(stream.offset == 4);
+    CHECK(matcher->feed(matcher, &stream, text + 4, strlen(text) - 4,
+                        NULL, NULL) == 5);
+
+    matcher->destroy(matcher);
+
+    // No patterns, or only empty ones, match nothing
+    matcher = matcher_pub.create(NULL, NULL, 0);
+    CHECK(matcher != NULL);
+    CHECK(matcher->scan_bytes(matcher, bytes, NULL, NULL) == 0);
+    matcher->destroy(matcher);
+
+    matcher = matcher_pub.create((const void * const *) words + 4,
+                                 sizes + 4, 1);
+    CHECK(matcher != NULL);
+    CHECK(matcher->states(matcher) == 1);
+    CHECK(matcher->scan_bytes(matcher, bytes, NULL, NULL) == 0);
+    matcher->destroy(matcher);
+
+    bytes->destroy(bytes);
+TEST_END
+
+TEST_BEGIN("agrees with naive search")
+    // Small alphabets make for many overlapping and nested matches, and
+    // patterns cut from the input make sure there are some
+    uint8_t data[600];
+    uint8_t storage[40][12];
+    const uint8_t * patterns[40];
+    size_t sizes[40];
+    size_t letters;
+    size_t round;
+    size_t i;
+
+    prng_seed(61);
+    for (letters = 1; letters <= 4; letters++)
+    {
+        for (round = 0; round < 300; round++)
+        {
+            size_t size = prng_next() % sizeof(data);
+            size_t count = 1 + prng_next() % 40;
+            matcher_t * matcher;
+
+            fill_alphabet(data, size, letters);
+            for (i = 0; i < count; i++)
+            {
+                sizes[i] = prng_next() % 12;
+                patterns[i] = storage[i];
+                if (i & 1 && sizes[i] <= size)
+                {
+                    memcpy(storage[i], data + prng_next() %
+                           (size - sizes[i] + 1), sizes[i]);
+                }
+                else
+                {
+                    fill_alphabet(storage[i], sizes[i], letters);
+                }
+            }
+
+            matcher = matcher_pub.create((const void * const *) patterns,
+                                         sizes, count);
+            naive_scan(data, size, patterns, sizes, count, &expected);
+            memset(&actual, 0, sizeof(actual));
+            CHECK(matcher->scan(matcher, data, size, record, &actual)
+                  == expected.count);
+            CHECK(same(&expected, &actual));
+            CHECK(matcher->scan(matcher, data, size, NULL, NULL)
+                  == expected.count);
+            matcher->destroy(matcher);
+        }
+    }
+TEST_END
+
+TEST_BEGIN("streaming")
+    // Random chunks, some of them empty, find the same matches at the
+    // same offsets as the whole input
+    uint8_t data[2000];
+    const char * words[] = { "abab", "bba", "aaaaaaa", "b", "abba",
+                             "babababa", "aab" };
+    size_t sizes[7];
+    matcher_t * matcher;
+    size_t round;
+    size_t i;
+
+    for (i = 0; i < 7; i++)
+    {
+        sizes[i] = strlen(words[i]);
+    }
+
+    matcher = matcher_pub.create((const void * const *) words, sizes, 7);
+    prng_seed(67);
+    for (round = 0; round < 200; round++)
+    {
+        matcher_stream_t stream = { 0, 0 };
+        size_t total = 0;
+        size_t at = 0;
+
+        fill_alphabet(data, sizeof(data), 2);
+        memset(&expected, 0, sizeof(expected));
+        matcher->scan(matcher, data, sizeof(data), record, &expected);
+
+        memset(&actual, 0, sizeof(actual));
+        while (at < sizeof(data))
+        {
+            size_t chunk = MIN(prng_next() % 20, sizeof(data) - at);
+            total += matcher->feed(matcher, &stream, data + at, chunk,
+                                   record, &actual);
+            at += chunk;
+        }
+
+        CHECK(stream.offset == sizeof(data));
+        CHECK(total == expected.count);
+        CHECK(same(&expected, &actual));
+    }
+
+    matcher->destroy(matcher);
+TEST_END
+
+TEST_BEGIN("benchmark")
+    // Count a couple hundred keywords in a log-like buffer, one count()
+    // pass per keyword versus a single matcher pass for all of them
+    const size_t size = 1 << 22;
+    const size_t nwords = 200;
+    const char * levels[] = { "INFO", "WARNING", "ERROR", "DEBUG" };
+    bytes_t * text = bytes_pub.create(NULL, 0);
+    char storage[200][16];
+    const char * words[200];
+    size_t sizes[200];
+    chronom_t * chronom = chronom_pub.create();
+    double seconds[2];
+    size_t counted = 0;
+    size_t scanned;
+    size_t i;
+    size_t j;
+
+    prng_seed(71);
+    for (i = 0; i < nwords; i++)
+    {
+        sizes[i] = 4 + prng_next() % 8;
+        for (j = 0; j < sizes[i]; j++)
+        {
+            storage[i][j] = 'a' + prng_next() % 26;
+        }
+
+        storage[i][j] = 0;
+        words[i] = storage[i];
+    }
+
+    while (text->size(text) < size)
+    {
+        char line[160];
+        int length = snprintf(line, sizeof(line), "%06u %s",
+                              (unsigned) (prng_next() % 1000000),
+                              levels[prng_next() % 4]);
+
+        for (j = 0; j < 8; j++)
+        {
+            char noise[8];
+
+            for (i = 0; i < 7; i++)
+            {
+                noise[i] = 'a' + prng_next() % 26;
+            }
+
+            noise[7] = 0;
+            length += snprintf(line + length, sizeof(line) - length, " %s",
+                               prng_next() % 4 ? noise :
+                               words[prng_next() % nwords]);
+        }
+
+        line[length++] = '\n';
+        text->append(text, line, length);
+    }
+
+    chronom->start(chronom);
+    for (i = 0; i < nwords; i++)
+    {
+        counted += text->count(text, 0, words[i], sizes[i], true);
+    }
+    chronom->stop(chronom);
+    seconds[0] = chronom->elapsed_seconds(chronom);
+
+    matcher_t * matcher = matcher_pub.create((const void * const *) words,
+                                             sizes, nwords);
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    scanned = matcher->scan_bytes(matcher, text, NULL, NULL);
+    chronom->stop(chronom);
+    seconds[1] = chronom->elapsed_seconds(chronom);
+    CHECK(scanned == counted);
+
+    BLAMMO(INFO, "%zu matches of %zu keywords in %zu bytes: "
+           "count() per keyword %.2f ms, matcher %.2f ms "
+           "(%zu states, %zu byte table)", scanned, nwords,
+           text->size(text), seconds[0] * 1e3, seconds[1] * 1e3,
+           matcher->states(matcher), matcher->table_size(matcher));
+
+    matcher->destroy(matcher);
+    chronom->destroy(chronom);
+    text->destroy(text);
+TEST_END
+
+TESTSUITE_END
@@ -0,0 +1,445 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "number.h"
+#include "prng.h"
+#include "chronom.h"
+#include "mut.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+//------------------------------------------------------------------------|
+// Random values spread over every magnitude, not just the large ones
+static uint64_t spread_u64(void)
+{
+    return prng_next() >> (prng_next() % 64);
+}
+
+// Random finite doubles, from their bits
+static double random_double(void)
+{
+    uint64_t bits;
+    double value;
+
+    do
+    {
+        bits = prng_next();
+    }
+    while (((bits >> 52) & 0x7ff) == 0x7ff);
+
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static bool same_double(double a, double b)
+{
+    return memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Format a double, terminated, for comparing and reading back
+static const char * format_double(char * out, double value)
+{
+    out[number_format_double(out, value)] = '\0';
+    return out;
+}
+
+// Fewest significant digits that printf() needs for a double to read
+// back the same, by trying each
+static int shortest_digits(double value)
+{
+    char text[40];
+    int precision;
+
+    for (precision = 1; precision < 17; precision++)
+    {
+        snprintf(text, sizeof(text), "%.*e", precision - 1, value);
+        if (same_double(strtod(text, NULL), value))
+        {
+            break;
+        }
+    }
+
+    return precision;
+}
+
+// Significant digits in formatted output, with any exponent left off
+static int count_digits(const char * text)
+{
+    int count = 0;
+    int zeros = 0;
+    bool leading = true;
+
+    for (; *text && *text != 'e'; text++)
+    {
+        if (*text < '0' || *text > '9')
+        {
+            continue;
+        }
+        else if (*text == '0')
+        {
+            zeros += !leading;
+            continue;
+        }
+
+        count += zeros + 1;
+        zeros = 0;
+        leading = false;
+    }
+
+    return count;
+}
+
+//------------------------------------------------------------------------|
+TESTSUITE_BEGIN
+
+    // Test setup code goes here
+    prng_seed(50);
+
+TEST_BEGIN("integers")
+    char out[NUMBER_MAX_CHARS + 1];
+    char expect[64];
+    size_t length;
+    size_t i;
+
+    CHECK(number_format_u64(out, 0) == 1 && out[0] == '0');
+    CHECK(number_format_u64(out, UINT64_MAX) == 20);
+    CHECK(memcmp(out, "18446744073709551615", 20) == 0);
+    CHECK(number_format_i64(out, INT64_MIN) == 20);
+    CHECK(memcmp(out, "-9223372036854775808", 20) == 0);
+    CHECK(number_format_hex(out, 0, 0) == 1 && out[0] == '0');
+    CHECK(number_format_hex(out, 0xbeef, 8) == 8);
+    CHECK(memcmp(out, "0000beef", 8) == 0);
+    CHECK(number_format_hex(out, 0x1234, 40) == 16);
+
+    for (i = 0; i < 200000; i++)
+    {
+        uint64_t value = spread_u64();
+
+        length = number_format_u64(out, value);
+        snprintf(expect, sizeof(expect), "%" PRIu64, value);
+        CHECK(length == strlen(expect) && memcmp(out, expect, length) == 0);
+
+        length = number_format_i64(out, (int64_t) value);
+        snprintf(expect, sizeof(expect), "%" PRId64, (int64_t) value);
+        CHECK(length == strlen(expect) && memcmp(out, expect, length) == 0);
+
+        length = number_format_hex(out, value, i % 18);
+        snprintf(expect, sizeof(expect), "%0*" PRIx64,
+                 (int) (i % 18 > 16 ? 16 : i % 18), value);
+        CHECK(length == strlen(expect) && memcmp(out, expect, length) == 0);
+    }
+TEST_END
+
+TEST_BEGIN("parse integers")
+    uint64_t u = 7;
+    int64_t s = 7;
+    char text[64];
+    size_t i;
+
+    CHECK(number_parse_u64("18446744073709551615", 20, &u) == 20);
+    CHECK(u == UINT64_MAX);
+    CHECK(number_parse_u64("18446744073709551616", 20, &u) < 0);
+    CHECK(number_parse_u64("184467440737095516150", 21, &u) < 0);
+    CHECK(u == UINT64_MAX);
+    CHECK(number_parse_u64("0000000000000000000000042", 25, &u) == 25);
+    CHECK(u == 42);
+    CHECK(number_parse_u64("12ab", 4, &u) == 2 && u == 12);
+    CHECK(number_parse_u64("123", 2, &u) == 2 && u == 12);
+    CHECK(number_parse_u64("", 0, &u) < 0);
+    CHECK(number_parse_u64("-1", 2, &u) < 0);
+    CHECK(number_parse_u64(" 1", 2, &u) < 0);
+
+    CHECK(number_parse_i64("-9223372036854775808", 20, &s) == 20);
+    CHECK(s == INT64_MIN);
+    CHECK(number_parse_i64("9223372036854775808", 19, &s) < 0);
+    CHECK(number_parse_i64("+17,", 4, &s) == 3 && s == 17);
+    CHECK(number_parse_i64("-", 1, &s) < 0);
+
+    CHECK(number_parse_hex("0xDeadBeef", 10, &u) == 10 && u == 0xdeadbeef);
+    CHECK(number_parse_hex("0x", 2, &u) == 1 && u == 0);
+    CHECK(number_parse_hex("ffffffffffffffff", 16, &u) == 16);
+    CHECK(u == UINT64_MAX);
+    CHECK(number_parse_hex("10000000000000000", 17, &u) < 0);
+    CHECK(number_parse_hex("g", 1, &u) < 0);
+
+    // Read back what the formatters write, and agree with strtoull()
+    for (i = 0; i < 200000; i++)
+    {
+        uint64_t value = spread_u64();
+        size_t length = number_format_u64(text, value);
+
+        CHECK(number_parse_u64(text, length, &u) == (ssize_t) length);
+        CHECK(u == value);
+        text[length] = '\0';
+        CHECK(u == strtoull(text, NULL, 10));
+
+        length = number_format_i64(text, (int64_t) value);
+        CHECK(number_parse_i64(text, length, &s) == (ssize_t) length);
+        CHECK(s == (int64_t) value);
+
+        length = number_format_hex(text, value, 0);
+        CHECK(number_parse_hex(text, length, &u) == (ssize_t) length);
+        CHECK(u == value);
+    }
+TEST_END
+
+TEST_BEGIN("doubles")
+    char out[NUMBER_MAX_CHARS + 1];
+    size_t shortest = 0;
+    size_t i;
+
+    CHECK(strcmp(format_double(out, 0.0), "0") == 0);
+    CHECK(strcmp(format_double(out, -0.0), "-0") == 0);
+    CHECK(strcmp(format_double(out, 0.1), "0.1") == 0);
+    CHECK(strcmp(format_double(out, -123.456), "-123.456") == 0);
+    CHECK(strcmp(format_double(out, 1e20), "100000000000000000000") == 0);
+    CHECK(strcmp(format_double(out, 1e21), "1e+21") == 0);
+    CHECK(strcmp(format_double(out, 0.000001), "0.000001") == 0);
+    CHECK(strcmp(format_double(out, 1.5e-7), "1.5e-7") == 0);
+    CHECK(strcmp(format_double(out, 5e-324), "5e-324") == 0);
+    CHECK(strcmp(format_double(out, 1.7976931348623157e308),
+                 "1.7976931348623157e+308") == 0);
+    CHECK(strcmp(format_double(out, __builtin_inf()), "inf") == 0);
+    CHECK(strcmp(format_double(out, -__builtin_inf()), "-inf") == 0);
+    CHECK(strcmp(format_double(out, __builtin_nan("")), "nan") == 0);
+
+    // Every output reads back exactly, and is nearly always as short as
+    // it can be
+    for (i = 0; i < 200000; i++)
+    {
+        double value = random_double();
+
+        format_double(out, value);
+        CHECK(same_double(strtod(out, NULL), value));
+        if (i % 10 == 0)
+        {
+            int digits = count_digits(out);
+
+            CHECK(digits >= shortest_digits(value) && digits <= 17);
+            shortest += digits == shortest_digits(value);
+        }
+    }
+
+    CHECK(shortest > 19900);
+    BLAMMO(INFO, "shortest digits for %zu of 20000 doubles", shortest);
+TEST_END
+
+TEST_BEGIN("parse doubles")
+    const char * cases[] = {
+        "0", "-0", "1", "0.1", ".5", "5.", "-2.5e-3", "1E10", "1e+308",
+        "2.2250738585072014e-308", "4.9406564584124654e-324",
+        "9007199254740993", "123456789012345678901234567890",
+        "0.000000000000000000000000000001", "1e400", "1e-400",
+        "3.14159265358979323846264338327950288", "00000000001.50000",
+        "1.7976931348623157e308", "179769313486231580793728971405301e276",
+    };
+    char text[64];
+    double value;
+    size_t i;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        size_t length = strlen(cases[i]);
+
+        value = 7.0;
+        CHECK(number_parse_double(cases[i], length, &value) ==
+              (ssize_t) length);
+        CHECK(same_double(value, strtod(cases[i], NULL)));
+    }
+
+    // Past the significant digits kept for strtod_l(): halfway between
+    // two doubles rounds to even, and any nonzero digit far beyond that
+    // must still round up, whether after the point or before it
+    char * longer = (char *) malloc(2048);
+    size_t length;
+
+    memcpy(longer, "9007199254740993.", 17);
+    memset(longer + 17, '0', 1000);
+    length = 1017;
+    CHECK(number_parse_double(longer, length, &value) == (ssize_t) length);
+    CHECK(value == 9007199254740992.0);
+    longer[length++] = '1';
+    CHECK(number_parse_double(longer, length, &value) == (ssize_t) length);
+    CHECK(value == 9007199254740994.0);
+    longer[length] = '\0';
+    CHECK(same_double(value, strtod(longer, NULL)));
+
+    memcpy(longer, "-9007199254740993", 17);
+    memset(longer + 17, '0', 1000);
+    memcpy(longer + 1017, "1e-1001", 7);
+    length = 1024;
+    longer[length] = '\0';
+    CHECK(number_parse_double(longer, length, &value) == (ssize_t) length);
+    CHECK(value == -9007199254740994.0);
+    CHECK(same_double(value, strtod(longer, NULL)));
+    free(longer);
+
+    CHECK(number_parse_double("1.5e", 4, &value) == 3 && value == 1.5);
+    CHECK(number_parse_double("2e+x", 4, &value) == 1 && value == 2.0);
+    CHECK(number_parse_double("-Infinity", 9, &value) == 9);
+    CHECK(value == -__builtin_inf());
+    CHECK(number_parse_double("nan", 3, &value) == 3 && value != value);
+    CHECK(number_parse_double(".", 1, &value) < 0);
+    CHECK(number_parse_double("-e5", 3, &value) < 0);
+    CHECK(number_parse_double("", 0, &value) < 0);
+
+    // Read back the formatter's output, and printf()'s
+    for (i = 0; i < 200000; i++)
+    {
+        double expect = random_double();
+        size_t length = number_format_double(text, expect);
+
+        CHECK(number_parse_double(text, length, &value) == (ssize_t) length);
+        CHECK(same_double(value, expect));
+
+        length = (size_t) snprintf(text, sizeof(text), "%.*g",
+                                   (int) (i % 17) + 1, expect);
+        CHECK(number_parse_double(text, length, &value) == (ssize_t) length);
+        CHECK(same_double(value, strtod(text, NULL)));
+    }
+TEST_END
+
+TEST_BEGIN("benchmark")
+    const size_t count = 1000000;
+    chronom_t * chronom = chronom_pub.create();
+    uint64_t * integers = (uint64_t *) malloc(count * sizeof(uint64_t));
+    double * doubles = (double *) malloc(count * sizeof(double));
+    char * texts = (char *) malloc(count * NUMBER_MAX_CHARS);
+    double seconds[2];
+    uint64_t sum[2] = { 0, 0 };
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        integers[i] = spread_u64();
+        doubles[i] = (double) (prng_next() % 100000000) / 1000.0;
+    }
+
+    // Formatting, keeping each result so nothing is optimized away
+    chronom->start(chronom);
+    for (i = 0; i < count; i++)
+    {
+        snprintf(texts + i * NUMBER_MAX_CHARS, NUMBER_MAX_CHARS,
+                 "%" PRIu64, integers[i]);
+    }
+    chronom->stop(chronom);
+    seconds[0] = chronom->elapsed_seconds(chronom);
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < count; i++)
+    {
+        char * text = texts + i * NUMBER_MAX_CHARS;
+        text[number_format_u64(text, integers[i])] = '\0';
+    }
+    chronom->stop(chronom);
+    seconds[1] = chronom->elapsed_seconds(chronom);
+    BLAMMO(INFO, "u64 format: snprintf %.1f ns, number %.1f ns",
+           seconds[0] * 1e9 / count, seconds[1] * 1e9 / count);
+
+    // Parsing what was just formatted
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < count; i++)
+    {
+        sum[0] += strtoull(texts + i * NUMBER_MAX_CHARS, NULL, 10);
+    }
+    chronom->stop(chronom);
+    seconds[0] = chronom->elapsed_seconds(chronom);
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < count; i++)
+    {
+        const char * text = texts + i * NUMBER_MAX_CHARS;
+        uint64_t value = 0;
+
+        number_parse_u64(text, NUMBER_MAX_CHARS, &value);
+        sum[1] += value;
+    }
+    chronom->stop(chronom);
+    seconds[1] = chronom->elapsed_seconds(chronom);
+    CHECK(sum[0] == sum[1]);
+    BLAMMO(INFO, "u64 parse: strtoull %.1f ns, number %.1f ns",
+           seconds[0] * 1e9 / count, seconds[1] * 1e9 / count);
+
+    // Doubles with three decimals, as in a report, formatted so that
+    // they read back exactly
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < count; i++)
+    {
+        snprintf(texts + i * NUMBER_MAX_CHARS, NUMBER_MAX_CHARS,
+                 "%.17g", doubles[i]);
+    }
+    chronom->stop(chronom);
+    seconds[0] = chronom->elapsed_seconds(chronom);
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < count; i++)
+    {
+        char * text = texts + i * NUMBER_MAX_CHARS;
+        text[number_format_double(text, doubles[i])] = '\0';
+    }
+    chronom->stop(chronom);
+    seconds[1] = chronom->elapsed_seconds(chronom);
+    BLAMMO(INFO, "double format: snprintf %.1f ns, number %.1f ns",
+           seconds[0] * 1e9 / count, seconds[1] * 1e9 / count);
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < count; i++)
+    {
+        sum[0] += (uint64_t) strtod(texts + i * NUMBER_MAX_CHARS, NULL);
+    }
+    chronom->stop(chronom);
+    seconds[0] = chronom->elapsed_seconds(chronom);
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < count; i++)
+    {
+        const char * text = texts + i * NUMBER_MAX_CHARS;
+        double value = 0.0;
+
+        number_parse_double(text, strlen(text), &value);
+        sum[1] += (uint64_t) value;
+    }
+    chronom->stop(chronom);
+    seconds[1] = chronom->elapsed_seconds(chronom);
+    CHECK(sum[0] == sum[1]);
+    BLAMMO(INFO, "double parse: strtod %.1f ns, number %.1f ns",
+           seconds[0] * 1e9 / count, seconds[1] * 1e9 / count);
+
+    free(texts);
+    free(doubles);
+    free(integers);
+    chronom->destroy(chronom);
+TEST_END
+
+TESTSUITE_END
@@ -0,0 +1,361 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "ordmap.h"
+#include "prng.h"
+#include "mut.h"
+#include "fixture.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+TESTSUITE_BEGIN
+
+    // Simple test of the blammo logger
+    BLAMMO_LEVEL(INFO);
+    BLAMMO_FILE("test_ordmap.log");
+    BLAMMO(INFO, "ordmap tests...");
+
+    // because these aren't always used, some warning eaters:
+    (void) fixture_reset;
+    (void) fixture_report;
+    (void) fixture_payload_one;
+
+TEST_BEGIN("create")
+    ordmap_t * ordmap = ordmap_pub.create();
+    CHECK(ordmap != NULL);
+    CHECK(ordmap->priv != NULL);
+    CHECK(ordmap->empty(ordmap));
+    CHECK(ordmap->length(ordmap) == 0);
+    ordmap->destroy(ordmap);
+TEST_END
+
+TEST_BEGIN("set, get, overwrite")
+    fixture_reset();
+
+    ordmap_t * ordmap = ordmap_pub.create();
+    ordmap->set(ordmap, "one", payload_one_create(1),
+                               payload_one_copy,
+                               payload_one_destroy);
+    ordmap->set(ordmap, "two", (void *) 2, NULL, NULL);
+    CHECK(ordmap->length(ordmap) == 2);
+    CHECK(ordmap->get(ordmap, "two") == (void *) 2);
+    CHECK(ordmap->get(ordmap, "three") == NULL);
+
+    payload_one_t * p1 = (payload_one_t *) ordmap->get(ordmap, "one");
+    CHECK(p1 != NULL);
+    CHECK(p1->id == 1);
+
+    // Overwriting must destroy the previous object
+    ordmap->set(ordmap, "one", (void *) 1, NULL, NULL);
+    CHECK(p1->is_destroyed);
+    CHECK(ordmap->get(ordmap, "one") == (void *) 1);
+    CHECK(ordmap->length(ordmap) == 2);
+
+    ordmap->destroy(ordmap);
+TEST_END
+
+TEST_BEGIN("ordering, keys & objects")
+    ordmap_t * ordmap = ordmap_pub.create();
+
+    ordmap->set(ordmap, "charlie", (void *) 3, NULL, NULL);
+    ordmap->set(ordmap, "alpha", (void *) 1, NULL, NULL);
+    ordmap->set(ordmap, "delta", (void *) 4, NULL, NULL);
+    ordmap->set(ordmap, "bravo", (void *) 2, NULL, NULL);
+
+    const char ** keys = ordmap->keys(ordmap);
+    CHECK(strcmp("alpha", keys[0]) == 0);
+    CHECK(strcmp("bravo", keys[1]) == 0);
+    CHECK(strcmp("charlie", keys[2]) == 0);
+    CHECK(strcmp("delta", keys[3]) == 0);
+    CHECK(keys[4] == NULL);
+
+    void ** objects = ordmap->objects(ordmap);
+    CHECK((void *) 1 == objects[0]);
+    CHECK((void *) 2 == objects[1]);
+    CHECK((void *) 3 == objects[2]);
+    CHECK((void *) 4 == objects[3]);
+    CHECK(objects[4] == NULL);
+
+    ordmap->destroy(ordmap);
+TEST_END
+
+TEST_BEGIN("random set & remove")
+    // Enough items for a tree several levels deep, then remove them
+    // in a different random order, checking order along the way.
+    const size_t count = 4000;
+    char key[32] = { 0 };
+    size_t * order = (size_t *) malloc(sizeof(size_t) * count);
+    ordmap_t * ordmap = ordmap_pub.create();
+    size_t i, j, tmp;
+
+    prng_seed(0xB7EEB7EEULL);
+    for (i = 0; i < count; i++)
+    {
+        order[i] = i;
+    }
+
+    for (i = count - 1; i > 0; i--)
+    {
+        j = prng_next() % (i + 1);
+        tmp = order[i]; order[i] = order[j]; order[j] = tmp;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        snprintf(key, sizeof(key), "key%06zu", order[i]);
+        ordmap->set(ordmap, key, (void *) (order[i] + 1), NULL, NULL);
+    }
+
+    CHECK(ordmap->length(ordmap) == count);
+
+    char * k = NULL;
+    void * o = NULL;
+    void * iter = ordmap->first(ordmap, &k, &o);
+    i = 0;
+    while (iter)
+    {
+        CHECK(o == (void *) (i + 1));
+        i++;
+        iter = ordmap->next(iter, &k, &o);
+    }
+    CHECK(i == count);
+
+    for (i = count - 1; i > 0; i--)
+    {
+        j = prng_next() % (i + 1);
+        tmp = order[i]; order[i] = order[j]; order[j] = tmp;
+    }
+
+    // remove all the odd ones first, verify the even ones remain
+    for (i = 0; i < count; i++)
+    {
+        if (order[i] & 1)
+        {
+            snprintf(key, sizeof(key), "key%06zu", order[i]);
+            CHECK(ordmap->remove(ordmap, key));
+            CHECK(!ordmap->remove(ordmap, key));
+        }
+    }
+
+    CHECK(ordmap->length(ordmap) == count / 2);
+
+    iter = ordmap->first(ordmap, &k, &o);
+    i = 0;
+    while (iter)
+    {
+        CHECK(o == (void *) (i + 1));
+        i += 2;
+        iter = ordmap->next(iter, &k, &o);
+    }
+    CHECK(i == count);
+
+    for (i = 0; i < count; i += 2)
+    {
+        snprintf(key, sizeof(key), "key%06zu", i);
+        CHECK(ordmap->get(ordmap, key) == (void *) (i + 1));
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (!(order[i] & 1))
+        {
+            snprintf(key, sizeof(key), "key%06zu", order[i]);
+            CHECK(ordmap->remove(ordmap, key));
+        }
+    }
+
+    CHECK(ordmap->empty(ordmap));
+    CHECK(ordmap->length(ordmap) == 0);
+    CHECK(ordmap->first(ordmap, &k, &o) == NULL);
+
+    free(order);
+    ordmap->destroy(ordmap);
+TEST_END
+
+TEST_BEGIN("lower_bound, upper_bound")
+    ordmap_t * ordmap = ordmap_pub.create();
+    char * key = NULL;
+    void * object = NULL;
+
+    ordmap->set(ordmap, "b", (void *) 2, NULL, NULL);
+    ordmap->set(ordmap, "d", (void *) 4, NULL, NULL);
+    ordmap->set(ordmap, "f", (void *) 6, NULL, NULL);
+
+    CHECK(ordmap->lower_bound(ordmap, "a", &key, &object) != NULL);
+    CHECK(strcmp(key, "b") == 0);
+    CHECK(ordmap->lower_bound(ordmap, "d", &key, &object) != NULL);
+    CHECK(strcmp(key, "d") == 0);
+    CHECK(ordmap->lower_bound(ordmap, "e", &key, &object) != NULL);
+    CHECK(strcmp(key, "f") == 0);
+    CHECK(ordmap->lower_bound(ordmap, "g", &key, &object) == NULL);
+    CHECK(key == NULL);
+
+    CHECK(ordmap->upper_bound(ordmap, "d", &key, &object) != NULL);
+    CHECK(strcmp(key, "f") == 0);
+    CHECK(ordmap->upper_bound(ordmap, "c", &key, &object) != NULL);
+    CHECK(strcmp(key, "d") == 0);
+    CHECK(ordmap->upper_bound(ordmap, "f", &key, &object) == NULL);
+
+    ordmap->destroy(ordmap);
+TEST_END
+
+TEST_BEGIN("range iteration")
+    ordmap_t * ordmap = ordmap_pub.create();
+    char key[8] = { 0 };
+    char * k = NULL;
+    void * o = NULL;
+    size_t i;
+
+    for (i = 0; i < 26; i++)
+    {
+        snprintf(key, sizeof(key), "%c", (char) ('a' + i));
+        ordmap->set(ordmap, key, (void *) (i + 1), NULL, NULL);
+    }
+
+    // [e, k) should be e f g h i j
+    i = 0;
+    void * iter = ordmap->range_first(ordmap, "e", "k", &k, &o);
+    while (iter)
+    {
+        CHECK(k[0] == 'e' + i);
+        i++;
+        iter = ordmap->range_next(iter, "k", &k, &o);
+    }
+    CHECK(i == 6);
+
+    // unbounded below, [.., c) should be a b
+    i = 0;
+    iter = ordmap->range_first(ordmap, NULL, "c", &k, &o);
+    while (iter)
+    {
+        i++;
+        iter = ordmap->range_next(iter, "c", &k, &o);
+    }
+    CHECK(i == 2);
+
+    // empty range
+    CHECK(ordmap->range_first(ordmap, "x", "x", &k, &o) == NULL);
+
+    ordmap->destroy(ordmap);
+TEST_END
+
+TEST_BEGIN("prefix iteration")
+    const char * keys[] = {
+        "net.ip",
+        "log.file",
+        "net.mask",
+        "netmask",
+        "ne",
+        "net.gateway",
+        "zzz",
+        NULL
+    };
+
+    const char * expect[] = {
+        "net.gateway",
+        "net.ip",
+        "net.mask",
+        NULL
+    };
+
+    ordmap_t * ordmap = ordmap_pub.create();
+    char * k = NULL;
+    void * o = NULL;
+    size_t i = 0;
+
+    while (keys[i])
+    {
+        ordmap->set(ordmap, keys[i], (void *) (i + 1), NULL, NULL);
+        i++;
+    }
+
+    i = 0;
+    void * iter = ordmap->prefix_first(ordmap, "net.", &k, &o);
+    while (iter)
+    {
+        CHECK(expect[i] != NULL);
+        CHECK(strcmp(k, expect[i]) == 0);
+        i++;
+        iter = ordmap->prefix_next(iter, "net.", &k, &o);
+    }
+    CHECK(expect[i] == NULL);
+
+    CHECK(ordmap->prefix_first(ordmap, "q", &k, &o) == NULL);
+
+    ordmap->destroy(ordmap);
+TEST_END
+
+TEST_BEGIN("copy")
+    fixture_reset();
+
+    const char * keys[] = {
+        "one",
+        "two",
+        "three",
+        "four",
+        NULL
+    };
+
+    ordmap_t * ordmap = ordmap_pub.create();
+    int i = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        ordmap->set(ordmap, keys[i], payload_one_create(i),
+                                     payload_one_copy,
+                                     payload_one_destroy);
+    }
+
+    ordmap_t * copy = ordmap->copy(ordmap);
+    CHECK(copy->length(copy) == ordmap->length(ordmap));
+
+    char * orig_key = NULL;
+    void * orig_object = NULL;
+    void * orig_iter = ordmap->first(ordmap, &orig_key, &orig_object);
+
+    char * copy_key = NULL;
+    void * copy_object = NULL;
+    void * copy_iter = copy->first(copy, &copy_key, &copy_object);
+
+    while (orig_iter && copy_iter)
+    {
+        CHECK(orig_key != copy_key);
+        CHECK(orig_object != copy_object);
+        CHECK(strcmp(orig_key, copy_key) == 0);
+        CHECK(payload_one_compare(&orig_object, &copy_object) == 0);
+
+        orig_iter = ordmap->next(orig_iter, &orig_key, &orig_object);
+        copy_iter = copy->next(copy_iter, &copy_key, &copy_object);
+    }
+
+    CHECK(orig_iter == NULL);
+    CHECK(copy_iter == NULL);
+
+    copy->destroy(copy);
+    ordmap->destroy(ordmap);
+TEST_END
+
+TESTSUITE_END
@@ -0,0 +1,303 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "rope.h"
+#include "bytes.h"
+#include "prng.h"
+#include "chronom.h"
+#include "mut.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//------------------------------------------------------------------------|
+// Check a rope against the bytes it should hold, through flatten() and
+// read_at() both
+static bool same(const rope_t * rope, const bytes_t * bytes)
+{
+    size_t size = bytes->size(bytes);
+    bytes_t * flat = rope->flatten(rope);
+    uint8_t * read = (uint8_t *) malloc(size + 1);
+    bool result = flat && read &&
+                  rope->size(rope) == size &&
+                  flat->compare(flat, bytes) == 0 &&
+                  rope->read_at(rope, read, size, 0) == (ssize_t) size &&
+                  memcmp(read, bytes->data(bytes), size) == 0;
+
+    if (flat)
+    {
+        flat->destroy(flat);
+    }
+
+    free(read);
+    return result;
+}
+
+// walk() visitor that counts bytes and stops after 'stop' pieces
+typedef struct
+{
+    size_t bytes;
+    size_t visits;
+    size_t stop;
+}
+walked_t;
+
+static bool walked(void * object, const uint8_t * data, size_t size)
+{
+    walked_t * w = (walked_t *) object;
+
+    (void) data;
+    w->bytes += size;
+    w->visits++;
+    return w->visits != w->stop;
+}
+
+//------------------------------------------------------------------------|
+TESTSUITE_BEGIN
+
+    // Test setup code goes here
+    prng_seed(47);
+
+TEST_BEGIN("basics")
+    rope_t * rope = rope_pub.create("hello world", 11);
+    char buffer[64];
+    walked_t w = { 0, 0, 0 };
+
+    CHECK(rope != NULL);
+    CHECK(rope->size(rope) == 11);
+    CHECK(rope->pieces(rope) == 1);
+
+    CHECK(rope->insert(rope, 5, ",", 1) == 12);
+    CHECK(rope->insert(rope, 12, "!", 1) == 13);
+    CHECK(rope->insert(rope, 0, ">> ", 3) == 16);
+    CHECK(rope->read_at(rope, buffer, 16, 0) == 16);
+    CHECK(memcmp(buffer, ">> hello, world!", 16) == 0);
+
+    // Out of bounds
+    CHECK(rope->insert(rope, 17, "x", 1) < 0);
+    CHECK(rope->remove(rope, 10, 7) < 0);
+    CHECK(rope->read_at(rope, buffer, 2, 15) < 0);
+    CHECK(rope->slice(rope, 16, 1) == NULL);
+    CHECK(rope->insert(rope, 16, "", 0) == 16);
+    CHECK(rope->remove(rope, 16, 0) == 16);
+
+    // Removing across pieces
+    CHECK(rope->remove(rope, 1, 6) == 10);
+    CHECK(rope->read_at(rope, buffer, 10, 0) == 10);
+    CHECK(memcmp(buffer, ">o, world!", 10) == 0);
+    CHECK(rope->read_at(rope, buffer, 4, 3) == 4);
+    CHECK(memcmp(buffer, " wor", 4) == 0);
+
+    // Slices share storage but are edited independently
+    rope_t * slice = rope->slice(rope, 2, 7);
+    CHECK(slice != NULL);
+    CHECK(slice->size(slice) == 7);
+    CHECK(slice->insert(slice, 7, "s", 1) == 8);
+    CHECK(slice->read_at(slice, buffer, 8, 0) == 8);
+    CHECK(memcmp(buffer, ", worlds", 8) == 0);
+    CHECK(rope->read_at(rope, buffer, 10, 0) == 10);
+    CHECK(memcmp(buffer, ">o, world!", 10) == 0);
+
+    CHECK(rope->walk(rope, walked, &w));
+    CHECK(w.bytes == 10);
+    CHECK(w.visits == rope->pieces(rope));
+    w.bytes = w.visits = 0;
+    w.stop = 1;
+    CHECK(!rope->walk(rope, walked, &w));
+    CHECK(w.visits == 1);
+
+    // The original can go first; the slice keeps what it shares
+    rope->destroy(rope);
+    bytes_t * flat = slice->flatten(slice);
+    CHECK(flat->size(flat) == 8);
+    CHECK(strcmp(flat->cstr(flat), ", worlds") == 0);
+    flat->destroy(flat);
+    slice->destroy(slice);
+
+    // Typing extends one piece rather than adding a piece per insert
+    rope = rope_pub.create(NULL, 0);
+    CHECK(rope->size(rope) == 0);
+    CHECK(rope->pieces(rope) == 0);
+    flat = rope->flatten(rope);
+    CHECK(flat->size(flat) == 0);
+    flat->destroy(flat);
+    for (size_t i = 0; i < 1000; i++)
+    {
+        CHECK(rope->insert(rope, i, "abcdefghij" + i % 10, 1) ==
+              (ssize_t) i + 1);
+    }
+    CHECK(rope->pieces(rope) == 1);
+    CHECK(rope->read_at(rope, buffer, 12, 995) < 0);
+    CHECK(rope->read_at(rope, buffer, 5, 995) == 5);
+    CHECK(memcmp(buffer, "fghij", 5) == 0);
+    rope->destroy(rope);
+TEST_END
+
+TEST_BEGIN("agrees with bytes_t")
+    // Mirror random edits in a bytes_t
+    bytes_t * bytes = bytes_pub.create("The quick brown fox", 19);
+    rope_t * rope = rope_pub.create(bytes->data(bytes), bytes->size(bytes));
+    rope_t * slice = NULL;
+    bytes_t * expect = NULL;
+    uint8_t data[64];
+    size_t agreed = 0;
+    size_t i;
+
+    for (i = 0; i < 20000; i++)
+    {
+        size_t size = bytes->size(bytes);
+        size_t offset = prng_next() % (size + 1);
+        size_t length = 1 + prng_next() % 16;
+
+        if (prng_next() % 3 || size < 100)
+        {
+            prng_fill(data, length);
+            bytes->insert(bytes, offset, data, length);
+            CHECK(rope->insert(rope, offset, data, length) ==
+                  (ssize_t) bytes->size(bytes));
+
+            // Keep typing after it, sometimes
+            if (prng_next() % 2)
+            {
+                bytes->insert(bytes, offset + length, "typed", 5);
+                rope->insert(rope, offset + length, "typed", 5);
+            }
+        }
+        else if (offset < size)
+        {
+            length = length > size - offset ? size - offset : length;
+            bytes->remove(bytes, offset, length);
+            CHECK(rope->remove(rope, offset, length) ==
+                  (ssize_t) bytes->size(bytes));
+        }
+
+        size = bytes->size(bytes);
+        offset = prng_next() % (size + 1);
+        length = prng_next() % (size - offset + 1);
+        length = length > sizeof(data) ? sizeof(data) : length;
+        CHECK(rope->read_at(rope, data, length, offset) == (ssize_t) length);
+        CHECK(memcmp(data, bytes->data(bytes) + offset, length) == 0);
+
+        if (i % 1000 == 0)
+        {
+            agreed += same(rope, bytes);
+
+            // Take a slice, and check that it holds on after more edits
+            if (slice)
+            {
+                agreed += same(slice, expect);
+                slice->destroy(slice);
+                expect->destroy(expect);
+            }
+
+            offset = prng_next() % (size + 1);
+            length = prng_next() % (size - offset + 1);
+            slice = rope->slice(rope, offset, length);
+            expect = bytes_pub.create(bytes->data(bytes) + offset, length);
+        }
+    }
+
+    CHECK(agreed == 39);
+    CHECK(same(rope, bytes));
+    CHECK(same(slice, expect));
+    BLAMMO(INFO, "%zu bytes in %zu pieces after %zu edits",
+           rope->size(rope), rope->pieces(rope), i);
+
+    slice->destroy(slice);
+    expect->destroy(expect);
+    rope->destroy(rope);
+    bytes->destroy(bytes);
+TEST_END
+
+TEST_BEGIN("benchmark")
+    // Random small edits scattered over a 50 MB buffer, as a bytes_t
+    // moves everything after each one and a rope does not
+    const size_t size = 50 << 20;
+    const size_t nbytes = 200;
+    const size_t nrope = 200000;
+    chronom_t * chronom = chronom_pub.create();
+    uint8_t * data = (uint8_t *) malloc(size);
+    double seconds[2];
+    size_t i;
+
+    prng_fill(data, size);
+    bytes_t * bytes = bytes_pub.create(data, size);
+    rope_t * rope = rope_pub.create(data, size);
+    free(data);
+
+    chronom->start(chronom);
+    for (i = 0; i < nbytes; i++)
+    {
+        size_t offset = prng_next() % (bytes->size(bytes) - 8);
+
+        if (i % 2)
+        {
+            bytes->remove(bytes, offset, 8);
+        }
+        else
+        {
+            bytes->insert(bytes, offset, "inserted", 8);
+        }
+    }
+    chronom->stop(chronom);
+    seconds[0] = chronom->elapsed_seconds(chronom);
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < nrope; i++)
+    {
+        size_t offset = prng_next() % (rope->size(rope) - 8);
+
+        if (i % 2)
+        {
+            rope->remove(rope, offset, 8);
+        }
+        else
+        {
+            rope->insert(rope, offset, "inserted", 8);
+        }
+    }
+    chronom->stop(chronom);
+    seconds[1] = chronom->elapsed_seconds(chronom);
+    CHECK(rope->size(rope) == size);
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    bytes_t * flat = rope->flatten(rope);
+    chronom->stop(chronom);
+    CHECK(flat->size(flat) == size);
+
+    BLAMMO(INFO, "random edits on %zu bytes: bytes_t %.2f us/edit, "
+           "rope %.3f us/edit (%zu pieces), flatten %.2f ms", size,
+           seconds[0] * 1e6 / nbytes, seconds[1] * 1e6 / nrope,
+           rope->pieces(rope), chronom->elapsed_seconds(chronom) * 1e3);
+
+    flat->destroy(flat);
+    rope->destroy(rope);
+    bytes->destroy(bytes);
+    chronom->destroy(chronom);
+TEST_END
+
+TESTSUITE_END
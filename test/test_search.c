@@ -0,0 +1,593 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "search.h"
+#include "bytes.h"
+#include "prng.h"
+#include "chronom.h"
+#include "mut.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//------------------------------------------------------------------------|
+static const cpu_path_t paths[] = {
+    CPU_PATH_SCALAR,
+    CPU_PATH_SSE2,
+    CPU_PATH_AVX2,
+};
+
+#define NUM_PATHS (sizeof(paths) / sizeof(paths[0]))
+
+//------------------------------------------------------------------------|
+// The obvious memcmp() at every offset, as the reference
+static ssize_t naive_forward(const uint8_t * haystack,
+                             size_t size,
+                             const uint8_t * needle,
+                             size_t needle_size)
+{
+    size_t i;
+
+    for (i = 0; i + needle_size <= size; i++)
+    {
+        if (!memcmp(haystack + i, needle, needle_size))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static ssize_t naive_reverse(const uint8_t * haystack,
+                             size_t size,
+                             const uint8_t * needle,
+                             size_t needle_size)
+{
+    size_t i;
+
+    for (i = size - needle_size + 1; size >= needle_size && i-- > 0; )
+    {
+        if (!memcmp(haystack + i, needle, needle_size))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static size_t naive_all(const uint8_t * haystack,
+                        size_t size,
+                        const uint8_t * needle,
+                        size_t needle_size,
+                        bool overlapping,
+                        size_t * offsets)
+{
+    size_t count = 0;
+    size_t i = 0;
+
+    while (needle_size && i + needle_size <= size)
+    {
+        if (!memcmp(haystack + i, needle, needle_size))
+        {
+            offsets[count++] = i;
+            i += overlapping ? 1 : needle_size;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    return count;
+}
+
+// Fill with bytes from a small alphabet, so that partial matches abound
+static void fill_alphabet(uint8_t * data, size_t size, size_t letters)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        data[i] = 'a' + prng_next() % letters;
+    }
+}
+
+// Whether every way of searching agrees with the reference
+static bool all_agree(const uint8_t * haystack,
+                      size_t size,
+                      const uint8_t * needle,
+                      size_t needle_size)
+{
+    ssize_t forward = naive_forward(haystack, size, needle, needle_size);
+    ssize_t reverse = naive_reverse(haystack, size, needle, needle_size);
+    bytes_searcher_t * searcher = bytes_searcher_pub.create(needle,
+                                                            needle_size);
+    bool agree = true;
+    size_t p;
+
+    agree &= search_forward(haystack, size, needle, needle_size) == forward;
+    agree &= search_reverse(haystack, size, needle, needle_size) == reverse;
+    agree &= searcher->forward(searcher, haystack, size) == forward;
+    agree &= searcher->reverse(searcher, haystack, size) == reverse;
+
+    for (p = 0; p < NUM_PATHS; p++)
+    {
+        agree &= search_forward_path(haystack, size, needle, needle_size,
+                                     paths[p]) == forward;
+        agree &= search_reverse_path(haystack, size, needle, needle_size,
+                                     paths[p]) == reverse;
+    }
+
+    if (!agree)
+    {
+        BLAMMO(ERROR, "disagreement on %zu byte needle in %zu bytes",
+               needle_size, size);
+    }
+
+    searcher->destroy(searcher);
+    return agree;
+}
+
+//------------------------------------------------------------------------|
+TESTSUITE_BEGIN
+
+    // Simple test of the blammo logger
+    BLAMMO_LEVEL(INFO);
+    BLAMMO_FILE("test_search.log");
+    BLAMMO(INFO, "search tests...");
+
+TEST_BEGIN("edge cases")
+    const char * text = "the quick brown fox jumps over the lazy dog";
+    size_t size = strlen(text);
+    size_t p;
+
+    BLAMMO(INFO, "auto path is %s", search_path_name(CPU_PATH_AUTO));
+    CHECK(cpu_path_supported(CPU_PATH_SCALAR));
+    CHECK(cpu_path_supported(CPU_PATH_AUTO));
+
+    // Empty needles are found at either end, even in empty haystacks
+    CHECK(search_forward(text, size, "", 0) == 0);
+    CHECK(search_reverse(text, size, "", 0) == (ssize_t) size);
+    CHECK(search_forward(NULL, 0, "", 0) == 0);
+    CHECK(search_reverse(NULL, 0, "", 0) == 0);
+    CHECK(search_forward(NULL, 0, "x", 1) < 0);
+    CHECK(search_reverse(NULL, 0, "x", 1) < 0);
+
+    for (p = 0; p < NUM_PATHS; p++)
+    {
+        cpu_path_t path = paths[p];
+
+        CHECK(search_forward_path(text, size, "the", 3, path) == 0);
+        CHECK(search_reverse_path(text, size, "the", 3, path) == 31);
+        CHECK(search_forward_path(text, size, "o", 1, path) == 12);
+        CHECK(search_reverse_path(text, size, "o", 1, path) == 41);
+        CHECK(search_forward_path(text, size, "dog", 3, path) == 40);
+        CHECK(search_reverse_path(text, size, "the q", 5, path) == 0);
+        CHECK(search_forward_path(text, size, "cat", 3, path) < 0);
+        CHECK(search_reverse_path(text, size, "cat", 3, path) < 0);
+        CHECK(search_forward_path(text, size, text, size, path) == 0);
+        CHECK(search_reverse_path(text, size, text, size, path) == 0);
+        CHECK(search_forward_path(text, size - 1, text, size, path) < 0);
+        CHECK(search_reverse_path(text, size - 1, text, size, path) < 0);
+    }
+
+    // Long needles, past the short-needle filter
+    CHECK(search_forward(text, size, "brown fox jumps over the lazy", 29)
+          == 10);
+    CHECK(search_reverse(text, size, "quick brown fox jumps over the", 30)
+          == 4);
+    CHECK(search_forward(text, size, "brown fox jumps over the crazy", 30)
+          < 0);
+TEST_END
+
+TEST_BEGIN("agrees with naive search")
+    // Small alphabets make for many near misses.  Needles are cut from
+    // the haystack so that most are found, or random so that most aren't,
+    // with lengths on either side of the vector widths and the short
+    // needle cutoff.
+    const size_t max = 700;
+    uint8_t haystack[700];
+    uint8_t needle[100];
+    size_t letters;
+    size_t round;
+
+    prng_seed(47);
+    for (letters = 1; letters <= 4; letters++)
+    {
+        for (round = 0; round < 2000; round++)
+        {
+            size_t size = prng_next() % max;
+            size_t needle_size = 1 + prng_next() % 80;
+
+            fill_alphabet(haystack, size, letters);
+            if (round & 1 && needle_size <= size)
+            {
+                memcpy(needle, haystack + prng_next() %
+                               (size - needle_size + 1), needle_size);
+            }
+            else
+            {
+                fill_alphabet(needle, needle_size, letters);
+            }
+
+            CHECK(all_agree(haystack, size, needle, needle_size));
+        }
+    }
+TEST_END
+
+TEST_BEGIN("adversarial inputs")
+    // Haystacks and needles built to defeat the first/last byte filter,
+    // or to have matches everywhere, or to be periodic
+    const size_t size = 20000;
+    uint8_t * haystack = (uint8_t *) malloc(size);
+    uint8_t needle[300];
+    size_t n;
+
+    memset(haystack, 'a', size);
+    for (n = 2; n <= sizeof(needle); n += 1 + n / 4)
+    {
+        // All 'a' except one byte in the middle, at the end, at the start
+        memset(needle, 'a', n);
+        needle[n / 2] = 'b';
+        CHECK(all_agree(haystack, size, needle, n));
+
+        memset(needle, 'a', n);
+        needle[n - 1] = 'b';
+        CHECK(all_agree(haystack, size, needle, n));
+
+        memset(needle, 'a', n);
+        needle[0] = 'b';
+        CHECK(all_agree(haystack, size, needle, n));
+
+        // Found everywhere
+        memset(needle, 'a', n);
+        CHECK(all_agree(haystack, size, needle, n));
+    }
+
+    // Periodic haystack, matching only at the very end or beginning
+    for (n = 0; n < size; n++)
+    {
+        haystack[n] = "ab"[n & 1];
+    }
+
+    for (n = 3; n <= sizeof(needle); n += 1 + n / 4)
+    {
+        size_t i;
+        for (i = 0; i < n; i++)
+        {
+            needle[i] = "ab"[i & 1];
+        }
+
+        needle[n - 1] = 'c';
+        haystack[size - 1] = 'c';
+        CHECK(all_agree(haystack, size, needle, n));
+        haystack[size - 1] = "ab"[(size - 1) & 1];
+        CHECK(all_agree(haystack, size, needle, n));
+    }
+
+    free(haystack);
+TEST_END
+
+TEST_BEGIN("all and count")
+    // Same inputs as above, plus the adversarial ones, with every match
+    // recorded, overlapping or not
+    const size_t max = 3000;
+    uint8_t * haystack = (uint8_t *) malloc(max);
+    size_t * expect = (size_t *) malloc(sizeof(size_t) * max);
+    size_t * offsets = NULL;
+    size_t capacity = 0;
+    uint8_t needle[100];
+    size_t round;
+
+    prng_seed(59);
+    for (round = 0; round < 4000; round++)
+    {
+        size_t size = prng_next() % max;
+        size_t needle_size = prng_next() % 40;
+        size_t letters = 1 + round % 4;
+        bool overlapping = round & 2;
+        size_t i;
+
+        if (round % 8 == 7)
+        {
+            // Periodic, to make the filter give up part way through
+            for (i = 0; i < size; i++)
+            {
+                haystack[i] = "ab"[i & 1];
+            }
+
+            for (i = 0; i < needle_size; i++)
+            {
+                needle[i] = "ab"[i & 1];
+            }
+
+            if (needle_size > 2 && round & 8)
+            {
+                needle[needle_size / 2] = 'c';
+                haystack[prng_next() % (size + 1)] = 'c';
+            }
+        }
+        else
+        {
+            fill_alphabet(haystack, size, letters);
+            fill_alphabet(needle, needle_size, letters);
+        }
+
+        size_t count = naive_all(haystack, size, needle, needle_size,
+                                 overlapping, expect);
+        bytes_searcher_t * searcher = bytes_searcher_pub.create(needle,
+                                                                needle_size);
+
+        CHECK(search_count(haystack, size, needle, needle_size,
+                           overlapping) == count);
+        CHECK(search_all(haystack, size, needle, needle_size, overlapping,
+                         &offsets, &capacity) == (ssize_t) count);
+        CHECK(count == 0 || !memcmp(offsets, expect, sizeof(size_t) * count));
+
+        CHECK(searcher->count(searcher, haystack, size, overlapping) ==
+              count);
+        CHECK(searcher->all(searcher, haystack, size, overlapping,
+                            &offsets, &capacity) == (ssize_t) count);
+        CHECK(count == 0 || !memcmp(offsets, expect, sizeof(size_t) * count));
+
+        searcher->destroy(searcher);
+    }
+
+    free(offsets);
+    free(expect);
+    free(haystack);
+TEST_END
+
+TEST_BEGIN("spans")
+    // Sets on either side of the vector limit, over data drawn mostly from
+    // them, with runs long enough to cross several vectors
+    const size_t max = 300;
+    uint8_t data[300];
+    uint8_t members[12];
+    search_set_t set;
+    size_t round;
+    size_t p;
+
+    prng_seed(59);
+    for (round = 0; round < 3000; round++)
+    {
+        size_t size = prng_next() % max;
+        size_t count = prng_next() % 13;
+        size_t span = 0;
+        size_t cspan = 0;
+        size_t i;
+
+        fill_alphabet(members, count, 16);
+        fill_alphabet(data, size, 1 + round % 16);
+        search_set_init(&set, members, count);
+
+        while (span < size && memchr(members, data[span], count))
+        {
+            span++;
+        }
+
+        while (cspan < size && !memchr(members, data[cspan], count))
+        {
+            cspan++;
+        }
+
+        CHECK(search_span(data, size, &set) == span);
+        CHECK(search_cspan(data, size, &set) == cspan);
+        for (p = 0; p < NUM_PATHS; p++)
+        {
+            CHECK(search_span_path(data, size, &set, paths[p]) == span);
+            CHECK(search_cspan_path(data, size, &set, paths[p]) == cspan);
+        }
+
+        for (i = 0; i < count; i++)
+        {
+            CHECK(set.member[members[i]]);
+        }
+    }
+TEST_END
+
+TEST_BEGIN("searcher")
+    bytes_t * bytes = bytes_pub.create("abc abc xabcx abc", 17);
+    bytes_searcher_t * searcher = bytes_searcher_pub.create("abc", 3);
+    char * copy = strdup("a longer needle, that is beyond the filter");
+    bytes_searcher_t * longer = bytes_searcher_pub.create(copy, strlen(copy));
+
+    CHECK(searcher->size(searcher) == 3);
+    CHECK(memcmp(searcher->needle(searcher), "abc", 3) == 0);
+
+    // The same answers as bytes->find_*
+    CHECK(searcher->find_forward(searcher, bytes, 0) == 0);
+    CHECK(searcher->find_forward(searcher, bytes, 1) == 4);
+    CHECK(searcher->find_forward(searcher, bytes, 5) == 9);
+    CHECK(searcher->find_forward(searcher, bytes, 15) < 0);
+    CHECK(searcher->find_forward(searcher, bytes, 99) < 0);
+    CHECK(searcher->find_reverse(searcher, bytes, 17) == 14);
+    CHECK(searcher->find_reverse(searcher, bytes, 16) == 9);
+    CHECK(searcher->find_reverse(searcher, bytes, 2) < 0);
+    CHECK(bytes->find_forward(bytes, 5, "abc", 3) == 9);
+    CHECK(bytes->find_reverse(bytes, 16, "abc", 3) == 9);
+    CHECK(bytes->find_forward(bytes, 99, "abc", 3) < 0);
+
+    // The needle is copied
+    memset(copy, 'x', strlen(copy));
+    bytes->assign(bytes, "it takes a longer needle, that is beyond the "
+                         "filter, to find this", 66);
+    CHECK(longer->find_forward(longer, bytes, 0) == 9);
+    CHECK(longer->find_reverse(longer, bytes, 66) == 9);
+    CHECK(longer->find_forward(longer, bytes, 10) < 0);
+
+    free(copy);
+    longer->destroy(longer);
+    searcher->destroy(searcher);
+    bytes->destroy(bytes);
+TEST_END
+
+TEST_BEGIN("benchmark")
+    // Needles that never occur in random text over 26 letters, in a run
+    // of one byte with the needle differing in the middle, and in periodic
+    // text with the needle breaking the period in the middle.  The last
+    // is built to defeat the filter, and ends up on Two-Way.  The naive
+    // search is the memcmp() at every offset that bytes->find_forward()
+    // used to be.
+    const char * inputs[] = { "random", "run", "periodic" };
+    const size_t size = 1 << 22;
+    const size_t lengths[] = { 2, 4, 8, 16, 32, 64, 256 };
+    uint8_t * haystack = (uint8_t *) malloc(size);
+    uint8_t needle[256];
+    chronom_t * chronom = chronom_pub.create();
+    size_t input;
+    size_t i;
+    size_t l;
+    size_t p;
+
+    prng_seed(53);
+    for (input = 0; input < 3; input++)
+    {
+        for (i = 0; i < size; i++)
+        {
+            haystack[i] = input == 0 ? 'a' + prng_next() % 26 :
+                          input == 1 ? 'a' : "ab"[i & 1];
+        }
+
+        for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+        {
+            size_t n = lengths[l];
+            double seconds;
+
+            for (i = 0; i < n; i++)
+            {
+                needle[i] = input == 0 ? 'a' + prng_next() % 26 :
+                            input == 1 ? 'a' : "ab"[i & 1];
+            }
+
+            needle[input == 0 ? n - 1 : n / 2] = input == 0 ? 'Z' : 'c';
+
+            chronom->reset(chronom);
+            chronom->start(chronom);
+            CHECK(naive_forward(haystack, size, needle, n) < 0);
+            chronom->stop(chronom);
+            seconds = chronom->elapsed_seconds(chronom);
+            BLAMMO(INFO, "%-8s %3zu byte needle: %-7s %7.3f GB/s",
+                   inputs[input], n, "naive", size / seconds / 1e9);
+
+            for (p = 0; p < NUM_PATHS; p++)
+            {
+                if (!cpu_path_supported(paths[p]))
+                {
+                    continue;
+                }
+
+                chronom->reset(chronom);
+                chronom->start(chronom);
+                CHECK(search_forward_path(haystack, size, needle, n,
+                                          paths[p]) < 0);
+                chronom->stop(chronom);
+                seconds = chronom->elapsed_seconds(chronom);
+                BLAMMO(INFO, "%-8s %3zu byte needle: %-7s %7.3f GB/s",
+                       inputs[input], n, search_path_name(paths[p]),
+                       size / seconds / 1e9);
+            }
+
+            chronom->reset(chronom);
+            chronom->start(chronom);
+            CHECK(search_reverse(haystack, size, needle, n) < 0);
+            chronom->stop(chronom);
+            seconds = chronom->elapsed_seconds(chronom);
+            BLAMMO(INFO, "%-8s %3zu byte needle: %-7s %7.3f GB/s",
+                   inputs[input], n, "reverse", size / seconds / 1e9);
+        }
+    }
+
+    chronom->destroy(chronom);
+    free(haystack);
+TEST_END
+
+TEST_BEGIN("find_all benchmark")
+    // Locating every line break and every marker in a log-like buffer.
+    // The loop of find_forward() calls is how this used to be done.
+    const size_t size = 1 << 23;
+    bytes_t * bytes = bytes_pub.create(NULL, 0);
+    chronom_t * chronom = chronom_pub.create();
+    const char * markers[] = { "\n", "ERROR" };
+    char line[128];
+    size_t m;
+
+    prng_seed(61);
+    while (bytes->size(bytes) < size)
+    {
+        int n = snprintf(line, sizeof(line), "%08x %s request %u took %u us\n",
+                         (unsigned) prng_next(),
+                         prng_next() % 50 ? "INFO " : "ERROR",
+                         (unsigned) (prng_next() % 100000),
+                         (unsigned) (prng_next() % 5000));
+        bytes->append(bytes, line, n);
+    }
+
+    for (m = 0; m < sizeof(markers) / sizeof(markers[0]); m++)
+    {
+        const char * marker = markers[m];
+        size_t length = strlen(marker);
+        size_t found = 0;
+        size_t count = 0;
+        double seconds[3];
+        ssize_t at = 0;
+
+        chronom->reset(chronom);
+        chronom->start(chronom);
+        while ((at = bytes->find_forward(bytes, at, marker, length)) >= 0)
+        {
+            found++;
+            at += length;
+        }
+        chronom->stop(chronom);
+        seconds[0] = chronom->elapsed_seconds(chronom);
+
+        chronom->reset(chronom);
+        chronom->start(chronom);
+        bytes->find_all(bytes, 0, marker, length, false, &count);
+        chronom->stop(chronom);
+        seconds[1] = chronom->elapsed_seconds(chronom);
+        CHECK(count == found);
+
+        chronom->reset(chronom);
+        chronom->start(chronom);
+        count = bytes->count(bytes, 0, marker, length, false);
+        chronom->stop(chronom);
+        seconds[2] = chronom->elapsed_seconds(chronom);
+        CHECK(count == found);
+
+        BLAMMO(INFO, "%zu x \"%s\": find_forward loop %.2f ms, "
+               "find_all %.2f ms, count %.2f ms",
+               found, m ? marker : "\\n", seconds[0] * 1e3,
+               seconds[1] * 1e3, seconds[2] * 1e3);
+    }
+
+    chronom->destroy(chronom);
+    bytes->destroy(bytes);
+TEST_END
+
+TESTSUITE_END
@@ -0,0 +1,381 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "snapshot.h"
+#include "collect.h"
+#include "chronom.h"
+#include "mut.h"
+#include "fixture.h"
+
+#include <string.h>
+#include <stdio.h>
+
+//------------------------------------------------------------------------|
+#define SNAPSHOT_PATH "test_snapshot.snap"
+
+//------------------------------------------------------------------------|
+// Serialize a C string object, including its terminator
+static ssize_t string_serialize(const void * object, void * buffer,
+                                size_t size)
+{
+    size_t length = strlen((const char *) object) + 1;
+    if (buffer && size >= length)
+    {
+        memcpy(buffer, object, length);
+    }
+
+    return (ssize_t) length;
+}
+
+static void * string_deserialize(const void * data, size_t size)
+{
+    char * string = (char *) malloc(size);
+    if (string)
+    {
+        memcpy(string, data, size);
+    }
+
+    return string;
+}
+
+// A serializer that always fails
+static ssize_t broken_serialize(const void * object, void * buffer,
+                                size_t size)
+{
+    return -1;
+}
+
+// Write arbitrary bytes to the snapshot path
+static void write_file(const void * data, size_t size)
+{
+    FILE * file = fopen(SNAPSHOT_PATH, "wb");
+    fwrite(data, 1, size, file);
+    fclose(file);
+}
+
+//------------------------------------------------------------------------|
+TESTSUITE_BEGIN
+
+    // Simple test of the blammo logger
+    BLAMMO_LEVEL(INFO);
+    BLAMMO_FILE("test_snapshot.log");
+    BLAMMO(INFO, "snapshot tests...");
+
+    // because these aren't always used, some warning eaters:
+    (void) fixture_reset;
+    (void) fixture_report;
+    (void) fixture_payload_one;
+    (void) fixture_payload_two;
+
+TEST_BEGIN("save and open")
+    collect_t * collect = collect_pub.create();
+    char key[32];
+    char value[32];
+    size_t size = 0;
+    size_t i;
+
+    for (i = 0; i < 1000; i++)
+    {
+        snprintf(key, sizeof(key), "key.%zu", i);
+        snprintf(value, sizeof(value), "value.%zu", i * 3);
+        collect->set(collect, key, strdup(value), NULL, free);
+    }
+
+    CHECK(snapshot_pub.save(collect, SNAPSHOT_PATH, string_serialize));
+
+    snapshot_t * snapshot = snapshot_pub.open(SNAPSHOT_PATH);
+    CHECK(snapshot != NULL);
+    CHECK(snapshot->priv != NULL);
+    CHECK(!snapshot->empty(snapshot));
+    CHECK(snapshot->length(snapshot) == 1000);
+
+    for (i = 0; i < 1000; i++)
+    {
+        snprintf(key, sizeof(key), "key.%zu", i);
+        snprintf(value, sizeof(value), "value.%zu", i * 3);
+
+        const char * object = snapshot->get(snapshot, key, &size);
+        CHECK(object != NULL);
+        CHECK(size == strlen(value) + 1);
+        CHECK(!strcmp(object, value));
+        CHECK(((uintptr_t) object & 7) == 0);
+        CHECK(snapshot->contains(snapshot, key));
+    }
+
+    CHECK(snapshot->get(snapshot, "key.1000", NULL) == NULL);
+    CHECK(snapshot->get(snapshot, "key.", NULL) == NULL);
+    CHECK(snapshot->get(snapshot, "", NULL) == NULL);
+    CHECK(!snapshot->contains(snapshot, "value.0"));
+
+    // Iteration follows the order of the collection
+    const char * snap_key;
+    const void * snap_object;
+    char * coll_key;
+    void * coll_object;
+    void * it = snapshot->first(snapshot, &snap_key, &snap_object, &size);
+    void * cit = collect->first(collect, &coll_key, &coll_object);
+    size_t count = 0;
+
+    while (it)
+    {
+        CHECK(cit != NULL);
+        CHECK(!strcmp(snap_key, coll_key));
+        CHECK(!strcmp((const char *) snap_object, (char *) coll_object));
+        CHECK(size == strlen((char *) coll_object) + 1);
+        count++;
+
+        it = snapshot->next(snapshot, it, &snap_key, &snap_object, &size);
+        cit = collect->next(cit, &coll_key, &coll_object);
+    }
+
+    CHECK(cit == NULL);
+    CHECK(count == 1000);
+    CHECK(snap_key == NULL);
+    CHECK(snap_object == NULL);
+
+    // The mapping outlives the collection, and survives a new snapshot
+    // being saved over the same path
+    collect->destroy(collect);
+    collect = collect_pub.create();
+    CHECK(snapshot_pub.save(collect, SNAPSHOT_PATH, string_serialize));
+    CHECK(!strcmp(snapshot->get(snapshot, "key.7", NULL), "value.21"));
+    snapshot->destroy(snapshot);
+
+    // ... which is empty
+    snapshot = snapshot_pub.open(SNAPSHOT_PATH);
+    CHECK(snapshot != NULL);
+    CHECK(snapshot->empty(snapshot));
+    CHECK(snapshot->length(snapshot) == 0);
+    CHECK(snapshot->get(snapshot, "key.7", NULL) == NULL);
+    CHECK(snapshot->first(snapshot, &snap_key, &snap_object, NULL) == NULL);
+    CHECK(snap_key == NULL);
+    snapshot->destroy(snapshot);
+
+    collect->destroy(collect);
+    remove(SNAPSHOT_PATH);
+TEST_END
+
+TEST_BEGIN("keys only and empty objects")
+    collect_t * collect = collect_pub.create();
+    size_t size = 1;
+
+    collect->set(collect, "alpha", "one", NULL, NULL);
+    collect->set(collect, "beta", NULL, NULL, NULL);
+    collect->set(collect, "", "three", NULL, NULL);
+
+    // NULL objects are stored empty, but their keys are still present
+    CHECK(snapshot_pub.save(collect, SNAPSHOT_PATH, string_serialize));
+    snapshot_t * snapshot = snapshot_pub.open(SNAPSHOT_PATH);
+    CHECK(snapshot != NULL);
+    CHECK(!strcmp(snapshot->get(snapshot, "alpha", &size), "one"));
+    CHECK(size == 4);
+    CHECK(snapshot->get(snapshot, "beta", &size) != NULL);
+    CHECK(size == 0);
+    CHECK(!strcmp(snapshot->get(snapshot, "", &size), "three"));
+    snapshot->destroy(snapshot);
+
+    // Without a serializer only the keys are kept
+    CHECK(snapshot_pub.save(collect, SNAPSHOT_PATH, NULL));
+    snapshot = snapshot_pub.open(SNAPSHOT_PATH);
+    CHECK(snapshot != NULL);
+    CHECK(snapshot->length(snapshot) == 3);
+    CHECK(snapshot->contains(snapshot, "alpha"));
+    CHECK(snapshot->contains(snapshot, "beta"));
+    CHECK(snapshot->contains(snapshot, ""));
+    CHECK(snapshot->get(snapshot, "alpha", &size) != NULL);
+    CHECK(size == 0);
+    snapshot->destroy(snapshot);
+
+    // A failing serializer leaves the existing snapshot alone
+    CHECK(!snapshot_pub.save(collect, SNAPSHOT_PATH, broken_serialize));
+    snapshot = snapshot_pub.open(SNAPSHOT_PATH);
+    CHECK(snapshot != NULL);
+    CHECK(snapshot->length(snapshot) == 3);
+    snapshot->destroy(snapshot);
+
+    collect->destroy(collect);
+    remove(SNAPSHOT_PATH);
+TEST_END
+
+TEST_BEGIN("restore")
+    collect_t * collect = collect_pub.create();
+    char key[32];
+    char value[32];
+    size_t i;
+
+    for (i = 0; i < 100; i++)
+    {
+        snprintf(key, sizeof(key), "restore.%zu", i);
+        snprintf(value, sizeof(value), "%zu", i * i);
+        collect->set(collect, key, strdup(value), NULL, free);
+    }
+
+    CHECK(snapshot_pub.save(collect, SNAPSHOT_PATH, string_serialize));
+    snapshot_t * snapshot = snapshot_pub.open(SNAPSHOT_PATH);
+    CHECK(snapshot != NULL);
+
+    collect_t * restored = snapshot->restore(snapshot,
+                                             string_deserialize, free);
+    snapshot->destroy(snapshot);
+
+    CHECK(restored != NULL);
+    CHECK(restored->length(restored) == 100);
+
+    // Same keys, same objects, same order, and independent of the file
+    const char ** keys = collect->keys(collect);
+    const char ** restored_keys = restored->keys(restored);
+    for (i = 0; i < 100; i++)
+    {
+        CHECK(!strcmp(keys[i], restored_keys[i]));
+        CHECK(!strcmp(collect->get(collect, keys[i]),
+                      restored->get(restored, keys[i])));
+    }
+
+    CHECK(restored_keys[100] == NULL);
+
+    restored->destroy(restored);
+    collect->destroy(collect);
+    remove(SNAPSHOT_PATH);
+TEST_END
+
+TEST_BEGIN("invalid files")
+    remove(SNAPSHOT_PATH);
+    CHECK(snapshot_pub.open(SNAPSHOT_PATH) == NULL);
+
+    write_file("", 0);
+    CHECK(snapshot_pub.open(SNAPSHOT_PATH) == NULL);
+
+    char garbage[256];
+    memset(garbage, 'x', sizeof(garbage));
+    write_file(garbage, sizeof(garbage));
+    CHECK(snapshot_pub.open(SNAPSHOT_PATH) == NULL);
+
+    // A truncated snapshot is refused
+    collect_t * collect = collect_pub.create();
+    collect->set(collect, "alpha", "one", NULL, NULL);
+    collect->set(collect, "beta", "two", NULL, NULL);
+    CHECK(snapshot_pub.save(collect, SNAPSHOT_PATH, string_serialize));
+
+    FILE * file = fopen(SNAPSHOT_PATH, "rb");
+    size_t size = fread(garbage, 1, sizeof(garbage), file);
+    fclose(file);
+    CHECK(size < sizeof(garbage));
+
+    write_file(garbage, size - 8);
+    CHECK(snapshot_pub.open(SNAPSHOT_PATH) == NULL);
+
+    // As is one with a corrupted header
+    garbage[8] ^= 0xff;
+    write_file(garbage, size);
+    CHECK(snapshot_pub.open(SNAPSHOT_PATH) == NULL);
+
+    collect->destroy(collect);
+    remove(SNAPSHOT_PATH);
+TEST_END
+
+TEST_BEGIN("startup benchmark")
+    // Loading by re-setting every key against mapping a snapshot, each
+    // followed by the same batch of lookups.
+    const size_t nkeys = 100000;
+    const size_t nlookups = 10000;
+    collect_t * collect = collect_pub.create();
+    chronom_t * chronom = chronom_pub.create();
+    char ** names = (char **) malloc(sizeof(char *) * nkeys);
+    void ** values = (void **) malloc(sizeof(void *) * nkeys);
+    generic_destroy_f * destroy_fns = (generic_destroy_f *)
+            malloc(sizeof(generic_destroy_f) * nkeys);
+    char key[32];
+    size_t found = 0;
+    size_t i;
+
+    for (i = 0; i < nkeys; i++)
+    {
+        snprintf(key, sizeof(key), "table.entry.%zu", i);
+        names[i] = strdup(key);
+        snprintf(key, sizeof(key), "%zu", i);
+        values[i] = strdup(key);
+        destroy_fns[i] = free;
+    }
+
+    CHECK(collect->set_many(collect, (const char **) names, values, NULL,
+                            destroy_fns, nkeys));
+
+    chronom->start(chronom);
+    CHECK(snapshot_pub.save(collect, SNAPSHOT_PATH, string_serialize));
+    chronom->stop(chronom);
+    double save_ms = chronom->elapsed_seconds(chronom) * 1e3;
+
+    // The old way: rebuild a collection from scratch, indexed for lookups
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    collect_t * rebuilt = collect_pub.create();
+    rebuilt->index(rebuilt, true);
+    for (i = 0; i < nkeys; i++)
+    {
+        rebuilt->set(rebuilt, names[i], strdup(values[i]), NULL, free);
+    }
+
+    for (i = 0; i < nlookups; i++)
+    {
+        snprintf(key, sizeof(key), "table.entry.%zu", (i * 7919) % nkeys);
+        found += rebuilt->get(rebuilt, key) != NULL;
+    }
+    chronom->stop(chronom);
+    double rebuild_ms = chronom->elapsed_seconds(chronom) * 1e3;
+    rebuilt->destroy(rebuilt);
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    snapshot_t * snapshot = snapshot_pub.open(SNAPSHOT_PATH);
+    CHECK(snapshot != NULL);
+    for (i = 0; i < nlookups; i++)
+    {
+        snprintf(key, sizeof(key), "table.entry.%zu", (i * 7919) % nkeys);
+        found += snapshot->get(snapshot, key, NULL) != NULL;
+    }
+    chronom->stop(chronom);
+    double open_ms = chronom->elapsed_seconds(chronom) * 1e3;
+
+    BLAMMO(INFO, "%zu keys: save %.1f ms, rebuild + lookups %.1f ms, "
+                 "open + lookups %.2f ms", nkeys, save_ms, rebuild_ms,
+                 open_ms);
+
+    CHECK(found == 2 * nlookups);
+    CHECK(open_ms < rebuild_ms);
+
+    for (i = 0; i < nkeys; i++)
+    {
+        free(names[i]);
+    }
+
+    free(names);
+    free(values);
+    free(destroy_fns);
+    snapshot->destroy(snapshot);
+    chronom->destroy(chronom);
+    collect->destroy(collect);
+    remove(SNAPSHOT_PATH);
+TEST_END
+
+TESTSUITE_END
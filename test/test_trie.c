@@ -0,0 +1,302 @@
+//------------------------------------------------------------------------|
+// Copyright (c) 2026 by Raymond M. Foulk IV (rfoulk@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//------------------------------------------------------------------------|
+
+#include "blammo.h"
+#include "trie.h"
+#include "chronom.h"
+#include "prng.h"
+#include "mut.h"
+
+#include <string.h>
+#include <limits.h>
+
+//------------------------------------------------------------------------|
+// Visitor that records visited keys into a flat array of fixed width
+typedef struct
+{
+    char keys[16][32];
+    size_t count;
+}
+visited_t;
+
+static bool visit_record(void * object, const char * key,
+                         size_t size, void * data)
+{
+    visited_t * visited = (visited_t *) object;
+    if (visited->count < 16)
+    {
+        strncpy(visited->keys[visited->count], key, 31);
+    }
+
+    visited->count++;
+    return true;
+}
+
+static bool visit_stop(void * object, const char * key,
+                       size_t size, void * data)
+{
+    (*(size_t *) object)++;
+    return false;
+}
+
+//------------------------------------------------------------------------|
+static void * string_copy(const void * str)
+{
+    return strdup((const char *) str);
+}
+
+//------------------------------------------------------------------------|
+TESTSUITE_BEGIN
+
+    // Simple test of the blammo logger
+    BLAMMO_LEVEL(INFO);
+    BLAMMO_FILE("test_trie.log");
+    BLAMMO(INFO, "trie tests...");
+
+TEST_BEGIN("create")
+    trie_t * trie = trie_pub.create(NULL, NULL);
+    CHECK(trie != NULL);
+    CHECK(trie->priv != NULL);
+    CHECK(trie->empty(trie));
+    CHECK(trie->length(trie) == 0);
+    trie->destroy(trie);
+TEST_END
+
+TEST_BEGIN("set, get, overwrite")
+    trie_t * trie = trie_pub.create(string_copy, free);
+
+    CHECK(trie->set(trie, "romane", 6, strdup("1")));
+    CHECK(trie->set(trie, "romanus", 7, strdup("2")));
+    CHECK(trie->set(trie, "romulus", 7, strdup("3")));
+    CHECK(trie->set(trie, "rubens", 6, strdup("4")));
+    CHECK(trie->set(trie, "ruber", 5, strdup("5")));
+    CHECK(trie->set(trie, "rubicon", 7, strdup("6")));
+    CHECK(trie->set(trie, "rubicundus", 10, strdup("7")));
+    CHECK(trie->set(trie, "rom", 3, strdup("8")));
+    CHECK(trie->length(trie) == 8);
+
+    CHECK(strcmp(trie->get(trie, "romulus", 7), "3") == 0);
+    CHECK(strcmp(trie->get(trie, "rubicon", 7), "6") == 0);
+    CHECK(strcmp(trie->get(trie, "rom", 3), "8") == 0);
+    CHECK(trie->get(trie, "ro", 2) == NULL);
+    CHECK(trie->get(trie, "roman", 5) == NULL);
+    CHECK(trie->get(trie, "rubiconx", 8) == NULL);
+    CHECK(!trie->contains(trie, "rub", 3));
+
+    // overwrite keeps the length the same
+    CHECK(trie->set(trie, "rom", 3, strdup("nine")));
+    CHECK(trie->length(trie) == 8);
+    CHECK(strcmp(trie->get(trie, "rom", 3), "nine") == 0);
+
+    // empty key and binary keys are both legitimate
+    CHECK(trie->set(trie, "", 0, strdup("empty")));
+    CHECK(trie->set(trie, "a\0b", 3, strdup("binary")));
+    CHECK(strcmp(trie->get(trie, "", 0), "empty") == 0);
+    CHECK(strcmp(trie->get(trie, "a\0b", 3), "binary") == 0);
+    CHECK(trie->get(trie, "a", 1) == NULL);
+    CHECK(trie->length(trie) == 10);
+
+    trie->destroy(trie);
+TEST_END
+
+TEST_BEGIN("remove")
+    trie_t * trie = trie_pub.create(NULL, NULL);
+
+    trie->set(trie, "test", 4, (void *) 1);
+    trie->set(trie, "tester", 6, (void *) 2);
+    trie->set(trie, "testing", 7, (void *) 3);
+    trie->set(trie, "team", 4, (void *) 4);
+
+    CHECK(!trie->remove(trie, "tes", 3));
+    CHECK(!trie->remove(trie, "testers", 7));
+    CHECK(trie->remove(trie, "test", 4));
+    CHECK(!trie->remove(trie, "test", 4));
+    CHECK(trie->length(trie) == 3);
+    CHECK(trie->get(trie, "tester", 6) == (void *) 2);
+    CHECK(trie->get(trie, "testing", 7) == (void *) 3);
+
+    CHECK(trie->remove(trie, "tester", 6));
+    CHECK(trie->get(trie, "testing", 7) == (void *) 3);
+    CHECK(trie->get(trie, "team", 4) == (void *) 4);
+
+    CHECK(trie->remove(trie, "testing", 7));
+    CHECK(trie->remove(trie, "team", 4));
+    CHECK(trie->empty(trie));
+
+    // re-usable after emptying by removal
+    trie->set(trie, "again", 5, (void *) 5);
+    CHECK(trie->get(trie, "again", 5) == (void *) 5);
+
+    trie->destroy(trie);
+TEST_END
+
+TEST_BEGIN("longest_prefix")
+    trie_t * trie = trie_pub.create(NULL, NULL);
+    size_t matched = 0;
+
+    trie->set(trie, "10.", 3, (void *) 1);
+    trie->set(trie, "10.1.", 5, (void *) 2);
+    trie->set(trie, "10.1.2.", 7, (void *) 3);
+
+    CHECK(trie->longest_prefix(trie, "10.1.2.3", 8, &matched) == (void *) 3);
+    CHECK(matched == 7);
+    CHECK(trie->longest_prefix(trie, "10.1.9.9", 8, &matched) == (void *) 2);
+    CHECK(matched == 5);
+    CHECK(trie->longest_prefix(trie, "10.2", 4, &matched) == (void *) 1);
+    CHECK(matched == 3);
+    CHECK(trie->longest_prefix(trie, "192.168", 7, &matched) == NULL);
+    CHECK(matched == 0);
+
+    trie->destroy(trie);
+TEST_END
+
+TEST_BEGIN("complete")
+    trie_t * trie = trie_pub.create(NULL, NULL);
+    visited_t visited;
+
+    trie->set(trie, "log", 3, NULL);
+    trie->set(trie, "log.file", 8, NULL);
+    trie->set(trie, "log.level", 9, NULL);
+    trie->set(trie, "logout", 6, NULL);
+    trie->set(trie, "list", 4, NULL);
+    trie->set(trie, "help", 4, NULL);
+
+    memset(&visited, 0, sizeof(visited));
+    CHECK(trie->complete(trie, "lo", 2, visit_record, &visited) == 4);
+    CHECK(visited.count == 4);
+    CHECK(strcmp(visited.keys[0], "log") == 0);
+    CHECK(strcmp(visited.keys[1], "log.file") == 0);
+    CHECK(strcmp(visited.keys[2], "log.level") == 0);
+    CHECK(strcmp(visited.keys[3], "logout") == 0);
+
+    // prefix ending part-way along a compressed edge
+    memset(&visited, 0, sizeof(visited));
+    CHECK(trie->complete(trie, "log.l", 5, visit_record, &visited) == 1);
+    CHECK(strcmp(visited.keys[0], "log.level") == 0);
+
+    // empty prefix visits everything, in order
+    memset(&visited, 0, sizeof(visited));
+    CHECK(trie->complete(trie, "", 0, visit_record, &visited) == 6);
+    CHECK(strcmp(visited.keys[0], "help") == 0);
+    CHECK(strcmp(visited.keys[1], "list") == 0);
+
+    CHECK(trie->complete(trie, "x", 1, NULL, NULL) == 0);
+    CHECK(trie->complete(trie, "l", 1, NULL, NULL) == 5);
+
+    size_t stops = 0;
+    trie->complete(trie, "l", 1, visit_stop, &stops);
+    CHECK(stops == 1);
+
+    trie->destroy(trie);
+TEST_END
+
+TEST_BEGIN("copy, clear")
+    trie_t * trie = trie_pub.create(string_copy, free);
+    trie->set(trie, "alpha", 5, strdup("a"));
+    trie->set(trie, "alphabet", 8, strdup("b"));
+    trie->set(trie, "beta", 4, strdup("c"));
+
+    trie_t * copy = trie->copy(trie);
+    CHECK(copy->length(copy) == 3);
+    CHECK(copy->get(copy, "alphabet", 8) != trie->get(trie, "alphabet", 8));
+    CHECK(strcmp(copy->get(copy, "alphabet", 8), "b") == 0);
+
+    trie->clear(trie);
+    CHECK(trie->empty(trie));
+    CHECK(trie->get(trie, "beta", 4) == NULL);
+    CHECK(strcmp(copy->get(copy, "beta", 4), "c") == 0);
+
+    copy->destroy(copy);
+    trie->destroy(trie);
+TEST_END
+
+TEST_BEGIN("completion latency, 100k keywords")
+    // Compare enumerating completions from the trie against the linear
+    // scan of every keyword that a completion handler would otherwise do
+    const size_t nkeys = 100000;
+    const size_t nlookups = 2000;
+    char (*words)[16] = malloc(nkeys * sizeof(*words));
+    trie_t * trie = trie_pub.create(NULL, NULL);
+    chronom_t * chronom = chronom_pub.create();
+    size_t i, j, len, linear = 0, fast = 0;
+
+    prng_seed(0x7A1E5ULL);
+    for (i = 0; i < nkeys; i++)
+    {
+        len = 4 + (prng_next() % 10);
+        prng_alpha(words[i], len);
+        words[i][len] = '\0';
+        trie->set(trie, words[i], len, (void *) (i + 1));
+    }
+
+    CHECK(trie->length(trie) <= nkeys);
+
+    chronom->start(chronom);
+    for (i = 0; i < nlookups; i++)
+    {
+        const char * prefix = words[prng_next() % nkeys];
+        len = 2 + (i % 3);
+        for (j = 0; j < nkeys; j++)
+        {
+            if (!strncmp(words[j], prefix, len))
+            {
+                linear++;
+            }
+        }
+    }
+    chronom->stop(chronom);
+    double linear_us = chronom->elapsed_seconds(chronom) * 1e6 / nlookups;
+
+    prng_seed(0x7A1E5ULL);
+    for (i = 0; i < nkeys; i++)
+    {
+        len = 4 + (prng_next() % 10);
+        prng_alpha(words[i], len);
+        words[i][len] = '\0';
+    }
+
+    chronom->reset(chronom);
+    chronom->start(chronom);
+    for (i = 0; i < nlookups; i++)
+    {
+        const char * prefix = words[prng_next() % nkeys];
+        len = 2 + (i % 3);
+        fast += trie->complete(trie, prefix, len, NULL, NULL);
+    }
+    chronom->stop(chronom);
+    double trie_us = chronom->elapsed_seconds(chronom) * 1e6 / nlookups;
+
+    BLAMMO(INFO, "completion latency: linear %.2f us, trie %.2f us",
+                 linear_us, trie_us);
+
+    // Duplicate random words collapse into one key, so the trie can
+    // only ever report the same or fewer matches than the raw scan.
+    CHECK(fast > 0);
+    CHECK(fast <= linear);
+
+    chronom->destroy(chronom);
+    trie->destroy(trie);
+    free(words);
+TEST_END
+
+TESTSUITE_END